@@ -70,11 +70,13 @@
 #include "ast2ram/utility/TranslatorContext.h"
 #include "config.h"
 #include "interpreter/Engine.h"
+#include "interpreter/Hybrid.h"
 #include "interpreter/ProgInterface.h"
 #include "parser/ParserDriver.h"
 #include "ram/Node.h"
 #include "ram/Program.h"
 #include "ram/TranslationUnit.h"
+#include "ram/analysis/LayoutAdvisor.h"
 #include "ram/transform/CollapseFilters.h"
 #include "ram/transform/Conditional.h"
 #include "ram/transform/EliminateDuplicates.h"
@@ -88,12 +90,16 @@
 #include "ram/transform/Parallel.h"
 #include "ram/transform/ReorderConditions.h"
 #include "ram/transform/ReorderFilterBreak.h"
+#include "ram/transform/ReplaceRareSearches.h"
 #include "ram/transform/ReportIndex.h"
+#include "ram/transform/SelectHashset.h"
 #include "ram/transform/Sequence.h"
 #include "ram/transform/Transformer.h"
+#include "ram/transform/TrieJoin.h"
 #include "ram/transform/TupleId.h"
 #include "reports/DebugReport.h"
 #include "reports/ErrorReport.h"
+#include "souffle/QueryServer.h"
 #include "souffle/RamTypes.h"
 #ifndef _MSC_VER
 #include "souffle/profile/Tui.h"
@@ -102,13 +108,16 @@
 #include "souffle/utility/ContainerUtil.h"
 #include "souffle/utility/FileUtil.h"
 #include "souffle/utility/MiscUtil.h"
+#include "souffle/utility/ParallelUtil.h"
 #include "souffle/utility/StreamUtil.h"
 #include "souffle/utility/StringUtil.h"
 #include "souffle/utility/SubProcess.h"
 #include "synthesiser/GenDb.h"
 #include "synthesiser/Synthesiser.h"
 
+#include <algorithm>
 #include <cassert>
+#include <cctype>
 #include <chrono>
 #include <cstdio>
 #include <cstdlib>
@@ -116,12 +125,14 @@
 #include <filesystem>
 #include <iomanip>
 #include <iostream>
+#include <limits>
 #include <map>
 #include <memory>
 #include <set>
 #include <sstream>
 #include <stdexcept>
 #include <string>
+#include <system_error>
 #include <thread>
 #include <utility>
 #include <vector>
@@ -177,29 +188,42 @@ namespace souffle {
 /**
  * Compiles the given source file to a binary file.
  */
-void compileToBinary(
-        Global& glb, const std::string& command, std::vector<fs::path>& sourceFilenames, fs::path binary) {
+void compileToBinary(const MainConfig& config, const std::string& command,
+        std::vector<fs::path>& sourceFilenames, fs::path binary, bool sharedLibrary = false) {
     std::vector<std::string> argv;
 
     argv.push_back(command);
 
-    if (glb.config().has("swig")) {
+    if (sharedLibrary) {
+        argv.push_back("--shared");
+    }
+
+    if (config.has("swig")) {
         argv.push_back("-s");
-        argv.push_back(glb.config().get("swig"));
+        argv.push_back(config.get("swig"));
     }
 
-    if (glb.config().has("verbose")) {
+    if (config.has("verbose")) {
         argv.push_back("-v");
     }
 
-    for (auto&& path : glb.config().getMany("library-dir")) {
+    // job count of 0 lets souffle-compile use one compiler process per core
+    argv.push_back("-j");
+    argv.push_back(config.get("jobs"));
+
+    if (config.has("compile-cache")) {
+        argv.push_back("--cache-dir");
+        argv.push_back(config.get("compile-cache"));
+    }
+
+    for (auto&& path : config.getMany("library-dir")) {
         // The first entry may be blank
         if (path.empty()) {
             continue;
         }
         argv.push_back(tfm::format("-L%s", path));
     }
-    for (auto&& library : glb.config().getMany("libraries")) {
+    for (auto&& library : config.getMany("libraries")) {
         // The first entry may be blank
         if (library.empty()) {
             continue;
@@ -447,24 +471,34 @@ static WarnSet process_warn_opts(const Global& glb) {
 }
 
 Own<ast::transform::PipelineTransformer> astTransformationPipeline(Global& glb) {
+    // A query server looks up tuples in all relations of the evaluated program, which must
+    // not be merged, inlined or removed
+    const bool keepRelations = glb.config().has("query-server");
+    auto unlessKeepRelations = [&](Own<ast::transform::Transformer> transformer) {
+        return mk<ast::transform::ConditionalTransformer>(!keepRelations, std::move(transformer));
+    };
+
     // clang-format off
     // Equivalence pipeline
     auto equivalencePipeline =
             mk<ast::transform::PipelineTransformer>(mk<ast::transform::NameUnnamedVariablesTransformer>(),
-                    mk<ast::transform::FixpointTransformer>(mk<ast::transform::MinimiseProgramTransformer>()),
+                    mk<ast::transform::FixpointTransformer>(
+                            unlessKeepRelations(mk<ast::transform::MinimiseProgramTransformer>())),
                     mk<ast::transform::ReplaceSingletonVariablesTransformer>(),
-                    mk<ast::transform::RemoveRelationCopiesTransformer>(),
-                    mk<ast::transform::RemoveEmptyRelationsTransformer>(),
-                    mk<ast::transform::RemoveRedundantRelationsTransformer>());
+                    unlessKeepRelations(mk<ast::transform::RemoveRelationCopiesTransformer>()),
+                    unlessKeepRelations(mk<ast::transform::RemoveEmptyRelationsTransformer>()),
+                    unlessKeepRelations(mk<ast::transform::RemoveRedundantRelationsTransformer>()));
 
     // Magic-Set pipeline
     auto magicPipeline = mk<ast::transform::PipelineTransformer>(
             mk<ast::transform::ConditionalTransformer>(
                     glb.config().has("magic-transform"), mk<ast::transform::ExpandEqrelsTransformer>()),
-            mk<ast::transform::MagicSetTransformer>(), mk<ast::transform::ResolveAliasesTransformer>(),
-            mk<ast::transform::RemoveRelationCopiesTransformer>(),
-            mk<ast::transform::RemoveEmptyRelationsTransformer>(),
-            mk<ast::transform::RemoveRedundantRelationsTransformer>(), clone(equivalencePipeline));
+            unlessKeepRelations(mk<ast::transform::MagicSetTransformer>()),
+            mk<ast::transform::ResolveAliasesTransformer>(),
+            unlessKeepRelations(mk<ast::transform::RemoveRelationCopiesTransformer>()),
+            unlessKeepRelations(mk<ast::transform::RemoveEmptyRelationsTransformer>()),
+            unlessKeepRelations(mk<ast::transform::RemoveRedundantRelationsTransformer>()),
+            clone(equivalencePipeline));
 
     // Partitioning pipeline
     auto partitionPipeline =
@@ -498,22 +532,26 @@ Own<ast::transform::PipelineTransformer> astTransformationPipeline(Global& glb)
             mk<ast::transform::NormaliseGeneratorsTransformer>(),
             mk<ast::transform::ResolveAliasesTransformer>(),
             mk<ast::transform::RemoveBooleanConstraintsTransformer>(),
-            mk<ast::transform::ResolveAliasesTransformer>(), mk<ast::transform::MinimiseProgramTransformer>(),
+            mk<ast::transform::ResolveAliasesTransformer>(),
+            unlessKeepRelations(mk<ast::transform::MinimiseProgramTransformer>()),
             mk<ast::transform::InlineUnmarkExcludedTransform>(),
-            mk<ast::transform::InlineRelationsTransformer>(), mk<ast::transform::GroundedTermsChecker>(),
+            unlessKeepRelations(mk<ast::transform::InlineRelationsTransformer>()),
+            mk<ast::transform::GroundedTermsChecker>(),
             mk<ast::transform::ResolveAliasesTransformer>(),
             mk<ast::transform::SimplifyConstantBinaryConstraintsTransformer>(),
             mk<ast::transform::RemoveBooleanConstraintsTransformer>(),
-            mk<ast::transform::RemoveRedundantRelationsTransformer>(),
-            mk<ast::transform::RemoveRelationCopiesTransformer>(),
-            mk<ast::transform::RemoveEmptyRelationsTransformer>(),
+            unlessKeepRelations(mk<ast::transform::RemoveRedundantRelationsTransformer>()),
+            unlessKeepRelations(mk<ast::transform::RemoveRelationCopiesTransformer>()),
+            unlessKeepRelations(mk<ast::transform::RemoveEmptyRelationsTransformer>()),
             mk<ast::transform::ReplaceSingletonVariablesTransformer>(),
             mk<ast::transform::FixpointTransformer>(mk<ast::transform::PipelineTransformer>(
-                    mk<ast::transform::ReduceExistentialsTransformer>(),
-                    mk<ast::transform::RemoveRedundantRelationsTransformer>())),
-            mk<ast::transform::RemoveRelationCopiesTransformer>(), std::move(partitionPipeline),
-            std::move(equivalencePipeline), mk<ast::transform::RemoveRelationCopiesTransformer>(),
-            std::move(magicPipeline), mk<ast::transform::RemoveEmptyRelationsTransformer>(),
+                    unlessKeepRelations(mk<ast::transform::ReduceExistentialsTransformer>()),
+                    unlessKeepRelations(mk<ast::transform::RemoveRedundantRelationsTransformer>()))),
+            unlessKeepRelations(mk<ast::transform::RemoveRelationCopiesTransformer>()),
+            std::move(partitionPipeline), std::move(equivalencePipeline),
+            unlessKeepRelations(mk<ast::transform::RemoveRelationCopiesTransformer>()),
+            std::move(magicPipeline),
+            unlessKeepRelations(mk<ast::transform::RemoveEmptyRelationsTransformer>()),
             mk<ast::transform::AddNullariesToAtomlessAggregatesTransformer>(),
             mk<ast::transform::ExecutionPlanChecker>(), std::move(provenancePipeline),
             mk<ast::transform::IOAttributesTransformer>());
@@ -539,16 +577,21 @@ Own<ram::transform::Transformer> ramTransformerSequence(Global& glb) {
             mk<LoopTransformer>(mk<TransformerSequence>(mk<ExpandFilterTransformer>(),
                     mk<HoistConditionsTransformer>(), mk<MakeIndexTransformer>())),
             mk<IfConversionTransformer>(), mk<IfExistsConversionTransformer>(),
+            mk<ConditionalTransformer>(
+                    [&]() -> bool { return glb.config().has("layout-advisor"); },
+                    mk<ReplaceRareSearchesTransformer>()),
             mk<CollapseFiltersTransformer>(), mk<TupleIdTransformer>(),
             mk<LoopTransformer>(
                     mk<TransformerSequence>(mk<HoistAggregateTransformer>(), mk<TupleIdTransformer>())),
             mk<ExpandFilterTransformer>(), mk<HoistConditionsTransformer>(),
             mk<CollapseFiltersTransformer>(), mk<EliminateDuplicatesTransformer>(),
             mk<ReorderConditionsTransformer>(), mk<LoopTransformer>(mk<ReorderFilterBreak>()),
+            mk<TrieJoinTransformer>(),
             mk<ConditionalTransformer>(
                     // job count of 0 means all cores are used.
                     [&]() -> bool { return std::stoi(glb.config().get("jobs")) != 1; },
                     mk<ParallelTransformer>()),
+            mk<SelectHashsetTransformer>(glb.config().has("select-hashsets")),
             mk<ReportIndexTransformer>());
     // clang-format on
 
@@ -588,6 +631,10 @@ bool interpretTranslationUnit(Global& glb, ram::TranslationUnit& ramTranslationU
             }
 #endif
         }
+        if (glb.config().has("query-server")) {
+            interpreter::ProgInterface interface(*interpreter);
+            serveQueries(interface, glb.config().get("query-server"));
+        }
         return true;
     } catch (std::exception& e) {
         std::cerr << e.what() << std::endl;
@@ -595,6 +642,102 @@ bool interpretTranslationUnit(Global& glb, ram::TranslationUnit& ramTranslationU
     }
 }
 
+/** Create a fresh directory, accessible to the current user only, for the sources of a hybrid build */
+fs::path createHybridDirectory(const std::string& baseIdentifier) {
+#ifdef _MSC_VER
+    throw std::runtime_error("hybrid execution is not supported on Windows");
+#else
+    std::string directory = (fs::temp_directory_path() / (baseIdentifier + "_hybrid_XXXXXX")).string();
+    if (mkdtemp(directory.data()) == nullptr) {
+        throw std::runtime_error("cannot create a directory for the hybrid build");
+    }
+    return directory;
+#endif
+}
+
+/**
+ * Interprets the translation unit while a compiled version of it is built in the background.
+ * Once the shared library is ready, the remaining strata run compiled.
+ */
+bool hybridTranslationUnit(
+        Global& glb, ram::TranslationUnit& ramTranslationUnit, const std::string& souffleExecutable) {
+    const bool verbose = glb.config().has("verbose");
+    const ram::Program& program = ramTranslationUnit.getProgram();
+    const auto souffle_compile = findTool("souffle-compile.py", souffleExecutable, ".");
+    if (!souffle_compile || !interpreter::CompiledStrata::isSupported(program)) {
+        if (verbose) {
+            std::cout << "Hybrid execution is not available for this program, interpreting only\n";
+        }
+        return interpretTranslationUnit(glb, ramTranslationUnit);
+    }
+
+    try {
+        // synthesise the program as a shared library in the background
+        const std::string baseIdentifier = identifier(simpleName(glb.config().get("")));
+        bool withSharedLibrary;
+        synthesiser::GenDb db;
+        mk<synthesiser::Synthesiser>(ramTranslationUnit)->generateCode(db, baseIdentifier, withSharedLibrary);
+
+        std::vector<fs::path> srcFiles;
+        const fs::path directory = createHybridDirectory(baseIdentifier);
+        const std::string mainClass = db.emitMultipleFilesInDir(directory, srcFiles);
+#ifdef __APPLE__
+        const fs::path library = directory / ("lib" + mainClass + ".dylib");
+#else
+        const fs::path library = directory / ("lib" + mainClass + ".so");
+#endif
+
+        // settle the functor libraries before the engine and the build read them
+        if (!glb.config().has("libraries")) {
+            glb.config().set("libraries", withSharedLibrary ? "functors" : "");
+        }
+        if (!glb.config().has("library-dir")) {
+            glb.config().set("library-dir", ".");
+        }
+
+        const std::size_t numThreadsOrZero = std::stoi(glb.config().get("jobs"));
+        Own<interpreter::Engine> interpreter(mk<interpreter::Engine>(ramTranslationUnit, numThreadsOrZero));
+        auto compiled = std::make_shared<interpreter::CompiledStrata>(
+                *interpreter, program, library.string(), "__new_" + mainClass);
+
+        // the build owns copies of everything it reads, so that it may outlive this function
+        auto build = [config = glb.config(), compiled, command = *souffle_compile, srcFiles, library,
+                             verbose]() mutable {
+            bool success = false;
+            try {
+                compileToBinary(config, command, srcFiles, library, true);
+                success = true;
+            } catch (std::exception& e) {
+                if (verbose) {
+                    std::cerr << e.what() << std::endl;
+                }
+            }
+            compiled->setBuilt(success);
+        };
+        std::thread builder(build);
+
+        bool success = true;
+        try {
+            interpreter->setStratumHandoff(
+                    [compiled](const std::string& stratum) { return (*compiled)(stratum); });
+            interpreter->executeMain();
+        } catch (std::exception& e) {
+            std::cerr << e.what() << std::endl;
+            success = false;
+        }
+
+        // A build still running is abandoned: removing its directory makes it fail on its own, and the
+        // library of a finished one stays mapped after its file is removed.
+        builder.detach();
+        std::error_code error;
+        fs::remove_all(directory, error);
+        return success;
+    } catch (std::exception& e) {
+        std::cerr << e.what() << std::endl;
+        return false;
+    }
+}
+
 const char* packageVersion() {
     return PACKAGE_VERSION;
 }
@@ -652,6 +795,9 @@ std::vector<MainOption> getMainOptions() {
       {"compile", 'c', "", "", false,
           "Generate C++ source code, compile to a binary executable, then run this "
           "executable."},
+      {"compile-cache", nextOptChar++, "DIR", "", false,
+          "Cache object files and a precompiled header in <DIR>, so that unchanged "
+          "generated C++ sources are not recompiled."},
       {"compile-many", 'C', "", "", false,
           "Generate C++ source code in multiple files, compile to a binary executable, then "
           "run this "
@@ -678,6 +824,9 @@ std::vector<MainOption> getMainOptions() {
        "namespace."},
       {"help", 'h', "", "", false,
           "Display this help message."},
+      {"hybrid", nextOptChar++, "", "", false,
+          "Start evaluating in the interpreter while the program is compiled in the background, "
+          "then run the remaining strata compiled once the compiler has finished."},
       {"include-dir", 'I', "DIR", ".", true,
           "Specify directory for include files."},
       {"inline-exclude", nextOptChar++, "RELATIONS", "", false,
@@ -685,6 +834,9 @@ std::vector<MainOption> getMainOptions() {
       {"jobs", 'j', "N", "1", false,
           "Run interpreter/compiler in parallel using N threads, N=auto for system "
           "default."},
+      {"layout-advisor", nextOptChar++, "FILE", "", false,
+          "Use the index statistics of the profile <FILE>, recorded with `profile-frequency`, to "
+          "replace rarely used indexes by filtered scans."},
       {"legacy", nextOptChar++, "", "", false,
           "Enable legacy support."},
       {"libraries", 'l', "FILE", "", true,
@@ -701,10 +853,19 @@ std::vector<MainOption> getMainOptions() {
       {"magic-transform-exclude", nextOptChar++, "RELATIONS", "", false,
           "Disable magic set transformation changes on the given relations. Overrides "
           "`magic-transform`. Implies `inline-exclude` for the given relations."},
+      {"memory-budget", nextOptChar++, "SIZE", "", false,
+          "Spill relations that are not needed in the next stratum to disk while the "
+          "resident size exceeds SIZE bytes. SIZE may carry a K, M, G or T suffix."},
+      {"no-narrow-storage", nextOptChar++, "", "", false,
+          "Store the identifiers of symbols, records and ADTs in b-tree relations at the full "
+          "width of the domain."},
       {"no-preprocessor", nextOptChar++, "", "", false,
           "Do not use a C preprocessor."},
       {"no-warn", 'w', "", "", false,
           "Disable warnings."},
+      {"numa", nextOptChar++, "", "", false,
+          "Pin worker threads to the NUMA nodes of the machine and hand each thread a contiguous "
+          "block of the partitions of parallel scans."},
       {"output-dir", 'D', "DIR", ".", false,
           "Specify directory for output files. If <DIR> is `-` then stdout is used."},
       {"parse-errors", nextOptChar++, "", "", false,
@@ -719,11 +880,19 @@ std::vector<MainOption> getMainOptions() {
           "Enable the frequency counter in the profiler."},
       {"provenance", 't', "[ none | explain | explore ]", "", false,
           "Enable provenance instrumentation and interaction."},
+      {"query-server", nextOptChar++, "SOCKET", "", false,
+          "Keep all relations after the evaluation and answer queries over them, read from the "
+          "Unix domain socket SOCKET or, if SOCKET is `-`, from stdin. Disables the "
+          "transformations inlining, merging or removing relations."},
+      {"select-hashsets", nextOptChar++, "", "", false,
+          "Store relations that are only searched by full tuples in hash sets, besides those "
+          "tagged with the hashset representation."},
       {"show", nextOptChar++, "[ <see-list> ]", "", true,
           "Print selected program information.\n"
           "Modes:\n"
               "\tinitial-ast\n"
               "\tinitial-ram\n"
+              "\tlayout-advice\n"
               "\tparse-errors\n"
               "\tprecedence-graph\n"
               "\tprecedence-graph-text\n"
@@ -735,6 +904,9 @@ std::vector<MainOption> getMainOptions() {
       {"swig", 's', "LANG", "", false,
           "Generate SWIG interface for given language. The values <LANG> accepts is java and "
           "python. "},
+      {"vectorize", nextOptChar++, "", "", false,
+          "Interpret scans whose rules only filter and insert in batches of tuples, evaluating "
+          "constraints one column at a time."},
       {"verbose", 'v', "", "", false,
           "Verbose output."},
       {"version", nextOptChar++, "", "", false,
@@ -817,6 +989,34 @@ int main(Global& glb, const char* souffle_executable) {
             glb.config().set("jobs", "1");
 #endif
         }
+#ifdef _OPENMP
+        // the frontend processes clauses in parallel with the same number of threads
+        if (glb.config().get("jobs") != "0") {
+            omp_set_num_threads(std::stoi(glb.config().get("jobs")));
+        }
+#endif
+
+        /* normalise the memory budget to bytes */
+        if (glb.config().has("memory-budget")) {
+            const std::string& budget = glb.config().get("memory-budget");
+            const std::size_t unit = std::string("KMGT").find(budget.empty() ? ' ' : budget.back());
+            const std::string digits = budget.substr(0, budget.size() - (unit == std::string::npos ? 0 : 1));
+            if (digits.empty() || !std::all_of(digits.begin(), digits.end(), ::isdigit)) {
+                throw std::runtime_error(
+                        "--memory-budget expects a size in bytes, optionally with a K, M, G or T suffix.");
+            }
+            const int shift = unit == std::string::npos ? 0 : 10 * static_cast<int>(unit + 1);
+            const unsigned long long limit = std::numeric_limits<unsigned long long>::max() >> shift;
+            unsigned long long bytes = 0;
+            for (const char digit : digits) {
+                if (bytes > (limit - (digit - '0')) / 10) {
+                    throw std::runtime_error("--memory-budget exceeds the addressable memory.");
+                }
+                bytes = bytes * 10 + (digit - '0');
+            }
+            bytes <<= shift;
+            glb.config().set("memory-budget", std::to_string(bytes));
+        }
 
         /* if an output directory is given, check it exists */
         if (glb.config().has("output-dir") && !glb.config().has("output-dir", "-") &&
@@ -853,6 +1053,16 @@ int main(Global& glb, const char* souffle_executable) {
             glb.config().set("profile");
         }
 
+        /* hybrid execution hands relations over through the embedding interface */
+        if (glb.config().has("hybrid")) {
+#ifdef _MSC_VER
+            throw std::runtime_error("hybrid execution is not supported on Windows");
+#endif
+            if (glb.config().has("provenance") || glb.config().has("profile")) {
+                throw std::runtime_error("hybrid execution cannot be combined with provenance or profiling");
+            }
+        }
+
         /* if emit-statistics is set then check that the profiler is also set */
         if (glb.config().has("emit-statistics")) {
             if (!glb.config().has("profile"))
@@ -1034,7 +1244,7 @@ int main(Global& glb, const char* souffle_executable) {
     }
 
     // bail if we've nothing else left to show
-    if (glb.config().has("show") && !hasShowOpt("initial-ram", "transformed-ram")) return 0;
+    if (glb.config().has("show") && !hasShowOpt("initial-ram", "transformed-ram", "layout-advice")) return 0;
 
     // ------- execution -------------
     /* translate AST to RAM */
@@ -1046,7 +1256,7 @@ int main(Global& glb, const char* souffle_executable) {
     if (hasShowOpt("initial-ram")) {
         std::cout << ramTranslationUnit->getProgram();
         // bail if we've nothing else left to show
-        if (!hasShowOpt("transformed-ram")) return 0;
+        if (!hasShowOpt("transformed-ram", "layout-advice")) return 0;
     }
 
     // Apply RAM transforms
@@ -1059,6 +1269,13 @@ int main(Global& glb, const char* souffle_executable) {
         std::cerr << ramTranslationUnit->getErrorReport();
     }
 
+    // Output the advice on the indexes and representations of the relations
+    if (hasShowOpt("layout-advice")) {
+        ramTranslationUnit->getAnalysis<ram::analysis::LayoutAdvisorAnalysis>().printAdvice(
+                std::cout, *ramTranslationUnit);
+        if (!hasShowOpt("transformed-ram")) return 0;
+    }
+
     // Output the transformed RAM program and return
     if (hasShowOpt("transformed-ram")) {
         std::cout << ramTranslationUnit->getProgram();
@@ -1078,7 +1295,9 @@ int main(Global& glb, const char* souffle_executable) {
     try {
         if (must_interpret) {
             // ------- interpreter -------------
-            const bool success = interpretTranslationUnit(glb, *ramTranslationUnit);
+            const bool success = glb.config().has("hybrid")
+                                         ? hybridTranslationUnit(glb, *ramTranslationUnit, souffleExecutable)
+                                         : interpretTranslationUnit(glb, *ramTranslationUnit);
             if (!success) {
                 std::exit(EXIT_FAILURE);
             }
@@ -1158,7 +1377,7 @@ int main(Global& glb, const char* souffle_executable) {
 
                 auto t_bgn = std::chrono::high_resolution_clock::now();
                 fs::path output(binaryFilename);
-                compileToBinary(glb, *souffle_compile, srcFiles, output);
+                compileToBinary(glb.config(), *souffle_compile, srcFiles, output);
                 auto t_end = std::chrono::high_resolution_clock::now();
 
                 if (glb.config().has("verbose")) {
@@ -23,19 +23,21 @@ namespace souffle {
 
 /** Space of user-chosen tags that a relation can have */
 enum class RelationTag {
-    INPUT,         // relation read from csv
-    OUTPUT,        // relation written to csv
-    PRINTSIZE,     // number of tuples written to stdout
-    OVERRIDABLE,   // rules defined in component can be overwritten by sub-component
-    INLINE,        // inlined
-    NO_INLINE,     // never inline
-    MAGIC,         // enable magic-set on this relation
-    NO_MAGIC,      // never magic-set on this relation
-    SUPPRESSED,    // warnings suppressed
-    BRIE,          // use brie data-structure
-    BTREE,         // use btree data-structure
-    BTREE_DELETE,  // use btree_delete data-structure
-    EQREL,         // use union data-structure
+    INPUT,             // relation read from csv
+    OUTPUT,            // relation written to csv
+    PRINTSIZE,         // number of tuples written to stdout
+    OVERRIDABLE,       // rules defined in component can be overwritten by sub-component
+    INLINE,            // inlined
+    NO_INLINE,         // never inline
+    MAGIC,             // enable magic-set on this relation
+    NO_MAGIC,          // never magic-set on this relation
+    SUPPRESSED,        // warnings suppressed
+    BRIE,              // use brie data-structure
+    BTREE,             // use btree data-structure
+    BTREE_DELETE,      // use btree_delete data-structure
+    BTREE_COMPRESSED,  // use btree with compressed leaves
+    EQREL,             // use union data-structure
+    HASHSET,           // use hash-set data-structure
 };
 
 /** Space of qualifiers that a relation can have */
@@ -53,12 +55,14 @@ enum class RelationQualifier {
 
 /** Space of internal representations that a relation can have */
 enum class RelationRepresentation {
-    DEFAULT,       // use default data-structure
-    BRIE,          // use brie data-structure
-    BTREE,         // use btree data-structure
-    BTREE_DELETE,  // use btree_delete data-structure
-    EQREL,         // use union data-structure
-    INFO,          // info relation for provenance
+    DEFAULT,           // use default data-structure
+    BRIE,              // use brie data-structure
+    BTREE,             // use btree data-structure
+    BTREE_DELETE,      // use btree_delete data-structure
+    BTREE_COMPRESSED,  // use btree with compressed leaves
+    EQREL,             // use union data-structure
+    HASHSET,           // use hash-set data-structure
+    INFO,              // info relation for provenance
 };
 
 /**
@@ -69,7 +73,9 @@ inline bool isRelationRepresentationTag(const RelationTag& tag) {
         case RelationTag::BRIE:
         case RelationTag::BTREE:
         case RelationTag::BTREE_DELETE:
-        case RelationTag::EQREL: return true;
+        case RelationTag::BTREE_COMPRESSED:
+        case RelationTag::EQREL:
+        case RelationTag::HASHSET: return true;
         default: return false;
     }
 }
@@ -118,7 +124,9 @@ inline RelationRepresentation getRelationRepresentationFromTag(const RelationTag
         case RelationTag::BRIE: return RelationRepresentation::BRIE;
         case RelationTag::BTREE: return RelationRepresentation::BTREE;
         case RelationTag::BTREE_DELETE: return RelationRepresentation::BTREE_DELETE;
+        case RelationTag::BTREE_COMPRESSED: return RelationRepresentation::BTREE_COMPRESSED;
         case RelationTag::EQREL: return RelationRepresentation::EQREL;
+        case RelationTag::HASHSET: return RelationRepresentation::HASHSET;
         default: fatal("invalid relation tag");
     }
 
@@ -139,7 +147,9 @@ inline std::ostream& operator<<(std::ostream& os, RelationTag qualifier) {
         case RelationTag::BRIE: return os << "brie";
         case RelationTag::BTREE: return os << "btree";
         case RelationTag::BTREE_DELETE: return os << "btree_delete";
+        case RelationTag::BTREE_COMPRESSED: return os << "btree_compressed";
         case RelationTag::EQREL: return os << "eqrel";
+        case RelationTag::HASHSET: return os << "hashset";
     }
 
     UNREACHABLE_BAD_CASE_ANALYSIS
@@ -165,8 +175,10 @@ inline std::ostream& operator<<(std::ostream& os, RelationRepresentation represe
     switch (representation) {
         case RelationRepresentation::BTREE: return os << "btree";
         case RelationRepresentation::BTREE_DELETE: return os << "btree_delete";
+        case RelationRepresentation::BTREE_COMPRESSED: return os << "btree_compressed";
         case RelationRepresentation::BRIE: return os << "brie";
         case RelationRepresentation::EQREL: return os << "eqrel";
+        case RelationRepresentation::HASHSET: return os << "hashset";
         case RelationRepresentation::INFO: return os << "info";
         case RelationRepresentation::DEFAULT: return os;
     }
@@ -19,17 +19,23 @@
 #include "Global.h"
 #include "reports/DebugReport.h"
 #include "reports/ErrorReport.h"
+#include "souffle/utility/ContainerUtil.h"
 #include "souffle/utility/DynamicCasting.h"
 #include "souffle/utility/Types.h"
 #include <cassert>
+#include <chrono>
 #include <cstring>
+#include <iostream>
 #include <map>
 #include <memory>
+#include <mutex>
 #include <ostream>
 #include <set>
 #include <string>
+#include <thread>
 #include <type_traits>
 #include <utility>
+#include <vector>
 
 namespace souffle::detail {
 
@@ -84,29 +90,75 @@ struct TranslationUnitBase {
         assert(program != nullptr && "program is a null-pointer");
     }
 
-    /** get analysis: analysis is generated on the fly if not present */
+    /**
+     * get analysis: analysis is generated on the fly if not present
+     *
+     * Cached analyses may be requested concurrently, e.g. by passes processing clauses in
+     * parallel. An analysis is computed once; concurrent requests wait for its result.
+     */
     template <class A, typename = std::enable_if_t<std::is_base_of_v<AnalysisBase, A>>>
     A& getAnalysis() const {
         static_assert(std::is_same_v<char const* const, decltype(A::name)>,
                 "`name` member must be a static literal");
-        auto it = analyses.find(A::name);
-        if (it == analyses.end()) {
-            it = analyses.insert({A::name, mk<A>()}).first;
+        const std::thread::id thread = std::this_thread::get_id();
+        CachedAnalysis* cached = nullptr;
+        {
+            std::lock_guard<std::mutex> guard(analysesLock);
+            auto& entry = analyses[A::name];
+            if (entry == nullptr) {
+                entry = mk<CachedAnalysis>();
+            }
+            cached = entry.get();
 
-            auto& analysis = *it->second;
+            // an analysis requested while another one runs on this thread may be referenced by the latter
+            auto stack = running.find(thread);
+            if (stack != running.end()) {
+                if (contains(stack->second, A::name)) {
+                    // requested by itself while running
+                    return asAssert<A>(cached->analysis.get());
+                }
+                dependencies[stack->second.back()].insert(A::name);
+            }
+        }
+
+        std::call_once(cached->computed, [&]() {
+            {
+                std::lock_guard<std::mutex> guard(analysesLock);
+                cached->analysis = mk<A>();
+                running[thread].push_back(A::name);
+            }
+            Analysis& analysis = *cached->analysis;
             assert((std::strcmp(analysis.getName(), A::name) == 0) && "must be same pointer");
+            auto start = std::chrono::high_resolution_clock::now();
             analysis.run(static_cast<Impl const&>(*this));
+            auto end = std::chrono::high_resolution_clock::now();
+            {
+                std::lock_guard<std::mutex> guard(analysesLock);
+                auto stack = running.find(thread);
+                stack->second.pop_back();
+                if (stack->second.empty()) {
+                    running.erase(stack);
+                }
+            }
+            if (glb.config().has("verbose")) {
+                std::cout << A::name << " analysis time: "
+                          << std::to_string(std::chrono::duration<double>(end - start).count()) << "s"
+                          << std::endl;
+            }
             logAnalysis(analysis);
-        }
+        });
 
-        return asAssert<A>(it->second.get());
+        return asAssert<A>(cached->analysis.get());
     }
 
     /** @brief Get all alive analyses */
     std::set<const AnalysisBase*> getAliveAnalyses() const {
+        std::lock_guard<std::mutex> guard(analysesLock);
         std::set<const AnalysisBase*> result;
         for (auto const& a : analyses) {
-            result.insert(a.second.get());
+            if (a.second->analysis != nullptr) {
+                result.insert(a.second->analysis.get());
+            }
         }
         return result;
     }
@@ -114,6 +166,41 @@ struct TranslationUnitBase {
     /** @brief Invalidate all alive analyses of the translation unit */
     void invalidateAnalyses() {
         analyses.clear();
+        dependencies.clear();
+    }
+
+    /**
+     * @brief Invalidate all alive analyses except the given ones
+     *
+     * A preserved analysis is invalidated nevertheless if it used an invalidated analysis
+     * while running, since it may refer to its results.
+     */
+    void invalidateAnalyses(const std::set<std::string>& preserved) {
+        std::set<std::string> invalid;
+        for (const auto& [name, analysis] : analyses) {
+            if (preserved.count(name) == 0) {
+                invalid.insert(name);
+            }
+        }
+        for (bool changed = true; changed;) {
+            changed = false;
+            for (const auto& [name, used] : dependencies) {
+                if (invalid.count(name) != 0) {
+                    continue;
+                }
+                for (const std::string& dependency : used) {
+                    if (invalid.count(dependency) != 0) {
+                        invalid.insert(name);
+                        changed = true;
+                        break;
+                    }
+                }
+            }
+        }
+        for (const std::string& name : invalid) {
+            analyses.erase(name);
+            dependencies.erase(name);
+        }
     }
 
     /** @brief Get the global configuration */
@@ -137,13 +224,28 @@ struct TranslationUnitBase {
     }
 
 protected:
+    /* An analysis computed at most once, whichever thread requests it first */
+    struct CachedAnalysis {
+        std::once_flag computed;
+        Own<Analysis> analysis;
+    };
+
     virtual void logAnalysis(Analysis&) const {}
 
     /* Cached analyses */
     // HACK: (GCC bug?) using `char const*` and GCC 9.2.0 w/ -O1+ and asan => program corruption
     //       Clang is happy. GCC 9.2.0 -O1+ w/o asan is happy. Go figure.
     //       Using `std::string` appears to suppress the issue (bug?).
-    mutable std::map<std::string, Own<Analysis>> analyses;
+    mutable std::map<std::string, Own<CachedAnalysis>> analyses;
+
+    /* Analyses requested by each cached analysis while it was running */
+    mutable std::map<std::string, std::set<std::string>> dependencies;
+
+    /* Analyses currently running on each thread, innermost last */
+    mutable std::map<std::thread::id, std::vector<std::string>> running;
+
+    /* Guards the cached analyses and the bookkeeping of their dependencies */
+    mutable std::mutex analysesLock;
 
     Global& glb;
 
@@ -14,7 +14,9 @@
 #include <cassert>
 #include <deque>
 #include <map>
+#include <mutex>
 #include <ostream>
+#include <shared_mutex>
 #include <sstream>
 #include <unordered_map>
 #include <utility>
@@ -23,6 +25,9 @@ namespace souffle::ast {
 
 /// Container of qualified names, provides interning by associating a unique
 /// numerical index to each qualified name.
+///
+/// The interner may be used concurrently, e.g. by frontend passes processing
+/// clauses in parallel.
 struct QNInterner {
 public:
     explicit QNInterner() {
@@ -34,6 +39,15 @@ public:
     ///
     /// Each `.` character is treated as a separator.
     QualifiedName intern(std::string_view qn) {
+        {
+            std::shared_lock<std::shared_mutex> guard(lock);
+            const auto It = qualifiedNameToIndex.find(qn);
+            if (It != qualifiedNameToIndex.end()) {
+                return QualifiedName{It->second};
+            }
+        }
+
+        std::unique_lock<std::shared_mutex> guard(lock);
         const auto It = qualifiedNameToIndex.find(qn);
         if (It != qualifiedNameToIndex.end()) {
             return QualifiedName{It->second};
@@ -50,10 +64,15 @@ public:
 
     /// Return the qualified name data object from the given index.
     const QualifiedNameData& at(uint32_t index) {
+        // elements of a deque stay in place when it grows
+        std::shared_lock<std::shared_mutex> guard(lock);
         return qualifiedNames.at(index);
     }
 
 private:
+    /// Guards both containers.
+    std::shared_mutex lock;
+
     /// Store the qualified name data of interned qualified names.
     std::deque<QualifiedNameData> qualifiedNames;
 
@@ -88,6 +88,16 @@ public:
         }
     }
 
+    /** Add the findings of an analyzer of other clauses */
+    void merge(const ErrorAnalyzer& other) {
+        for (const auto& [arg, unsatCore] : other.unsatCores) {
+            unsatCores[arg].insert(unsatCore.begin(), unsatCore.end());
+        }
+        constraintLocations.insert(other.constraintLocations.begin(), other.constraintLocations.end());
+        equivalentArguments.insert(other.equivalentArguments.begin(), other.equivalentArguments.end());
+        explainedArguments.insert(other.explainedArguments.begin(), other.explainedArguments.end());
+    }
+
     bool argumentIsExplained(const Argument* argument) {
         return explainedArguments.find(argument) != explainedArguments.end();
     }
@@ -27,6 +27,7 @@
 #include <algorithm>
 #include <cstddef>
 #include <iterator>
+#include <map>
 #include <memory>
 #include <set>
 
@@ -41,6 +42,14 @@ void RelationScheduleAnalysisStep::print(std::ostream& os) const {
     for (const Relation* compRel : expired()) {
         os << compRel->getQualifiedName() << ", ";
     }
+    os << "\ncold: ";
+    for (const Relation* coldRel : cold()) {
+        os << coldRel->getQualifiedName() << ", ";
+    }
+    os << "\nresumed: ";
+    for (const Relation* resumedRel : resumed()) {
+        os << resumedRel->getQualifiedName() << ", ";
+    }
     os << "\n";
     if (recursive()) {
         os << "recursive";
@@ -57,13 +66,16 @@ void RelationScheduleAnalysis::run(const TranslationUnit& translationUnit) {
 
     const std::size_t numSCCs = sccGraph->getNumberOfSCCs();
     std::vector<RelationSet> relationExpirySchedule = computeRelationExpirySchedule();
+    std::vector<RelationSet> coldRelations(numSCCs);
+    std::vector<RelationSet> resumedRelations(numSCCs);
+    computeColdRelations(coldRelations, resumedRelations);
 
     relationSchedule.clear();
     for (std::size_t i = 0; i < numSCCs; i++) {
         const auto scc = topsortSCCGraphAnalysis->order()[i];
         const RelationSet computedRelations = sccGraph->getInternalRelations(scc);
-        relationSchedule.emplace_back(
-                computedRelations, relationExpirySchedule[i], sccGraph->isRecursive(scc));
+        relationSchedule.emplace_back(computedRelations, relationExpirySchedule[i], coldRelations[i],
+                resumedRelations[i], sccGraph->isRecursive(scc));
     }
 
     topsortSCCGraphAnalysis = nullptr;
@@ -107,6 +119,33 @@ std::vector<RelationSet> RelationScheduleAnalysis::computeRelationExpirySchedule
     return relationExpirySchedule;
 }
 
+void RelationScheduleAnalysis::computeColdRelations(
+        std::vector<RelationSet>& cold, std::vector<RelationSet>& resumed) {
+    const std::size_t numSCCs = topsortSCCGraphAnalysis->order().size();
+
+    /* Steps in which a relation is computed or used, in increasing order */
+    std::map<const Relation*, std::set<std::size_t>, NameComparison> touched;
+    for (std::size_t step = 0; step < numSCCs; step++) {
+        const auto scc = topsortSCCGraphAnalysis->order()[step];
+        for (const Relation* r : sccGraph->getInternalRelations(scc)) {
+            touched[r].insert(step);
+            for (const Relation* predecessor : precedenceGraph->graph().predecessors(r)) {
+                touched[predecessor].insert(step);
+            }
+        }
+    }
+
+    /* A relation is cold between two steps touching it that are not adjacent */
+    for (const auto& [relation, steps] : touched) {
+        for (auto cur = steps.begin(), next = std::next(cur); next != steps.end(); cur = next++) {
+            if (*next > *cur + 1) {
+                cold[*cur].insert(relation);
+                resumed[*next].insert(relation);
+            }
+        }
+    }
+}
+
 void RelationScheduleAnalysis::print(std::ostream& os) const {
     os << "begin schedule\n";
     for (const RelationScheduleAnalysisStep& step : relationSchedule) {
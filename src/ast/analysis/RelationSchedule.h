@@ -35,12 +35,17 @@ namespace souffle::ast::analysis {
 /**
  * A single step in a relation schedule, consisting of the relations computed in the step
  * and the relations that are no longer required at that step.
+ *
+ * A step also lists the cold relations: relations that are required again only after
+ * at least one further step. They may be spilled after this step and have to be
+ * restored before the step that uses them next.
  */
 class RelationScheduleAnalysisStep {
 public:
-    RelationScheduleAnalysisStep(
-            RelationSet computedRelations, RelationSet expiredRelations, const bool isRecursive)
+    RelationScheduleAnalysisStep(RelationSet computedRelations, RelationSet expiredRelations,
+            RelationSet coldRelations, RelationSet resumedRelations, const bool isRecursive)
             : computedRelations(std::move(computedRelations)), expiredRelations(std::move(expiredRelations)),
+              coldRelations(std::move(coldRelations)), resumedRelations(std::move(resumedRelations)),
               isRecursive(isRecursive) {}
 
     const RelationSet& computed() const {
@@ -51,6 +56,16 @@ public:
         return expiredRelations;
     }
 
+    /** Relations that are not used in the next step but later on */
+    const RelationSet& cold() const {
+        return coldRelations;
+    }
+
+    /** Relations that were cold before this step and are used in this step */
+    const RelationSet& resumed() const {
+        return resumedRelations;
+    }
+
     bool recursive() const {
         return isRecursive;
     }
@@ -66,6 +81,8 @@ public:
 private:
     RelationSet computedRelations;
     RelationSet expiredRelations;
+    RelationSet coldRelations;
+    RelationSet resumedRelations;
     const bool isRecursive;
 };
 
@@ -96,6 +113,9 @@ private:
     std::vector<RelationScheduleAnalysisStep> relationSchedule;
 
     std::vector<RelationSet> computeRelationExpirySchedule();
+
+    /** Compute the cold and resumed relations of each step */
+    void computeColdRelations(std::vector<RelationSet>& cold, std::vector<RelationSet>& resumed);
 };
 
 }  // namespace souffle::ast::analysis
@@ -48,6 +48,7 @@
 #include "souffle/utility/ContainerUtil.h"
 #include "souffle/utility/FunctionalUtil.h"
 #include "souffle/utility/MiscUtil.h"
+#include "souffle/utility/ParallelUtil.h"
 #include "souffle/utility/StringUtil.h"
 #include <algorithm>
 #include <cassert>
@@ -58,6 +59,7 @@
 #include <optional>
 #include <set>
 #include <sstream>
+#include <vector>
 #include <string>
 #include <utility>
 
@@ -519,9 +521,12 @@ void TypeAnalysis::run(const TranslationUnit& translationUnit) {
 
     typeEnv = &translationUnit.getAnalysis<TypeEnvironmentAnalysis>().getTypeEnvironment();
     functorAnalysis = &translationUnit.getAnalysis<FunctorAnalysis>();
+    // requested by the analysis of each clause, so it must be present before clauses are analysed in parallel
+    translationUnit.getAnalysis<SumTypeBranchesAnalysis>();
 
     // Analyse user-defined functor types
     const Program& program = translationUnit.getProgram();
+    const std::vector<Clause*> clauses = program.getClauses();
 
     // Rest of the analysis done until fixpoint reached
     bool changed = true;
@@ -529,15 +534,26 @@ void TypeAnalysis::run(const TranslationUnit& translationUnit) {
         changed = false;
         argumentTypes.clear();
 
-        // Analyse general argument types, clause by clause.
-        for (const Clause* clause : program.getClauses()) {
-            auto clauseArgumentTypes =
-                    analyseTypes(translationUnit, *clause, errorAnalyzer.get(), debugStream);
-            argumentTypes.insert(clauseArgumentTypes.begin(), clauseArgumentTypes.end());
+        // Analyse general argument types, clause by clause. Clauses are independent, so they are
+        // analysed in parallel and their results are combined in the order of the clauses.
+        std::vector<std::map<const Argument*, TypeSet>> clauseArgumentTypes(clauses.size());
+        std::vector<TypeErrorAnalyzer> clauseErrors(clauses.size());
+        std::vector<std::stringstream> clauseLogs(debugStream != nullptr ? clauses.size() : 0);
+        PARALLEL_START
+        pfor(std::size_t i = 0; i < clauses.size(); ++i) {
+            clauseArgumentTypes[i] = analyseTypes(translationUnit, *clauses[i], &clauseErrors[i],
+                    debugStream != nullptr ? &clauseLogs[i] : nullptr);
+        }
+        PARALLEL_END
+
+        for (std::size_t i = 0; i < clauses.size(); ++i) {
+            argumentTypes.insert(clauseArgumentTypes[i].begin(), clauseArgumentTypes[i].end());
+            errorAnalyzer->merge(clauseErrors[i]);
 
             if (debugStream != nullptr) {
+                *debugStream << clauseLogs[i].str();
                 // Store an annotated clause for printing purposes
-                annotatedClauses.emplace_back(createAnnotatedClause(clause, clauseArgumentTypes));
+                annotatedClauses.emplace_back(createAnnotatedClause(clauses[i], clauseArgumentTypes[i]));
             }
         }
 
@@ -23,6 +23,9 @@
 #include "ast/Relation.h"
 #include "ast/TranslationUnit.h"
 #include "ast/analysis/ClauseNormalisation.h"
+#include "ast/analysis/PrecedenceGraph.h"
+#include "ast/analysis/SCCGraph.h"
+#include "ast/analysis/typesystem/TypeEnvironment.h"
 #include "ast/transform/MagicSet.h"
 #include "ast/transform/MinimiseProgram.h"
 #include "ast/transform/RemoveRedundantRelations.h"
@@ -797,4 +800,38 @@ TEST(Transformers, MagicSetComprehensive) {
     });
     checkRelMapEq(finalProgram, mappifyRelations(program));
 }
+
+TEST(Transformers, PreservedAnalyses) {
+    Global glb;
+    ErrorReport errorReport;
+    DebugReport debugReport(glb);
+    Own<TranslationUnit> tu = ParserDriver::parseTranslationUnit(glb,
+            R"(
+                .type N <: number
+                .decl a(x:N)
+                .decl b(x:N)
+                a(x) :- b(y), x = y.
+            )",
+            errorReport, debugReport);
+
+    auto isAlive = [&](const analysis::Analysis* analysis) {
+        return tu->getAliveAnalyses().count(analysis) != 0;
+    };
+    const auto* typeEnv = &tu->getAnalysis<TypeEnvironmentAnalysis>();
+    const auto* precedenceGraph = &tu->getAnalysis<PrecedenceGraphAnalysis>();
+    EXPECT_TRUE(isAlive(typeEnv));
+    EXPECT_TRUE(isAlive(precedenceGraph));
+
+    // resolving the alias changes clauses only, so the declarations stay analysed
+    EXPECT_TRUE(ResolveAliasesTransformer().apply(*tu));
+    EXPECT_TRUE(isAlive(typeEnv));
+    EXPECT_FALSE(isAlive(precedenceGraph));
+
+    // the SCC graph refers to the precedence graph and cannot outlive it
+    const auto* sccGraph = &tu->getAnalysis<SCCGraphAnalysis>();
+    tu->invalidateAnalyses({SCCGraphAnalysis::name, TypeEnvironmentAnalysis::name});
+    EXPECT_FALSE(isAlive(sccGraph));
+    EXPECT_TRUE(isAlive(typeEnv));
+}
+
 }  // namespace souffle::ast::transform::test
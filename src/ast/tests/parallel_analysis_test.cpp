@@ -0,0 +1,131 @@
+/*
+ * Souffle - A Datalog Compiler
+ * Copyright (c) 2026, The Souffle Developers. All rights reserved
+ * Licensed under the Universal Permissive License v 1.0 as shown at:
+ * - https://opensource.org/licenses/UPL
+ * - <souffle root>/licenses/SOUFFLE-UPL.txt
+ */
+
+/************************************************************************
+ *
+ * @file parallel_analysis_test.cpp
+ *
+ * Tests that the analyses and checks of clauses running in parallel
+ * report the same results as running sequentially.
+ *
+ ***********************************************************************/
+
+#include "tests/test.h"
+
+#include "Global.h"
+#include "ast/Program.h"
+#include "ast/TranslationUnit.h"
+#include "ast/analysis/typesystem/Type.h"
+#include "ast/transform/SemanticChecker.h"
+#include "parser/ParserDriver.h"
+#include "reports/DebugReport.h"
+#include "reports/ErrorReport.h"
+#include "souffle/utility/ParallelUtil.h"
+#include "souffle/utility/StringUtil.h"
+#include <atomic>
+#include <cstddef>
+#include <set>
+#include <string>
+#include <vector>
+
+namespace souffle::ast::test {
+
+/** A program with many clauses, some of which are ill-typed or ungrounded */
+std::string erroneousProgram() {
+    std::string program = R"(
+        .type Name <: symbol
+        .decl num(x: number)
+        .decl name(x: Name)
+        .decl pair(x: number, y: Name)
+        num(0).
+        name("a").
+    )";
+    for (std::size_t i = 0; i < 64; ++i) {
+        const std::string n = std::to_string(i);
+        switch (i % 4) {
+            case 0: program += "pair(x, y) :- num(x), name(y), x < " + n + ".\n"; break;
+            case 1: program += "pair(x, y) :- num(y), name(x), x = \"" + n + "\".\n"; break;
+            case 2: program += "num(x + " + n + ") :- num(y).\n"; break;
+            default: program += "name(y) :- pair(x, y), x = \"" + n + "\", y = " + n + ".\n";
+        }
+    }
+    return program;
+}
+
+/** Checks the erroneous program with the given number of threads and returns the reported errors */
+ErrorReport checkWithThreads(int threads) {
+#ifdef _OPENMP
+    omp_set_num_threads(threads);
+#endif
+    Global glb;
+    glb.config().set("jobs", std::to_string(threads));
+    ErrorReport errorReport;
+    DebugReport debugReport(glb);
+    Own<TranslationUnit> tu =
+            ParserDriver::parseTranslationUnit(glb, erroneousProgram(), errorReport, debugReport);
+    transform::SemanticChecker().apply(*tu);
+    return errorReport;
+}
+
+TEST(ParallelAnalysis, SemanticChecker) {
+    const ErrorReport sequential = checkWithThreads(1);
+    EXPECT_LT(0, sequential.getNumErrors());
+    for (int threads : {2, 4, 8}) {
+        EXPECT_EQ(toString(sequential), toString(checkWithThreads(threads)));
+    }
+#ifdef _OPENMP
+    omp_set_num_threads(1);
+#endif
+}
+
+/** An analysis counting how often it is run */
+class CountingAnalysis : public analysis::Analysis {
+public:
+    static constexpr const char* name = "counting-analysis";
+
+    CountingAnalysis() : Analysis(name) {}
+
+    void run(const TranslationUnit& translationUnit) override {
+        ++runs;
+        // runs an analysis in turn, which the waiting threads see completed
+        types = &translationUnit.getAnalysis<analysis::TypeAnalysis>();
+    }
+
+    static std::atomic<std::size_t> runs;
+
+    const analysis::TypeAnalysis* types = nullptr;
+};
+
+std::atomic<std::size_t> CountingAnalysis::runs{0};
+
+TEST(ParallelAnalysis, ComputedOnce) {
+    Global glb;
+    ErrorReport errorReport;
+    DebugReport debugReport(glb);
+    Own<TranslationUnit> tu = ParserDriver::parseTranslationUnit(glb,
+            R"(
+                .decl num(x: number)
+                num(0).
+                num(x + 1) :- num(x), x < 10.
+            )",
+            errorReport, debugReport);
+
+    // every thread waits for the single computation and sees its complete result
+    std::vector<const CountingAnalysis*> seen(64, nullptr);
+    PARALLEL_START
+    pfor(std::size_t i = 0; i < seen.size(); ++i) {
+        seen[i] = &tu->getAnalysis<CountingAnalysis>();
+    }
+    PARALLEL_END
+
+    EXPECT_EQ(1, CountingAnalysis::runs.load());
+    EXPECT_EQ(1, std::set<const CountingAnalysis*>(seen.begin(), seen.end()).size());
+    EXPECT_EQ(&tu->getAnalysis<analysis::TypeAnalysis>(), seen[0]->types);
+}
+
+}  // namespace souffle::ast::test
@@ -18,6 +18,7 @@
 
 #include "ast/TranslationUnit.h"
 #include "ast/transform/Transformer.h"
+#include <set>
 #include <string>
 
 namespace souffle::ast::transform {
@@ -28,6 +29,10 @@ public:
         return "ExpandEqrelsTransformer";
     }
 
+    std::set<std::string> getPreservedAnalyses() const override {
+        return declarationAnalyses();
+    }
+
 private:
     ExpandEqrelsTransformer* cloning() const override {
         return new ExpandEqrelsTransformer();
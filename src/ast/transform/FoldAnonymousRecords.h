@@ -23,6 +23,7 @@
 #include "ast/transform/Transformer.h"
 #include "souffle/utility/ContainerUtil.h"
 #include <memory>
+#include <set>
 #include <string>
 #include <vector>
 
@@ -51,6 +52,10 @@ public:
         return "FoldAnonymousRecords";
     }
 
+    std::set<std::string> getPreservedAnalyses() const override {
+        return declarationAnalyses();
+    }
+
 private:
     FoldAnonymousRecords* cloning() const override {
         return new FoldAnonymousRecords();
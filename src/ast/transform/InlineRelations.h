@@ -36,6 +36,10 @@ public:
         return "InlineRelationsTransformer";
     }
 
+    std::set<std::string> getPreservedAnalyses() const override {
+        return declarationAnalyses();
+    }
+
 private:
     InlineRelationsTransformer* cloning() const override {
         return new InlineRelationsTransformer();
@@ -287,19 +287,19 @@ bool NormaliseDatabaseTransformer::transform(TranslationUnit& translationUnit) {
 
     /** (1) Partition input and output relations */
     changed |= partitionIO(translationUnit);
-    if (changed) translationUnit.invalidateAnalyses();
+    if (changed) translationUnit.invalidateAnalyses(getPreservedAnalyses());
 
     /** (2) Separate the IDB from the EDB */
     changed |= extractIDB(translationUnit);
-    if (changed) translationUnit.invalidateAnalyses();
+    if (changed) translationUnit.invalidateAnalyses(getPreservedAnalyses());
 
     /** (3) Normalise arguments within each clause */
     changed |= normaliseArguments(translationUnit);
-    if (changed) translationUnit.invalidateAnalyses();
+    if (changed) translationUnit.invalidateAnalyses(getPreservedAnalyses());
 
     /** (4) Querify output relations */
     changed |= querifyOutputRelations(translationUnit);
-    if (changed) translationUnit.invalidateAnalyses();
+    if (changed) translationUnit.invalidateAnalyses(getPreservedAnalyses());
 
     return changed;
 }
@@ -116,6 +116,10 @@ public:
         return "NormaliseDatabaseTransformer";
     }
 
+    std::set<std::string> getPreservedAnalyses() const override {
+        return declarationAnalyses();
+    }
+
 private:
     NormaliseDatabaseTransformer* cloning() const override {
         return new NormaliseDatabaseTransformer();
@@ -189,6 +193,10 @@ public:
         return "NegativeLabellingTransformer";
     }
 
+    std::set<std::string> getPreservedAnalyses() const override {
+        return declarationAnalyses();
+    }
+
 private:
     NegativeLabellingTransformer* cloning() const override {
         return new NegativeLabellingTransformer();
@@ -212,6 +220,10 @@ public:
         return "PositiveLabellingTransformer";
     }
 
+    std::set<std::string> getPreservedAnalyses() const override {
+        return declarationAnalyses();
+    }
+
 private:
     PositiveLabellingTransformer* cloning() const override {
         return new PositiveLabellingTransformer();
@@ -234,6 +246,10 @@ public:
         return "AdornDatabaseTransformer";
     }
 
+    std::set<std::string> getPreservedAnalyses() const override {
+        return declarationAnalyses();
+    }
+
 private:
     AdornDatabaseTransformer* cloning() const override {
         return new AdornDatabaseTransformer();
@@ -297,6 +313,10 @@ public:
         return "MagicSetCoreTransformer";
     }
 
+    std::set<std::string> getPreservedAnalyses() const override {
+        return declarationAnalyses();
+    }
+
 private:
     MagicSetCoreTransformer* cloning() const override {
         return new MagicSetCoreTransformer();
@@ -38,6 +38,10 @@ public:
         return "MaterializeAggregationQueriesTransformer";
     }
 
+    std::set<std::string> getPreservedAnalyses() const override {
+        return declarationAnalyses();
+    }
+
     /**
      * Creates artificial relations for bodies of aggregation functions
      * consisting of more than a single atom, in the given program.
@@ -22,6 +22,7 @@
 #include "ast/Program.h"
 #include "ast/TranslationUnit.h"
 #include "ast/transform/Transformer.h"
+#include <set>
 #include <string>
 
 namespace souffle::ast::transform {
@@ -36,6 +37,10 @@ public:
         return "MaterializeSingletonAggregationTransformer";
     }
 
+    std::set<std::string> getPreservedAnalyses() const override {
+        return declarationAnalyses();
+    }
+
 private:
     MaterializeSingletonAggregationTransformer* cloning() const override {
         return new MaterializeSingletonAggregationTransformer();
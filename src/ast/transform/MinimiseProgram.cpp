@@ -412,11 +412,11 @@ bool MinimiseProgramTransformer::reduceClauseBodies(TranslationUnit& translation
 bool MinimiseProgramTransformer::transform(TranslationUnit& translationUnit) {
     bool changed = false;
     changed |= reduceClauseBodies(translationUnit);
-    if (changed) translationUnit.invalidateAnalyses();
+    if (changed) translationUnit.invalidateAnalyses(getPreservedAnalyses());
     changed |= removeRedundantClauses(translationUnit);
-    if (changed) translationUnit.invalidateAnalyses();
+    if (changed) translationUnit.invalidateAnalyses(getPreservedAnalyses());
     changed |= reduceLocallyEquivalentClauses(translationUnit);
-    if (changed) translationUnit.invalidateAnalyses();
+    if (changed) translationUnit.invalidateAnalyses(getPreservedAnalyses());
     changed |= reduceSingletonRelations(translationUnit);
     return changed;
 }
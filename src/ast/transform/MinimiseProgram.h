@@ -19,6 +19,7 @@
 #include "ast/TranslationUnit.h"
 #include "ast/analysis/ClauseNormalisation.h"
 #include "ast/transform/Transformer.h"
+#include <set>
 #include <string>
 #include <vector>
 
@@ -37,6 +38,10 @@ public:
         return "MinimiseProgramTransformer";
     }
 
+    std::set<std::string> getPreservedAnalyses() const override {
+        return declarationAnalyses();
+    }
+
     // Check whether two normalised clause representations are equivalent.
     static bool areBijectivelyEquivalent(
             const analysis::NormalisedClause& left, const analysis::NormalisedClause& right);
@@ -18,6 +18,8 @@
 #pragma once
 
 #include "ast/transform/Transformer.h"
+#include <set>
+#include <string>
 
 namespace souffle::ast::transform {
 
@@ -28,6 +30,10 @@ public:
         return "NormaliseGeneratorsTransformer";
     }
 
+    std::set<std::string> getPreservedAnalyses() const override {
+        return dependencyAnalyses();
+    }
+
 private:
     bool transform(TranslationUnit& translationUnit) override;
 
@@ -23,6 +23,7 @@
 
 #include "ast/TranslationUnit.h"
 #include "ast/transform/Transformer.h"
+#include <set>
 #include <string>
 
 namespace souffle::ast::transform {
@@ -41,6 +42,10 @@ public:
         return "PartitionBodyLiteralsTransformer";
     }
 
+    std::set<std::string> getPreservedAnalyses() const override {
+        return declarationAnalyses();
+    }
+
 private:
     PartitionBodyLiteralsTransformer* cloning() const override {
         return new PartitionBodyLiteralsTransformer();
@@ -16,6 +16,7 @@
 
 #include "ast/TranslationUnit.h"
 #include "ast/transform/Transformer.h"
+#include <set>
 #include <string>
 
 namespace souffle::ast::transform {
@@ -30,6 +31,10 @@ public:
         return "RemoveBooleanConstraintsTransformer";
     }
 
+    std::set<std::string> getPreservedAnalyses() const override {
+        return declarationAnalyses();
+    }
+
 private:
     RemoveBooleanConstraintsTransformer* cloning() const override {
         return new RemoveBooleanConstraintsTransformer();
@@ -16,6 +16,7 @@
 
 #include "ast/TranslationUnit.h"
 #include "ast/transform/Transformer.h"
+#include <set>
 #include <string>
 
 namespace souffle::ast::transform {
@@ -34,6 +35,10 @@ public:
         return "RemoveRelationCopiesTransformer";
     }
 
+    std::set<std::string> getPreservedAnalyses() const override {
+        return declarationAnalyses();
+    }
+
     /**
      * Replaces copies of relations by their origin in the given program.
      *
@@ -16,6 +16,7 @@
 
 #include "ast/TranslationUnit.h"
 #include "ast/transform/Transformer.h"
+#include <set>
 #include <string>
 
 namespace souffle::ast::transform {
@@ -31,6 +32,10 @@ public:
         return "ReplaceSingletonVariablesTransformer";
     }
 
+    std::set<std::string> getPreservedAnalyses() const override {
+        return dependencyAnalyses();
+    }
+
 private:
     ReplaceSingletonVariablesTransformer* cloning() const override {
         return new ReplaceSingletonVariablesTransformer();
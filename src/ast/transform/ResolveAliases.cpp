@@ -35,6 +35,7 @@
 #include "souffle/utility/FunctionalUtil.h"
 #include "souffle/utility/MiscUtil.h"
 #include "souffle/utility/NodeMapper.h"
+#include "souffle/utility/ParallelUtil.h"
 #include "souffle/utility/StreamUtil.h"
 #include "souffle/utility/StringUtil.h"
 #include <algorithm>
@@ -467,11 +468,19 @@ Own<Clause> ResolveAliasesTransformer::removeComplexTermsInAtoms(const Clause& c
     using substitution_map = std::vector<std::pair<Own<Argument>, Own<ast::Variable>>>;
     substitution_map termToVar;
 
-    static int varCounter = 0;
+    // number the new variables per clause, so that clauses can be processed in parallel and the
+    // result does not depend on the order in which they are processed
+    const std::string tmpPrefix = " _tmp_";
+    int varCounter = 0;
+    visit(*res, [&](const ast::Variable& var) {
+        if (isPrefix(tmpPrefix, var.getName())) {
+            varCounter = std::max(varCounter, std::stoi(var.getName().substr(tmpPrefix.size())) + 1);
+        }
+    });
     for (const Argument* arg : terms) {
         // create a new mapping for this term
         auto term = clone(arg);
-        auto newVariable = mk<ast::Variable>(" _tmp_" + toString(varCounter++));
+        auto newVariable = mk<ast::Variable>(tmpPrefix + toString(varCounter++));
         termToVar.push_back(std::make_pair(std::move(term), std::move(newVariable)));
     }
 
@@ -531,12 +540,17 @@ bool ResolveAliasesTransformer::transform(TranslationUnit& translationUnit) {
         }
     });
 
-    // clean all clauses
-    for (Clause* clause : clauses) {
+    // clean all clauses; each clause is cleaned on its own, so this is done in parallel
+    VecOwn<Clause> normalisedClauses(clauses.size());
+    std::vector<char> named(clauses.size(), 0);
+    PARALLEL_START
+    pfor(std::size_t i = 0; i < clauses.size(); ++i) {
+        Clause* clause = clauses[i];
+
         // -- Step 0 --
         // Name unnamed variables in record and branch inits (souffle-lang/souffle#2482)
         // This is fine as long as this transformer runs after the semantics checker
-        changed |= nameUnnamedInit(*clause);
+        named[i] = nameUnnamedInit(*clause);
 
         // -- Step 1 --
         // get rid of aliases
@@ -547,13 +561,17 @@ bool ResolveAliasesTransformer::transform(TranslationUnit& translationUnit) {
 
         // -- Step 2 --
         // restore simple terms in atoms
-        Own<Clause> normalised = removeComplexTermsInAtoms(*cleaned);
+        normalisedClauses[i] = removeComplexTermsInAtoms(*cleaned);
+    }
+    PARALLEL_END
 
-        // swap if changed
-        if (*normalised != *clause) {
+    // swap if changed
+    for (std::size_t i = 0; i < clauses.size(); ++i) {
+        changed |= named[i] != 0;
+        if (*normalisedClauses[i] != *clauses[i]) {
             changed = true;
-            program.removeClause(*clause);
-            program.addClause(std::move(normalised));
+            program.removeClause(*clauses[i]);
+            program.addClause(std::move(normalisedClauses[i]));
         }
     }
 
@@ -19,6 +19,7 @@
 #include "ast/TranslationUnit.h"
 #include "ast/transform/Transformer.h"
 #include <map>
+#include <set>
 #include <string>
 
 namespace souffle::ast::transform {
@@ -38,6 +39,10 @@ public:
         return "ResolveAnonymousRecordAliases";
     }
 
+    std::set<std::string> getPreservedAnalyses() const override {
+        return declarationAnalyses();
+    }
+
 private:
     ResolveAnonymousRecordAliasesTransformer* cloning() const override {
         return new ResolveAnonymousRecordAliasesTransformer();
@@ -78,6 +78,7 @@
 #include "souffle/utility/ContainerUtil.h"
 #include "souffle/utility/FunctionalUtil.h"
 #include "souffle/utility/MiscUtil.h"
+#include "souffle/utility/ParallelUtil.h"
 #include "souffle/utility/StreamUtil.h"
 #include "souffle/utility/StringUtil.h"
 #include "souffle/utility/tinyformat.h"
@@ -174,9 +175,13 @@ SemanticCheckerImpl::SemanticCheckerImpl(TranslationUnit& tu) : tu(tu) {
     for (auto* lattice : program.getLattices()) {
         checkLatticeDeclaration(*lattice);
     }
-    for (auto* clause : program.getClauses()) {
-        checkClause(*clause);
+    // clauses are checked independently of each other
+    const std::vector<Clause*> clauses = program.getClauses();
+    PARALLEL_START
+    pfor(std::size_t i = 0; i < clauses.size(); ++i) {
+        checkClause(*clauses[i]);
     }
+    PARALLEL_END
     for (auto* decl : program.getFunctorDeclarations()) {
         checkFunctorDeclaration(*decl);
     }
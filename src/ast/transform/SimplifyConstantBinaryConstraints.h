@@ -16,6 +16,7 @@
 
 #include "ast/TranslationUnit.h"
 #include "ast/transform/Transformer.h"
+#include <set>
 #include <string>
 
 namespace souffle::ast::transform {
@@ -29,6 +30,10 @@ public:
         return "SimplifyConstantBinaryConstraintsTransformer";
     }
 
+    std::set<std::string> getPreservedAnalyses() const override {
+        return declarationAnalyses();
+    }
+
 private:
     SimplifyConstantBinaryConstraintsTransformer* cloning() const override {
         return new SimplifyConstantBinaryConstraintsTransformer();
@@ -18,6 +18,7 @@
 
 #include "ast/TranslationUnit.h"
 #include "souffle/utility/Types.h"
+#include <set>
 #include <string>
 
 namespace souffle::ast::transform {
@@ -33,6 +34,14 @@ public:
 
     virtual std::string getName() const = 0;
 
+    /**
+     * Names of the analyses that stay valid when the transformer changes
+     * the program; all other analyses are invalidated after a change.
+     */
+    virtual std::set<std::string> getPreservedAnalyses() const {
+        return {};
+    }
+
     /**
      * Transformers can be disabled by command line
      * with --disable-transformer. Default behaviour
@@ -46,6 +55,16 @@ public:
         return Own<Transformer>(cloning());
     }
 
+protected:
+    /** Analyses of type and functor declarations, valid while no declaration changes */
+    static std::set<std::string> declarationAnalyses();
+
+    /**
+     * Analyses of the dependencies between relations, valid while no relation,
+     * directive, clause or atom is added or removed
+     */
+    static std::set<std::string> dependencyAnalyses();
+
 private:
     virtual Transformer* cloning() const = 0;
 };
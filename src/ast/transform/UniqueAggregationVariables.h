@@ -16,6 +16,7 @@
 
 #include "ast/TranslationUnit.h"
 #include "ast/transform/Transformer.h"
+#include <set>
 #include <string>
 
 namespace souffle::ast::transform {
@@ -29,6 +30,10 @@ public:
         return "UniqueAggregationVariablesTransformer";
     }
 
+    std::set<std::string> getPreservedAnalyses() const override {
+        return dependencyAnalyses();
+    }
+
 private:
     UniqueAggregationVariablesTransformer* cloning() const override {
         return new UniqueAggregationVariablesTransformer();
@@ -15,6 +15,7 @@
 #include "ast2ram/provenance/UnitTranslator.h"
 #include "Global.h"
 #include "LogStatement.h"
+#include "RelationTag.h"
 #include "ast/BinaryConstraint.h"
 #include "ast/Clause.h"
 #include "ast/Constraint.h"
@@ -85,8 +86,14 @@ Own<ram::Relation> UnitTranslator::createRamRelation(
     attributeNames.push_back("@level_number");
     attributeTypeQualifiers.push_back("i:number");
 
+    // compressed leaves do not hold the provenance attributes
+    auto representation = relation->getRepresentation();
+    if (representation == RelationRepresentation::BTREE_COMPRESSED) {
+        representation = RelationRepresentation::DEFAULT;
+    }
+
     return mk<ram::Relation>(ramRelationName, arity + 2, auxiliaryArity + 2, attributeNames,
-            attributeTypeQualifiers, relation->getRepresentation());
+            attributeTypeQualifiers, representation);
 }
 
 std::string UnitTranslator::getInfoRelationName(const ast::Clause* clause) const {
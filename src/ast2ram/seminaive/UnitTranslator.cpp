@@ -27,10 +27,10 @@
 #include "ast2ram/ClauseTranslator.h"
 #include "ast2ram/utility/TranslatorContext.h"
 #include "ast2ram/utility/Utils.h"
-#include "ram/Aggregate.h"
 #include "ram/Assign.h"
 #include "ram/Call.h"
 #include "ram/Clear.h"
+#include "ram/Compact.h"
 #include "ram/Condition.h"
 #include "ram/Conjunction.h"
 #include "ram/Constraint.h"
@@ -48,7 +48,9 @@
 #include "ram/LogSize.h"
 #include "ram/LogTimer.h"
 #include "ram/Loop.h"
+#include "ram/Merge.h"
 #include "ram/MergeExtend.h"
+#include "ram/MergeLattice.h"
 #include "ram/Negation.h"
 #include "ram/Parallel.h"
 #include "ram/Program.h"
@@ -62,7 +64,6 @@
 #include "ram/Swap.h"
 #include "ram/TranslationUnit.h"
 #include "ram/TupleElement.h"
-#include "ram/UndefValue.h"
 #include "ram/UnsignedConstant.h"
 #include "ram/UserDefinedAggregator.h"
 #include "ram/UserDefinedOperator.h"
@@ -76,6 +77,7 @@
 #include "souffle/utility/FunctionalUtil.h"
 #include "souffle/utility/MiscUtil.h"
 #include "souffle/utility/StringUtil.h"
+#include "souffle/utility/json11.h"
 #include <algorithm>
 #include <cassert>
 #include <chrono>
@@ -183,7 +185,7 @@ Own<ram::Statement> UnitTranslator::generateStratum(std::size_t scc) const {
         const auto* rel = *sccRelations.begin();
         appendStmt(current, generateNonRecursiveRelation(*rel));
 
-        // lub auxiliary arities using the @lub relation
+        // merge the lattice attributes of @new() into the relation with a MERGE-LATTICE statement
         if (rel->getAuxiliaryArity() > 0) {
             std::string mainRelation = getConcreteRelationName(rel->getQualifiedName());
             std::string newRelation = getNewRelationName(rel->getQualifiedName());
@@ -197,6 +199,14 @@ Own<ram::Statement> UnitTranslator::generateStratum(std::size_t scc) const {
         appendStmt(current, generateNonRecursiveDelete(*rel));
     }
 
+    // Compress the tuples computed by the stratum, which are only read from now on
+    for (const auto* rel : sccRelations) {
+        if (rel->getRepresentation() == RelationRepresentation::BTREE_COMPRESSED && rel->getArity() > 0 &&
+                rel->getAuxiliaryArity() == 0) {
+            appendStmt(current, mk<ram::Compact>(getConcreteRelationName(rel->getQualifiedName())));
+        }
+    }
+
     // Get all non-recursive relation statements
     auto nonRecursiveJoinSizeStatements = context->getNonRecursiveJoinSizeStatementsInSCC(scc);
     auto joinSizeSequence = mk<ram::Sequence>(std::move(nonRecursiveJoinSizeStatements));
@@ -219,6 +229,35 @@ Own<ram::Statement> UnitTranslator::generateClearExpiredRelations(
     return mk<ram::Sequence>(std::move(stmts));
 }
 
+Own<ram::Statement> UnitTranslator::generateSpillRelations(
+        const ast::RelationSet& relations, const std::string& operation) const {
+    VecOwn<ram::Statement> stmts;
+    for (const auto* relation : relations) {
+        // Nullary relations hold at most one tuple
+        if (relation->getArity() == 0) {
+            continue;
+        }
+
+        std::vector<std::string> attributeTypes;
+        for (const auto* attribute : relation->getAttributes()) {
+            attributeTypes.push_back(context->getAttributeTypeQualifier(attribute->getTypeName()));
+        }
+        json11::Json relationJson =
+                json11::Json::object{{"arity", static_cast<long long>(relation->getArity())},
+                        {"types", json11::Json::array(attributeTypes.begin(), attributeTypes.end())}};
+
+        std::string ramRelationName = getConcreteRelationName(relation->getQualifiedName());
+        std::map<std::string, std::string> directives = {{"IO", "spill"}, {"operation", operation},
+                {"name", ramRelationName},
+                {"types", json11::Json(json11::Json::object{{"relation", relationJson}}).dump()},
+                {"memory-budget", glb->config().get("memory-budget")}};
+        // the spill files hold whole tuples of the RAM relation, including auxiliary attributes
+        addAuxiliaryArity(relation, directives);
+        appendStmt(stmts, mk<ram::IO>(ramRelationName, directives));
+    }
+    return mk<ram::Sequence>(std::move(stmts));
+}
+
 Own<ram::Statement> UnitTranslator::generateEraseTuples(
         const ast::Relation* rel, const std::string& destRelation, const std::string& srcRelation) const {
     VecOwn<ram::Expression> values;
@@ -274,12 +313,7 @@ Own<ram::Statement> UnitTranslator::generateMergeRelations(
     if (rel->getRepresentation() == RelationRepresentation::EQREL) {
         return mk<ram::MergeExtend>(destRelation, srcRelation);
     }
-    for (std::size_t i = 0; i < rel->getArity(); i++) {
-        values.push_back(mk<ram::TupleElement>(0, i));
-    }
-    auto insertion = mk<ram::Insert>(destRelation, std::move(values));
-    auto stmt = mk<ram::Query>(mk<ram::Scan>(srcRelation, 0, std::move(insertion)));
-    return stmt;
+    return mk<ram::Merge>(destRelation, srcRelation);
 }
 
 Own<ram::Statement> UnitTranslator::generateDebugRelation(const ast::Relation* rel,
@@ -473,7 +507,7 @@ Own<ram::Statement> UnitTranslator::generateStratumPreamble(const ast::RelationS
         std::string deltaRelation = getDeltaRelationName(rel->getQualifiedName());
         std::string mainRelation = getConcreteRelationName(rel->getQualifiedName());
         appendStmt(preamble, generateNonRecursiveRelation(*rel));
-        // lub tuples using the @lub relation
+        // merge the tuples of @new() into the relation with a MERGE-LATTICE statement
         if (rel->getAuxiliaryArity() > 0) {
             std::string newRelation = getNewRelationName(rel->getQualifiedName());
             appendStmt(preamble, generateStratumLubSequence(*rel, false));
@@ -522,9 +556,9 @@ Own<ram::Statement> UnitTranslator::generateStratumTableUpdates(const ast::Relat
         // swap new and and delta relation and clear new relation afterwards (if not a subsumptive relation)
         Own<ram::Statement> updateRelTable;
         if (rel->getAuxiliaryArity() > 0) {
+            // the lub sequence updates the main relation in place
             updateRelTable =
-                    mk<ram::Sequence>(mk<ram::Clear>(deltaRelation), generateStratumLubSequence(*rel, true),
-                            generateMergeRelations(rel, mainRelation, deltaRelation));
+                    mk<ram::Sequence>(mk<ram::Clear>(deltaRelation), generateStratumLubSequence(*rel, true));
         } else if (!context->hasSubsumptiveClause(rel->getQualifiedName())) {
             updateRelTable = mk<ram::Sequence>(generateMergeRelations(rel, mainRelation, newRelation),
                     mk<ram::Swap>(deltaRelation, newRelation), mk<ram::Clear>(newRelation));
@@ -585,8 +619,10 @@ Own<ram::Statement> UnitTranslator::generateStratumLoopBody(const ast::RelationS
     return mk<ram::Sequence>(std::move(loopBody));
 }
 
-/// assuming the @new() relation is populated with new tuples, generate RAM code
-/// to populate the @delta() relation with the lubbed elements from @new()
+/// assuming the @new() relation is populated with new tuples, generate RAM code to merge them
+/// into the concrete relation, combining the lattice attributes of tuples that agree on all other
+/// attributes with their least upper bound; in the recursive loop, the tuples that are new or
+/// changed in the concrete relation also populate the @delta() relation
 Own<ram::Statement> UnitTranslator::generateStratumLubSequence(
         const ast::Relation& rel, bool inRecursiveLoop) const {
     VecOwn<ram::Statement> stmts;
@@ -594,122 +630,27 @@ Own<ram::Statement> UnitTranslator::generateStratumLubSequence(
 
     auto attributes = rel.getAttributes();
     std::string name = getConcreteRelationName(rel.getQualifiedName());
-    std::string lubName = getLubRelationName(rel.getQualifiedName());
     std::string newName = getNewRelationName(rel.getQualifiedName());
-
-    const std::size_t arity = rel.getArity();
-    const std::size_t auxiliaryArity = rel.getAuxiliaryArity();
-
-    // Step 1 : populate @lub() from @new()
-    VecOwn<ram::Expression> values;
+    std::string deltaName = inRecursiveLoop ? getDeltaRelationName(rel.getQualifiedName()) : "";
 
     // index of the first auxiliary element of the relation
-    std::size_t firstAuxiliary = arity - auxiliaryArity;
-
-    for (std::size_t i = 0; i < arity; i++) {
-        if (i >= firstAuxiliary) {
-            values.push_back(mk<ram::TupleElement>(i - firstAuxiliary + 1, 0));
-        } else {
-            values.push_back(mk<ram::TupleElement>(0, i));
-        }
-    }
-    Own<ram::Operation> op = mk<ram::Insert>(lubName, std::move(values));
+    const std::size_t arity = rel.getArity();
+    const std::size_t firstAuxiliary = arity - rel.getAuxiliaryArity();
 
-    for (std::size_t i = arity; i >= firstAuxiliary + 1; i--) {
-        const auto type = attributes[i - 1]->getTypeName();
-        std::size_t level = i - firstAuxiliary;
-        auto aggregator = context->getLatticeTypeLubAggregator(type, mk<ram::TupleElement>(0, i - 1));
-        Own<ram::Condition> condition = mk<ram::Constraint>(
-                BinaryConstraintOp::NE, mk<ram::TupleElement>(level, i - 1), mk<ram::TupleElement>(0, i - 1));
-        for (std::size_t j = 0; j < attributes.size(); j++) {
-            if (attributes[j]->getIsLattice()) break;
-            condition = mk<ram::Conjunction>(std::move(condition),
-                    mk<ram::Constraint>(BinaryConstraintOp::EQ, mk<ram::TupleElement>(level, j),
-                            mk<ram::TupleElement>(0, j)));
-        }
-        op = mk<ram::Aggregate>(std::move(op), std::move(aggregator), newName,
-                mk<ram::TupleElement>(level, i - 1), std::move(condition), level);
+    // the least upper bound of each lattice attribute combines the tuples 0 and 1
+    VecOwn<ram::Expression> lubs;
+    for (std::size_t i = firstAuxiliary; i < arity; i++) {
+        assert(attributes[i]->getIsLattice());
+        VecOwn<ram::Expression> args;
+        args.push_back(mk<ram::TupleElement>(0, i));
+        args.push_back(mk<ram::TupleElement>(1, i));
+        lubs.push_back(context->getLatticeTypeLubFunctor(attributes[i]->getTypeName(), std::move(args)));
     }
-
-    op = mk<ram::Scan>(newName, 0, std::move(op));
-    appendStmt(stmts, mk<ram::Query>(std::move(op)));
+    appendStmt(stmts, mk<ram::MergeLattice>(name, newName, deltaName, std::move(lubs)));
 
     // clear @new() now that we no longer need it
     appendStmt(stmts, mk<ram::Clear>(newName));
 
-    if (inRecursiveLoop) {
-        // Step 2 : populate @delta() from @lub() for tuples that have to be lubbed with @concrete
-        std::string deltaName = getDeltaRelationName(rel.getQualifiedName());
-
-        Own<ram::Condition> condition;
-        for (std::size_t i = 0; i < arity; i++) {
-            if (i < firstAuxiliary) {
-                values.push_back(mk<ram::TupleElement>(0, i));
-            } else {
-                assert(attributes[i]->getIsLattice());
-                const auto type = attributes[i]->getTypeName();
-                VecOwn<ram::Expression> args;
-                args.push_back(mk<ram::TupleElement>(0, i));
-                args.push_back(mk<ram::TupleElement>(1, i));
-                auto lub = context->getLatticeTypeLubFunctor(type, std::move(args));
-                auto cst =
-                        mk<ram::Constraint>(BinaryConstraintOp::EQ, mk<ram::TupleElement>(1, i), clone(lub));
-                if (condition) {
-                    condition = mk<ram::Conjunction>(std::move(condition), std::move(cst));
-                } else {
-                    condition = std::move(cst);
-                }
-                values.push_back(std::move(lub));
-            }
-        }
-        op = mk<ram::Insert>(deltaName, std::move(values));
-        op = mk<ram::Filter>(mk<ram::Negation>(std::move(condition)), std::move(op));
-
-        for (std::size_t i = 0; i < arity - auxiliaryArity; i++) {
-            auto cst = mk<ram::Constraint>(
-                    BinaryConstraintOp::EQ, mk<ram::TupleElement>(0, i), mk<ram::TupleElement>(1, i));
-            if (condition) {
-                condition = mk<ram::Conjunction>(std::move(condition), std::move(cst));
-            } else {
-                condition = std::move(cst);
-            }
-        }
-        if (condition) {
-            op = mk<ram::Filter>(std::move(condition), std::move(op));
-        }
-        op = mk<ram::Scan>(name, 1, std::move(op));
-        op = mk<ram::Scan>(lubName, 0, std::move(op));
-        appendStmt(stmts, mk<ram::Query>(std::move(op)));
-
-        // Step 3 : populate @delta() from @lub() for tuples that have nothing to lub in @concrete
-        for (std::size_t i = 0; i < arity; i++) {
-            values.push_back(mk<ram::TupleElement>(0, i));
-        }
-        op = mk<ram::Insert>(deltaName, std::move(values));
-        for (std::size_t i = 0; i < arity; i++) {
-            if (i < firstAuxiliary) {
-                values.push_back(mk<ram::TupleElement>(0, i));
-            } else {
-                values.push_back(mk<ram::UndefValue>());
-            }
-        }
-        op = mk<ram::Filter>(
-                mk<ram::Negation>(mk<ram::ExistenceCheck>(name, std::move(values))), std::move(op));
-        op = mk<ram::Scan>(lubName, 0, std::move(op));
-        appendStmt(stmts, mk<ram::Query>(std::move(op)));
-    } else {
-        // we are not in the recursive loop, so the concrete relation is empty for now
-        // we can just insert the content of the @lub relation into the concrete one
-        for (std::size_t i = 0; i < arity; i++) {
-            values.push_back(mk<ram::TupleElement>(0, i));
-        }
-        op = mk<ram::Insert>(name, std::move(values));
-        op = mk<ram::Scan>(lubName, 0, std::move(op));
-        appendStmt(stmts, mk<ram::Query>(std::move(op)));
-    }
-
-    appendStmt(stmts, mk<ram::Clear>(lubName));
-
     return mk<ram::Sequence>(std::move(stmts));
 }
 
@@ -846,6 +787,12 @@ Own<ram::Relation> UnitTranslator::createRamRelation(
     if (representation == RelationRepresentation::BTREE_DELETE && ramRelationName[0] == '@') {
         representation = RelationRepresentation::DEFAULT;
     }
+    // compressing pays off neither for temporaries, rewritten at every iteration, nor for nullary relations;
+    // compressed leaves do not hold auxiliary attributes
+    if (representation == RelationRepresentation::BTREE_COMPRESSED &&
+            (ramRelationName[0] == '@' || arity == 0 || auxArity > 0)) {
+        representation = RelationRepresentation::DEFAULT;
+    }
 
     std::vector<std::string> attributeNames;
     std::vector<std::string> attributeTypeQualifiers;
@@ -867,12 +814,6 @@ VecOwn<ram::Relation> UnitTranslator::createRamRelations(const std::vector<std::
             std::string mainName = getConcreteRelationName(rel->getQualifiedName());
             ramRelations.push_back(createRamRelation(rel, mainName));
 
-            if (rel->getAuxiliaryArity() > 0) {
-                // Add lub relation
-                std::string lubName = getLubRelationName(rel->getQualifiedName());
-                ramRelations.push_back(createRamRelation(rel, lubName));
-            }
-
             if (isRecursive || rel->getAuxiliaryArity() > 0) {
                 // Add new relation
                 std::string newName = getNewRelationName(rel->getQualifiedName());
@@ -914,14 +855,25 @@ Own<ram::Sequence> UnitTranslator::generateProgram(const ast::TranslationUnit& t
             translationUnit.getAnalysis<ast::analysis::TopologicallySortedSCCGraphAnalysis>().order();
     VecOwn<ram::Statement> res;
 
+    // A query server answers queries over all relations once the program has been evaluated
+    const bool keepRelations = glb->config().has("query-server");
+
     // Create subroutines for each SCC according to topological order
     for (std::size_t i = 0; i < sccOrdering.size(); i++) {
         // Generate the main stratum code
         auto stratum = generateStratum(sccOrdering.at(i));
 
         // Clear expired relations
-        const auto& expiredRelations = context->getExpiredRelations(i);
-        stratum = mk<ram::Sequence>(std::move(stratum), generateClearExpiredRelations(expiredRelations));
+        if (!keepRelations) {
+            const auto& expiredRelations = context->getExpiredRelations(i);
+            stratum = mk<ram::Sequence>(std::move(stratum), generateClearExpiredRelations(expiredRelations));
+        }
+
+        // Spill relations that are not needed in the next stratum if memory runs short
+        if (glb->config().has("memory-budget") && !keepRelations) {
+            stratum = mk<ram::Sequence>(generateSpillRelations(context->getResumedRelations(i), "restore"),
+                    std::move(stratum), generateSpillRelations(context->getColdRelations(i), "spill"));
+        }
 
         // Add the subroutine
         const ast::Relation* rel = *context->getRelationsInSCC(sccOrdering.at(i)).begin();
@@ -90,6 +90,8 @@ protected:
     /** Other helper generations */
     virtual Own<ram::Statement> generateClearExpiredRelations(const ast::RelationSet& expiredRelations) const;
     Own<ram::Statement> generateClearRelation(const ast::Relation* relation) const;
+    Own<ram::Statement> generateSpillRelations(
+            const ast::RelationSet& relations, const std::string& operation) const;
     virtual Own<ram::Statement> generateMergeRelations(
             const ast::Relation* rel, const std::string& destRelation, const std::string& srcRelation) const;
     virtual Own<ram::Statement> generateMergeRelationsWithFilter(const ast::Relation* rel,
@@ -146,22 +146,6 @@ Own<ram::AbstractOperator> TranslatorContext::getLatticeTypeLubFunctor(
     return {};
 }
 
-Own<ram::Aggregator> TranslatorContext::getLatticeTypeLubAggregator(
-        const ast::QualifiedName& typeName, Own<ram::Expression> init) const {
-    const ast::Lattice* lattice = lattices.at(typeName);
-    if (const auto* lub = as<ast::UserDefinedFunctor>(lattice->getLub())) {
-        const auto typeAttributes = getFunctorParamTypeAtributes(*lub);
-        const auto returnAttribute = getFunctorReturnTypeAttribute(*lub);
-        bool stateful = isStatefulFunctor(*lub);
-        return mk<ram::UserDefinedAggregator>(
-                lub->getName(), std::move(init), typeAttributes, returnAttribute, stateful);
-    } else if (const auto* lub = as<ast::IntrinsicFunctor>(lattice->getLub())) {
-        assert(false && lub && "intrinsic aggregators not yet supported in lattice");
-    }
-    assert(false);
-    return {};
-}
-
 std::size_t TranslatorContext::getNumberOfSCCs() const {
     return sccGraph->getNumberOfSCCs();
 }
@@ -235,6 +219,14 @@ ast::RelationSet TranslatorContext::getExpiredRelations(std::size_t scc) const {
     return relationSchedule->schedule().at(scc).expired();
 }
 
+ast::RelationSet TranslatorContext::getColdRelations(std::size_t scc) const {
+    return relationSchedule->schedule().at(scc).cold();
+}
+
+ast::RelationSet TranslatorContext::getResumedRelations(std::size_t scc) const {
+    return relationSchedule->schedule().at(scc).resumed();
+}
+
 bool TranslatorContext::hasSubsumptiveClause(const ast::QualifiedName& name) const {
     for (const auto* clause : getProgram()->getClauses(name)) {
         if (isA<ast::SubsumptiveClause>(clause)) {
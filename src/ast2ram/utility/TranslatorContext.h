@@ -97,8 +97,6 @@ public:
     bool hasSizeLimit(const ast::Relation* relation) const;
     std::size_t getSizeLimit(const ast::Relation* relation) const;
 
-    Own<ram::Aggregator> getLatticeTypeLubAggregator(
-            const ast::QualifiedName& typeName, Own<ram::Expression> init) const;
     Own<ram::AbstractOperator> getLatticeTypeLubFunctor(
             const ast::QualifiedName& typeName, VecOwn<ram::Expression> args) const;
 
@@ -114,6 +112,8 @@ public:
     std::size_t getNumberOfSCCs() const;
     bool isRecursiveSCC(std::size_t scc) const;
     ast::RelationSet getExpiredRelations(std::size_t scc) const;
+    ast::RelationSet getColdRelations(std::size_t scc) const;
+    ast::RelationSet getResumedRelations(std::size_t scc) const;
     ast::RelationSet getRelationsInSCC(std::size_t scc) const;
     ast::RelationSet getInputRelationsInSCC(std::size_t scc) const;
     ast::RelationSet getOutputRelationsInSCC(std::size_t scc) const;
@@ -104,10 +104,6 @@ std::string getNewRelationName(const ast::QualifiedName& name) {
     return getConcreteRelationName(name, "@new_");
 }
 
-std::string getLubRelationName(const ast::QualifiedName& name) {
-    return getConcreteRelationName(name, "@lub_");
-}
-
 std::string getRejectRelationName(const ast::QualifiedName& name) {
     return getConcreteRelationName(name, "@reject_");
 }
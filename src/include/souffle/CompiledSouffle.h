@@ -33,6 +33,16 @@
 #include "souffle/io/IOSystem.h"
 #include "souffle/io/WriteStream.h"
 #include "souffle/utility/EvaluatorUtil.h"
+#include "souffle/utility/NumaUtil.h"
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <limits>
+#include <optional>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
 
 #if defined(_OPENMP)
 #include <omp.h>
@@ -66,13 +76,14 @@ private:
     const arity_type numAuxAttribs;
 
     // NB: internal wrapper. does not satisfy the `iterator` concept.
+    template <typename Iter = typename RelType::iterator>
     class iterator_wrapper : public iterator_base {
-        typename RelType::iterator it;
+        Iter it;
         const Relation* relation;
         tuple t;
 
     public:
-        iterator_wrapper(uint32_t arg_id, const Relation* rel, typename RelType::iterator arg_it)
+        iterator_wrapper(uint32_t arg_id, const Relation* rel, Iter arg_it)
                 : iterator_base(arg_id), it(std::move(arg_it)), relation(rel), t(rel) {}
         void operator++() override {
             ++it;
@@ -90,11 +101,27 @@ private:
 
     protected:
         bool equal(const iterator_base& o) const override {
-            const auto& casted = asAssert<iterator_wrapper>(o);
-            return it == casted.it;
+            // iterators of lookups may run over a different index than the scan of the relation
+            const auto* casted = dynamic_cast<const iterator_wrapper*>(&o);
+            return casted != nullptr && it == casted->it;
         }
     };
 
+    /** Stands in for the consumer of a lookup when detecting lookup support */
+    struct range_consumer {
+        template <typename Range>
+        void operator()(const Range&) const {}
+    };
+
+    /** Detects relation types that look up binding patterns through their indexes */
+    template <typename R, typename = void>
+    struct has_lookup : std::false_type {};
+
+    template <typename R>
+    struct has_lookup<R, std::void_t<decltype(std::declval<const R&>().lookup(std::declval<const std::string&>(),
+                                 std::declval<const TupleType&>(), std::declval<const TupleType&>(),
+                                 std::declval<range_consumer>()))>> : std::true_type {};
+
 public:
     RelationWrapper(uint32_t id, RelType& r, SouffleProgram& p, std::string name, const AttrStrSeq& t,
             const AttrStrSeq& n, arity_type numAuxAttribs)
@@ -102,10 +129,10 @@ public:
               numAuxAttribs(numAuxAttribs) {}
 
     iterator begin() const override {
-        return iterator(mk<iterator_wrapper>(id, this, relation.begin()));
+        return iterator(mk<iterator_wrapper<>>(id, this, relation.begin()));
     }
     iterator end() const override {
-        return iterator(mk<iterator_wrapper>(id, this, relation.end()));
+        return iterator(mk<iterator_wrapper<>>(id, this, relation.end()));
     }
 
     void insert(const tuple& arg) override {
@@ -125,9 +152,65 @@ public:
         }
         return relation.contains(t);
     }
+    void insertBatch(const RamDomain* data, std::size_t count, bool columnMajor = false) override {
+        TupleType t;
+        auto ctxt = relation.createContext();
+        for (std::size_t i = 0; i < count; i++) {
+            for (std::size_t j = 0; j < Arity; j++) {
+                t[j] = columnMajor ? data[j * count + i] : data[i * Arity + j];
+            }
+            relation.insert(t, ctxt);
+        }
+    }
+    void scanBatch(const std::function<void(const RamDomain*, std::size_t)>& consumer, std::size_t batchSize,
+            bool columnMajor = false) const override {
+        scanBatches(relation.begin(), relation.end(), Arity, consumer, batchSize, columnMajor);
+    }
+    souffle::range<iterator> lookup(
+            const std::string& pattern, const tuple& lower, const tuple& upper) const override {
+        if constexpr (has_lookup<RelType>::value) {
+            assert(pattern.size() == Arity && "wrong pattern length");
+            TupleType low;
+            TupleType high;
+            for (std::size_t i = 0; i < Arity; i++) {
+                if (pattern[i] != 'f') {
+                    low[i] = lower[i];
+                    high[i] = pattern[i] == 'b' ? lower[i] : upper[i];
+                    continue;
+                }
+                // free attributes span all values in the order of their type
+                switch (*attrTypes[i]) {
+                    case 'f':
+                        low[i] = ramBitCast(-std::numeric_limits<RamFloat>::infinity());
+                        high[i] = ramBitCast(std::numeric_limits<RamFloat>::infinity());
+                        break;
+                    case 'u':
+                        low[i] = ramBitCast(MIN_RAM_UNSIGNED);
+                        high[i] = ramBitCast(MAX_RAM_UNSIGNED);
+                        break;
+                    default:
+                        low[i] = MIN_RAM_SIGNED;
+                        high[i] = MAX_RAM_SIGNED;
+                }
+            }
+            std::optional<souffle::range<iterator>> result;
+            relation.lookup(pattern, low, high, [&](auto range) {
+                using Iter = std::decay_t<decltype(range.begin())>;
+                result.emplace(iterator(mk<iterator_wrapper<Iter>>(id, this, range.begin())),
+                        iterator(mk<iterator_wrapper<Iter>>(id, this, range.end())));
+            });
+            if (result) {
+                return *result;
+            }
+        }
+        return Relation::lookup(pattern, lower, upper);
+    }
     std::size_t size() const override {
         return relation.size();
     }
+    std::vector<std::size_t> getIndexMemoryUsage() const override {
+        return relation.getIndexMemoryUsage();
+    }
     std::string getName() const override {
         return name;
     }
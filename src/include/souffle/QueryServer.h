@@ -0,0 +1,394 @@
+/*
+ * Souffle - A Datalog Compiler
+ * Copyright (c) 2026, The Souffle Developers. All rights reserved
+ * Licensed under the Universal Permissive License v 1.0 as shown at:
+ * - https://opensource.org/licenses/UPL
+ * - <souffle root>/licenses/SOUFFLE-UPL.txt
+ */
+
+/************************************************************************
+ *
+ * @file QueryServer.h
+ *
+ * Answers queries over the relations of an evaluated program; works for
+ * compiler and interpreter.
+ *
+ * The server reads one command per line and answers every command with the
+ * matching lines followed by a line "end <n>", or with a single line
+ * "error: <message>":
+ *
+ *   edge("a", X)     print the tuples of edge whose first attribute is "a"
+ *   size edge        print the number of tuples of edge
+ *   relations        print the names and signatures of all relations
+ *   quit             stop the server
+ *
+ * Constants of a query are bound, variables and `_` are free; the resulting
+ * binding pattern selects an index of the relation, so a query only visits
+ * the tuples it returns.
+ *
+ ***********************************************************************/
+
+#pragma once
+
+#include "souffle/RamTypes.h"
+#include "souffle/SouffleInterface.h"
+#include "souffle/SymbolTable.h"
+#include <cctype>
+#include <cstddef>
+#include <iostream>
+#include <map>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#ifndef _MSC_VER
+#include <cerrno>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+#endif
+
+namespace souffle {
+
+class QueryServer {
+public:
+    explicit QueryServer(SouffleProgram& prog) : prog(prog) {}
+
+    /** Answer the commands read from the input stream until it ends or a quit command is processed */
+    void serve(std::istream& in, std::ostream& out) {
+        std::string line;
+        while (running && std::getline(in, line)) {
+            processCommand(line, out);
+            out.flush();
+        }
+    }
+
+#ifndef _MSC_VER
+    /**
+     * Answer the commands of clients connecting to a Unix domain socket at the given path, one
+     * client at a time, until a quit command is processed.
+     */
+    void serve(const std::string& path) {
+        sockaddr_un address{};
+        if (path.size() >= sizeof(address.sun_path)) {
+            throw std::invalid_argument("Socket path is too long: " + path);
+        }
+        address.sun_family = AF_UNIX;
+        path.copy(address.sun_path, path.size());
+
+        const int server = socket(AF_UNIX, SOCK_STREAM, 0);
+        if (server < 0) {
+            throw std::runtime_error("Cannot create socket " + path);
+        }
+        unlink(path.c_str());
+        if (bind(server, reinterpret_cast<sockaddr*>(&address), sizeof(address)) < 0 ||
+                listen(server, 1) < 0) {
+            close(server);
+            throw std::runtime_error("Cannot listen on socket " + path);
+        }
+
+        while (running) {
+            const int client = accept(server, nullptr, nullptr);
+            if (client < 0) {
+                if (errno == EINTR) {
+                    continue;
+                }
+                break;
+            }
+            serveClient(client);
+            close(client);
+        }
+        close(server);
+        unlink(path.c_str());
+    }
+#endif
+
+    /**
+     * Process a single command and write the answer.
+     *
+     * @return false, if the command stops the server
+     */
+    bool processCommand(const std::string& line, std::ostream& out) {
+        const std::string command = trim(line);
+        if (command.empty()) {
+            return running;
+        }
+        try {
+            if (command == "quit" || command == "exit") {
+                running = false;
+            } else if (command == "relations") {
+                std::size_t count = 0;
+                for (Relation* rel : prog.getAllRelations()) {
+                    out << rel->getName() << "\t" << rel->getSignature() << "\n";
+                    ++count;
+                }
+                out << "end " << count << "\n";
+            } else if (command.compare(0, 5, "size ") == 0) {
+                out << getRelation(trim(command.substr(5))).size() << "\nend 1\n";
+            } else {
+                query(command, out);
+            }
+        } catch (const std::exception& e) {
+            out << "error: " << e.what() << "\n";
+        }
+        return running;
+    }
+
+private:
+    /** Answer a query of the form name(arg, ...) */
+    void query(const std::string& command, std::ostream& out) {
+        const std::size_t open = command.find('(');
+        if (open == std::string::npos || command.back() != ')') {
+            throw std::invalid_argument("expected a query of the form relation(arg, ...)");
+        }
+        const Relation& rel = getRelation(trim(command.substr(0, open)));
+        const std::vector<std::string> args =
+                splitArguments(command.substr(open + 1, command.size() - open - 2));
+        const std::size_t arity = rel.getPrimaryArity();
+        if (args.size() != arity) {
+            throw std::invalid_argument("relation " + rel.getName() + " has " + std::to_string(arity) +
+                                        " attributes, but the query has " + std::to_string(args.size()));
+        }
+
+        // Constants are bound, and repeated variables are checked on the matching tuples
+        std::string pattern(rel.getArity(), 'f');
+        tuple lower(&rel);
+        tuple upper(&rel);
+        std::map<std::string, std::size_t> variables;
+        std::vector<std::pair<std::size_t, std::size_t>> equalities;
+        for (std::size_t i = 0; i < arity; ++i) {
+            const std::string& arg = args[i];
+            if (isVariable(rel, i, arg)) {
+                if (arg != "_") {
+                    auto [pos, inserted] = variables.insert({arg, i});
+                    if (!inserted) {
+                        equalities.push_back({pos->second, i});
+                    }
+                }
+                continue;
+            }
+            RamDomain value;
+            if (!encode(rel, i, arg, value)) {
+                // a symbol that does not occur in the program cannot occur in a tuple
+                out << "end 0\n";
+                return;
+            }
+            pattern[i] = 'b';
+            lower[i] = value;
+            upper[i] = value;
+        }
+
+        std::size_t count = 0;
+        for (const tuple& t : rel.lookup(pattern, lower, upper)) {
+            bool matches = true;
+            for (const auto& [first, second] : equalities) {
+                matches = matches && t[first] == t[second];
+            }
+            if (!matches) {
+                continue;
+            }
+            for (std::size_t i = 0; i < arity; ++i) {
+                out << (i == 0 ? "" : "\t") << decode(rel, i, t[i]);
+            }
+            out << "\n";
+            ++count;
+        }
+        out << "end " << count << "\n";
+    }
+
+    const Relation& getRelation(const std::string& name) const {
+        const Relation* rel = prog.getRelation(name);
+        if (rel == nullptr) {
+            throw std::invalid_argument("unknown relation " + name);
+        }
+        return *rel;
+    }
+
+    /** Encode a constant of the given attribute; returns false for symbols unknown to the program */
+    static bool encode(const Relation& rel, std::size_t pos, const std::string& arg, RamDomain& value) {
+        const char type = *rel.getAttrType(pos);
+        if (type == 's') {
+            if (arg.size() < 2 || arg.front() != '"' || arg.back() != '"') {
+                throw std::invalid_argument("expected a quoted symbol for attribute " +
+                                            std::string(rel.getAttrName(pos)));
+            }
+            const std::string symbol = unescape(arg.substr(1, arg.size() - 2));
+            SymbolTable& symbols = rel.getSymbolTable();
+            if (!symbols.weakContains(symbol)) {
+                return false;
+            }
+            value = symbols.encode(symbol);
+            return true;
+        }
+
+        if (type != 'i' && type != 'u' && type != 'f') {
+            throw std::invalid_argument("records and ADTs can only be queried with variables");
+        }
+        std::size_t end = 0;
+        try {
+            switch (type) {
+                case 'i': value = ramBitCast(static_cast<RamSigned>(std::stoll(arg, &end))); break;
+                case 'u': value = ramBitCast(static_cast<RamUnsigned>(std::stoull(arg, &end))); break;
+                default: value = ramBitCast(static_cast<RamFloat>(std::stod(arg, &end))); break;
+            }
+        } catch (const std::logic_error&) {
+            end = 0;
+        }
+        if (end == 0 || end != arg.size()) {
+            throw std::invalid_argument("invalid constant " + arg + " for attribute " +
+                                        std::string(rel.getAttrName(pos)));
+        }
+        return true;
+    }
+
+    static std::string decode(const Relation& rel, std::size_t pos, RamDomain value) {
+        switch (*rel.getAttrType(pos)) {
+            case 's': return rel.getSymbolTable().decode(value);
+            case 'u': return std::to_string(ramBitCast<RamUnsigned>(value));
+            case 'f': {
+                std::stringstream ss;
+                ss << ramBitCast<RamFloat>(value);
+                return ss.str();
+            }
+            default: return std::to_string(value);
+        }
+    }
+
+    /** Check whether an argument is a variable; the special values of floats are constants */
+    static bool isVariable(const Relation& rel, std::size_t pos, const std::string& arg) {
+        if (*rel.getAttrType(pos) == 'f' && isFloatKeyword(arg)) {
+            return false;
+        }
+        return !arg.empty() && (std::isalpha(static_cast<unsigned char>(arg[0])) != 0 || arg[0] == '_');
+    }
+
+    /** Check whether an argument names an infinite or undefined float, as accepted by std::stod */
+    static bool isFloatKeyword(const std::string& arg) {
+        std::string lower;
+        for (const char c : arg) {
+            lower += static_cast<char>(std::tolower(static_cast<unsigned char>(c)));
+        }
+        return lower == "inf" || lower == "infinity" || lower == "nan";
+    }
+
+    /** Resolve the escaped quotes and backslashes of a quoted symbol */
+    static std::string unescape(const std::string& symbol) {
+        std::string result;
+        for (std::size_t i = 0; i < symbol.size(); ++i) {
+            const bool escape = symbol[i] == '\\' && i + 1 < symbol.size();
+            if (escape && (symbol[i + 1] == '"' || symbol[i + 1] == '\\')) {
+                ++i;
+            }
+            result += symbol[i];
+        }
+        return result;
+    }
+
+    /** Split the arguments of a query at commas outside of quoted symbols */
+    static std::vector<std::string> splitArguments(const std::string& args) {
+        std::vector<std::string> result;
+        if (trim(args).empty()) {
+            return result;
+        }
+        std::string current;
+        bool quoted = false;
+        for (std::size_t i = 0; i < args.size(); ++i) {
+            const char c = args[i];
+            if (quoted && c == '\\' && i + 1 < args.size()) {
+                // keep escaped characters, in particular quotes, for unescape()
+                current += c;
+                current += args[++i];
+                continue;
+            }
+            if (c == '"') {
+                quoted = !quoted;
+            }
+            if (c == ',' && !quoted) {
+                result.push_back(trim(current));
+                current.clear();
+            } else {
+                current += c;
+            }
+        }
+        if (quoted) {
+            throw std::invalid_argument("unterminated symbol");
+        }
+        result.push_back(trim(current));
+        return result;
+    }
+
+    static std::string trim(const std::string& str) {
+        const std::size_t first = str.find_first_not_of(" \t\r\n");
+        if (first == std::string::npos) {
+            return "";
+        }
+        return str.substr(first, str.find_last_not_of(" \t\r\n") - first + 1);
+    }
+
+#ifndef _MSC_VER
+    /** Answer the commands of a connected client until it disconnects */
+    void serveClient(int client) {
+        std::string buffer;
+        char chunk[4096];
+        while (running) {
+            const ssize_t received = read(client, chunk, sizeof(chunk));
+            if (received < 0 && errno == EINTR) {
+                continue;
+            }
+            if (received <= 0) {
+                return;
+            }
+            buffer.append(chunk, static_cast<std::size_t>(received));
+            std::size_t newline;
+            while (running && (newline = buffer.find('\n')) != std::string::npos) {
+                std::stringstream answer;
+                processCommand(buffer.substr(0, newline), answer);
+                buffer.erase(0, newline + 1);
+                if (!sendAll(client, answer.str())) {
+                    return;
+                }
+            }
+        }
+    }
+
+    static bool sendAll(int client, const std::string& data) {
+        std::size_t sent = 0;
+        while (sent < data.size()) {
+            const ssize_t n = write(client, data.data() + sent, data.size() - sent);
+            if (n < 0 && errno == EINTR) {
+                continue;
+            }
+            if (n <= 0) {
+                return false;
+            }
+            sent += static_cast<std::size_t>(n);
+        }
+        return true;
+    }
+#endif
+
+    SouffleProgram& prog;
+    bool running = true;
+};
+
+/**
+ * Serve queries over the relations of an evaluated program.
+ *
+ * @param prog The evaluated program
+ * @param where "-" to read commands from the standard input, or the path of a Unix domain socket
+ */
+inline void serveQueries(SouffleProgram& prog, const std::string& where) {
+    QueryServer server(prog);
+    if (where == "-") {
+        server.serve(std::cin, std::cout);
+        return;
+    }
+#ifndef _MSC_VER
+    server.serve(where);
+#else
+    throw std::invalid_argument("Query server sockets are not supported on this platform");
+#endif
+}
+
+}  // namespace souffle
@@ -20,6 +20,7 @@
 #include "souffle/RamTypes.h"
 #include "souffle/utility/span.h"
 
+#include <cstddef>
 #include <functional>
 #include <initializer_list>
 
@@ -41,6 +42,11 @@ public:
     /// Enumerate each record.
     virtual void enumerate(const std::function<void(const RamDomain* /*tuple*/, std::size_t /* arity*/,
                     RamDomain /* key */)>& Callback) const = 0;
+
+    /// Return the number of bytes held by the record table, including the records, or 0 if unknown.
+    virtual std::size_t getMemoryUsage() const {
+        return 0;
+    }
 };
 
 /** @brief helper to convert tuple to record reference for the synthesiser */
@@ -25,6 +25,7 @@
 #include <cassert>
 #include <cstddef>
 #include <cstdint>
+#include <functional>
 #include <initializer_list>
 #include <iostream>
 #include <map>
@@ -285,6 +286,93 @@ public:
         }
     };
 
+protected:
+    /**
+     * Iterator over the tuples of another iterator that match a binding pattern.
+     * Used to answer lookups for which the relation has no suitable index.
+     */
+    class filter_iterator : public iterator_base {
+    public:
+        /** The binding pattern and its boundaries, see lookup() */
+        struct Filter {
+            std::string pattern;
+            std::string types;
+            std::vector<RamDomain> lower;
+            std::vector<RamDomain> upper;
+
+            bool operator()(const tuple& t) const;
+        };
+
+        filter_iterator(iterator cur, iterator end, std::shared_ptr<const Filter> filter)
+                : iterator_base(0), cur(std::move(cur)), end(std::move(end)), filter(std::move(filter)) {
+            skip();
+        }
+
+        void operator++() override {
+            ++cur;
+            skip();
+        }
+
+        tuple& operator*() override {
+            return *cur;
+        }
+
+        iterator_base* clone() const override {
+            return new filter_iterator(*this);
+        }
+
+    protected:
+        bool equal(const iterator_base& o) const override {
+            const auto* other = dynamic_cast<const filter_iterator*>(&o);
+            return other != nullptr && cur == other->cur;
+        }
+
+    private:
+        /** Advance to the next matching tuple */
+        void skip() {
+            while (cur != end && !(*filter)(*cur)) {
+                ++cur;
+            }
+        }
+
+        iterator cur;
+        iterator end;
+        std::shared_ptr<const Filter> filter;
+    };
+
+    /**
+     * Pass the tuples between two iterators to a consumer in batches, as described for scanBatch.
+     * Relations whose own iterators are cheaper than the virtual iterator use it to override scanBatch.
+     *
+     * @param it Iterator to the first tuple, dereferencing to an indexable tuple
+     * @param end Iterator past the last tuple
+     * @param arity Number of attributes of the tuples
+     */
+    template <class Iter>
+    static void scanBatches(Iter it, const Iter& end, std::size_t arity,
+            const std::function<void(const RamDomain*, std::size_t)>& consumer, std::size_t batchSize,
+            bool columnMajor) {
+        assert(batchSize > 0 && "empty batches");
+        std::vector<RamDomain> batch(batchSize * arity);
+        while (it != end) {
+            std::size_t count = 0;
+            for (; it != end && count < batchSize; ++it, ++count) {
+                const auto& value = *it;
+                for (std::size_t j = 0; j < arity; j++) {
+                    batch[columnMajor ? j * batchSize + count : count * arity + j] = value[j];
+                }
+            }
+            if (columnMajor && count < batchSize) {
+                // close the gaps left by the columns of a partial batch
+                for (std::size_t j = 1; j < arity; j++) {
+                    std::copy_n(&batch[j * batchSize], count, &batch[j * count]);
+                }
+            }
+            consumer(batch.data(), count);
+        }
+    }
+
+public:
     /**
      * Insert a new tuple into the relation.
      * The definition of insert function has to be defined by the child class of relation class.
@@ -302,6 +390,69 @@ public:
      */
     virtual bool contains(const tuple& t) const = 0;
 
+    /**
+     * Insert a batch of tuples stored in a contiguous array.
+     * The array holds all attributes of the relation, including auxiliary ones. In row-major
+     * layout attribute j of tuple i is at data[i * arity + j], in column-major layout it is at
+     * data[j * count + i]. Symbols must already be encoded, see SymbolTable::encodeBatch.
+     *
+     * @param data Pointer to the first element of the array
+     * @param count Number of tuples in the array
+     * @param columnMajor Whether the array is stored column by column
+     */
+    virtual void insertBatch(const RamDomain* data, std::size_t count, bool columnMajor = false);
+
+    /**
+     * Pass all tuples of a relation to a consumer in batches of at most batchSize tuples.
+     * Each batch has the layout described for insertBatch, with count being the number of
+     * tuples in the batch. The batch is only valid during the call of the consumer.
+     *
+     * @param consumer Function receiving a pointer to each batch and the number of its tuples
+     * @param batchSize Maximal number of tuples in a batch
+     * @param columnMajor Whether batches are stored column by column
+     */
+    virtual void scanBatch(const std::function<void(const RamDomain*, std::size_t)>& consumer,
+            std::size_t batchSize, bool columnMajor = false) const;
+
+    /**
+     * Return the tuples of a relation matching a binding pattern.
+     * The pattern holds one character per attribute: 'b' if the attribute is bound to its value in
+     * lower, 'r' if it ranges over the interval [lower, upper], and 'f' if it is free. Intervals
+     * compare floats and unsigned numbers by value and all other attributes as signed numbers.
+     * The lookup uses an index of the relation if one starts with the bound attributes, followed
+     * by at most one ranging attribute; otherwise it scans the relation.
+     *
+     * @param pattern Binding pattern, e.g. "bf" for the tuples with a given first attribute
+     * @param lower Tuple holding the bound values and the lower boundaries of the intervals
+     * @param upper Tuple holding the upper boundaries of the intervals
+     * @return Range of the matching tuples
+     */
+    virtual souffle::range<iterator> lookup(
+            const std::string& pattern, const tuple& lower, const tuple& upper) const;
+
+    /**
+     * Check whether an index with the given lexicographical order answers lookups with the given
+     * binding pattern, i.e., it starts with the bound attributes followed by at most one ranging one.
+     *
+     * @param pattern Binding pattern, see lookup()
+     * @param order Attributes in the order of the index
+     * @return Boolean. True, if the matching tuples form a contiguous range of the index
+     */
+    template <typename Order>
+    static bool coversPattern(const std::string& pattern, const Order& order) {
+        const auto bound = static_cast<std::size_t>(std::count(pattern.begin(), pattern.end(), 'b'));
+        const auto ranged = static_cast<std::size_t>(std::count(pattern.begin(), pattern.end(), 'r'));
+        if (ranged > 1 || order.size() < bound + ranged) {
+            return false;
+        }
+        for (std::size_t i = 0; i < bound + ranged; ++i) {
+            if (pattern[order[i]] != (i < bound ? 'b' : 'r')) {
+                return false;
+            }
+        }
+        return true;
+    }
+
     /**
      * Return an iterator pointing to the first tuple of the relation.
      * This iterator is used to access the tuples of the relation.
@@ -324,6 +475,30 @@ public:
      */
     virtual std::size_t size() const = 0;
 
+    /**
+     * Get the memory occupied by each index of a relation.
+     *
+     * Relations that do not account for their memory report no indexes.
+     *
+     * @return The number of bytes held by each index of a relation (std::vector<std::size_t>)
+     */
+    virtual std::vector<std::size_t> getIndexMemoryUsage() const {
+        return {};
+    }
+
+    /**
+     * Get the memory occupied by a relation.
+     *
+     * @return The number of bytes held by all indexes of a relation (std::size_t)
+     */
+    std::size_t getMemoryUsage() const {
+        std::size_t bytes = 0;
+        for (std::size_t index : getIndexMemoryUsage()) {
+            bytes += index;
+        }
+        return bytes;
+    }
+
     /**
      * Get the name of a relation.
      *
@@ -690,6 +865,66 @@ public:
     }
 };
 
+inline void Relation::insertBatch(const RamDomain* data, std::size_t count, bool columnMajor) {
+    const arity_type arity = getArity();
+    tuple t(this);
+    for (std::size_t i = 0; i < count; ++i) {
+        for (arity_type j = 0; j < arity; ++j) {
+            t[j] = columnMajor ? data[j * count + i] : data[i * arity + j];
+        }
+        insert(t);
+    }
+}
+
+inline bool Relation::filter_iterator::Filter::operator()(const tuple& t) const {
+    for (std::size_t i = 0; i < pattern.size(); ++i) {
+        if (pattern[i] == 'b' && t[i] != lower[i]) {
+            return false;
+        }
+        if (pattern[i] != 'r') {
+            continue;
+        }
+        switch (types[i]) {
+            case 'f':
+                if (ramBitCast<RamFloat>(t[i]) < ramBitCast<RamFloat>(lower[i]) ||
+                        ramBitCast<RamFloat>(upper[i]) < ramBitCast<RamFloat>(t[i])) {
+                    return false;
+                }
+                break;
+            case 'u':
+                if (ramBitCast<RamUnsigned>(t[i]) < ramBitCast<RamUnsigned>(lower[i]) ||
+                        ramBitCast<RamUnsigned>(upper[i]) < ramBitCast<RamUnsigned>(t[i])) {
+                    return false;
+                }
+                break;
+            default:
+                if (t[i] < lower[i] || upper[i] < t[i]) {
+                    return false;
+                }
+        }
+    }
+    return true;
+}
+
+inline souffle::range<Relation::iterator> Relation::lookup(
+        const std::string& pattern, const tuple& lower, const tuple& upper) const {
+    assert(pattern.size() == getArity() && "wrong pattern length");
+    auto filter = std::make_shared<filter_iterator::Filter>();
+    filter->pattern = pattern;
+    for (arity_type i = 0; i < getArity(); ++i) {
+        filter->types.push_back(*getAttrType(i));
+        filter->lower.push_back(lower[i]);
+        filter->upper.push_back(upper[i]);
+    }
+    return {iterator(mk<filter_iterator>(begin(), end(), filter)),
+            iterator(mk<filter_iterator>(end(), end(), filter))};
+}
+
+inline void Relation::scanBatch(const std::function<void(const RamDomain*, std::size_t)>& consumer,
+        std::size_t batchSize, bool columnMajor) const {
+    scanBatches(begin(), end(), getArity(), consumer, batchSize, columnMajor);
+}
+
 /**
  * Abstract base class for generated Datalog programs.
  */
@@ -940,6 +1175,19 @@ public:
      */
     virtual RecordTable& getRecordTable() = 0;
 
+    /**
+     * Get the memory occupied by all relations, the symbol table and the record table of the program.
+     *
+     * @return The number of bytes held by the program (std::size_t)
+     */
+    std::size_t getMemoryUsage() {
+        std::size_t bytes = getSymbolTable().getMemoryUsage() + getRecordTable().getMemoryUsage();
+        for (Relation* relation : allRelations) {
+            bytes += relation->getMemoryUsage();
+        }
+        return bytes;
+    }
+
     /**
      * Remove all the tuples from the outputRelations, calling the purge method of each.
      *
@@ -18,6 +18,7 @@
 
 #include "souffle/RamTypes.h"
 
+#include <cstddef>
 #include <memory>
 #include <string>
 
@@ -117,6 +118,20 @@ public:
     /** @brief Decode a symbol index to a symbol; aliases decode. */
     virtual const std::string& unsafeDecode(const RamDomain index) const = 0;
 
+    /** @brief Encode count symbols into the given array of symbol indices. */
+    virtual void encodeBatch(const std::string* symbols, std::size_t count, RamDomain* indices) {
+        for (std::size_t i = 0; i < count; ++i) {
+            indices[i] = encode(symbols[i]);
+        }
+    }
+
+    /** @brief Decode count symbol indices into the given array of symbols. */
+    virtual void decodeBatch(const RamDomain* indices, std::size_t count, std::string* symbols) const {
+        for (std::size_t i = 0; i < count; ++i) {
+            symbols[i] = decode(indices[i]);
+        }
+    }
+
     /**
      * @brief Encode the symbol, it is inserted if it does not exist.
      *
@@ -124,6 +139,11 @@ public:
      * happened.
      */
     virtual std::pair<RamDomain, bool> findOrInsert(const std::string& symbol) = 0;
+
+    /** @brief Return the number of bytes held by the symbol table, including the symbols, or 0 if unknown. */
+    virtual std::size_t getMemoryUsage() const {
+        return 0;
+    }
 };
 
 }  // namespace souffle
@@ -18,11 +18,14 @@
 #pragma once
 
 #include "souffle/datastructure/BTreeUtil.h"
+#include "souffle/datastructure/NodeArena.h"
 #include "souffle/utility/CacheUtil.h"
 #include "souffle/utility/ContainerUtil.h"
 #include "souffle/utility/MiscUtil.h"
 #include "souffle/utility/ParallelUtil.h"
 #include <algorithm>
+#include <array>
+#include <atomic>
 #include <cassert>
 #include <cstddef>
 #include <cstdint>
@@ -38,19 +41,34 @@ namespace souffle {
 
 namespace detail {
 
+/**
+ * The node storage of b-trees allocating each node on the heap.
+ */
+struct heap_node_storage {
+    struct Scope {
+        explicit Scope(heap_node_storage&) {}
+    };
+
+    void release() {}
+
+    void swap(heap_node_storage&) {}
+};
+
 /**
  * The actual implementation of a b-tree data structure.
  *
  * @tparam Key             .. the element type to be stored in this tree
  * @tparam Comparator     .. a class defining an order on the stored elements
- * @tparam Allocator     .. utilized for allocating memory for required nodes
+ * @tparam Allocator     .. utilized for allocating memory for required nodes; a NodeArena
+ *                           allocates the nodes of a tree from per-thread slabs, other types
+ *                           allocate each node on the heap
  * @tparam blockSize    .. determines the number of bytes/block utilized by leaf nodes
  * @tparam SearchStrategy .. enables switching between linear, binary or any other search strategy
  * @tparam isSet        .. true = set, false = multiset
  */
 template <typename Key, typename Comparator,
-        typename Allocator,  // is ignored so far - TODO: add support
-        unsigned blockSize, typename SearchStrategy, bool isSet, typename WeakComparator = Comparator,
+        typename Allocator, unsigned blockSize, typename SearchStrategy, bool isSet,
+        typename WeakComparator = Comparator,
         typename Updater = detail::updater<Key>>
 class btree {
 public:
@@ -95,6 +113,26 @@ protected:
         return upd.update(old_k, new_k);
     }
 
+    /* -------------- node allocation ----------------- */
+
+    // whether the nodes of this tree are allocated from an arena
+    static constexpr bool hasArena = std::is_same_v<Allocator, NodeArena>;
+
+    static_assert(!hasArena || std::is_trivially_destructible_v<Key>,
+            "nodes in an arena are released without destructing their keys");
+
+    using node_storage = std::conditional_t<hasArena, NodeArena, heap_node_storage>;
+
+    // creates a node, in the arena of the current scope if nodes are allocated from an arena
+    template <typename Node>
+    static Node* newNode() {
+        if constexpr (hasArena) {
+            return new (NodeArena::current().allocate(sizeof(Node), alignof(Node))) Node();
+        } else {
+            return new Node();
+        }
+    }
+
     /* -------------- the node type ----------------- */
 
     using size_type = std::size_t;
@@ -114,7 +152,7 @@ protected:
         node* volatile parent;
 
         // a lock for synchronizing parallel operations on this node
-        lock_type lock;
+        mutable lock_type lock;
 
         // the number of keys in this node
         volatile size_type numElements;
@@ -190,8 +228,8 @@ protected:
          */
         node* clone() const {
             // create a clone of this node
-            node* res = (this->isInner()) ? static_cast<node*>(new inner_node())
-                                          : static_cast<node*>(new leaf_node());
+            node* res = (this->isInner()) ? static_cast<node*>(newNode<inner_node>())
+                                          : static_cast<node*>(newNode<leaf_node>());
 
             // copy basic fields
             res->position = this->position;
@@ -269,13 +307,65 @@ protected:
             if (this->isLeaf()) {
                 return this->numElements;
             }
-            size_type sum = this->numElements;
-            for (unsigned i = 0; i <= this->numElements; ++i) {
-                sum += getChild(i)->countEntries();
+            return sumChildren([](const node& child) { return child.countEntries(); });
+        }
+
+        /**
+         * Sums the number of keys of this inner node and the given count of
+         * each of its children. The children are read under a read lease, since
+         * insertions may split this node concurrently; the nodes they refer to
+         * stay valid until the tree is cleared.
+         */
+        template <typename F>
+        size_type sumChildren(const F& count) const {
+            std::array<const node*, maxKeys + 1> children;
+            size_type numKeys = 0;
+#ifdef IS_PARALLEL
+            bool consistent = false;
+            while (!consistent) {
+                auto lease = this->lock.start_read();
+                const size_type current = this->numElements;
+                numKeys = std::min<size_type>(current, maxKeys);
+                for (unsigned i = 0; i <= numKeys; ++i) {
+                    children[i] = getChild(i);
+                }
+                consistent = this->lock.validate(lease);
+            }
+#else
+            numKeys = this->numElements;
+            for (unsigned i = 0; i <= numKeys; ++i) {
+                children[i] = getChild(i);
+            }
+#endif
+            size_type sum = numKeys;
+            for (unsigned i = 0; i <= numKeys; ++i) {
+                sum += count(*children[i]);
             }
             return sum;
         }
 
+        /**
+         * Counts the number of entries contained in the sub-tree rooted
+         * by this node like countEntries(), caching the count of every
+         * inner node on the way.
+         */
+        size_type cacheSubtreeSizes() const {
+            if (this->isLeaf()) {
+                return this->numElements;
+            }
+            const size_type sum = sumChildren([](const node& child) { return child.cacheSubtreeSizes(); });
+            asInnerNode().subtreeSize = sum;
+            return sum;
+        }
+
+        /**
+         * Obtains the number of entries in the sub-tree rooted by this
+         * node, as cached by the last call to cacheSubtreeSizes().
+         */
+        size_type getSubtreeSize() const {
+            return (this->isLeaf()) ? this->numElements : asInnerNode().subtreeSize;
+        }
+
         /**
          * Determines the amount of memory used by the sub-tree rooted
          * by this node.
@@ -362,8 +452,8 @@ protected:
             int split_point = getSplitPoint(idx);
 
             // create a new sibling node
-            node* sibling = (this->inner) ? static_cast<node*>(new inner_node())
-                                          : static_cast<node*>(new leaf_node());
+            node* sibling = (this->inner) ? static_cast<node*>(newNode<inner_node>())
+                                          : static_cast<node*>(newNode<leaf_node>());
 
 #ifdef IS_PARALLEL
             // lock sibling
@@ -541,7 +631,7 @@ protected:
                 assert(*root == this);
 
                 // create a new root node
-                auto* new_root = new inner_node();
+                auto* new_root = newNode<inner_node>();
                 new_root->numElements = 1;
                 new_root->keys[0] = keys[this->numElements];
 
@@ -869,6 +959,9 @@ protected:
         // references to child nodes owned by this node
         node* children[node::maxKeys + 1];
 
+        // the number of entries in the sub-tree rooted by this node, see btree::updateSubtreeSizes()
+        mutable size_type subtreeSize = 0;
+
         // a simple default constructor initializing member fields
         inner_node() : node(true) {}
 
@@ -902,6 +995,8 @@ public:
      * The iterator type to be utilized for scanning through btree instances.
      */
     class iterator {
+        friend class btree;
+
         // a pointer to the node currently referred to
         node const* cur;
 
@@ -1038,6 +1133,9 @@ protected:
     // a pointer to the left-most node of this tree (initial note for iteration)
     leaf_node* leftmost;
 
+    // the storage of the nodes of this tree
+    node_storage nodes;
+
     /* -------------- operator hint statistics ----------------- */
 
     // an aggregation of statistical values of the hint utilization
@@ -1058,10 +1156,24 @@ protected:
     // the hint statistic of this b-tree instance
     mutable hint_statistics hint_stats;
 
+    /* -------------- order statistics ----------------- */
+
+    // the state of the sub-tree sizes cached in the inner nodes
+    enum class subtree_sizes : int { outdated, counting, valid };
+
+    // whether the sub-tree sizes cached in the inner nodes are up to date
+    mutable std::atomic<subtree_sizes> subtreeSizesState{subtree_sizes::outdated};
+
+    // a lock to synchronize the computation of the sub-tree sizes
+    mutable Lock subtreeSizesLock;
+
 public:
     // the maximum number of keys stored per node
     static constexpr std::size_t max_keys_per_node = node::maxKeys;
 
+    // the maximum size of the buffer of merged elements used by insertSorted()
+    static constexpr std::size_t max_merge_buffer_bytes = std::size_t(64) << 20;
+
     // -- ctors / dtors --
 
     // the default constructor creating an empty tree
@@ -1079,6 +1191,7 @@ public:
             : comp(other.comp), weak_comp(other.weak_comp), root(other.root), leftmost(other.leftmost) {
         other.root = nullptr;
         other.leftmost = nullptr;
+        nodes.swap(other.nodes);
     }
 
     // a copy constructor
@@ -1109,9 +1222,59 @@ public:
 
     // determines the number of elements in this tree
     size_type size() const {
+        if (subtreeSizesState.load(std::memory_order_acquire) == subtree_sizes::valid) {
+            return (root) ? root->getSubtreeSize() : 0;
+        }
         return (root) ? root->countEntries() : 0;
     }
 
+    /**
+     * Determines the number of elements preceding the given position.
+     *
+     * The first call after a modification of the tree counts the elements
+     * of all inner nodes, which takes time linear in the number of nodes;
+     * subsequent calls take logarithmic time until the tree is modified
+     * again. Concurrently to insertions, only the rank of the end iterator
+     * may be requested; it may miss elements being inserted, but counts
+     * cached while the tree is modified are discarded once it is.
+     */
+    size_type rank(const iterator& pos) const {
+        updateSubtreeSizes();
+
+        // the end iterator is preceded by all elements
+        const node* cur = pos.cur;
+        if (cur == nullptr) {
+            return (root) ? root->getSubtreeSize() : 0;
+        }
+
+        // elements in front of the position within the sub-tree of the current node
+        size_type res = pos.pos;
+        if (cur->isInner()) {
+            for (unsigned i = 0; i <= pos.pos; ++i) {
+                res += cur->getChild(i)->getSubtreeSize();
+            }
+        }
+
+        // elements in front of the sub-tree of the current node within its ancestors
+        while (cur->getParent() != nullptr) {
+            field_index_type position = cur->getPositionInParent();
+            cur = cur->getParent();
+            res += position;
+            for (unsigned i = 0; i < position; ++i) {
+                res += cur->getChild(i)->getSubtreeSize();
+            }
+        }
+        return res;
+    }
+
+    /**
+     * Determines the number of elements in the range [from, to) in
+     * logarithmic time; see rank() for the conditions.
+     */
+    size_type distance(const iterator& from, const iterator& to) const {
+        return rank(to) - rank(from);
+    }
+
     /**
      * Inserts the given key into this tree.
      */
@@ -1124,6 +1287,8 @@ public:
      * Inserts the given key into this tree.
      */
     bool insert(const Key& k, operation_hints& hints) {
+        [[maybe_unused]] subtree_sizes_invalidation invalidation(*this);
+
 #ifdef IS_PARALLEL
 
         // special handling for inserting first element
@@ -1142,7 +1307,8 @@ public:
             }
 
             // create new node
-            leftmost = new leaf_node();
+            typename node_storage::Scope scope(nodes);
+            leftmost = newNode<leaf_node>();
             leftmost->numElements = 1;
             leftmost->keys[0] = k;
             root = leftmost;
@@ -1340,8 +1506,11 @@ public:
 
                 // split this node
                 auto old_root = root;
-                idx -= cur->rebalance_or_split(
-                        const_cast<node**>(&root), root_lock, static_cast<int>(idx), parents);
+                {
+                    typename node_storage::Scope scope(nodes);
+                    idx -= cur->rebalance_or_split(
+                            const_cast<node**>(&root), root_lock, static_cast<int>(idx), parents);
+                }
 
                 // release parent lock
                 for (auto it = parents.rbegin(); it != parents.rend(); ++it) {
@@ -1393,7 +1562,8 @@ public:
         // special handling for inserting first element
         if (empty()) {
             // create new node
-            leftmost = new leaf_node();
+            typename node_storage::Scope scope(nodes);
+            leftmost = newNode<leaf_node>();
             leftmost->numElements = 1;
             leftmost->keys[0] = k;
             root = leftmost;
@@ -1466,7 +1636,10 @@ public:
 
             if (cur->numElements >= node::maxKeys) {
                 // split this node
-                idx -= cur->rebalance_or_split(&root, root_lock, static_cast<int>(idx));
+                {
+                    typename node_storage::Scope scope(nodes);
+                    idx -= cur->rebalance_or_split(&root, root_lock, static_cast<int>(idx));
+                }
 
                 // insert element in right fragment
                 if (((size_type)idx) > cur->numElements) {
@@ -1509,6 +1682,88 @@ public:
         }
     }
 
+    /**
+     * Inserts the given range of elements, which must be sorted in the order of this
+     * tree, and calls the given function on each element that was not present before.
+     *
+     * A range that is large compared to this tree is merged with the content of the
+     * tree in a single linear pass, building the nodes of the new tree bottom-up;
+     * a smaller range is inserted element by element, starting each search from the
+     * position of the previous insertion. Must not run concurrently to other operations.
+     *
+     * The merge trades memory for time: while the new tree is built, the old tree,
+     * a buffer of all merged elements and the new tree are held at once, about three
+     * times the size of the result. Merges whose buffer would exceed
+     * max_merge_buffer_bytes insert element by element instead.
+     */
+    template <typename Iter, typename F>
+    void insertSorted(const Iter& a, const Iter& b, F&& onInsert) {
+        // the merge requires elements updating each other to be adjacent in the order of the tree
+        constexpr bool canMerge = std::is_same_v<Comparator, WeakComparator>;
+        const size_type count = std::distance(a, b);
+        const size_type treeSize = size();
+
+        // merging copies the whole tree, inserting searches it once per element
+        size_type depth = 1;
+        for (size_type n = treeSize; n > 1; n >>= 1) {
+            ++depth;
+        }
+        const bool fitsBuffer = (treeSize + count) <= max_merge_buffer_bytes / sizeof(Key);
+        if (!canMerge || !fitsBuffer || count == 0 || count * depth < treeSize + count) {
+            operation_hints hints;
+            for (auto it = a; it != b; ++it) {
+                if (insert(*it, hints)) {
+                    onInsert(*it);
+                }
+            }
+            return;
+        }
+
+        std::vector<Key> merged;
+        merged.reserve(treeSize + count);
+        auto cur = begin();
+        const auto fin = end();
+        for (auto it = a; it != b; ++it) {
+            const Key& k = *it;
+            while (cur != fin && less(*cur, k)) {
+                merged.push_back(*cur);
+                ++cur;
+            }
+            if (isSet && ((cur != fin && equal(*cur, k)) || (!merged.empty() && equal(merged.back(), k)))) {
+                continue;
+            }
+            merged.push_back(k);
+            onInsert(k);
+        }
+        for (; cur != fin; ++cur) {
+            merged.push_back(*cur);
+        }
+
+        // replace the content by the tree built from the merged elements
+        node_storage newNodes;
+        node* newRoot;
+        {
+            typename node_storage::Scope scope(newNodes);
+            newRoot = buildSubTree(merged.begin(), merged.end() - 1);
+        }
+        clear();
+        nodes.swap(newNodes);
+        root = newRoot;
+        node* first = root;
+        while (!first->isLeaf()) {
+            first = first->getChild(0);
+        }
+        leftmost = static_cast<leaf_node*>(first);
+    }
+
+    /**
+     * Inserts the given range of elements, which must be sorted in the order of this tree.
+     */
+    template <typename Iter>
+    void insertSorted(const Iter& a, const Iter& b) {
+        insertSorted(a, b, [](const Key&) {});
+    }
+
     // Obtains an iterator referencing the first element of the tree.
     iterator begin() const {
         return iterator(leftmost, 0);
@@ -1735,7 +1990,10 @@ public:
      * Clears this tree.
      */
     void clear() {
-        if (root != nullptr) {
+        if constexpr (hasArena) {
+            // all nodes are released at once, without visiting them
+            nodes.release();
+        } else if (root != nullptr) {
             if (root->isLeaf()) {
                 delete static_cast<leaf_node*>(root);
             } else {
@@ -1744,6 +2002,7 @@ public:
         }
         root = nullptr;
         leftmost = nullptr;
+        invalidateSubtreeSizes();
     }
 
     /**
@@ -1755,6 +2014,12 @@ public:
         // swap the content
         std::swap(root, other.root);
         std::swap(leftmost, other.leftmost);
+        nodes.swap(other.nodes);
+
+        // the cached sub-tree sizes are stored in the nodes and move along
+        subtree_sizes state = subtreeSizesState.load();
+        subtreeSizesState = other.subtreeSizesState.load();
+        other.subtreeSizesState = state;
     }
 
     // Implementation of the assignment operation for trees.
@@ -1771,7 +2036,9 @@ public:
         }
 
         // clone content (deep copy)
+        typename node_storage::Scope scope(nodes);
         root = other.root->clone();
+        invalidateSubtreeSizes();
 
         // update leftmost reference
         auto tmp = root;
@@ -1827,6 +2094,9 @@ public:
 
     // Determines the amount of memory used by this data structure
     size_type getMemoryUsage() const {
+        if constexpr (hasArena) {
+            return sizeof(*this) - sizeof(nodes) + nodes.getMemoryUsage();
+        }
         return sizeof(*this) + (empty() ? 0 : root->getMemoryUsage());
     }
 
@@ -1904,7 +2174,12 @@ public:
         }
 
         // resolve tree recursively
-        auto root = buildSubTree(a, b - 1);
+        node_storage nodes;
+        node* root;
+        {
+            typename node_storage::Scope scope(nodes);
+            root = buildSubTree(a, b - 1);
+        }
 
         // find leftmost node
         node* leftmost = root;
@@ -1913,10 +2188,60 @@ public:
         }
 
         // build result
-        return R(b - a, root, static_cast<leaf_node*>(leftmost));
+        R res(b - a, root, static_cast<leaf_node*>(leftmost));
+        res.nodes.swap(nodes);
+        return res;
     }
 
 protected:
+    /**
+     * Caches the number of entries of every sub-tree in its root node
+     * unless the cached values are still up to date.
+     */
+    void updateSubtreeSizes() const {
+        if (subtreeSizesState.load(std::memory_order_acquire) == subtree_sizes::valid) {
+            return;
+        }
+        [[maybe_unused]] auto lease = subtreeSizesLock.acquire();
+        subtree_sizes state = subtree_sizes::outdated;
+        if (!subtreeSizesState.compare_exchange_strong(state, subtree_sizes::counting)) {
+            return;
+        }
+        if (root != nullptr) {
+            root->cacheSubtreeSizes();
+        }
+        // an insertion running meanwhile has reset the state, leaving the counts outdated
+        state = subtree_sizes::counting;
+        subtreeSizesState.compare_exchange_strong(state, subtree_sizes::valid, std::memory_order_release,
+                std::memory_order_relaxed);
+    }
+
+    /**
+     * Marks the cached sub-tree sizes as outdated; only writes the state if
+     * it is not outdated yet, to keep parallel insertions from contending on it.
+     */
+    void invalidateSubtreeSizes() const {
+        if (subtreeSizesState.load(std::memory_order_relaxed) != subtree_sizes::outdated) {
+            subtreeSizesState.store(subtree_sizes::outdated, std::memory_order_release);
+        }
+    }
+
+    /**
+     * Invalidates the cached sub-tree sizes before and after a modification of
+     * the tree, so that sizes counted while the tree was modified are discarded.
+     */
+    struct subtree_sizes_invalidation {
+        explicit subtree_sizes_invalidation(const btree& tree) : tree(tree) {
+            tree.invalidateSubtreeSizes();
+        }
+
+        ~subtree_sizes_invalidation() {
+            tree.invalidateSubtreeSizes();
+        }
+
+        const btree& tree;
+    };
+
     /**
      * Determines whether the range covered by the given node is also
      * covering the given key value.
@@ -1966,7 +2291,7 @@ private:
         // terminal case: length is less then maxKeys
         if (length <= N) {
             // create a leaf node
-            node* res = new leaf_node();
+            node* res = newNode<leaf_node>();
             res->numElements = length;
 
             for (int i = 0; i < length; ++i) {
@@ -1986,7 +2311,7 @@ private:
         }
 
         // create inner node
-        node* res = new inner_node();
+        node* res = newNode<inner_node>();
         res->numElements = numKeys;
 
         Iter c = a;
@@ -1087,6 +1087,9 @@ protected:
     lock_type root_lock;
 #endif
 
+    // a lock separating erasures in leaves from changes to the structure of the tree
+    ReadWriteLock structure_lock;
+
     // a pointer to the left-most node of this tree (initial note for iteration)
     leaf_node* leftmost;
 
@@ -1589,32 +1592,68 @@ public:
     /**
      * Erase the given key from the tree.
      * Return the number of erased keys.
+     *
+     * In parallel mode erasures may run concurrently with each other, but not with
+     * insertions or traversals. Keys of sets that can be removed from their leaf
+     * without merging or rebalancing it are erased under the lock of the leaf only;
+     * all other erasures change the structure of the tree and run exclusively.
      */
     size_type erase(const Key& k) {
-        if (empty()) {
-            return 0;
+#ifdef IS_PARALLEL
+        if (isSet) {
+            structure_lock.start_read();
+            const leaf_erase_result res = erase_in_leaf(k);
+            structure_lock.end_read();
+            if (res != leaf_erase_result::restructure) {
+                return res == leaf_erase_result::erased ? 1 : 0;
+            }
         }
+        structure_lock.start_write();
+        const size_type count = erase_exclusive(k);
+        structure_lock.end_write();
+        return count;
+#else
+        return erase_exclusive(k);
+#endif
+    }
+
+    /**
+     * Erase the keys of the given range from the tree.
+     * Return the number of erased keys.
+     *
+     * In parallel mode the keys that can be removed from their leaf are erased first,
+     * and those requiring a merge or rebalance are erased afterwards in a single
+     * exclusive phase.
+     */
+    template <typename Iter>
+    size_type erase(const Iter& a, const Iter& b) {
+        size_type count = 0;
+#ifdef IS_PARALLEL
         if (isSet) {
-            iterator iter = internal_find(k);
-            if (iter == end()) {
-                // Key not found
-                return 0;
-            } else {
-                erase(iter);
-                return 1;
+            std::vector<Key> deferred;
+            structure_lock.start_read();
+            for (auto it = a; it != b; ++it) {
+                switch (erase_in_leaf(*it)) {
+                    case leaf_erase_result::erased: ++count; break;
+                    case leaf_erase_result::restructure: deferred.push_back(*it); break;
+                    case leaf_erase_result::missing: break;
+                }
             }
-        } else {
-            iterator lower_iter = internal_lower_bound(k);
-            if (lower_iter != end() && equal(*lower_iter, k)) {
-                size_type count = std::distance(lower_iter, internal_upper_bound(k));
-                for (size_type i = 0; i < count; i++) {
-                    erase(lower_iter);
+            structure_lock.end_read();
+            if (!deferred.empty()) {
+                structure_lock.start_write();
+                for (const Key& k : deferred) {
+                    count += erase_exclusive(k);
                 }
-                return count;
-            } else {
-                return 0;
+                structure_lock.end_write();
             }
+            return count;
         }
+#endif
+        for (auto it = a; it != b; ++it) {
+            count += erase(*it);
+        }
+        return count;
     }
 
     /**
@@ -1702,6 +1741,84 @@ public:
     }
 
 private:
+    /**
+     * Erase the given key from the tree, assuming no concurrent modification.
+     * Return the number of erased keys.
+     */
+    size_type erase_exclusive(const Key& k) {
+        if (empty()) {
+            return 0;
+        }
+        if (isSet) {
+            iterator iter = internal_find(k);
+            if (iter == end()) {
+                // Key not found
+                return 0;
+            } else {
+                erase(iter);
+                return 1;
+            }
+        } else {
+            iterator lower_iter = internal_lower_bound(k);
+            if (lower_iter != end() && equal(*lower_iter, k)) {
+                size_type count = std::distance(lower_iter, internal_upper_bound(k));
+                for (size_type i = 0; i < count; i++) {
+                    erase(lower_iter);
+                }
+                return count;
+            } else {
+                return 0;
+            }
+        }
+    }
+
+    /** The outcome of an attempt to erase a key from its leaf */
+    enum class leaf_erase_result { erased, missing, restructure };
+
+    /**
+     * Erase the given key of a set if it is stored in a leaf that does not
+     * underflow by the removal. Other erasures in leaves may run concurrently,
+     * changes to the structure of the tree must not.
+     */
+    leaf_erase_result erase_in_leaf(const Key& k) {
+        node* cur = root;
+        if (cur == nullptr) {
+            return leaf_erase_result::missing;
+        }
+
+        // inner nodes are not modified by concurrent erasures in leaves
+        while (cur->inner) {
+            auto a = &(cur->keys[0]);
+            auto b = &(cur->keys[cur->numElements]);
+            auto pos = search(k, a, b, comp);
+            if (pos < b && equal(*pos, k)) {
+                // the key has to be replaced by its predecessor
+                return leaf_erase_result::restructure;
+            }
+            cur = cur->getChild(pos - a);
+        }
+
+        cur->lock.start_write();
+        auto a = &(cur->keys[0]);
+        auto b = &(cur->keys[cur->numElements]);
+        auto pos = search(k, a, b, comp);
+        leaf_erase_result res = leaf_erase_result::erased;
+        if (pos == b || !equal(*pos, k)) {
+            res = leaf_erase_result::missing;
+        } else if (cur->numElements <= (cur->parent ? node::minKeys : 1)) {
+            res = leaf_erase_result::restructure;
+        } else {
+            // delete the key and move other keys backwards
+            pos->~Key();
+            for (auto it = pos + 1; it < b; ++it) {
+                *(it - 1) = *it;
+            }
+            cur->numElements--;
+        }
+        cur->lock.end_write();
+        return res;
+    }
+
     /**
      * Find the given key in a non-empty tree.
      * If found, return an iterator pointing to the key.
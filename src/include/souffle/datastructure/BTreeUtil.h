@@ -16,7 +16,17 @@
 
 #pragma once
 
+#include <array>
+#include <cstddef>
+#include <cstdint>
 #include <tuple>
+#include <type_traits>
+#include <utility>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define SOUFFLE_BTREE_AVX2
+#include <immintrin.h>
+#endif
 
 namespace souffle {
 
@@ -188,6 +198,204 @@ struct binary_search : public search_strategy {
     }
 };
 
+/**
+ * Utilities of the SIMD search strategy counting the keys of a node whose leading
+ * column is smaller (or not greater) than the leading column of a searched key.
+ */
+namespace simd_util {
+
+/**
+ * Determines whether a comparator orders tuples by the signed value of a leading column
+ * first. Such comparators declare the column through a static leading_column member.
+ */
+template <typename Comp, typename = void>
+struct has_leading_column : public std::false_type {};
+
+template <typename Comp>
+struct has_leading_column<Comp, std::void_t<decltype(Comp::leading_column)>> : public std::true_type {};
+
+/**
+ * Determines whether the leading column of keys can be compared vectorised.
+ */
+template <typename Key>
+struct is_columnar : public std::false_type {};
+
+template <typename T, std::size_t N>
+struct is_columnar<std::array<T, N>>
+        : public std::integral_constant<bool, std::is_integral_v<T> && std::is_signed_v<T> &&
+                                                      (sizeof(T) == 4 || sizeof(T) == 8) && N != 0 &&
+                                                      sizeof(std::array<T, N>) == N * sizeof(T)> {};
+
+/** Counts values in base[0], base[stride], ... smaller and not greater than the given value */
+template <typename T>
+inline void count_scalar(const T* base, std::size_t stride, std::size_t n, T value, std::size_t& less,
+        std::size_t& lessEqual) {
+    std::size_t lt = 0;
+    std::size_t le = 0;
+    for (std::size_t i = 0; i < n; ++i) {
+        const T cur = base[i * stride];
+        lt += static_cast<std::size_t>(cur < value);
+        le += static_cast<std::size_t>(cur <= value);
+    }
+    less += lt;
+    lessEqual += le;
+}
+
+#ifdef SOUFFLE_BTREE_AVX2
+
+/** Whether the executing processor supports AVX2 (evaluated once) */
+inline const bool has_avx2 = __builtin_cpu_supports("avx2");
+
+__attribute__((target("avx2"))) inline void count_avx2(const std::int32_t* base, std::size_t stride,
+        std::size_t n, std::int32_t value, std::size_t& less, std::size_t& lessEqual) {
+    const auto s = static_cast<int>(stride);
+    const __m256i offsets = _mm256_setr_epi32(0, s, 2 * s, 3 * s, 4 * s, 5 * s, 6 * s, 7 * s);
+    const __m256i key = _mm256_set1_epi32(value);
+    std::size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        const __m256i cur =
+                _mm256_i32gather_epi32(reinterpret_cast<const int*>(base + i * stride), offsets, 4);
+        const auto lt = static_cast<unsigned>(
+                _mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpgt_epi32(key, cur))));
+        const auto gt = static_cast<unsigned>(
+                _mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpgt_epi32(cur, key))));
+        less += __builtin_popcount(lt);
+        lessEqual += 8 - __builtin_popcount(gt);
+    }
+    count_scalar(base + i * stride, stride, n - i, value, less, lessEqual);
+}
+
+__attribute__((target("avx2"))) inline void count_avx2(const std::int64_t* base, std::size_t stride,
+        std::size_t n, std::int64_t value, std::size_t& less, std::size_t& lessEqual) {
+    const auto s = static_cast<long long>(stride);
+    const __m256i offsets = _mm256_setr_epi64x(0, s, 2 * s, 3 * s);
+    const __m256i key = _mm256_set1_epi64x(value);
+    std::size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        const __m256i cur =
+                _mm256_i64gather_epi64(reinterpret_cast<const long long*>(base + i * stride), offsets, 8);
+        const auto lt = static_cast<unsigned>(
+                _mm256_movemask_pd(_mm256_castsi256_pd(_mm256_cmpgt_epi64(key, cur))));
+        const auto gt = static_cast<unsigned>(
+                _mm256_movemask_pd(_mm256_castsi256_pd(_mm256_cmpgt_epi64(cur, key))));
+        less += __builtin_popcount(lt);
+        lessEqual += 4 - __builtin_popcount(gt);
+    }
+    count_scalar(base + i * stride, stride, n - i, value, less, lessEqual);
+}
+
+#endif
+
+/**
+ * Counts values in base[0], base[stride], ... smaller and not greater than the given value,
+ * using AVX2 gathers if supported by the processor.
+ */
+template <typename T>
+inline void count(const T* base, std::size_t stride, std::size_t n, T value, std::size_t& less,
+        std::size_t& lessEqual) {
+    less = 0;
+    lessEqual = 0;
+#ifdef SOUFFLE_BTREE_AVX2
+#ifndef __AVX2__
+    if (has_avx2)
+#endif
+    {
+        using word = std::conditional_t<sizeof(T) == 4, std::int32_t, std::int64_t>;
+        count_avx2(reinterpret_cast<const word*>(base), stride, n, static_cast<word>(value), less, lessEqual);
+        return;
+    }
+#endif
+    count_scalar(base, stride, n, value, less, lessEqual);
+}
+
+}  // namespace simd_util
+
+/**
+ * A search strategy for looking up keys in b-tree nodes comparing the leading
+ * column of many keys at once. Keys are arrays of signed integers stored row-wise
+ * in nodes; the leading column is thus gathered with a stride. Only keys sharing
+ * the leading column of the searched key are compared through the comparator.
+ *
+ * The strategy applies to comparators declaring a static leading_column member,
+ * stating that tuples are ordered by the signed value of this column first. For
+ * all other comparators and keys it degrades to a binary search.
+ */
+struct simd_search : public search_strategy {
+    /**
+     * Required user-defined default constructor.
+     */
+    simd_search() = default;
+
+    /**
+     * Obtains an iterator pointing to some element within the given range
+     * that is equal to the given key, if available. Otherwise, a reference
+     * to the first element not less than the given key will be returned.
+     */
+    template <typename Key, typename Iter, typename Comp>
+    Iter operator()(const Key& k, Iter a, Iter b, Comp& comp) const {
+        if constexpr (applicable<Key, Iter, Comp>()) {
+            auto [lo, hi] = narrow(k, a, b, comp);
+            return binary_search()(k, lo, hi, comp);
+        } else {
+            return binary_search()(k, a, b, comp);
+        }
+    }
+
+    /**
+     * Obtains a reference to the first element in the given range that
+     * is not less than the given key.
+     */
+    template <typename Key, typename Iter, typename Comp>
+    Iter lower_bound(const Key& k, Iter a, Iter b, Comp& comp) const {
+        if constexpr (applicable<Key, Iter, Comp>()) {
+            auto [lo, hi] = narrow(k, a, b, comp);
+            return binary_search().lower_bound(k, lo, hi, comp);
+        } else {
+            return binary_search().lower_bound(k, a, b, comp);
+        }
+    }
+
+    /**
+     * Obtains a reference to the first element in the given range that
+     * such that the given key is less than the referenced element.
+     */
+    template <typename Key, typename Iter, typename Comp>
+    Iter upper_bound(const Key& k, Iter a, Iter b, Comp& comp) const {
+        if constexpr (applicable<Key, Iter, Comp>()) {
+            auto [lo, hi] = narrow(k, a, b, comp);
+            return binary_search().upper_bound(k, lo, hi, comp);
+        } else {
+            return binary_search().upper_bound(k, a, b, comp);
+        }
+    }
+
+private:
+    template <typename Key, typename Iter, typename Comp>
+    static constexpr bool applicable() {
+        using comp_type = std::decay_t<Comp>;
+        if constexpr (std::is_pointer_v<Iter> && simd_util::is_columnar<Key>::value &&
+                      simd_util::has_leading_column<comp_type>::value) {
+            return comp_type::leading_column < std::tuple_size<Key>::value;
+        } else {
+            return false;
+        }
+    }
+
+    /**
+     * Narrows the given range to the elements sharing the leading column of the given key.
+     */
+    template <typename Key, typename Iter, typename Comp>
+    static std::pair<Iter, Iter> narrow(const Key& k, Iter a, Iter b, Comp&) {
+        using value_type = typename Key::value_type;
+        constexpr std::size_t column = std::decay_t<Comp>::leading_column;
+        std::size_t less;
+        std::size_t lessEqual;
+        simd_util::count(reinterpret_cast<const value_type*>(a) + column, std::tuple_size<Key>::value,
+                static_cast<std::size_t>(b - a), k[column], less, lessEqual);
+        return {a + less, a + lessEqual};
+    }
+};
+
 // ---------- search strategies selection --------------
 
 /**
@@ -201,6 +409,7 @@ struct strategy_selection {
 
 struct linear : public strategy_selection<linear_search> {};
 struct binary : public strategy_selection<binary_search> {};
+struct simd : public strategy_selection<simd_search> {};
 
 // by default every key utilizes binary search
 template <typename Key>
@@ -212,6 +421,11 @@ struct default_strategy<int> : public linear {};
 template <typename... Ts>
 struct default_strategy<std::tuple<Ts...>> : public linear {};
 
+// tuples of integers utilize the leading column search if supported by the comparator
+template <typename T, std::size_t N>
+struct default_strategy<std::array<T, N>>
+        : public std::conditional_t<simd_util::is_columnar<std::array<T, N>>::value, simd, binary> {};
+
 /**
  * The default non-updater
  */
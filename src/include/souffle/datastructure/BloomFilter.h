@@ -0,0 +1,214 @@
+/*
+ * Souffle - A Datalog Compiler
+ * Copyright (c) 2026, The Souffle Developers. All rights reserved
+ * Licensed under the Universal Permissive License v 1.0 as shown at:
+ * - https://opensource.org/licenses/UPL
+ * - <souffle root>/licenses/SOUFFLE-UPL.txt
+ */
+
+/************************************************************************
+ *
+ * @file BloomFilter.h
+ *
+ * A concurrently updatable blocked Bloom filter guarding the searches of a relation
+ *
+ ***********************************************************************/
+
+#pragma once
+
+#include "souffle/RamTypes.h"
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+namespace souffle {
+
+/**
+ * A Bloom filter over the hashes of the values searched in a relation.
+ *
+ * The filter is split into blocks of 256 bits, the hash of a value selecting a
+ * block and one bit in each of its eight 32-bit words, so that inserting and
+ * probing a value touches a single cache line. Bits are set by atomic or, so
+ * values can be inserted concurrently; probes concurrent to inserts may miss
+ * the values being inserted.
+ *
+ * The filter grows without rehashing: it is a sequence of levels, each four
+ * times larger than the previous one, and values are inserted into the last
+ * level. A probe checks every level; the small ones stay in cache.
+ */
+class BloomFilter {
+public:
+    /** The hash of no values */
+    static constexpr std::uint64_t seed = 0x9e3779b97f4a7c15ull;
+
+    /** Mix a value into the hash of the preceding values */
+    static std::uint64_t mix(std::uint64_t hash, RamDomain value) {
+        const auto bits = static_cast<std::uint64_t>(static_cast<RamUnsigned>(value));
+        hash = (hash ^ bits) * 0xbf58476d1ce4e5b9ull;
+        return hash ^ (hash >> 31);
+    }
+
+    /** The hash of the given values */
+    template <typename... Values>
+    static std::uint64_t hash(Values... values) {
+        std::uint64_t res = seed;
+        ((res = mix(res, static_cast<RamDomain>(values))), ...);
+        return res;
+    }
+
+    BloomFilter() = default;
+
+    BloomFilter(const BloomFilter&) = delete;
+    BloomFilter& operator=(const BloomFilter&) = delete;
+
+    ~BloomFilter() {
+        clear();
+    }
+
+    /** Insert the values of the given hash */
+    void insert(std::uint64_t hash) {
+        hash = finalize(hash);
+        // count a sample of the insertions only, so that threads rarely contend on the counter
+        if ((hash & (sampleRate - 1)) == 0) {
+            count.fetch_add(sampleRate, std::memory_order_relaxed);
+        }
+        Level& level = getLevel(levelOf(count.load(std::memory_order_relaxed)));
+        Block& block = level.blocks[blockOf(level, hash)];
+        const auto key = static_cast<std::uint32_t>(hash);
+        for (std::size_t i = 0; i < wordsPerBlock; ++i) {
+            const std::uint32_t mask = bitOf(key, i);
+            if ((block.words[i].load(std::memory_order_relaxed) & mask) == 0) {
+                block.words[i].fetch_or(mask, std::memory_order_relaxed);
+            }
+        }
+    }
+
+    /** Test whether values of the given hash may have been inserted; if not, they have not */
+    bool mayContain(std::uint64_t hash) const {
+        hash = finalize(hash);
+        const auto key = static_cast<std::uint32_t>(hash);
+        for (std::size_t l = maxLevels; l-- > 0;) {
+            const Level* level = levels[l].load(std::memory_order_acquire);
+            if (level == nullptr) {
+                continue;
+            }
+            const Block& block = level->blocks[blockOf(*level, hash)];
+            bool found = true;
+            for (std::size_t i = 0; i < wordsPerBlock && found; ++i) {
+                found = (block.words[i].load(std::memory_order_relaxed) & bitOf(key, i)) != 0;
+            }
+            if (found) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    /** Remove all values; not thread-safe */
+    void clear() {
+        for (auto& level : levels) {
+            delete level.exchange(nullptr, std::memory_order_relaxed);
+        }
+        count.store(0, std::memory_order_relaxed);
+    }
+
+    /** Swap the values of this and the given filter; not thread-safe */
+    void swap(BloomFilter& other) {
+        for (std::size_t l = 0; l < maxLevels; ++l) {
+            Level* level = levels[l].load(std::memory_order_relaxed);
+            levels[l].store(other.levels[l].load(std::memory_order_relaxed), std::memory_order_relaxed);
+            other.levels[l].store(level, std::memory_order_relaxed);
+        }
+        std::size_t size = count.load(std::memory_order_relaxed);
+        count.store(other.count.load(std::memory_order_relaxed), std::memory_order_relaxed);
+        other.count.store(size, std::memory_order_relaxed);
+    }
+
+    /** The number of bytes held by the filter */
+    std::size_t getMemoryUsage() const {
+        std::size_t res = sizeof(*this);
+        for (std::size_t l = 0; l < maxLevels; ++l) {
+            if (levels[l].load(std::memory_order_relaxed) != nullptr) {
+                res += sizeof(Level) + (minBlocks << (2 * l)) * sizeof(Block);
+            }
+        }
+        return res;
+    }
+
+private:
+    static constexpr std::size_t wordsPerBlock = 8;
+
+    /** Values per block of a full level, giving a false positive rate of about half a percent */
+    static constexpr std::size_t valuesPerBlock = 16;
+
+    static constexpr std::size_t minBlocks = 64;
+
+    static constexpr std::size_t maxLevels = 16;
+
+    static constexpr std::size_t sampleRate = 16;
+
+    struct alignas(32) Block {
+        std::array<std::atomic<std::uint32_t>, wordsPerBlock> words;
+    };
+
+    struct Level {
+        explicit Level(std::size_t numBlocks) : mask(numBlocks - 1), blocks(new Block[numBlocks]()) {}
+
+        std::size_t mask;
+        std::unique_ptr<Block[]> blocks;
+    };
+
+    /** The odd multipliers selecting the bit of each word of a block */
+    static constexpr std::array<std::uint32_t, wordsPerBlock> salts = {0x47b6137bu, 0x44974d91u,
+            0x8824ad5bu, 0xa2b7289du, 0x705495c7u, 0x2df1424bu, 0x9efc4947u, 0x5c6bfb31u};
+
+    static std::uint64_t finalize(std::uint64_t hash) {
+        hash ^= hash >> 33;
+        hash *= 0xff51afd7ed558ccdull;
+        hash ^= hash >> 33;
+        hash *= 0xc4ceb9fe1a85ec53ull;
+        return hash ^ (hash >> 33);
+    }
+
+    static std::size_t blockOf(const Level& level, std::uint64_t hash) {
+        return static_cast<std::size_t>(hash >> 32) & level.mask;
+    }
+
+    static std::uint32_t bitOf(std::uint32_t key, std::size_t word) {
+        return std::uint32_t(1) << ((key * salts[word]) >> 27);
+    }
+
+    /** The level receiving the values inserted after the given number of values */
+    static std::size_t levelOf(std::size_t size) {
+        std::size_t capacity = minBlocks * valuesPerBlock;
+        std::size_t level = 0;
+        while (size >= capacity && level + 1 < maxLevels) {
+            size -= capacity;
+            capacity *= 4;
+            ++level;
+        }
+        return level;
+    }
+
+    Level& getLevel(std::size_t l) {
+        Level* level = levels[l].load(std::memory_order_acquire);
+        if (level != nullptr) {
+            return *level;
+        }
+        auto created = std::make_unique<Level>(minBlocks << (2 * l));
+        if (levels[l].compare_exchange_strong(level, created.get(), std::memory_order_acq_rel)) {
+            return *created.release();
+        }
+        return *level;
+    }
+
+    std::array<std::atomic<Level*>, maxLevels> levels{};
+
+    /** The approximate number of inserted values */
+    std::atomic<std::size_t> count{0};
+};
+
+}  // namespace souffle
@@ -0,0 +1,542 @@
+/*
+ * Souffle - A Datalog Compiler
+ * Copyright (c) 2026, The Souffle Developers. All rights reserved
+ * Licensed under the Universal Permissive License v 1.0 as shown at:
+ * - https://opensource.org/licenses/UPL
+ * - <souffle root>/licenses/SOUFFLE-UPL.txt
+ */
+
+/************************************************************************
+ *
+ * @file CompressedBTree.h
+ *
+ * A b-tree variant keeping its compacted leaves delta-encoded
+ *
+ ***********************************************************************/
+
+#pragma once
+
+#include "souffle/datastructure/BTree.h"
+#include "souffle/utility/Iteration.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+#include <iterator>
+#include <tuple>
+#include <type_traits>
+#include <vector>
+
+namespace souffle {
+
+namespace detail {
+
+/**
+ * An ordered set or multiset of tuples whose compacted content is stored
+ * as a sequence of compressed leaves.
+ *
+ * Each leaf holds up to blockSize tuples. The first tuple of a leaf is kept
+ * uncompressed, serving as separator when searching the leaves; every other
+ * tuple is encoded relative to its predecessor as a varint mask of the columns
+ * that differ, followed by a zigzag varint delta of each of those columns.
+ * Sorted neighbours share their leading columns and differ by small amounts
+ * in the others, so a wide tuple typically shrinks to a few bytes.
+ *
+ * The compressed leaves are immutable. Insertions go to a regular b-tree,
+ * the staging area, which supports concurrent insertions; compact() merges
+ * the staging area into new compressed leaves. The staging area and the
+ * compressed leaves are disjoint for sets. Iterators decode the leaves on
+ * the fly and interleave them with the staging area; they are invalidated
+ * by compact() and clear().
+ *
+ * @tparam Key        .. the tuple type, an array of integral columns
+ * @tparam Comparator .. a class defining an order on the stored elements
+ * @tparam isSet      .. true for a set, false for a multiset
+ * @tparam blockSize  .. the number of tuples per compressed leaf
+ */
+template <typename Key, typename Comparator, bool isSet, unsigned blockSize>
+class compressed_btree {
+public:
+    using key_type = Key;
+    using element_type = Key;
+    using size_type = std::size_t;
+
+    using staging_type =
+            std::conditional_t<isSet, btree_set<Key, Comparator>, btree_multiset<Key, Comparator>>;
+
+protected:
+    using column_type = std::make_unsigned_t<typename Key::value_type>;
+
+    static constexpr std::size_t columns = std::tuple_size<Key>::value;
+
+    static_assert(columns > 0 && columns <= 64, "columns must fit the mask of changed columns");
+    static_assert(blockSize > 1, "leaves must hold more than one tuple");
+
+    /** A compressed leaf */
+    struct leaf {
+        // the uncompressed first tuple of the leaf
+        Key first;
+        // the position of the encoding of the second tuple in the byte buffer
+        std::size_t offset;
+        // the number of tuples in the leaf
+        std::size_t count;
+    };
+
+    std::vector<leaf> leaves;
+    std::vector<uint8_t> bytes;
+    size_type compressedSize = 0;
+    staging_type staging;
+    Comparator comp;
+
+    static void writeVarint(std::vector<uint8_t>& out, uint64_t value) {
+        while (value >= 0x80) {
+            out.push_back(static_cast<uint8_t>(value | 0x80));
+            value >>= 7;
+        }
+        out.push_back(static_cast<uint8_t>(value));
+    }
+
+    static uint64_t readVarint(const uint8_t*& in) {
+        uint64_t value = 0;
+        for (unsigned shift = 0;; shift += 7) {
+            const uint8_t byte = *in++;
+            value |= static_cast<uint64_t>(byte & 0x7f) << shift;
+            if (byte < 0x80) {
+                return value;
+            }
+        }
+    }
+
+    /** Appends the encoding of a tuple relative to its predecessor */
+    static void encode(std::vector<uint8_t>& out, const Key& prev, const Key& cur) {
+        uint64_t mask = 0;
+        for (std::size_t c = 0; c < columns; ++c) {
+            if (cur[c] != prev[c]) {
+                mask |= uint64_t(1) << c;
+            }
+        }
+        writeVarint(out, mask);
+        for (std::size_t c = 0; c < columns; ++c) {
+            if ((mask >> c) & 1) {
+                const column_type delta =
+                        static_cast<column_type>(cur[c]) - static_cast<column_type>(prev[c]);
+                // zigzag maps small negative deltas to small unsigned values
+                const column_type sign = (delta >> (sizeof(column_type) * 8 - 1)) & 1;
+                writeVarint(out, static_cast<column_type>(delta << 1) ^ static_cast<column_type>(-sign));
+            }
+        }
+    }
+
+    /** Decodes the tuple following the given one, returns the position after its encoding */
+    static const uint8_t* decode(const uint8_t* in, Key& cur) {
+        const uint64_t mask = readVarint(in);
+        for (std::size_t c = 0; c < columns; ++c) {
+            if ((mask >> c) & 1) {
+                const auto zigzag = static_cast<column_type>(readVarint(in));
+                const column_type delta = (zigzag >> 1) ^ static_cast<column_type>(-(zigzag & 1));
+                cur[c] = static_cast<typename Key::value_type>(static_cast<column_type>(cur[c]) + delta);
+            }
+        }
+        return in;
+    }
+
+    /** An iterator over the compressed leaves, decoding one tuple per step */
+    class leaf_iterator {
+        const compressed_btree* tree = nullptr;
+        std::size_t leafPos = 0;
+        std::size_t pos = 0;
+        const uint8_t* next = nullptr;
+        Key cur{};
+
+    public:
+        leaf_iterator() = default;
+
+        // the iterator at the first tuple of the given leaf
+        leaf_iterator(const compressed_btree* tree, std::size_t leafPos) : tree(tree), leafPos(leafPos) {
+            load();
+        }
+
+        bool isEnd() const {
+            return tree == nullptr || leafPos >= tree->leaves.size();
+        }
+
+        const Key& operator*() const {
+            return cur;
+        }
+
+        leaf_iterator& operator++() {
+            const leaf& l = tree->leaves[leafPos];
+            if (pos + 1 < l.count) {
+                next = decode(next, cur);
+                ++pos;
+            } else {
+                ++leafPos;
+                load();
+            }
+            return *this;
+        }
+
+        bool operator==(const leaf_iterator& other) const {
+            if (isEnd() || other.isEnd()) {
+                return isEnd() == other.isEnd();
+            }
+            return leafPos == other.leafPos && pos == other.pos;
+        }
+
+    private:
+        void load() {
+            pos = 0;
+            if (!isEnd()) {
+                const leaf& l = tree->leaves[leafPos];
+                cur = l.first;
+                next = tree->bytes.data() + l.offset;
+            }
+        }
+    };
+
+    using staging_iterator = typename staging_type::iterator;
+
+public:
+    /**
+     * The hints of operations, caching the last leaf searched and the hints of the staging area.
+     */
+    struct operation_hints {
+        std::size_t leaf = 0;
+        typename staging_type::operation_hints staging;
+    };
+
+    /**
+     * An iterator merging the compressed leaves and the staging area in the order of the tree.
+     * Ties of multisets are visited compressed leaves first.
+     */
+    class iterator {
+        leaf_iterator compressed;
+        staging_iterator staged;
+        bool fromStaging = false;
+
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = Key;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const Key*;
+        using reference = const Key&;
+
+        iterator() = default;
+
+        iterator(leaf_iterator compressed, staging_iterator staged)
+                : compressed(std::move(compressed)), staged(std::move(staged)) {
+            select();
+        }
+
+        const Key& operator*() const {
+            return fromStaging ? *staged : *compressed;
+        }
+
+        const Key* operator->() const {
+            return &**this;
+        }
+
+        iterator& operator++() {
+            if (fromStaging) {
+                ++staged;
+            } else {
+                ++compressed;
+            }
+            select();
+            return *this;
+        }
+
+        iterator operator++(int) {
+            auto res = *this;
+            ++(*this);
+            return res;
+        }
+
+        bool operator==(const iterator& other) const {
+            return compressed == other.compressed && staged == other.staged;
+        }
+
+        bool operator!=(const iterator& other) const {
+            return !(*this == other);
+        }
+
+    private:
+        void select() {
+            if (compressed.isEnd()) {
+                fromStaging = true;
+            } else if (staged == staging_iterator()) {
+                fromStaging = false;
+            } else {
+                fromStaging = Comparator().less(*staged, *compressed);
+            }
+        }
+    };
+
+    using chunk = range<iterator>;
+
+    compressed_btree() = default;
+
+    compressed_btree(const compressed_btree& other) = delete;
+
+    compressed_btree& operator=(const compressed_btree& other) = delete;
+
+    bool empty() const {
+        return compressedSize == 0 && staging.empty();
+    }
+
+    size_type size() const {
+        return compressedSize + staging.size();
+    }
+
+    /** Tests whether some tuples are held uncompressed in the staging area */
+    bool hasStaged() const {
+        return !staging.empty();
+    }
+
+    /**
+     * Inserts the given key; may run concurrently to other insertions.
+     *
+     * @return true if the key is new to a set, always true for multisets
+     */
+    bool insert(const Key& k) {
+        operation_hints hints;
+        return insert(k, hints);
+    }
+
+    bool insert(const Key& k, operation_hints& hints) {
+        if constexpr (isSet) {
+            if (containsCompressed(k, hints)) {
+                return false;
+            }
+        }
+        return staging.insert(k, hints.staging);
+    }
+
+    /**
+     * Inserts the given range of elements, which must be sorted in the order of this
+     * tree, and calls the given function on each element that was not present before.
+     */
+    template <typename Iter, typename F>
+    void insertSorted(const Iter& a, const Iter& b, F&& onInsert) {
+        if (compressedSize == 0 || !isSet) {
+            staging.insertSorted(a, b, onInsert);
+            return;
+        }
+        operation_hints hints;
+        std::vector<Key> fresh;
+        for (auto it = a; it != b; ++it) {
+            if (!containsCompressed(*it, hints)) {
+                fresh.push_back(*it);
+            }
+        }
+        staging.insertSorted(fresh.begin(), fresh.end(), onInsert);
+    }
+
+    template <typename Iter>
+    void insertSorted(const Iter& a, const Iter& b) {
+        insertSorted(a, b, [](const Key&) {});
+    }
+
+    bool contains(const Key& k) const {
+        operation_hints hints;
+        return contains(k, hints);
+    }
+
+    bool contains(const Key& k, operation_hints& hints) const {
+        return containsCompressed(k, hints) || staging.contains(k, hints.staging);
+    }
+
+    iterator find(const Key& k) const {
+        operation_hints hints;
+        return find(k, hints);
+    }
+
+    iterator find(const Key& k, operation_hints& hints) const {
+        auto pos = lower_bound(k, hints);
+        if (pos != end() && comp.equal(*pos, k)) {
+            return pos;
+        }
+        return end();
+    }
+
+    iterator lower_bound(const Key& k) const {
+        operation_hints hints;
+        return lower_bound(k, hints);
+    }
+
+    iterator lower_bound(const Key& k, operation_hints& hints) const {
+        return iterator(leafLowerBound(k, hints), staging.lower_bound(k, hints.staging));
+    }
+
+    iterator upper_bound(const Key& k) const {
+        operation_hints hints;
+        return upper_bound(k, hints);
+    }
+
+    iterator upper_bound(const Key& k, operation_hints& hints) const {
+        return iterator(leafUpperBound(k, hints), staging.upper_bound(k, hints.staging));
+    }
+
+    iterator begin() const {
+        return iterator(leaf_iterator(this, 0), staging.begin());
+    }
+
+    iterator end() const {
+        return iterator(leaf_iterator(), staging.end());
+    }
+
+    /**
+     * Partitions the full range of this tree into up to a given number of chunks,
+     * cut at the boundaries of compressed leaves.
+     */
+    std::vector<chunk> partition(size_type num) const {
+        return getChunks(num);
+    }
+
+    std::vector<chunk> getChunks(size_type num) const {
+        std::vector<chunk> res;
+        if (empty()) {
+            return res;
+        }
+        if (leaves.empty()) {
+            for (const auto& cur : staging.getChunks(num)) {
+                res.push_back(chunk(iterator(leaf_iterator(), cur.begin()),
+                        iterator(leaf_iterator(), cur.end())));
+            }
+            return res;
+        }
+        // the staging elements before the first leaf belong to the first chunk
+        num = std::max<size_type>(num, 1);
+        const std::size_t step = (leaves.size() + num - 1) / num;
+        iterator from = begin();
+        for (std::size_t l = step; l < leaves.size(); l += step) {
+            iterator to(leaf_iterator(this, l), staging.lower_bound(leaves[l].first));
+            res.push_back(chunk(from, to));
+            from = to;
+        }
+        res.push_back(chunk(from, end()));
+        return res;
+    }
+
+    /**
+     * Merges the staging area into the compressed leaves.
+     * Must not run concurrently to other operations.
+     */
+    void compact() {
+        if (staging.empty()) {
+            return;
+        }
+        std::vector<leaf> newLeaves;
+        std::vector<uint8_t> newBytes;
+        newBytes.reserve(bytes.size() + staging.size() * 2);
+        Key prev{};
+        for (const auto& cur : *this) {
+            if (newLeaves.empty() || newLeaves.back().count == blockSize) {
+                newLeaves.push_back({cur, newBytes.size(), 1});
+            } else {
+                encode(newBytes, prev, cur);
+                ++newLeaves.back().count;
+            }
+            prev = cur;
+        }
+        newLeaves.shrink_to_fit();
+        newBytes.shrink_to_fit();
+        compressedSize = size();
+        leaves.swap(newLeaves);
+        bytes.swap(newBytes);
+        staging.clear();
+    }
+
+    void clear() {
+        leaves.clear();
+        leaves.shrink_to_fit();
+        bytes.clear();
+        bytes.shrink_to_fit();
+        compressedSize = 0;
+        staging.clear();
+    }
+
+    size_type getMemoryUsage() const {
+        return sizeof(*this) - sizeof(staging) + leaves.capacity() * sizeof(leaf) + bytes.capacity() +
+               staging.getMemoryUsage();
+    }
+
+    void printStats(std::ostream& out = std::cout) const {
+        out << " ---------------------------------\n";
+        out << "  Elements:        " << size() << "\n";
+        out << "  Compressed:      " << compressedSize << "\n";
+        out << "  Leaves:          " << leaves.size() << "\n";
+        out << "  Encoded bytes:   " << bytes.size() << "\n";
+        if (compressedSize > 0) {
+            out << "  Bytes per tuple: "
+                << double(bytes.size() + leaves.size() * sizeof(leaf)) / double(compressedSize) << " (vs "
+                << sizeof(Key) << " uncompressed)\n";
+        }
+        out << "  Staged:          " << staging.size() << "\n";
+        out << "  Memory usage:    " << (getMemoryUsage() / 1'000'000) << "MB\n";
+        out << " ---------------------------------\n";
+    }
+
+protected:
+    /**
+     * Obtains the last leaf whose first tuple satisfies the given predicate, which
+     * must hold for a prefix of the leaves; the first leaf if there is none.
+     */
+    template <typename Before>
+    std::size_t locateLeaf(operation_hints& hints, const Before& before) const {
+        const std::size_t h = hints.leaf;
+        if (h < leaves.size() && before(leaves[h].first) &&
+                (h + 1 == leaves.size() || !before(leaves[h + 1].first))) {
+            return h;
+        }
+        auto pos = std::partition_point(
+                leaves.begin(), leaves.end(), [&](const leaf& l) { return before(l.first); });
+        hints.leaf = (pos == leaves.begin()) ? 0 : static_cast<std::size_t>(pos - leaves.begin()) - 1;
+        return hints.leaf;
+    }
+
+    leaf_iterator leafLowerBound(const Key& k, operation_hints& hints) const {
+        if (leaves.empty()) {
+            return leaf_iterator();
+        }
+        leaf_iterator it(this, locateLeaf(hints, [&](const Key& first) { return comp.less(first, k); }));
+        while (!it.isEnd() && comp.less(*it, k)) {
+            ++it;
+        }
+        return it;
+    }
+
+    leaf_iterator leafUpperBound(const Key& k, operation_hints& hints) const {
+        if (leaves.empty()) {
+            return leaf_iterator();
+        }
+        leaf_iterator it(this, locateLeaf(hints, [&](const Key& first) { return !comp.less(k, first); }));
+        while (!it.isEnd() && !comp.less(k, *it)) {
+            ++it;
+        }
+        return it;
+    }
+
+    bool containsCompressed(const Key& k, operation_hints& hints) const {
+        auto it = leafLowerBound(k, hints);
+        return !it.isEnd() && comp.equal(*it, k);
+    }
+};
+
+}  // namespace detail
+
+/**
+ * A set whose compacted content is kept in delta-encoded leaves.
+ */
+template <typename Key, typename Comparator = detail::comparator<Key>, unsigned blockSize = 128>
+class compressed_btree_set : public detail::compressed_btree<Key, Comparator, true, blockSize> {};
+
+/**
+ * A multiset whose compacted content is kept in delta-encoded leaves.
+ */
+template <typename Key, typename Comparator = detail::comparator<Key>, unsigned blockSize = 128>
+class compressed_btree_multiset : public detail::compressed_btree<Key, Comparator, false, blockSize> {};
+
+}  // end namespace souffle
@@ -273,6 +273,12 @@ public:
         Lanes.setNumLanes(NumLanes);
     }
 
+    /// Return the number of bytes held by the datastructure, excluding memory owned by the keys.
+    std::size_t getMemoryUsage() const {
+        return sizeof(*this) - sizeof(Mapping) + Mapping.getMemoryUsage() + HandleCount * sizeof(Handle) +
+               SlotCount * sizeof(const value_type*);
+    }
+
     /** Return a concurrent iterator on the first element. */
     Iterator begin(const lane_id H) const {
         return Iterator(this, H);
@@ -465,6 +471,10 @@ public:
         return Base::end();
     }
 
+    std::size_t getMemoryUsage() const {
+        return Base::getMemoryUsage();
+    }
+
     template <typename K>
     bool weakContains(const K& X) const {
         return Base::weakContains(Base::Lanes.threadLane(), X);
@@ -508,6 +518,10 @@ public:
         return Base::end();
     }
 
+    std::size_t getMemoryUsage() const {
+        return Base::getMemoryUsage();
+    }
+
     template <typename K>
     bool weakContains(const K& X) const {
         return Base::weakContains(0, X);
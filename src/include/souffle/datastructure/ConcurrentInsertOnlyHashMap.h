@@ -167,6 +167,11 @@ public:
         Lanes.setNumLanes(NumLanes);
     }
 
+    /** @brief Return the number of bytes held by the map, excluding memory owned by the keys. */
+    std::size_t getMemoryUsage() const {
+        return sizeof(*this) + BucketCount * sizeof(std::atomic<BucketList*>) + Size * sizeof(BucketList);
+    }
+
     /** @brief Create a fresh node initialized with the given value and a
      * default-constructed key.
      *
@@ -0,0 +1,492 @@
+/*
+ * Souffle - A Datalog Compiler
+ * Copyright (c) 2026, The Souffle Developers. All rights reserved
+ * Licensed under the Universal Permissive License v 1.0 as shown at:
+ * - https://opensource.org/licenses/UPL
+ * - <souffle root>/licenses/SOUFFLE-UPL.txt
+ */
+
+/************************************************************************
+ *
+ * @file ConcurrentInsertOnlyHashSet.h
+ *
+ * A concurrent open-addressing hash set that can only grow
+ *
+ ***********************************************************************/
+
+#pragma once
+
+#include "souffle/RamTypes.h"
+#include "souffle/utility/Iteration.h"
+#include "souffle/utility/ParallelUtil.h"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <ostream>
+#include <vector>
+
+namespace souffle {
+
+/**
+ * A concurrent hash set with open addressing that can only grow.
+ * Elements cannot be removed, the hash set can only grow.
+ *
+ * Keys are stored inline in a table probed linearly. A control byte per slot
+ * tells whether the slot is empty, claimed by an ongoing insertion or occupied,
+ * in which case it holds seven bits of the hash of the key to skip most key
+ * comparisons while probing.
+ *
+ * As for the ConcurrentInsertOnlyHashMap, accesses go through lanes. Access to
+ * the datastructure is lock-free between different lanes; growing the table
+ * temporarily locks all lanes.
+ *
+ * Iterating the set is not synchronised with concurrent insertions.
+ */
+template <class LanesPolicy, class Key, class Hash = std::hash<Key>, class KeyEqual = std::equal_to<Key>>
+class ConcurrentInsertOnlyHashSet {
+public:
+    using key_type = Key;
+    using value_type = Key;
+    using size_type = std::size_t;
+    using hasher = Hash;
+    using key_equal = KeyEqual;
+    using lane_id = typename LanesPolicy::lane_id;
+
+    /**
+     * A forward iterator over the occupied slots of the table.
+     */
+    class iterator {
+        const ConcurrentInsertOnlyHashSet* set = nullptr;
+        std::size_t slot = 0;
+
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = Key;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const Key*;
+        using reference = const Key&;
+
+        iterator() = default;
+
+        // the iterator at the first occupied slot not before the given slot
+        iterator(const ConcurrentInsertOnlyHashSet* set, std::size_t slot) : set(set), slot(slot) {
+            skip();
+        }
+
+        const Key& operator*() const {
+            return set->Keys[slot];
+        }
+
+        const Key* operator->() const {
+            return &set->Keys[slot];
+        }
+
+        iterator& operator++() {
+            ++slot;
+            skip();
+            return *this;
+        }
+
+        iterator operator++(int) {
+            iterator res = *this;
+            ++(*this);
+            return res;
+        }
+
+        bool operator==(const iterator& other) const {
+            return slot == other.slot;
+        }
+
+        bool operator!=(const iterator& other) const {
+            return !(*this == other);
+        }
+
+    private:
+        void skip() {
+            while (slot < set->Capacity && !isOccupied(set->Slots[slot].load(std::memory_order_relaxed))) {
+                ++slot;
+            }
+        }
+    };
+
+    /**
+     * @brief Construct a hash set with at least the given number of slots.
+     */
+    explicit ConcurrentInsertOnlyHashSet(const std::size_t LaneCount, const std::size_t InitialCapacity = 16,
+            const Hash& hash = Hash(), const KeyEqual& key_equal = KeyEqual())
+            : Lanes(LaneCount), Hasher(hash), EqualTo(key_equal), MinCapacity(InitialCapacity) {
+        allocate(minCapacity());
+    }
+
+    ConcurrentInsertOnlyHashSet(const ConcurrentInsertOnlyHashSet&) = delete;
+    ConcurrentInsertOnlyHashSet& operator=(const ConcurrentInsertOnlyHashSet&) = delete;
+
+    void setNumLanes(const std::size_t NumLanes) {
+        Lanes.setNumLanes(NumLanes);
+        if (Capacity < minCapacity()) {
+            rehash(minCapacity());
+        }
+    }
+
+    /** @brief Return the number of elements of the set. */
+    std::size_t size() const {
+        return Size.load(std::memory_order_relaxed);
+    }
+
+    bool empty() const {
+        return size() == 0;
+    }
+
+    /** @brief Return the number of bytes held by the set. */
+    std::size_t getMemoryUsage() const {
+        return sizeof(*this) + Capacity * (sizeof(Key) + sizeof(std::atomic<std::uint8_t>));
+    }
+
+    void printStats(std::ostream& o) const {
+        o << "Hash set with " << size() << " elements in " << Capacity << " slots, load factor "
+          << static_cast<double>(size()) / static_cast<double>(Capacity) << "\n";
+    }
+
+    iterator begin() const {
+        return iterator(this, 0);
+    }
+
+    iterator end() const {
+        return iterator(this, Capacity);
+    }
+
+    /**
+     * @brief Splits the slots of the table into the given number of ranges.
+     *
+     * Ranges without elements are omitted.
+     */
+    std::vector<range<iterator>> partition(const std::size_t Count) const {
+        std::vector<range<iterator>> res;
+        const std::size_t Chunks = std::max<std::size_t>(1, std::min(Count, Capacity));
+        iterator Lower = begin();
+        for (std::size_t I = 1; I <= Chunks; ++I) {
+            iterator Upper(this, Capacity * I / Chunks);
+            if (Lower != Upper) {
+                res.push_back(make_range(Lower, Upper));
+            }
+            Lower = Upper;
+        }
+        return res;
+    }
+
+    /**
+     * @brief Lookup a key.
+     *
+     * The search is done concurrently with possible insertion of the
+     * searched key. If end() is returned, then the key was not present
+     * when the search began.
+     */
+    iterator weakFind(const lane_id H, const Key& X) const {
+        const std::size_t HashValue = mix(Hasher(X));
+        const auto Guard = Lanes.guard(H);
+        const std::size_t Slot = findSlot(HashValue, X);
+        return Slot == Capacity ? end() : iterator(this, Slot);
+    }
+
+    /** @brief Checks if the set contains the given key, see weakFind. */
+    bool weakContains(const lane_id H, const Key& X) const {
+        const std::size_t HashValue = mix(Hasher(X));
+        const auto Guard = Lanes.guard(H);
+        return findSlot(HashValue, X) != Capacity;
+    }
+
+    /**
+     * @brief Inserts the given key if it is not present yet.
+     *
+     * Returns true if the key has been inserted by this call.
+     */
+    bool insert(const lane_id H, const Key& X) {
+        // A slot is claimed by atomically exchanging its control byte from empty to busy,
+        // after which the key is written and the control byte is published with the tag of
+        // the hash. Concurrent insertions of the same key probe the same sequence of slots,
+        // so they wait for busy slots on their way to compare the keys written there.
+        const std::size_t HashValue = mix(Hasher(X));
+        const std::uint8_t Tag = tag(HashValue);
+
+        Lanes.lock(H);  // prevent the datastructure from growing
+
+        bool Inserted = false;
+        std::size_t NewSize = 0;
+        const std::size_t Mask = Capacity - 1;
+        for (std::size_t Slot = HashValue & Mask;; Slot = (Slot + 1) & Mask) {
+            std::uint8_t Control = Slots[Slot].load(std::memory_order_acquire);
+            if (Control == EMPTY) {
+                if (Slots[Slot].compare_exchange_strong(
+                            Control, BUSY, std::memory_order_acquire, std::memory_order_acquire)) {
+                    Keys[Slot] = X;
+                    Slots[Slot].store(Tag, std::memory_order_release);
+                    Inserted = true;
+                    NewSize = ++Size;
+                    break;
+                }
+            }
+            // the slot has been claimed concurrently
+            while (Control == BUSY) {
+#ifdef IS_PARALLEL
+                cpu_relax();
+#endif
+                Control = Slots[Slot].load(std::memory_order_acquire);
+            }
+            if (Control == Tag && EqualTo(Keys[Slot], X)) {
+                break;
+            }
+        }
+
+        if (Inserted && NewSize > MaxSizeBeforeGrow) {
+            tryGrow(H);
+        }
+
+        Lanes.unlock(H);
+        return Inserted;
+    }
+
+    /**
+     * @brief Removes all elements and releases the table.
+     *
+     * Must not be called concurrently with other operations.
+     */
+    void clear() {
+        allocate(minCapacity());
+    }
+
+private:
+    /// Control byte of free slots.
+    static constexpr std::uint8_t EMPTY = 0;
+
+    /// Control byte of slots claimed by an ongoing insertion.
+    static constexpr std::uint8_t BUSY = 1;
+
+    static constexpr bool isOccupied(const std::uint8_t Control) {
+        return (Control & 0x80U) != 0;
+    }
+
+    // The control byte of an occupied slot: the highest 7 bits of the hash.
+    static constexpr std::uint8_t tag(const std::size_t HashValue) {
+        return static_cast<std::uint8_t>(0x80U | (HashValue >> (sizeof(std::size_t) * 8 - 7)));
+    }
+
+    // Mixes the bits of the hash so that both the lowest bits selecting the slot and
+    // the highest bits forming the tag depend on all bits of the key.
+    static std::size_t mix(std::size_t H) {
+        if constexpr (sizeof(std::size_t) == 8) {
+            H ^= H >> 33U;
+            H *= 0xff51afd7ed558ccdULL;
+            H ^= H >> 33U;
+            H *= 0xc4ceb9fe1a85ec53ULL;
+            H ^= H >> 33U;
+        } else {
+            H ^= H >> 16U;
+            H *= 0x85ebca6bU;
+            H ^= H >> 13U;
+            H *= 0xc2b2ae35U;
+            H ^= H >> 16U;
+        }
+        return H;
+    }
+
+    // Leaves room for one concurrent insertion per lane past the growth threshold.
+    std::size_t minCapacity() const {
+        std::size_t Res = 16;
+        while (Res < MinCapacity || Res < 4 * Lanes.lanes()) {
+            Res <<= 1U;
+        }
+        return Res;
+    }
+
+    // Return the slot of the given key, or the capacity if it is not present.
+    std::size_t findSlot(const std::size_t HashValue, const Key& X) const {
+        const std::uint8_t Tag = tag(HashValue);
+        const std::size_t Mask = Capacity - 1;
+        for (std::size_t Slot = HashValue & Mask;; Slot = (Slot + 1) & Mask) {
+            const std::uint8_t Control = Slots[Slot].load(std::memory_order_acquire);
+            if (Control == EMPTY) {
+                return Capacity;
+            }
+            // busy slots are being inserted concurrently and are skipped
+            if (Control == Tag && EqualTo(Keys[Slot], X)) {
+                return Slot;
+            }
+        }
+    }
+
+    void allocate(const std::size_t NewCapacity) {
+        Slots = std::make_unique<std::atomic<std::uint8_t>[]>(NewCapacity);
+        for (std::size_t I = 0; I < NewCapacity; ++I) {
+            Slots[I].store(EMPTY, std::memory_order_relaxed);
+        }
+        Keys = std::make_unique<Key[]>(NewCapacity);
+        Capacity = NewCapacity;
+        MaxSizeBeforeGrow = NewCapacity / 4 * 3;
+        Size = 0;
+    }
+
+    // Move all keys into a table of the given capacity.
+    // Must be called while no other lane accesses the set.
+    void rehash(const std::size_t NewCapacity) {
+        auto OldSlots = std::move(Slots);
+        auto OldKeys = std::move(Keys);
+        const std::size_t OldCapacity = Capacity;
+        const std::size_t OldSize = Size;
+
+        allocate(NewCapacity);
+        const std::size_t Mask = Capacity - 1;
+        for (std::size_t I = 0; I < OldCapacity; ++I) {
+            const std::uint8_t Control = OldSlots[I].load(std::memory_order_relaxed);
+            if (!isOccupied(Control)) {
+                continue;
+            }
+            std::size_t Slot = mix(Hasher(OldKeys[I])) & Mask;
+            while (Slots[Slot].load(std::memory_order_relaxed) != EMPTY) {
+                Slot = (Slot + 1) & Mask;
+            }
+            Slots[Slot].store(Control, std::memory_order_relaxed);
+            Keys[Slot] = std::move(OldKeys[I]);
+        }
+        Size = OldSize;
+    }
+
+    // Grow the datastructure.
+    // Must be called while owning lane H.
+    bool tryGrow(const lane_id H) {
+        Lanes.beforeLockAllBut(H);
+
+        if (Size <= MaxSizeBeforeGrow) {
+            // Current size is fine
+            Lanes.beforeUnlockAllBut(H);
+            return false;
+        }
+
+        Lanes.lockAllBut(H);
+
+        std::size_t NewCapacity = Capacity * 2;
+        while (Size > NewCapacity / 4 * 3) {
+            NewCapacity *= 2;
+        }
+        rehash(NewCapacity);
+
+        Lanes.beforeUnlockAllBut(H);
+        Lanes.unlockAllBut(H);
+        return true;
+    }
+
+protected:
+    // The concurrent lanes manager.
+    mutable LanesPolicy Lanes;
+
+private:
+    /// Hash function.
+    Hash Hasher;
+
+    /// The Equal-to function.
+    KeyEqual EqualTo;
+
+    /// Requested minimal number of slots.
+    std::size_t MinCapacity;
+
+    /// Current number of slots, a power of two.
+    std::size_t Capacity = 0;
+
+    /// Control bytes of the slots.
+    std::unique_ptr<std::atomic<std::uint8_t>[]> Slots;
+
+    /// Keys of the slots.
+    std::unique_ptr<Key[]> Keys;
+
+    /// Current number of elements stored in the set.
+    std::atomic<std::size_t> Size{0};
+
+    /// Maximum size before the set should grow.
+    std::size_t MaxSizeBeforeGrow = 0;
+};
+
+/** Hash function object for tuples of RamDomain values. */
+template <std::size_t Arity>
+struct TupleHash {
+    std::size_t operator()(const Tuple<RamDomain, Arity>& Tuple) const {
+        std::size_t Seed = 0;
+        for (std::size_t I = 0; I < Arity; ++I) {
+            Seed ^= static_cast<std::size_t>(Tuple[I]) + 0x9e3779b9U + (Seed << 6U) + (Seed >> 2U);
+        }
+        return Seed;
+    }
+};
+
+/**
+ * A hash set of tuples with concurrent access through the lane of the calling thread.
+ *
+ * It stores relations that are only searched for full tuples; the set is unordered.
+ */
+template <std::size_t Arity>
+class TupleHashSet : protected ConcurrentInsertOnlyHashSet<
+#ifdef _OPENMP
+                             ConcurrentLanes,
+#else
+                             SeqConcurrentLanes,
+#endif
+                             Tuple<RamDomain, Arity>, TupleHash<Arity>> {
+public:
+#ifdef _OPENMP
+    using Base = ConcurrentInsertOnlyHashSet<ConcurrentLanes, Tuple<RamDomain, Arity>, TupleHash<Arity>>;
+#else
+    using Base = ConcurrentInsertOnlyHashSet<SeqConcurrentLanes, Tuple<RamDomain, Arity>, TupleHash<Arity>>;
+#endif
+    using element_type = Tuple<RamDomain, Arity>;
+    using iterator = typename Base::iterator;
+
+    TupleHashSet() : Base(MAX_THREADS) {}
+
+    using Base::begin;
+    using Base::clear;
+    using Base::empty;
+    using Base::end;
+    using Base::getMemoryUsage;
+    using Base::partition;
+    using Base::printStats;
+    using Base::setNumLanes;
+    using Base::size;
+
+    bool insert(const element_type& tuple) {
+        return Base::insert(lane(), tuple);
+    }
+
+    bool contains(const element_type& tuple) const {
+        return Base::weakContains(lane(), tuple);
+    }
+
+    iterator find(const element_type& tuple) const {
+        return Base::weakFind(lane(), tuple);
+    }
+
+    /** Return the range of the elements equal to the given tuple */
+    range<iterator> equalRange(const element_type& tuple) const {
+        iterator pos = find(tuple);
+        if (pos == end()) {
+            return make_range(pos, pos);
+        }
+        iterator next = pos;
+        return make_range(pos, ++next);
+    }
+
+private:
+    typename Base::lane_id lane() const {
+#ifdef _OPENMP
+        return Base::Lanes.threadLane();
+#else
+        return 0;
+#endif
+    }
+};
+
+}  // namespace souffle
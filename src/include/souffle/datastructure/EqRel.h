@@ -161,6 +161,9 @@ struct t_eqrel {
     void purge() {
         ind.clear();
     }
+    std::vector<std::size_t> getIndexMemoryUsage() const {
+        return {sizeof(*this) - sizeof(ind) + ind.getMemoryUsage()};
+    }
     iterator begin() const {
         return iterator(ind.begin());
     }
@@ -716,6 +716,23 @@ public:
         return find(t, context);
     }
 
+    /**
+     * Number of bytes held by the relation, including the cached partition lists
+     * @return the memory usage in bytes
+     */
+    std::size_t getMemoryUsage() const {
+        statesLock.lock_shared();
+
+        std::size_t res = sizeof(*this) - sizeof(sds) - sizeof(equivalencePartition) + sds.getMemoryUsage() +
+                          equivalencePartition.getMemoryUsage();
+        for (auto& e : this->equivalencePartition) {
+            res += e.second->getMemoryUsage();
+        }
+
+        statesLock.unlock_shared();
+        return res;
+    }
+
     void printStats(std::ostream& /* o */) const {}
 
 protected:
@@ -103,6 +103,9 @@ public:
         data.clear();
     }
     void printStatistics(std::ostream& /* o */) const {}
+    std::vector<std::size_t> getIndexMemoryUsage() const {
+        return {sizeof(*this) + data.capacity() * sizeof(Tuple<RamDomain, Arity>)};
+    }
 
 private:
     std::vector<Tuple<RamDomain, Arity>> data;
@@ -51,6 +51,9 @@ public:
     using parenttype =
             btree<Key, Comparator, Allocator, blockSize, SearchStrategy, isSet, WeakComparator, Updater>;
 
+    // nodes created by the insertions of this class are allocated on the heap
+    static_assert(!parenttype::hasArena, "lambda b-trees do not support node arenas");
+
     LambdaBTree(const Comparator& comp = Comparator(), const WeakComparator& weak_comp = WeakComparator())
             : parenttype(comp, weak_comp) {}
 
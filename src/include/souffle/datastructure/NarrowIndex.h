@@ -0,0 +1,340 @@
+/*
+ * Souffle - A Datalog Compiler
+ * Copyright (c) 2026, The Souffle Developers. All rights reserved
+ * Licensed under the Universal Permissive License v 1.0 as shown at:
+ * - https://opensource.org/licenses/UPL
+ * - <souffle root>/licenses/SOUFFLE-UPL.txt
+ */
+
+/************************************************************************
+ *
+ * @file NarrowIndex.h
+ *
+ * Indexes storing tuples in packed 32-bit columns
+ *
+ ***********************************************************************/
+
+#pragma once
+
+#include "souffle/utility/Iteration.h"
+#include "souffle/utility/MiscUtil.h"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+#include <iterator>
+#include <limits>
+#include <tuple>
+#include <vector>
+
+namespace souffle {
+
+/**
+ * Converts tuples between their evaluation type and a packed storage type
+ * made of 32-bit slots.
+ *
+ * Columns holding values that fit into 32 bits, such as symbol or record
+ * identifiers, take one slot and are sign-extended when widened. Storing a
+ * value beyond the range of such a column is a fatal error; only the bounds
+ * of range searches saturate at its limits. Columns listed in WideColumns
+ * take two slots, holding the upper and lower halves of the value, if the
+ * column type is wider than 32 bits.
+ *
+ * @tparam Tuple       .. the evaluation type, an array of integral columns
+ * @tparam WideColumns .. the mask of the columns keeping their full width
+ */
+template <typename Tuple, uint64_t WideColumns = 0>
+struct narrow_codec {
+    using wide_type = Tuple;
+    using column_type = typename Tuple::value_type;
+
+    static constexpr std::size_t arity = std::tuple_size<Tuple>::value;
+
+    static_assert(arity <= 64, "columns must fit the mask of wide columns");
+
+    static constexpr bool isWide(std::size_t column) {
+        return sizeof(column_type) > sizeof(uint32_t) && ((WideColumns >> column) & 1) != 0;
+    }
+
+    static constexpr std::size_t countSlots() {
+        std::size_t slots = 0;
+        for (std::size_t c = 0; c < arity; ++c) {
+            slots += isWide(c) ? 2 : 1;
+        }
+        return slots;
+    }
+
+    static constexpr std::size_t slots = countSlots();
+
+    using stored_type = std::array<uint32_t, slots>;
+
+    /** Checks whether a value fits into the range of a narrow column */
+    static bool fits(column_type value) {
+        const auto wide = static_cast<int64_t>(value);
+        return std::numeric_limits<int32_t>::min() <= wide && wide <= std::numeric_limits<int32_t>::max();
+    }
+
+    /** Checks whether the narrow columns of a tuple can be stored without loss */
+    static bool fits(const Tuple& t) {
+        for (std::size_t c = 0; c < arity; ++c) {
+            if (!isWide(c) && !fits(t[c])) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    /**
+     * Clamps a value to the range of a narrow column. Only the bounds of range searches
+     * are clamped, such as those leaving a column unconstrained.
+     */
+    static int32_t saturate(column_type value) {
+        const auto wide = static_cast<int64_t>(value);
+        if (wide < std::numeric_limits<int32_t>::min()) {
+            return std::numeric_limits<int32_t>::min();
+        }
+        if (wide > std::numeric_limits<int32_t>::max()) {
+            return std::numeric_limits<int32_t>::max();
+        }
+        return static_cast<int32_t>(wide);
+    }
+
+    /** Narrows a tuple to be stored, which must fit into its narrow columns */
+    static stored_type narrow(const Tuple& t) {
+        if (!fits(t)) {
+            fatal("value out of range of a 32-bit column of a narrow index");
+        }
+        return narrowBound(t);
+    }
+
+    /** Narrows the bound of a range search, saturating the narrow columns */
+    static stored_type narrowBound(const Tuple& t) {
+        stored_type res{};
+        std::size_t slot = 0;
+        for (std::size_t c = 0; c < arity; ++c) {
+            if (isWide(c)) {
+                const auto value = static_cast<uint64_t>(t[c]);
+                res[slot++] = static_cast<uint32_t>(value >> 32);
+                res[slot++] = static_cast<uint32_t>(value);
+            } else {
+                res[slot++] = static_cast<uint32_t>(saturate(t[c]));
+            }
+        }
+        return res;
+    }
+
+    static Tuple widen(const stored_type& s) {
+        Tuple res{};
+        std::size_t slot = 0;
+        for (std::size_t c = 0; c < arity; ++c) {
+            if (isWide(c)) {
+                const uint64_t upper = s[slot++];
+                res[c] = static_cast<column_type>((upper << 32) | s[slot++]);
+            } else {
+                res[c] = static_cast<column_type>(static_cast<int32_t>(s[slot++]));
+            }
+        }
+        return res;
+    }
+};
+
+/**
+ * Orders stored tuples by the order of a comparator of their evaluation type.
+ */
+template <typename Codec, typename Comparator>
+struct narrow_comparator {
+    using stored_type = typename Codec::stored_type;
+
+    int operator()(const stored_type& a, const stored_type& b) const {
+        return comp(Codec::widen(a), Codec::widen(b));
+    }
+
+    bool less(const stored_type& a, const stored_type& b) const {
+        return comp.less(Codec::widen(a), Codec::widen(b));
+    }
+
+    bool equal(const stored_type& a, const stored_type& b) const {
+        return comp.equal(Codec::widen(a), Codec::widen(b));
+    }
+
+    Comparator comp;
+};
+
+/**
+ * An index storing tuples in packed columns, presenting the interface of the
+ * underlying tree for tuples of the evaluation type.
+ *
+ * Tuples are narrowed when inserted or searched and widened when iterated;
+ * iterators yield tuples by value. Tuples beyond the range of the narrow
+ * columns are never contained; inserting one is a fatal error.
+ *
+ * @tparam Codec .. the narrow_codec converting between stored and evaluated tuples
+ * @tparam Tree  .. a b-tree of stored tuples, ordered by a narrow_comparator
+ */
+template <typename Codec, typename Tree>
+class narrow_index {
+public:
+    using element_type = typename Codec::wide_type;
+    using stored_type = typename Codec::stored_type;
+    using size_type = std::size_t;
+    using operation_hints = typename Tree::operation_hints;
+
+    /**
+     * An iterator widening the stored tuples of the tree.
+     */
+    class iterator {
+        typename Tree::iterator it;
+
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = element_type;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const element_type*;
+        using reference = element_type;
+
+        iterator() = default;
+
+        explicit iterator(typename Tree::iterator it) : it(std::move(it)) {}
+
+        element_type operator*() const {
+            return Codec::widen(*it);
+        }
+
+        iterator& operator++() {
+            ++it;
+            return *this;
+        }
+
+        iterator operator++(int) {
+            auto res = *this;
+            ++it;
+            return res;
+        }
+
+        bool operator==(const iterator& other) const {
+            return it == other.it;
+        }
+
+        bool operator!=(const iterator& other) const {
+            return it != other.it;
+        }
+
+        const typename Tree::iterator& base() const {
+            return it;
+        }
+    };
+
+    using chunk = range<iterator>;
+
+    bool empty() const {
+        return tree.empty();
+    }
+
+    size_type size() const {
+        return tree.size();
+    }
+
+    bool insert(const element_type& t) {
+        return tree.insert(Codec::narrow(t));
+    }
+
+    bool insert(const element_type& t, operation_hints& hints) {
+        return tree.insert(Codec::narrow(t), hints);
+    }
+
+    /**
+     * Inserts the given range of elements, which must be sorted in the order of this
+     * index, and calls the given function on each element that was not present before.
+     */
+    template <typename Iter, typename F>
+    void insertSorted(const Iter& a, const Iter& b, F&& onInsert) {
+        std::vector<stored_type> stored;
+        for (auto it = a; it != b; ++it) {
+            stored.push_back(Codec::narrow(*it));
+        }
+        tree.insertSorted(stored.begin(), stored.end(),
+                [&](const stored_type& s) { onInsert(Codec::widen(s)); });
+    }
+
+    template <typename Iter>
+    void insertSorted(const Iter& a, const Iter& b) {
+        insertSorted(a, b, [](const element_type&) {});
+    }
+
+    bool contains(const element_type& t) const {
+        return Codec::fits(t) && tree.contains(Codec::narrow(t));
+    }
+
+    bool contains(const element_type& t, operation_hints& hints) const {
+        return Codec::fits(t) && tree.contains(Codec::narrow(t), hints);
+    }
+
+    iterator find(const element_type& t) const {
+        return Codec::fits(t) ? iterator(tree.find(Codec::narrow(t))) : end();
+    }
+
+    iterator find(const element_type& t, operation_hints& hints) const {
+        return Codec::fits(t) ? iterator(tree.find(Codec::narrow(t), hints)) : end();
+    }
+
+    iterator lower_bound(const element_type& t) const {
+        return iterator(tree.lower_bound(Codec::narrowBound(t)));
+    }
+
+    iterator lower_bound(const element_type& t, operation_hints& hints) const {
+        return iterator(tree.lower_bound(Codec::narrowBound(t), hints));
+    }
+
+    iterator upper_bound(const element_type& t) const {
+        return iterator(tree.upper_bound(Codec::narrowBound(t)));
+    }
+
+    iterator upper_bound(const element_type& t, operation_hints& hints) const {
+        return iterator(tree.upper_bound(Codec::narrowBound(t), hints));
+    }
+
+    iterator begin() const {
+        return iterator(tree.begin());
+    }
+
+    iterator end() const {
+        return iterator(tree.end());
+    }
+
+    /** Counts the elements between the two given iterators */
+    size_type distance(const iterator& from, const iterator& to) const {
+        return tree.distance(from.base(), to.base());
+    }
+
+    std::vector<chunk> partition(size_type num) const {
+        return getChunks(num);
+    }
+
+    std::vector<chunk> getChunks(size_type num) const {
+        std::vector<chunk> res;
+        for (const auto& cur : tree.getChunks(num)) {
+            res.push_back(chunk(iterator(cur.begin()), iterator(cur.end())));
+        }
+        return res;
+    }
+
+    void clear() {
+        tree.clear();
+    }
+
+    size_type getMemoryUsage() const {
+        return tree.getMemoryUsage();
+    }
+
+    void printStats(std::ostream& out = std::cout) const {
+        out << "  Stored tuple size: " << sizeof(stored_type) << " bytes (vs " << sizeof(element_type)
+            << " evaluated)\n";
+        tree.printStats(out);
+    }
+
+private:
+    Tree tree;
+};
+
+}  // end namespace souffle
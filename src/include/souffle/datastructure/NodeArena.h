@@ -0,0 +1,239 @@
+/*
+ * Souffle - A Datalog Compiler
+ * Copyright (c) 2026, The Souffle Developers. All rights reserved
+ * Licensed under the Universal Permissive License v 1.0 as shown at:
+ * - https://opensource.org/licenses/UPL
+ * - <souffle root>/licenses/SOUFFLE-UPL.txt
+ */
+
+/************************************************************************
+ *
+ * @file NodeArena.h
+ *
+ * An arena allocating the nodes of a data structure from per-thread slabs
+ *
+ ***********************************************************************/
+
+#pragma once
+
+#include "souffle/utility/ParallelUtil.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <utility>
+#include <vector>
+
+#if defined(__linux__)
+#include <sys/mman.h>
+#endif
+
+namespace souffle {
+
+/**
+ * An arena handing out memory for the nodes of a data structure.
+ *
+ * Every thread of a parallel region bumps a pointer through a slab of its own,
+ * so allocations do not contend; slabs grow from a page up to the size of a
+ * huge page, which the largest slabs are advised to be backed by. Nodes are
+ * never freed one by one: releasing the arena drops all its slabs at once, in
+ * time independent of the number of nodes.
+ *
+ * Data structures select the arena to allocate from by opening a Scope on it
+ * in the operations creating nodes.
+ */
+class NodeArena {
+public:
+    /** The size of the first slab of a thread */
+    static constexpr std::size_t minSlabSize = std::size_t(4) << 10;
+
+    /** The size of the largest slabs, the size of a transparent huge page */
+    static constexpr std::size_t maxSlabSize = std::size_t(2) << 20;
+
+    /**
+     * Makes the given arena the one nodes are allocated from by the current
+     * thread until the end of the scope.
+     */
+    class Scope {
+    public:
+        explicit Scope(NodeArena& arena) : previous(active()) {
+            active() = &arena;
+        }
+
+        Scope(const Scope&) = delete;
+        Scope& operator=(const Scope&) = delete;
+
+        ~Scope() {
+            active() = previous;
+        }
+
+    private:
+        NodeArena* previous;
+    };
+
+    NodeArena() : numLanes(std::max<std::size_t>(1, MAX_THREADS)), lanes(new Lane[numLanes]) {}
+
+    NodeArena(const NodeArena&) = delete;
+    NodeArena& operator=(const NodeArena&) = delete;
+
+    NodeArena(NodeArena&& other) : NodeArena() {
+        swap(other);
+    }
+
+    ~NodeArena() {
+        release();
+    }
+
+    /** Obtains the arena nodes are allocated from by the current thread. */
+    static NodeArena& current() {
+        assert(active() != nullptr && "no arena to allocate nodes from");
+        return *active();
+    }
+
+    /**
+     * Enables or disables the advice to back the largest slabs of all arenas by
+     * transparent huge pages.
+     */
+    static void setHugePages(bool enable) {
+        hugePages().store(enable, std::memory_order_relaxed);
+    }
+
+    /**
+     * Allocates the given number of bytes at the given alignment. The memory
+     * remains valid until the arena is released.
+     */
+    void* allocate(std::size_t size, std::size_t alignment = alignof(std::max_align_t)) {
+        assert(size + alignment <= maxSlabSize && "node exceeds the size of a slab");
+        const std::size_t lane = threadLane();
+        if (lane < numLanes) {
+            return allocate(lanes[lane], size, alignment);
+        }
+        // threads outside of a parallel region or beyond the lanes of the arena share a lane
+        std::lock_guard<std::mutex> guard(sharedLock);
+        return allocate(shared, size, alignment);
+    }
+
+    /** Frees all memory of this arena, invalidating all nodes allocated from it. */
+    void release() {
+        for (const auto& slab : slabs) {
+            std::free(slab);
+        }
+        slabs.clear();
+        for (std::size_t i = 0; i < numLanes; ++i) {
+            lanes[i] = Lane();
+        }
+        shared = Lane();
+        reserved.store(0, std::memory_order_relaxed);
+    }
+
+    /** Swaps the memory of this arena with the given one. */
+    void swap(NodeArena& other) {
+        std::swap(numLanes, other.numLanes);
+        std::swap(lanes, other.lanes);
+        std::swap(shared, other.shared);
+        std::swap(slabs, other.slabs);
+        const std::size_t bytes = reserved.load(std::memory_order_relaxed);
+        reserved.store(other.reserved.load(std::memory_order_relaxed), std::memory_order_relaxed);
+        other.reserved.store(bytes, std::memory_order_relaxed);
+    }
+
+    /** Obtains the number of bytes of the slabs held by this arena. */
+    std::size_t getMemoryUsage() const {
+        return sizeof(*this) + numLanes * sizeof(Lane) + reserved.load(std::memory_order_relaxed);
+    }
+
+private:
+    /** The slab a thread currently allocates from */
+    struct alignas(hardware_destructive_interference_size) Lane {
+        char* next = nullptr;
+        char* end = nullptr;
+        std::size_t slabSize = 0;
+    };
+
+    static NodeArena*& active() {
+        static thread_local NodeArena* arena = nullptr;
+        return arena;
+    }
+
+    static std::atomic<bool>& hugePages() {
+        static std::atomic<bool> enabled{true};
+        return enabled;
+    }
+
+    static std::size_t threadLane() {
+#ifdef IS_PARALLEL
+        // thread numbers identify threads only within a single parallel region
+        if (omp_get_level() != 1 || omp_get_active_level() != 1) {
+            return std::numeric_limits<std::size_t>::max();
+        }
+        return static_cast<std::size_t>(omp_get_thread_num());
+#else
+        return 0;
+#endif
+    }
+
+    void* allocate(Lane& lane, std::size_t size, std::size_t alignment) {
+        auto aligned = [&](char* ptr) {
+            const auto address = reinterpret_cast<std::uintptr_t>(ptr);
+            return reinterpret_cast<char*>((address + alignment - 1) & ~(alignment - 1));
+        };
+        char* res = aligned(lane.next);
+        if (lane.next == nullptr || res + size > lane.end) {
+            // slabs of a lane double in size up to a huge page
+            lane.slabSize = std::min(maxSlabSize, std::max(minSlabSize, 2 * lane.slabSize));
+            lane.next = newSlab(lane.slabSize);
+            lane.end = lane.next + lane.slabSize;
+            res = aligned(lane.next);
+        }
+        lane.next = res + size;
+        return res;
+    }
+
+    char* newSlab(std::size_t size) {
+        void* slab = std::aligned_alloc(std::min(size, maxSlabSize), size);
+        if (slab == nullptr) {
+            throw std::bad_alloc();
+        }
+#if defined(__linux__) && defined(MADV_HUGEPAGE)
+        if (size == maxSlabSize && hugePages().load(std::memory_order_relaxed)) {
+            madvise(slab, size, MADV_HUGEPAGE);
+        }
+#endif
+        {
+            std::lock_guard<std::mutex> guard(slabLock);
+            slabs.push_back(slab);
+        }
+        reserved.fetch_add(size, std::memory_order_relaxed);
+        return static_cast<char*>(slab);
+    }
+
+    // the number of per-thread lanes
+    std::size_t numLanes;
+
+    // the slab each thread allocates from
+    std::unique_ptr<Lane[]> lanes;
+
+    // the slab shared by the threads without a lane of their own
+    Lane shared;
+
+    // a lock guarding the shared lane
+    std::mutex sharedLock;
+
+    // a lock guarding the list of slabs
+    std::mutex slabLock;
+
+    // the slabs of this arena
+    std::vector<void*> slabs;
+
+    // the number of bytes of all slabs
+    std::atomic<std::size_t> reserved{0};
+};
+
+}  // end namespace souffle
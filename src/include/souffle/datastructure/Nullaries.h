@@ -103,6 +103,9 @@ public:
         data = false;
     }
     void printStatistics(std::ostream& /* o */) const {}
+    std::vector<std::size_t> getIndexMemoryUsage() const {
+        return {sizeof(*this)};
+    }
 };
 
 }  // namespace souffle
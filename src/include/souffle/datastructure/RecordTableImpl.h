@@ -346,6 +346,7 @@ public:
     virtual const RamDomain* unpack(RamDomain index) const = 0;
     virtual void enumerate(const std::function<void(const RamDomain* /*tuple*/, std::size_t /* arity*/,
                     RamDomain /* key */)>& Callback) const = 0;
+    virtual std::size_t getMemoryUsage() const = 0;
 };
 
 /** @brief Bidirectional mappping between records and record references, for any record arity. */
@@ -400,6 +401,15 @@ public:
             Callback(tuple.data(), Arity, key);
         }
     }
+
+    std::size_t getMemoryUsage() const override {
+        std::size_t bytes = Base::getMemoryUsage();
+        const auto End = end();
+        for (auto It = begin(); It != End; ++It) {
+            bytes += It->first.capacity() * sizeof(RamDomain);
+        }
+        return bytes;
+    }
 };
 
 /** @brief Bidirectional mappping between records and record references, specialized for a record arity. */
@@ -459,6 +469,10 @@ public:
             Callback(tuple.data(), Arity, key);
         }
     }
+
+    std::size_t getMemoryUsage() const override {
+        return Base::getMemoryUsage();
+    }
 };
 
 /** Record map specialized for arity 0 */
@@ -504,6 +518,10 @@ public:
 
     void enumerate(const std::function<void(const RamDomain* /*tuple*/, std::size_t /* arity*/,
                     RamDomain /* key */)>&) const override {}
+
+    std::size_t getMemoryUsage() const override {
+        return sizeof(*this);
+    }
 };
 
 /** A concurrent Record Table with some specialized record maps. */
@@ -588,6 +606,17 @@ public:
         }
     }
 
+    std::size_t getMemoryUsage() const override {
+        auto Guard = Lanes.guard();
+        std::size_t Bytes = sizeof(*this) + Maps.capacity() * sizeof(RecordMap*);
+        for (const RecordMap* Map : Maps) {
+            if (Map != nullptr) {
+                Bytes += Map->getMemoryUsage();
+            }
+        }
+        return Bytes;
+    }
+
 private:
     /** @brief lookup RecordMap for a given arity; the map for that arity must exist. */
     RecordMap& lookupMap(const std::size_t Arity) const {
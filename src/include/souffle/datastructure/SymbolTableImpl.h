@@ -124,10 +124,35 @@ public:
         return decode(index);
     }
 
+    void encodeBatch(const std::string* symbols, std::size_t count, RamDomain* indices) override {
+        for (std::size_t i = 0; i < count; ++i) {
+            indices[i] = Base::findOrInsert(symbols[i]).first;
+        }
+    }
+
+    void decodeBatch(const RamDomain* indices, std::size_t count, std::string* symbols) const override {
+        for (std::size_t i = 0; i < count; ++i) {
+            symbols[i] = Base::fetch(indices[i]);
+        }
+    }
+
     std::pair<RamDomain, bool> findOrInsert(const std::string& symbol) override {
         auto Res = Base::findOrInsert(symbol);
         return std::make_pair(static_cast<RamDomain>(Res.first), Res.second);
     }
+
+    std::size_t getMemoryUsage() const override {
+        std::size_t bytes = Base::getMemoryUsage();
+        // only symbols exceeding the small string buffer own a separate allocation
+        const std::size_t inlineCapacity = std::string().capacity();
+        const auto End = Base::end();
+        for (auto It = Base::begin(); It != End; ++It) {
+            if (It->first.capacity() > inlineCapacity) {
+                bytes += It->first.capacity() + 1;
+            }
+        }
+        return bytes;
+    }
 };
 
 }  // namespace souffle
@@ -108,6 +108,10 @@ public:
         return count;
     }
 
+    std::size_t getMemoryUsage() const {
+        return sizeof(*this) + (count + blockSize - 1) / blockSize * sizeof(Block);
+    }
+
     const T& insert(const T& element) {
         // check whether the head is initialized
         if (!head) {
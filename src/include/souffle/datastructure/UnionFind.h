@@ -73,6 +73,13 @@ public:
         return sz;
     };
 
+    /**
+     * Return the number of bytes held by this disjoint set
+     */
+    std::size_t getMemoryUsage() const {
+        return sizeof(*this) - sizeof(a_blocks) + a_blocks.getMemoryUsage();
+    }
+
     /**
      * Yield reference to the node by its node index
      * @param node node to be searched
@@ -327,6 +334,14 @@ public:
         return ds.size();
     };
 
+    /**
+     * Return the number of bytes held by this disjoint set, including both mappings
+     */
+    std::size_t getMemoryUsage() const {
+        return sizeof(*this) - sizeof(ds) - sizeof(sparseToDenseMap) - sizeof(denseToSparseMap) +
+               ds.getMemoryUsage() + sparseToDenseMap.getMemoryUsage() + denseToSparseMap.getMemoryUsage();
+    }
+
     /**
      * Remove all elements from this disjoint set
      */
@@ -0,0 +1,178 @@
+/*
+ * Souffle - A Datalog Compiler
+ * Copyright (c) 2026, The Souffle Developers. All rights reserved
+ * Licensed under the Universal Permissive License v 1.0 as shown at:
+ * - https://opensource.org/licenses/UPL
+ * - <souffle root>/licenses/SOUFFLE-UPL.txt
+ */
+
+/************************************************************************
+ *
+ * @file Spill.h
+ *
+ * Moves relations that are not needed for a while out of memory and back.
+ *
+ * Spilled tuples are written in their raw encoding: symbols and records
+ * refer to the tables of the running program, so a spill file can only be
+ * read back by the process that wrote it.
+ *
+ ***********************************************************************/
+
+#pragma once
+
+#include "souffle/RamTypes.h"
+#include "souffle/RecordTable.h"
+#include "souffle/SymbolTable.h"
+#include "souffle/io/ReadStream.h"
+#include "souffle/io/WriteStream.h"
+#include "souffle/utility/ContainerUtil.h"
+#include <cstddef>
+#include <filesystem>
+#include <fstream>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+
+#ifdef _MSC_VER
+#include <process.h>
+#else
+#include <unistd.h>
+#endif
+
+namespace souffle {
+
+class WriteStreamSpill : public WriteStream {
+public:
+    WriteStreamSpill(const std::map<std::string, std::string>& rwOperation, const SymbolTable& symbolTable,
+            const RecordTable& recordTable)
+            : WriteStream(rwOperation, symbolTable, recordTable), width(typeAttributes.size()),
+              file(rwOperation.at("filename"), std::ios::binary | std::ios::trunc) {
+        if (!file.is_open()) {
+            throw std::invalid_argument("Cannot open spill file " + rwOperation.at("filename"));
+        }
+    }
+
+protected:
+    void writeNullary() override {}
+
+    void writeNextTuple(const RamDomain* tuple) override {
+        file.write(reinterpret_cast<const char*>(tuple), sizeof(RamDomain) * width);
+    }
+
+    const std::size_t width;
+    std::ofstream file;
+};
+
+class ReadStreamSpill : public ReadStream {
+public:
+    ReadStreamSpill(const std::map<std::string, std::string>& rwOperation, SymbolTable& symbolTable,
+            RecordTable& recordTable)
+            : ReadStream(rwOperation, symbolTable, recordTable), width(typeAttributes.size()),
+              file(rwOperation.at("filename"), std::ios::binary) {
+        if (!file.is_open()) {
+            throw std::invalid_argument("Cannot open spill file " + rwOperation.at("filename"));
+        }
+    }
+
+protected:
+    Own<RamDomain[]> readNextTuple() override {
+        auto tuple = mk<RamDomain[]>(width);
+        if (!file.read(reinterpret_cast<char*>(tuple.get()), sizeof(RamDomain) * width)) {
+            return nullptr;
+        }
+        return tuple;
+    }
+
+    const std::size_t width;
+    std::ifstream file;
+};
+
+/**
+ * Keeps track of spilled relations.
+ *
+ * Relations are identified by their address, so that several programs in one
+ * process can spill relations of the same name.
+ */
+class SpillManager {
+public:
+    static SpillManager& getInstance() {
+        static SpillManager singleton;
+        return singleton;
+    }
+
+    /**
+     * Write the relation to disk and purge it, provided that the resident size of the
+     * process exceeds the "memory-budget" directive (in bytes).
+     */
+    template <typename Rel>
+    void spill(Rel& relation, std::map<std::string, std::string> directives, const SymbolTable& symbolTable,
+            const RecordTable& recordTable) {
+        const std::size_t budget = std::stoull(directives.at("memory-budget"));
+        if (relation.size() == 0 || residentMemory() <= budget) {
+            return;
+        }
+
+        const std::string path = spillPath(&relation, directives.at("name"));
+        directives["filename"] = path;
+        WriteStreamSpill(directives, symbolTable, recordTable).writeAll(relation);
+        relation.purge();
+
+        std::lock_guard<std::mutex> guard(lock);
+        spilled[&relation] = path;
+    }
+
+    /** Read a previously spilled relation back into memory */
+    template <typename Rel>
+    void restore(Rel& relation, std::map<std::string, std::string> directives, SymbolTable& symbolTable,
+            RecordTable& recordTable) {
+        std::string path;
+        {
+            std::lock_guard<std::mutex> guard(lock);
+            auto it = spilled.find(&relation);
+            if (it == spilled.end()) {
+                return;
+            }
+            path = it->second;
+            spilled.erase(it);
+        }
+
+        directives["filename"] = path;
+        ReadStreamSpill(directives, symbolTable, recordTable).readAll(relation);
+        std::filesystem::remove(path);
+    }
+
+    /** Return the resident memory of the process in bytes, or 0 if it cannot be determined */
+    static std::size_t residentMemory() {
+#ifdef __linux__
+        std::ifstream statm("/proc/self/statm");
+        std::size_t size = 0;
+        std::size_t resident = 0;
+        if (statm >> size >> resident) {
+            return resident * static_cast<std::size_t>(sysconf(_SC_PAGESIZE));
+        }
+#endif
+        return 0;
+    }
+
+private:
+    SpillManager() = default;
+
+    static std::string spillPath(const void* relation, const std::string& name) {
+#ifdef _MSC_VER
+        const auto pid = _getpid();
+#else
+        const auto pid = getpid();
+#endif
+        std::stringstream file;
+        file << "souffle-" << pid << "-" << relation << "-" << name << ".spill";
+        return (std::filesystem::temp_directory_path() / file.str()).string();
+    }
+
+    std::mutex lock;
+    std::map<const void*, std::string> spilled;
+};
+
+}  // namespace souffle
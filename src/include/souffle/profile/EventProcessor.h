@@ -576,6 +576,54 @@ public:
 
 } relationReadsProcessor;
 
+/**
+ * Index Searches Processor
+ *
+ * Each event counts the executions of the index operations searching a relation
+ * with one search signature.
+ */
+const class IndexSearchesProcessor : public EventProcessor {
+public:
+    IndexSearchesProcessor() {
+        EventProcessorSingleton::instance().registerEventProcessor("@index-searches", this);
+    }
+    /** process event input */
+    void process(ProfileDatabase& db, const std::vector<std::string>& signature, va_list& args) override {
+        const std::string& relation = signature[1];
+        const std::string& search = signature[2];
+        std::size_t searches = va_arg(args, std::size_t);
+        db.addSizeEntry({"program", "index-searches", relation, search}, searches);
+    }
+
+} indexSearchesProcessor;
+
+/**
+ * Memory Accounting Processor
+ *
+ * Each event attributes bytes to a component of the snapshot taken at the end of a stratum:
+ * either an index of a relation, the symbol table or the record table.
+ */
+const class MemoryProcessor : public EventProcessor {
+public:
+    MemoryProcessor() {
+        EventProcessorSingleton::instance().registerEventProcessor("@memory", this);
+    }
+    /** process event input */
+    void process(ProfileDatabase& db, const std::vector<std::string>& signature, va_list& args) override {
+        const std::string& stratum = signature[1];
+        const std::string& component = signature[2];
+        microseconds time = va_arg(args, microseconds);
+        std::size_t bytes = va_arg(args, std::size_t);
+        db.addTimeEntry({"program", "memory", "stratum", stratum, "time"}, time);
+        if (component == "relation") {
+            db.addSizeEntry(
+                    {"program", "memory", "stratum", stratum, "relation", signature[3], signature[4]}, bytes);
+        } else {
+            db.addSizeEntry({"program", "memory", "stratum", stratum, component}, bytes);
+        }
+    }
+} memoryProcessor;
+
 /**
  * Config entry processor
  */
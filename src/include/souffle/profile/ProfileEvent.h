@@ -85,6 +85,12 @@ public:
         profile::EventProcessorSingleton::instance().process(database, txt.c_str(), number, iteration);
     }
 
+    /** create memory event, attributing bytes to one component of a memory snapshot */
+    void makeMemoryEvent(const std::string& txt, time_point snapshot, std::size_t bytes) {
+        microseconds snapshot_ms = std::chrono::duration_cast<microseconds>(snapshot.time_since_epoch());
+        profile::EventProcessorSingleton::instance().process(database, txt.c_str(), snapshot_ms, bytes);
+    }
+
     void makeNonRecursiveCountEvent(const std::string& txt, double joinSize) {
         profile::EventProcessorSingleton::instance().process(database, txt.c_str(), joinSize);
     }
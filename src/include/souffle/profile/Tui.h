@@ -82,6 +82,23 @@ private:
         }
     };
 
+    /** Bytes held by relations and tables at the end of a stratum */
+    struct MemorySnapshot {
+        std::chrono::microseconds time;
+        std::string stratum;
+        std::map<std::string, std::vector<std::size_t>> relations;
+        std::size_t symbols;
+        std::size_t records;
+
+        std::size_t relationBytes(const std::string& name) const {
+            std::size_t bytes = 0;
+            for (std::size_t index : relations.at(name)) {
+                bytes += index;
+            }
+            return bytes;
+        }
+    };
+
 public:
     Tui(std::string filename, bool live, bool /* gui */) {
         // Set a friendlier output size if we're being interacted with directly.
@@ -186,7 +203,12 @@ public:
                 std::cout << "Invalid parameters to graph command.\n";
             }
         } else if (c[0] == "memory") {
-            memoryUsage();
+            if (c.size() == 2) {
+                memoryRelation(c[1]);
+            } else {
+                memoryUsage();
+                memoryTimeline();
+            }
         } else if (c[0] == "usage") {
             if (c.size() > 1) {
                 if (c[1][0] == 'R') {
@@ -711,6 +733,8 @@ public:
         std::printf("  %-30s%-5s %s\n", "usage [relation id|rule id]", "-",
                 "display CPU usage graphs for a relation or rule.");
         std::printf("  %-30s%-5s %s\n", "memory", "-", "display memory usage.");
+        std::printf("  %-30s%-5s %s\n", "memory <relation>", "-",
+                "display the memory of each index of a relation per stratum.");
         std::printf("  %-30s%-5s %s\n", "help", "-", "print this.");
 
         std::cout << "\nInteractive mode only commands:" << std::endl;
@@ -992,6 +1016,119 @@ public:
         }
         std::cout << std::endl;
     }
+    /** Return the memory snapshots of all strata, ordered by time */
+    std::vector<MemorySnapshot> getMemorySnapshots() {
+        std::vector<MemorySnapshot> snapshots;
+        auto* strata = as<DirectoryEntry>(
+                ProfileEventSingleton::instance().getDB().lookupEntry({"program", "memory", "stratum"}));
+        if (strata == nullptr) {
+            return snapshots;
+        }
+        for (const auto& stratum : strata->getKeys()) {
+            DirectoryEntry* entry = strata->readDirectoryEntry(stratum);
+            MemorySnapshot snapshot{};
+            snapshot.stratum = stratum;
+            if (auto* time = as<TimeEntry>(entry->readEntry("time"))) {
+                snapshot.time = time->getTime();
+            }
+            if (auto* size = as<SizeEntry>(entry->readEntry("symbol-table"))) {
+                snapshot.symbols = size->getSize();
+            }
+            if (auto* size = as<SizeEntry>(entry->readEntry("record-table"))) {
+                snapshot.records = size->getSize();
+            }
+            if (DirectoryEntry* relations = entry->readDirectoryEntry("relation")) {
+                for (const auto& rel : relations->getKeys()) {
+                    DirectoryEntry* indexes = relations->readDirectoryEntry(rel);
+                    auto& usage = snapshot.relations[rel];
+                    for (const auto& index : indexes->getKeys()) {
+                        const std::size_t i = std::stoul(index);
+                        usage.resize(std::max(usage.size(), i + 1));
+                        usage[i] = as<SizeEntry>(indexes->readEntry(index))->getSize();
+                    }
+                }
+            }
+            snapshots.push_back(std::move(snapshot));
+        }
+        std::sort(snapshots.begin(), snapshots.end(),
+                [](const MemorySnapshot& a, const MemorySnapshot& b) { return a.time < b.time; });
+        return snapshots;
+    }
+
+    /** Display the memory held by relations and tables at the end of each stratum */
+    void memoryTimeline(uint32_t barWidth = 20) {
+        std::vector<MemorySnapshot> snapshots = getMemorySnapshots();
+        if (snapshots.empty()) {
+            return;
+        }
+        const auto beginTime = out.getProgramRun()->getStarttime();
+
+        std::vector<std::size_t> totals;
+        std::size_t maxTotal = 1;
+        for (const auto& snapshot : snapshots) {
+            std::size_t total = snapshot.symbols + snapshot.records;
+            for (const auto& rel : snapshot.relations) {
+                total += snapshot.relationBytes(rel.first);
+            }
+            totals.push_back(total);
+            maxTotal = std::max(maxTotal, total);
+        }
+
+        std::cout << "\nAccounted memory at the end of each stratum:\n";
+        std::printf("%8s %8s %10s %10s %10s %10s  %-*s %s\n", "TIME", "STRATUM", "RELATIONS", "SYMBOLS",
+                "RECORDS", "TOTAL", barWidth, "", "LARGEST RELATION");
+        for (std::size_t i = 0; i < snapshots.size(); ++i) {
+            const MemorySnapshot& snapshot = snapshots[i];
+            std::string largest;
+            std::size_t largestBytes = 0;
+            for (const auto& rel : snapshot.relations) {
+                if (largest.empty() || snapshot.relationBytes(rel.first) > largestBytes) {
+                    largest = rel.first;
+                    largestBytes = snapshot.relationBytes(rel.first);
+                }
+            }
+            if (!largest.empty()) {
+                largest += " (" + Tools::formatMemory(largestBytes / 1024) + ")";
+            }
+            const std::size_t relationTotal = totals[i] - snapshot.symbols - snapshot.records;
+            std::printf("%8s %8s %10s %10s %10s %10s  %-*s %s\n",
+                    Tools::formatTime(snapshot.time - beginTime).c_str(), snapshot.stratum.c_str(),
+                    Tools::formatMemory(relationTotal / 1024).c_str(),
+                    Tools::formatMemory(snapshot.symbols / 1024).c_str(),
+                    Tools::formatMemory(snapshot.records / 1024).c_str(),
+                    Tools::formatMemory(totals[i] / 1024).c_str(), barWidth,
+                    std::string(barWidth * totals[i] / maxTotal, '*').c_str(), largest.c_str());
+        }
+    }
+
+    /** Display the memory held by each index of a relation at the end of each stratum */
+    void memoryRelation(const std::string& name) {
+        std::vector<MemorySnapshot> snapshots = getMemorySnapshots();
+        const auto beginTime = out.getProgramRun()->getStarttime();
+        bool found = false;
+        for (const auto& snapshot : snapshots) {
+            auto it = snapshot.relations.find(name);
+            if (it == snapshot.relations.end()) {
+                continue;
+            }
+            if (!found) {
+                std::printf("%8s %8s %10s  %s\n", "TIME", "STRATUM", "TOTAL", "INDEXES");
+                found = true;
+            }
+            std::string indexes;
+            for (std::size_t i = 0; i < it->second.size(); ++i) {
+                indexes += (i > 0 ? " " : "") + std::to_string(i) + ":" +
+                           Tools::formatMemory(it->second[i] / 1024);
+            }
+            std::printf("%8s %8s %10s  %s\n", Tools::formatTime(snapshot.time - beginTime).c_str(),
+                    snapshot.stratum.c_str(),
+                    Tools::formatMemory(snapshot.relationBytes(name) / 1024).c_str(), indexes.c_str());
+        }
+        if (!found) {
+            std::cout << "No memory accounting for relation " << name << ".\n";
+        }
+    }
+
     void setupTabCompletion() {
         linereader.clearTabCompletion();
 
@@ -19,7 +19,11 @@
 #include "souffle/RamTypes.h"
 #include "souffle/utility/StringUtil.h"
 #include "souffle/utility/tinyformat.h"
+#include <algorithm>
 #include <csignal>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
 
 namespace souffle::evaluator {
 
@@ -84,6 +88,57 @@ A symbol2numeric(const std::string& src) {
     }
 };
 
+/**
+ * Finds the least value, not below the given one, that each of the given number of
+ * relations admits, as the leapfrog step of leapfrog triejoin does. The seek maps a
+ * relation and a value to the least value not below it the relation admits, or to
+ * nothing if there is none.
+ */
+template <typename F /* (std::size_t, RamDomain) -> std::optional<RamDomain> */>
+std::optional<RamDomain> leapfrogSeek(RamDomain value, const std::size_t count, F&& seek) {
+    std::size_t agreeing = 0;
+    for (std::size_t i = 0; agreeing < count; i = (i + 1) % count) {
+        const std::optional<RamDomain> next = seek(i, value);
+        if (!next) {
+            return std::nullopt;
+        }
+        if (*next == value) {
+            ++agreeing;
+        } else {
+            value = *next;
+            agreeing = 1;
+        }
+    }
+    return value;
+}
+
+/**
+ * Clears the entries of the given mask of a batch whose values fail the comparison. Each
+ * operand is either a column of the batch or a single value compared with every entry;
+ * the loops have no branches, so that compilers can vectorize them.
+ */
+template <typename A, typename F /* (A, A) -> bool */>
+void maskBatch(std::uint8_t* mask, const std::size_t size, const RamDomain* lhs, const bool lhsColumn,
+        const RamDomain* rhs, const bool rhsColumn, F&& compare) {
+    if (lhsColumn && rhsColumn) {
+        for (std::size_t i = 0; i < size; ++i) {
+            mask[i] &= static_cast<std::uint8_t>(compare(ramBitCast<A>(lhs[i]), ramBitCast<A>(rhs[i])));
+        }
+    } else if (lhsColumn) {
+        const A value = ramBitCast<A>(*rhs);
+        for (std::size_t i = 0; i < size; ++i) {
+            mask[i] &= static_cast<std::uint8_t>(compare(ramBitCast<A>(lhs[i]), value));
+        }
+    } else if (rhsColumn) {
+        const A value = ramBitCast<A>(*lhs);
+        for (std::size_t i = 0; i < size; ++i) {
+            mask[i] &= static_cast<std::uint8_t>(compare(value, ramBitCast<A>(rhs[i])));
+        }
+    } else if (!compare(ramBitCast<A>(*lhs), ramBitCast<A>(*rhs))) {
+        std::fill_n(mask, size, std::uint8_t(0));
+    }
+}
+
 template <typename A>
 bool lxor(A x, A y) {
     return (x || y) && (!x != !y);
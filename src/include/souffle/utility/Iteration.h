@@ -18,6 +18,7 @@
 
 #include "souffle/utility/Types.h"
 
+#include <cstddef>
 #include <iterator>
 #include <type_traits>
 #include <utility>
@@ -329,6 +330,33 @@ range<Iter> make_range(const Iter& a, const Iter& b) {
     return range<Iter>(a, b);
 }
 
+namespace detail {
+/**
+ * Detects containers counting the elements between two of their iterators in
+ * logarithmic time, such as the B-tree.
+ */
+template <typename C, typename = void>
+struct has_range_count : std::false_type {};
+
+template <typename C>
+struct has_range_count<C, std::void_t<decltype(std::declval<const C&>().distance(
+                                  std::declval<typename C::iterator>(), std::declval<typename C::iterator>()))>>
+        : std::true_type {};
+}  // namespace detail
+
+/**
+ * Counts the elements of a range of the given container; takes logarithmic
+ * time if the container supports it, linear time otherwise.
+ */
+template <typename C>
+std::size_t countRange(const C& container, const range<typename C::iterator>& r) {
+    if constexpr (detail::has_range_count<C>::value) {
+        return container.distance(r.begin(), r.end());
+    } else {
+        return static_cast<std::size_t>(std::distance(r.begin(), r.end()));
+    }
+}
+
 template <typename Iter, typename F>
 auto makeTransformRange(Iter&& begin, Iter&& end, F const& f) {
     return make_range(transformIter(std::forward<Iter>(begin), f), transformIter(std::forward<Iter>(end), f));
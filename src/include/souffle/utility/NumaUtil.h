@@ -0,0 +1,161 @@
+/*
+ * Souffle - A Datalog Compiler
+ * Copyright (c) 2026, The Souffle Developers. All rights reserved
+ * Licensed under the Universal Permissive License v 1.0 as shown at:
+ * - https://opensource.org/licenses/UPL
+ * - <souffle root>/licenses/SOUFFLE-UPL.txt
+ */
+
+/************************************************************************
+ *
+ * @file NumaUtil.h
+ *
+ * Placement of worker threads and partitioned scans on NUMA machines
+ *
+ ***********************************************************************/
+
+#pragma once
+
+#include "souffle/utility/ParallelUtil.h"
+
+#include <cstddef>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#if defined(__linux__) && defined(IS_PARALLEL) && _OPENMP >= 200805
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+namespace souffle {
+
+/**
+ * The NUMA nodes of the machine and the CPUs belonging to each of them, as
+ * reported by the kernel. Machines without NUMA information, or platforms
+ * other than Linux, appear as a single node.
+ */
+class NumaTopology {
+public:
+    /**
+     * Parses a CPU list of the kernel, e.g. "0-3,8,10-11", into the listed CPUs.
+     * Malformed entries are skipped.
+     */
+    static std::vector<std::size_t> parseCpuList(const std::string& list) {
+        std::vector<std::size_t> res;
+        std::stringstream in(list);
+        std::string item;
+        while (std::getline(in, item, ',')) {
+            try {
+                const std::size_t dash = item.find('-');
+                const std::size_t first = std::stoul(item.substr(0, dash));
+                const std::size_t last =
+                        dash == std::string::npos ? first : std::stoul(item.substr(dash + 1));
+                for (std::size_t cpu = first; cpu <= last; ++cpu) {
+                    res.push_back(cpu);
+                }
+            } catch (...) {
+                // not a CPU or a range of CPUs
+            }
+        }
+        return res;
+    }
+
+    /** Obtains the topology of this machine. */
+    static const NumaTopology& instance() {
+        static const NumaTopology topology = read("/sys/devices/system/node");
+        return topology;
+    }
+
+    /** Reads the topology from the node directory of sysfs at the given path. */
+    static NumaTopology read(const std::string& path) {
+        NumaTopology res;
+        for (std::size_t node : parseCpuList(readLine(path + "/online"))) {
+            auto cpus = parseCpuList(readLine(path + "/node" + std::to_string(node) + "/cpulist"));
+            if (!cpus.empty()) {
+                res.nodes.push_back(std::move(cpus));
+            }
+        }
+        return res;
+    }
+
+    /** Obtains the number of nodes holding CPUs, at least one. */
+    std::size_t getNumNodes() const {
+        return nodes.empty() ? 1 : nodes.size();
+    }
+
+    /** Obtains the CPUs of the given node; empty if the CPUs of the machine are unknown. */
+    const std::vector<std::size_t>& getCpus(std::size_t node) const {
+        static const std::vector<std::size_t> unknown;
+        return node < nodes.size() ? nodes[node] : unknown;
+    }
+
+    /**
+     * Obtains the node of the given thread among the given number of threads.
+     * Threads are placed in blocks, such that consecutive thread numbers, which
+     * process adjacent partitions under a static schedule, share a node.
+     */
+    std::size_t getNodeOfThread(std::size_t thread, std::size_t numThreads) const {
+        if (numThreads == 0) {
+            return 0;
+        }
+        return (thread % numThreads) * getNumNodes() / numThreads;
+    }
+
+private:
+    static std::string readLine(const std::string& file) {
+        std::ifstream in(file);
+        std::string line;
+        std::getline(in, line);
+        return line;
+    }
+
+    // the CPUs of each node
+    std::vector<std::vector<std::size_t>> nodes;
+};
+
+/**
+ * Enables or disables NUMA-aware placement for the parallel regions started by
+ * the calling thread.
+ *
+ * When enabled, the threads of the OpenMP team are pinned to the CPUs of the
+ * node given by NumaTopology::getNodeOfThread, and the partitions of parallel
+ * scans are handed out in contiguous blocks, one per thread, rather than
+ * dynamically. Each thread thus scans the same key range in every iteration
+ * of a fixpoint, while the nodes it allocates, from its own lane of the node
+ * arena of a b-tree, are first touched on its node. Otherwise partitions are
+ * scheduled dynamically and threads float freely.
+ */
+inline void setNumaPlacement(bool enable) {
+#if defined(IS_PARALLEL) && _OPENMP >= 200805
+    if (!enable) {
+        omp_set_schedule(omp_sched_dynamic, 1);
+        return;
+    }
+    omp_set_schedule(omp_sched_static, 0);
+#if defined(__linux__)
+    const auto& topology = NumaTopology::instance();
+    if (topology.getNumNodes() < 2) {
+        return;
+    }
+    // the threads of the team persist across parallel regions, and so does their affinity
+    PARALLEL_START
+        const auto thread = static_cast<std::size_t>(omp_get_thread_num());
+        const auto numThreads = static_cast<std::size_t>(omp_get_num_threads());
+        cpu_set_t cpus;
+        CPU_ZERO(&cpus);
+        for (std::size_t cpu : topology.getCpus(topology.getNodeOfThread(thread, numThreads))) {
+            if (cpu < CPU_SETSIZE) {
+                CPU_SET(cpu, &cpus);
+            }
+        }
+        pthread_setaffinity_np(pthread_self(), sizeof(cpus), &cpus);
+    PARALLEL_END
+#endif
+#else
+    (void)enable;
+#endif
+}
+
+}  // end namespace souffle
@@ -62,6 +62,9 @@ constexpr std::size_t hardware_destructive_interference_size = 2 * sizeof(max_al
 
 // support for parallel loops
 #define pfor __pragma(omp for schedule(dynamic)) for
+
+// support for parallel loops over the partitions of a relation, scheduled as set by setNumaPlacement
+#define pfor_partitions __pragma(omp for schedule(runtime)) for
 #else
 // support for a parallel region
 #define PARALLEL_START _Pragma("omp parallel") {
@@ -69,6 +72,9 @@ constexpr std::size_t hardware_destructive_interference_size = 2 * sizeof(max_al
 
 // support for parallel loops
 #define pfor _Pragma("omp for schedule(dynamic)") for
+
+// support for parallel loops over the partitions of a relation, scheduled as set by setNumaPlacement
+#define pfor_partitions _Pragma("omp for schedule(runtime)") for
 #endif
 
 // spawn and sync are processed sequentially (overhead to expensive)
@@ -99,6 +105,7 @@ constexpr std::size_t hardware_destructive_interference_size = 2 * sizeof(max_al
 
 // support for parallel loops => simple sequential loop
 #define pfor for
+#define pfor_partitions for
 
 // spawn and sync not supported
 #define task_spawn
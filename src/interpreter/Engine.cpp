@@ -25,6 +25,7 @@
 
 #include "interpreter/LLMQueryRelationWrapper.h"
 
+#include "ram/AbstractAggregate.h"
 #include "ram/Aggregate.h"
 #include "ram/Aggregator.h"
 #include "ram/Assign.h"
@@ -32,6 +33,7 @@
 #include "ram/Break.h"
 #include "ram/Call.h"
 #include "ram/Clear.h"
+#include "ram/Compact.h"
 #include "ram/Conjunction.h"
 #include "ram/Constraint.h"
 #include "ram/DebugInfo.h"
@@ -46,6 +48,7 @@
 #include "ram/IfExists.h"
 #include "ram/IndexAggregate.h"
 #include "ram/IndexIfExists.h"
+#include "ram/IndexOperation.h"
 #include "ram/IndexScan.h"
 #include "ram/Insert.h"
 #include "ram/IntrinsicAggregator.h"
@@ -54,6 +57,7 @@
 #include "ram/LogSize.h"
 #include "ram/LogTimer.h"
 #include "ram/Loop.h"
+#include "ram/Merge.h"
 #include "ram/MergeExtend.h"
 #include "ram/Negation.h"
 #include "ram/NestedIntrinsicOperator.h"
@@ -93,14 +97,17 @@
 #include "souffle/SignalHandler.h"
 #include "souffle/SymbolTable.h"
 #include "souffle/TypeAttribute.h"
+#include "souffle/datastructure/BloomFilter.h"
 #include "souffle/datastructure/RecordTableImpl.h"
 #include "souffle/datastructure/SymbolTableImpl.h"
 #include "souffle/io/IOSystem.h"
 #include "souffle/io/ReadStream.h"
+#include "souffle/io/Spill.h"
 #include "souffle/io/WriteStream.h"
 #include "souffle/profile/Logger.h"
 #include "souffle/profile/ProfileEvent.h"
 #include "souffle/utility/EvaluatorUtil.h"
+#include "souffle/utility/NumaUtil.h"
 #include "souffle/utility/ParallelUtil.h"
 #include "souffle/utility/StringUtil.h"
 
@@ -148,6 +155,11 @@ namespace souffle::interpreter {
 #endif
 #endif
 
+// Dispatch through label addresses where the compiler supports computed goto.
+#if defined(__GNUC__) || defined(__clang__)
+#define SOUFFLE_THREADED_DISPATCH
+#endif
+
 namespace {
 constexpr RamDomain RAM_BIT_SHIFT_MASK = RAM_DOMAIN_SIZE - 1;
 
@@ -303,11 +315,19 @@ RamDomain callStateless(ExecuteFn&& execute, Context& ctxt, Shadow& shadow, souf
     }
 }
 
+/** Check whether the aggregate merely counts the tuples it ranges over */
+bool isPlainCount(const ram::AbstractAggregate& aggregate) {
+    const auto* ia = as<ram::IntrinsicAggregator>(aggregate.getAggregator());
+    return ia != nullptr && ia->getFunction() == AggregateOp::COUNT &&
+           isA<ram::True>(aggregate.getCondition());
+}
+
 }  // namespace
 
 Engine::Engine(ram::TranslationUnit& tUnit, const std::size_t numberOfThreadsOrZero)
         : tUnit(tUnit), global(tUnit.global()), profileEnabled(global.config().has("profile")),
           frequencyCounterEnabled(global.config().has("profile-frequency")),
+          vectorizeEnabled(global.config().has("vectorize")),
           numOfThreads(number_of_threads(numberOfThreadsOrZero)),
           isa(tUnit.getAnalysis<ram::analysis::IndexAnalysis>()), recordTable(numOfThreads),
           symbolTable(numOfThreads), regexCache(numOfThreads) {}
@@ -375,6 +395,13 @@ void Engine::createRelation(const ram::Relation& id, const std::size_t idx) {
             res = createEqrelRelation(id, isa.getIndexSelection(id.getName()));
         } else if (id.getRepresentation() == RelationRepresentation::BTREE_DELETE) {
             res = createBTreeDeleteRelation(id, isa.getIndexSelection(id.getName()));
+        } else if (id.getRepresentation() == RelationRepresentation::BTREE_COMPRESSED &&
+                   id.getAuxiliaryArity() == 0) {
+            res = createBTreeCompressedRelation(id, isa.getIndexSelection(id.getName()));
+        } else if (id.getRepresentation() == RelationRepresentation::HASHSET) {
+            res = createHashsetRelation(id, isa.getIndexSelection(id.getName()));
+        } else if (hasNarrowStorage(global, id)) {
+            res = createBTreeNarrowRelation(id, isa.getIndexSelection(id.getName()));
         } else {
             res = createBTreeRelation(id, isa.getIndexSelection(id.getName()));
         }
@@ -456,6 +483,8 @@ void Engine::executeMain() {
      * must be able to find actual functions for each user-defined functor. */
     loadDLL();
 
+    setNumaPlacement(global.config().has("numa"));
+
     generateIR();
     assert(main != nullptr && "Executing an empty program");
 
@@ -490,6 +519,11 @@ void Engine::executeMain() {
         }
         ProfileEventSingleton::instance().makeConfigRecord("relationCount", std::to_string(relationCount));
 
+        // Store counters of index operations
+        if (frequencyCounterEnabled) {
+            visit(program, [&](const ram::IndexOperation& op) { searches[&op] = 0; });
+        }
+
         // Store count of rules
         std::size_t ruleCount = 0;
         visit(program, [&](const ram::Query&) { ++ruleCount; });
@@ -510,10 +544,44 @@ void Engine::executeMain() {
             ProfileEventSingleton::instance().makeQuantityEvent(
                     "@relation-reads;" + cur.first, cur.second, 0);
         }
+        // operations searching a relation with the same signature share an index
+        std::map<std::string, std::size_t> searchCounts;
+        for (auto const& [op, count] : searches) {
+            const std::string signature = toString(isa.getSearchSignature(op));
+            searchCounts["@index-searches;" + op->getRelation() + ";" + signature] += count;
+        }
+        for (auto const& cur : searchCounts) {
+            ProfileEventSingleton::instance().makeQuantityEvent(cur.first, cur.second, 0);
+        }
     }
     SignalHandler::instance()->reset();
 }
 
+void Engine::countSearch(const ram::IndexOperation& op) {
+    if (profileEnabled && frequencyCounterEnabled) {
+        searches.at(&op)++;
+    }
+}
+
+void Engine::profileMemoryUsage(const std::string& stratum) {
+    const std::string prefix = "@memory;" + stratum.substr(stratum.find('_') + 1) + ";";
+    const auto snapshot = now();
+    for (const ram::Relation* rel : tUnit.getProgram().getRelations()) {
+        if (rel->isTemp()) {
+            continue;
+        }
+        const auto usage = getRelationHandle(relToIdMap.at(rel->getName()))->getIndexMemoryUsage();
+        for (std::size_t i = 0; i < usage.size(); ++i) {
+            ProfileEventSingleton::instance().makeMemoryEvent(
+                    prefix + "relation;" + rel->getName() + ";" + std::to_string(i), snapshot, usage[i]);
+        }
+    }
+    ProfileEventSingleton::instance().makeMemoryEvent(
+            prefix + "symbol-table", snapshot, symbolTable.getMemoryUsage());
+    ProfileEventSingleton::instance().makeMemoryEvent(
+            prefix + "record-table", snapshot, recordTable.getMemoryUsage());
+}
+
 void Engine::generateIR() {
     const ram::Program& program = tUnit.getProgram();
     NodeGenerator generator(*this);
@@ -532,6 +600,7 @@ void Engine::executeSubroutine(
     Context ctxt;
     ctxt.setReturnValues(ret);
     ctxt.setArguments(args);
+    setNumaPlacement(global.config().has("numa"));
     generateIR();
     execute(subroutine["stratum_" + name].get(), ctxt);
 }
@@ -548,18 +617,38 @@ RamDomain Engine::execute(const Node* node, Context& ctxt) {
 #define GET_MACRO(_1, _2, _3, _4, NAME, ...) NAME
 #define CASE(...) GET_MACRO(__VA_ARGS__, EXTEND_CASE, _Dummy, _Dummy2, BASE_CASE)(__VA_ARGS__)
 
+// With threaded dispatch every case also carries a label, and execute jumps to it
+// through a table of label addresses instead of the bounds-checked switch.
+#ifdef SOUFFLE_THREADED_DISPATCH
+#define DISPATCH_LABEL(Token) Token##_label:
+#else
+#define DISPATCH_LABEL(Token)
+#endif
+
 #define BASE_CASE(Kind) \
-    case (I_##Kind): {  \
+    case (I_##Kind): DISPATCH_LABEL(I_##Kind) {  \
         return [&]() -> RamDomain { \
             [[maybe_unused]] const auto& shadow = *static_cast<const interpreter::Kind*>(node); \
             [[maybe_unused]] const auto& cur = *static_cast<const ram::Kind*>(node->getShadow());
 // EXTEND_CASE also defer the relation type
 #define EXTEND_CASE(Kind, Structure, Arity, AuxiliaryArity)       \
-    case (I_##Kind##_##Structure##_##Arity##_##AuxiliaryArity): { \
+    case (I_##Kind##_##Structure##_##Arity##_##AuxiliaryArity): \
+    DISPATCH_LABEL(I_##Kind##_##Structure##_##Arity##_##AuxiliaryArity) { \
         return [&]() -> RamDomain { \
             [[maybe_unused]] const auto& shadow = *static_cast<const interpreter::Kind*>(node); \
             [[maybe_unused]] const auto& cur = *static_cast<const ram::Kind*>(node->getShadow());\
             using RelType = Relation<Arity, AuxiliaryArity, interpreter::Structure>;
+// Fused nodes replace a subtree of RAM nodes; they have no RAM counterpart of their own kind
+#define FUSED_CASE(Kind) \
+    case (I_##Kind): DISPATCH_LABEL(I_##Kind) {  \
+        return [&]() -> RamDomain { \
+            [[maybe_unused]] const auto& shadow = *static_cast<const interpreter::Kind*>(node);
+#define FUSED_EXTEND_CASE(Kind, Structure, Arity, AuxiliaryArity)       \
+    case (I_##Kind##_##Structure##_##Arity##_##AuxiliaryArity): \
+    DISPATCH_LABEL(I_##Kind##_##Structure##_##Arity##_##AuxiliaryArity) { \
+        return [&]() -> RamDomain { \
+            [[maybe_unused]] const auto& shadow = *static_cast<const interpreter::Kind*>(node); \
+            using RelType = Relation<Arity, AuxiliaryArity, interpreter::Structure>;
 #define ESAC(Kind) \
     }              \
     ();            \
@@ -588,6 +677,20 @@ RamDomain Engine::execute(const Node* node, Context& ctxt) {
         high[expr.first] = execute(expr.second.get(), ctxt);            \
     }
 
+#ifdef SOUFFLE_THREADED_DISPATCH
+#define SINGLE_TOKEN(tok) &&I_##tok##_label,
+#define EXPAND_TOKEN(structure, arity, auxiliaryArity, tok) \
+    &&I_##tok##_##structure##_##arity##_##auxiliaryArity##_label,
+    // clang-format off
+    static const void* const dispatchTable[] = {
+        FOR_EACH_INTERPRETER_TOKEN(SINGLE_TOKEN, EXPAND_TOKEN)
+    };
+    // clang-format on
+#undef SINGLE_TOKEN
+#undef EXPAND_TOKEN
+    goto* dispatchTable[node->getType()];
+#endif
+
     switch (node->getType()) {
         CASE(NumericConstant)
             return cur.getConstant();
@@ -1149,6 +1252,40 @@ RamDomain Engine::execute(const Node* node, Context& ctxt) {
 #undef COMPARE_EQ_NE
         ESAC(Constraint)
 
+        FUSED_CASE(TupleConstraint)
+        // clang-format off
+#define OPERAND(ty, operand) \
+    ramBitCast<ty>(operand.isConstant ? operand.constant : ctxt[operand.tupleId][operand.element])
+#define COMPARE_NUMERIC(ty, op) return OPERAND(ty, shadow.getLhs()) op OPERAND(ty, shadow.getRhs())
+#define COMPARE_EQ_NE(opCode, op)                                         \
+    case BinaryConstraintOp::   opCode: COMPARE_NUMERIC(RamDomain  , op); \
+    case BinaryConstraintOp::F##opCode: COMPARE_NUMERIC(RamFloat   , op);
+#define COMPARE(opCode, op)                                               \
+    case BinaryConstraintOp::   opCode: COMPARE_NUMERIC(RamSigned  , op); \
+    case BinaryConstraintOp::U##opCode: COMPARE_NUMERIC(RamUnsigned, op); \
+    case BinaryConstraintOp::F##opCode: COMPARE_NUMERIC(RamFloat   , op);
+            // clang-format on
+
+            switch (shadow.getOperator()) {
+                COMPARE_EQ_NE(EQ, ==)
+                COMPARE_EQ_NE(NE, !=)
+
+                COMPARE(LT, <)
+                COMPARE(LE, <=)
+                COMPARE(GT, >)
+                COMPARE(GE, >=)
+
+                default: break;
+            }
+
+        {UNREACHABLE_BAD_CASE_ANALYSIS}
+
+#undef OPERAND
+#undef COMPARE_NUMERIC
+#undef COMPARE
+#undef COMPARE_EQ_NE
+        ESAC(TupleConstraint)
+
         CASE(TupleOperation)
             bool result = execute(shadow.getChild(), ctxt);
 
@@ -1181,6 +1318,15 @@ RamDomain Engine::execute(const Node* node, Context& ctxt) {
         FOR_EACH(PARALLEL_SCAN)
 #undef PARALLEL_SCAN
 
+#define BATCH_SCAN(Structure, Arity, AuxiliaryArity, ...)               \
+    FUSED_EXTEND_CASE(BatchScan, Structure, Arity, AuxiliaryArity)      \
+        const auto& rel = *static_cast<RelType*>(shadow.getRelation()); \
+        return evalBatchScan(rel, shadow, ctxt);                        \
+    ESAC(BatchScan)
+
+        FOR_EACH(BATCH_SCAN)
+#undef BATCH_SCAN
+
 #define INDEX_SCAN(Structure, Arity, AuxiliaryArity, ...) \
     CASE(IndexScan, Structure, Arity, AuxiliaryArity)     \
         return evalIndexScan<RelType>(cur, shadow, ctxt); \
@@ -1233,6 +1379,10 @@ RamDomain Engine::execute(const Node* node, Context& ctxt) {
         FOR_EACH(PARALLEL_INDEX_IFEXISTS)
 #undef PARALLEL_INDEX_IFEXISTS
 
+        CASE(TrieJoin)
+            return evalTrieJoin(cur, shadow, ctxt);
+        ESAC(TrieJoin)
+
         CASE(UnpackRecord)
             RamDomain ref = execute(shadow.getExpr(), ctxt);
 
@@ -1264,6 +1414,9 @@ RamDomain Engine::execute(const Node* node, Context& ctxt) {
 #define AGGREGATE(Structure, Arity, AuxiliaryArity, ...)                \
     CASE(Aggregate, Structure, Arity, AuxiliaryArity)                   \
         const auto& rel = *static_cast<RelType*>(shadow.getRelation()); \
+        if (isPlainCount(cur)) {                                        \
+            return evalCount(cur, shadow, rel.size(), ctxt);            \
+        }                                                               \
         return evalAggregate(cur, shadow, rel.scan(), ctxt);            \
     ESAC(Aggregate)
 
@@ -1272,7 +1425,8 @@ RamDomain Engine::execute(const Node* node, Context& ctxt) {
 
 #define PARALLEL_INDEX_AGGREGATE(Structure, Arity, AuxiliaryArity, ...) \
     CASE(ParallelIndexAggregate, Structure, Arity, AuxiliaryArity)      \
-        return evalParallelIndexAggregate<RelType>(cur, shadow, ctxt);  \
+        const auto& rel = *static_cast<RelType*>(shadow.getRelation()); \
+        return evalParallelIndexAggregate(rel, cur, shadow, ctxt);      \
     ESAC(ParallelIndexAggregate)
 
         FOR_EACH(PARALLEL_INDEX_AGGREGATE)
@@ -1333,6 +1487,15 @@ RamDomain Engine::execute(const Node* node, Context& ctxt) {
         FOR_EACH(INSERT)
 #undef INSERT
 
+#define FILTERED_INSERT(Structure, Arity, AuxiliaryArity, ...)                \
+    FUSED_EXTEND_CASE(FilteredInsert, Structure, Arity, AuxiliaryArity)       \
+        auto& rel = *static_cast<RelType*>(shadow.getRelation());             \
+        return evalGuardedInsert(rel, shadow, ctxt);                          \
+    ESAC(FilteredInsert)
+
+        FOR_EACH(FILTERED_INSERT)
+#undef FILTERED_INSERT
+
 #define ERASE(Structure, Arity, AuxiliaryArity, ...)                                                 \
     CASE(Erase, Structure, Arity, AuxiliaryArity)                                                    \
         void(static_cast<RelType*>(shadow.getRelation()));                                           \
@@ -1409,6 +1572,12 @@ RamDomain Engine::execute(const Node* node, Context& ctxt) {
             return true;
         ESAC(Clear)
 
+        CASE(Compact)
+            auto* rel = shadow.getRelation();
+            rel->compact();
+            return true;
+        ESAC(Compact)
+
 #define ESTIMATEJOINSIZE(Structure, Arity, AuxiliaryArity, ...)         \
     CASE(EstimateJoinSize, Structure, Arity, AuxiliaryArity)            \
         const auto& rel = *static_cast<RelType*>(shadow.getRelation()); \
@@ -1419,7 +1588,13 @@ RamDomain Engine::execute(const Node* node, Context& ctxt) {
 #undef ESTIMATEJOINSIZE
 
         CASE(Call)
+            if (stratumHandoff && stratumHandoff(shadow.getSubroutineName())) {
+                return true;
+            }
             execute(subroutine[shadow.getSubroutineName()].get(), ctxt);
+            if (profileEnabled) {
+                profileMemoryUsage(shadow.getSubroutineName());
+            }
             return true;
         ESAC(Call)
 
@@ -1455,6 +1630,22 @@ RamDomain Engine::execute(const Node* node, Context& ctxt) {
                     exit(EXIT_FAILURE);
                 }
                 return true;
+            } else if (op == "spill") {
+                try {
+                    SpillManager::getInstance().spill(rel, directive, getSymbolTable(), getRecordTable());
+                } catch (std::exception& e) {
+                    std::cerr << "Error spilling " << rel.getName() << ": " << e.what() << "\n";
+                    exit(EXIT_FAILURE);
+                }
+                return true;
+            } else if (op == "restore") {
+                try {
+                    SpillManager::getInstance().restore(rel, directive, getSymbolTable(), getRecordTable());
+                } catch (std::exception& e) {
+                    std::cerr << "Error restoring " << rel.getName() << ": " << e.what() << "\n";
+                    exit(EXIT_FAILURE);
+                }
+                return true;
             } else {
                 assert("wrong i/o operation");
                 return true;
@@ -1499,6 +1690,12 @@ RamDomain Engine::execute(const Node* node, Context& ctxt) {
             return true;
         ESAC(Query)
 
+        CASE(Merge)
+            const RelationWrapper& src = *getRelationHandle(shadow.getSourceId());
+            getRelationHandle(shadow.getTargetId())->merge(src);
+            return true;
+        ESAC(Merge)
+
         CASE(MergeExtend)
             auto& src = *static_cast<EqrelRelation*>(getRelationHandle(shadow.getSourceId()).get());
             auto& trg = *static_cast<EqrelRelation*>(getRelationHandle(shadow.getTargetId()).get());
@@ -1506,6 +1703,10 @@ RamDomain Engine::execute(const Node* node, Context& ctxt) {
             return true;
         ESAC(MergeExtend)
 
+        CASE(MergeLattice)
+            return evalMergeLattice(shadow, ctxt);
+        ESAC(MergeLattice)
+
         CASE(Swap)
             swapRelation(shadow.getSourceId(), shadow.getTargetId());
             return true;
@@ -1525,6 +1726,79 @@ RamDomain Engine::execute(const Node* node, Context& ctxt) {
 #undef DEBUG
 }
 
+RamDomain Engine::evalMergeLattice(const MergeLattice& shadow, Context& ctxt) {
+    const RelationWrapper& source = *getRelationHandle(shadow.getSourceId());
+    RelationWrapper& target = *getRelationHandle(shadow.getTargetId());
+    RelationWrapper* delta = shadow.getDeltaId() ? getRelationHandle(*shadow.getDeltaId()).get() : nullptr;
+    const std::size_t arity = target.getArity();
+    const std::size_t firstLattice = arity - target.getAuxiliaryArity();
+    const auto& lubs = shadow.getChildren();
+
+    // Copy the source tuples; the index orders them by their non-lattice attributes,
+    // so that the tuples of a group are adjacent.
+    const std::vector<RamDomain> low(arity, MIN_RAM_SIGNED);
+    const std::vector<RamDomain> high(arity, MAX_RAM_SIGNED);
+    std::vector<RamDomain> tuples;
+    std::vector<std::size_t> groups;
+    tuples.reserve(source.size() * arity);
+    auto [it, end] = source.range(shadow.getSourceIndexPos(), low.data(), high.data());
+    for (; it != end; ++it) {
+        const RamDomain* tuple = *it;
+        if (tuples.empty() || !std::equal(tuple, tuple + firstLattice, tuples.end() - arity)) {
+            groups.push_back(tuples.size() / arity);
+        }
+        tuples.insert(tuples.end(), tuple, tuple + arity);
+    }
+    const std::size_t numGroups = groups.size();
+    groups.push_back(tuples.size() / arity);
+
+    // Compute the least upper bound of each group and combine it with the tuple of the
+    // group in the target relation; the target relation is only read in this phase.
+    std::vector<RamDomain> merged(numGroups * arity);
+    std::vector<char> changed(numGroups, 0);
+    PARALLEL_START
+        Context newCtxt(ctxt);
+        std::vector<RamDomain> lower(low);
+        std::vector<RamDomain> upper(high);
+        pfor(std::size_t g = 0; g < numGroups; ++g) {
+            RamDomain* lub = &merged[g * arity];
+            std::copy_n(&tuples[groups[g] * arity], arity, lub);
+            newCtxt[0] = lub;
+            for (std::size_t t = groups[g] + 1; t < groups[g + 1]; ++t) {
+                newCtxt[1] = &tuples[t * arity];
+                for (std::size_t i = firstLattice; i < arity; ++i) {
+                    lub[i] = execute(lubs[i - firstLattice].get(), newCtxt);
+                }
+            }
+
+            std::copy_n(lub, firstLattice, lower.begin());
+            std::copy_n(lub, firstLattice, upper.begin());
+            auto [existing, none] = target.range(shadow.getTargetIndexPos(), lower.data(), upper.data());
+            if (existing == none) {
+                changed[g] = 1;
+                continue;
+            }
+            newCtxt[1] = *existing;
+            for (std::size_t i = firstLattice; i < arity; ++i) {
+                const RamDomain value = execute(lubs[i - firstLattice].get(), newCtxt);
+                changed[g] |= static_cast<char>(value != newCtxt[1][i]);
+                lub[i] = value;
+            }
+        }
+
+        // Update the target relation in place and record the changes
+        pfor(std::size_t g = 0; g < numGroups; ++g) {
+            if (changed[g] != 0) {
+                target.insert(&merged[g * arity]);
+                if (delta != nullptr) {
+                    delta->insert(&merged[g * arity]);
+                }
+            }
+        }
+    PARALLEL_END
+    return true;
+}
+
 template <typename Rel>
 RamDomain Engine::evalExistenceCheck(const ExistenceCheck& shadow, Context& ctxt) {
     constexpr std::size_t Arity = Rel::Arity;
@@ -1534,6 +1808,19 @@ RamDomain Engine::evalExistenceCheck(const ExistenceCheck& shadow, Context& ctxt
         reads[shadow.getRelationName()]++;
     }
 
+    // anti-joins probe the Bloom filter guarding their search, if any, before the index
+    auto isFiltered = [&](const souffle::Tuple<RamDomain, Arity>& tuple) {
+        const auto& filter = shadow.getBloomFilter();
+        if (!filter) {
+            return false;
+        }
+        std::uint64_t hash = BloomFilter::seed;
+        for (std::size_t column : shadow.getBloomFilterColumns()) {
+            hash = BloomFilter::mix(hash, tuple[column]);
+        }
+        return !static_cast<const Rel*>(shadow.getRelation())->mayContain(*filter, hash);
+    };
+
     const auto& superInfo = shadow.getSuperInst();
     // for total we use the exists test
     if (shadow.isTotalSearch()) {
@@ -1547,6 +1834,9 @@ RamDomain Engine::evalExistenceCheck(const ExistenceCheck& shadow, Context& ctxt
         for (const auto& expr : superInfo.exprFirst) {
             tuple[expr.first] = execute(expr.second.get(), ctxt);
         }
+        if (isFiltered(tuple)) {
+            return false;
+        }
         return Rel::castView(ctxt.getView(viewPos))->contains(tuple);
     }
 
@@ -1567,6 +1857,9 @@ RamDomain Engine::evalExistenceCheck(const ExistenceCheck& shadow, Context& ctxt
         high[expr.first] = low[expr.first];
     }
 
+    if (isFiltered(low)) {
+        return false;
+    }
     return Rel::castView(ctxt.getView(viewPos))->contains(low, high);
 }
 
@@ -1642,10 +1935,10 @@ RamDomain Engine::evalParallelScan(
 #if defined _OPENMP && _OPENMP < 200805
         auto count = std::distance(pStream.begin(), pStream.end());
         auto b = pStream.begin();
-        pfor(int i = 0; i < count; i++) {
+        pfor_partitions(int i = 0; i < count; i++) {
             auto it = b + i;
 #else
-        pfor(auto it = pStream.begin(); it < pStream.end(); it++) {
+        pfor_partitions(auto it = pStream.begin(); it < pStream.end(); it++) {
 #endif
             for (const auto& tuple : *it) {
                 newCtxt[cur.getTupleId()] = tuple.data();
@@ -1658,6 +1951,199 @@ RamDomain Engine::evalParallelScan(
     return true;
 }
 
+template <typename Rel>
+RamDomain Engine::evalBatchScan(const Rel& rel, const BatchScan& shadow, Context& ctxt) {
+    constexpr std::size_t Arity = Rel::Arity;
+    constexpr std::size_t batchSize = BatchScan::batchSize;
+    const std::size_t insertArity = shadow.getInsert().getSuperInst().first.size();
+
+    // copy the scanned tuples into the columns of the batch, evaluating each full batch
+    auto scanBatches = [&](const auto& tuples, ScanBatch& batch, Context& ctxt) {
+        for (const auto& tuple : tuples) {
+            for (std::size_t i = 0; i < Arity; ++i) {
+                batch.columns[i * batchSize + batch.size] = tuple[i];
+            }
+            if (++batch.size == batchSize) {
+                evalBatch(shadow, batch, ctxt);
+            }
+        }
+    };
+
+    if (!isA<ram::ParallelScan>(shadow.getShadow())) {
+        ScanBatch batch(Arity, insertArity);
+        scanBatches(rel.scan(), batch, ctxt);
+        evalBatch(shadow, batch, ctxt);
+        return true;
+    }
+
+    auto viewContext = shadow.getViewContext();
+    auto pStream = rel.partitionScan(numOfThreads * 20);
+
+    PARALLEL_START
+        Context newCtxt(ctxt);
+        auto viewInfo = viewContext->getViewInfoForNested();
+        for (const auto& info : viewInfo) {
+            newCtxt.createView(*getRelationHandle(info[0]), info[1], info[2]);
+        }
+        ScanBatch batch(Arity, insertArity);
+#if defined _OPENMP && _OPENMP < 200805
+        auto count = std::distance(pStream.begin(), pStream.end());
+        auto b = pStream.begin();
+        pfor_partitions(int i = 0; i < count; i++) {
+            auto it = b + i;
+#else
+        pfor_partitions(auto it = pStream.begin(); it < pStream.end(); it++) {
+#endif
+            scanBatches(*it, batch, newCtxt);
+        }
+        evalBatch(shadow, batch, newCtxt);
+    PARALLEL_END
+    return true;
+}
+
+void Engine::evalBatch(const BatchScan& shadow, ScanBatch& batch, Context& ctxt) {
+    constexpr std::size_t batchSize = BatchScan::batchSize;
+    const std::size_t size = batch.size;
+    if (size == 0) {
+        return;
+    }
+    batch.size = 0;
+    const std::size_t tupleId = shadow.getTupleId();
+
+    // narrow the batch by the constraints, one column at a time
+    std::uint8_t* mask = batch.mask.data();
+    std::fill_n(mask, size, std::uint8_t(1));
+    auto operand = [&](const TupleConstraint::Operand& op) -> std::pair<const RamDomain*, bool> {
+        if (op.isConstant) {
+            return {&op.constant, false};
+        }
+        if (op.tupleId == tupleId) {
+            return {&batch.columns[op.element * batchSize], true};
+        }
+        return {&ctxt[op.tupleId][op.element], false};
+    };
+    for (const TupleConstraint* constraint : shadow.getConstraints()) {
+        const auto [lhs, lhsColumn] = operand(constraint->getLhs());
+        const auto [rhs, rhsColumn] = operand(constraint->getRhs());
+        // clang-format off
+#define MASK(ty, cmp) \
+    evaluator::maskBatch<ty>(mask, size, lhs, lhsColumn, rhs, rhsColumn, std::cmp<ty>()); break;
+#define MASK_EQ_NE(opCode, cmp)                                  \
+    case BinaryConstraintOp::   opCode: MASK(RamDomain  , cmp); \
+    case BinaryConstraintOp::F##opCode: MASK(RamFloat   , cmp);
+#define MASK_COMPARE(opCode, cmp)                                \
+    case BinaryConstraintOp::   opCode: MASK(RamSigned  , cmp); \
+    case BinaryConstraintOp::U##opCode: MASK(RamUnsigned, cmp); \
+    case BinaryConstraintOp::F##opCode: MASK(RamFloat   , cmp);
+        // clang-format on
+
+        switch (constraint->getOperator()) {
+            MASK_EQ_NE(EQ, equal_to)
+            MASK_EQ_NE(NE, not_equal_to)
+
+            MASK_COMPARE(LT, less)
+            MASK_COMPARE(LE, less_equal)
+            MASK_COMPARE(GT, greater)
+            MASK_COMPARE(GE, greater_equal)
+
+            default: fatal("unsupported constraint in batch scan");
+        }
+
+#undef MASK
+#undef MASK_EQ_NE
+#undef MASK_COMPARE
+    }
+    std::size_t* selection = batch.selection.data();
+    std::size_t selected = 0;
+    for (std::size_t i = 0; i < size; ++i) {
+        selection[selected] = i;
+        selected += mask[i];
+    }
+
+    // the remaining conditions and generic expressions see the scanned tuple in the context
+    const std::size_t arity = batch.tuple.size();
+    auto bind = [&](std::size_t i) {
+        for (std::size_t j = 0; j < arity; ++j) {
+            batch.tuple[j] = batch.columns[j * batchSize + i];
+        }
+        ctxt[tupleId] = batch.tuple.data();
+    };
+    auto holds = [&]() {
+        for (const Node* condition : shadow.getConditions()) {
+            if (!execute(condition, ctxt)) {
+                return false;
+            }
+        }
+        return true;
+    };
+
+    const Insert& insert = shadow.getInsert();
+    const auto& superInfo = insert.getSuperInst();
+    RelationWrapper& target = *insert.getRelation();
+    RamDomain* inserted = batch.inserted.data();
+    const std::size_t insertArity = superInfo.first.size();
+
+    if (!shadow.isInsertDeferred()) {
+        // the conditions read the target relation, so each tuple is inserted before the next is checked
+        for (std::size_t k = 0; k < selected; ++k) {
+            bind(selection[k]);
+            if (!holds()) {
+                continue;
+            }
+            std::copy_n(superInfo.first.begin(), insertArity, inserted);
+            for (const auto& tupleElement : superInfo.tupleFirst) {
+                inserted[tupleElement[0]] = ctxt[tupleElement[1]][tupleElement[2]];
+            }
+            for (const auto& expr : superInfo.exprFirst) {
+                inserted[expr.first] = execute(expr.second.get(), ctxt);
+            }
+            target.insert(inserted);
+        }
+        return;
+    }
+
+    if (!shadow.getConditions().empty()) {
+        std::size_t passed = 0;
+        for (std::size_t k = 0; k < selected; ++k) {
+            bind(selection[k]);
+            selection[passed] = selection[k];
+            passed += holds() ? 1 : 0;
+        }
+        selected = passed;
+    }
+
+    // gather the inserted tuples one attribute at a time, and insert them together
+    for (std::size_t j = 0; j < insertArity; ++j) {
+        const RamDomain constant = superInfo.first[j];
+        for (std::size_t k = 0; k < selected; ++k) {
+            inserted[k * insertArity + j] = constant;
+        }
+    }
+    for (const auto& tupleElement : superInfo.tupleFirst) {
+        const std::size_t j = tupleElement[0];
+        if (tupleElement[1] == tupleId) {
+            const RamDomain* column = &batch.columns[tupleElement[2] * batchSize];
+            for (std::size_t k = 0; k < selected; ++k) {
+                inserted[k * insertArity + j] = column[selection[k]];
+            }
+        } else {
+            const RamDomain value = ctxt[tupleElement[1]][tupleElement[2]];
+            for (std::size_t k = 0; k < selected; ++k) {
+                inserted[k * insertArity + j] = value;
+            }
+        }
+    }
+    if (!superInfo.exprFirst.empty()) {
+        for (std::size_t k = 0; k < selected; ++k) {
+            bind(selection[k]);
+            for (const auto& expr : superInfo.exprFirst) {
+                inserted[k * insertArity + expr.first] = execute(expr.second.get(), ctxt);
+            }
+        }
+    }
+    target.insertBatch(inserted, selected);
+}
+
 template <typename Rel>
 RamDomain Engine::evalEstimateJoinSize(
         const Rel& rel, const ram::EstimateJoinSize& cur, const EstimateJoinSize& shadow, Context& ctxt) {
@@ -1774,6 +2260,7 @@ RamDomain Engine::evalEstimateJoinSize(
 
 template <typename Rel>
 RamDomain Engine::evalIndexScan(const ram::IndexScan& cur, const IndexScan& shadow, Context& ctxt) {
+    countSearch(cur);
     constexpr std::size_t Arity = Rel::Arity;
     // create pattern tuple for range query
     const auto& superInfo = shadow.getSuperInst();
@@ -1796,6 +2283,7 @@ RamDomain Engine::evalIndexScan(const ram::IndexScan& cur, const IndexScan& shad
 template <typename Rel>
 RamDomain Engine::evalParallelIndexScan(
         const Rel& rel, const ram::ParallelIndexScan& cur, const ParallelIndexScan& shadow, Context& ctxt) {
+    countSearch(cur);
     auto viewContext = shadow.getViewContext();
 
     // create pattern tuple for range query
@@ -1816,10 +2304,10 @@ RamDomain Engine::evalParallelIndexScan(
 #if defined _OPENMP && _OPENMP < 200805
         auto count = std::distance(pStream.begin(), pStream.end());
         auto b = pStream.begin();
-        pfor(int i = 0; i < count; i++) {
+        pfor_partitions(int i = 0; i < count; i++) {
             auto it = b + i;
 #else
-        pfor(auto it = pStream.begin(); it < pStream.end(); it++) {
+        pfor_partitions(auto it = pStream.begin(); it < pStream.end(); it++) {
 #endif
             for (const auto& tuple : *it) {
                 newCtxt[cur.getTupleId()] = tuple.data();
@@ -1861,10 +2349,10 @@ RamDomain Engine::evalParallelIfExists(
 #if defined _OPENMP && _OPENMP < 200805
         auto count = std::distance(pStream.begin(), pStream.end());
         auto b = pStream.begin();
-        pfor(int i = 0; i < count; i++) {
+        pfor_partitions(int i = 0; i < count; i++) {
             auto it = b + i;
 #else
-        pfor(auto it = pStream.begin(); it < pStream.end(); it++) {
+        pfor_partitions(auto it = pStream.begin(); it < pStream.end(); it++) {
 #endif
             for (const auto& tuple : *it) {
                 newCtxt[cur.getTupleId()] = tuple.data();
@@ -1881,6 +2369,7 @@ RamDomain Engine::evalParallelIfExists(
 template <typename Rel>
 RamDomain Engine::evalIndexIfExists(
         const ram::IndexIfExists& cur, const IndexIfExists& shadow, Context& ctxt) {
+    countSearch(cur);
     constexpr std::size_t Arity = Rel::Arity;
     const auto& superInfo = shadow.getSuperInst();
     souffle::Tuple<RamDomain, Arity> low;
@@ -1903,6 +2392,7 @@ RamDomain Engine::evalIndexIfExists(
 template <typename Rel>
 RamDomain Engine::evalParallelIndexIfExists(const Rel& rel, const ram::ParallelIndexIfExists& cur,
         const ParallelIndexIfExists& shadow, Context& ctxt) {
+    countSearch(cur);
     auto viewContext = shadow.getViewContext();
 
     auto viewInfo = viewContext->getViewInfoForNested();
@@ -1925,10 +2415,10 @@ RamDomain Engine::evalParallelIndexIfExists(const Rel& rel, const ram::ParallelI
 #if defined _OPENMP && _OPENMP < 200805
         auto count = std::distance(pStream.begin(), pStream.end());
         auto b = pStream.begin();
-        pfor(int i = 0; i < count; i++) {
+        pfor_partitions(int i = 0; i < count; i++) {
             auto it = b + i;
 #else
-        pfor(auto it = pStream.begin(); it < pStream.end(); it++) {
+        pfor_partitions(auto it = pStream.begin(); it < pStream.end(); it++) {
 #endif
             for (const auto& tuple : *it) {
                 newCtxt[cur.getTupleId()] = tuple.data();
@@ -1943,6 +2433,83 @@ RamDomain Engine::evalParallelIndexIfExists(const Rel& rel, const ram::ParallelI
     return true;
 }
 
+RamDomain Engine::evalTrieJoin(const ram::TrieJoin& cur, const TrieJoin& shadow, Context& ctxt) {
+    // all searches start unbounded, except for the fixed columns
+    TrieJoinBounds low(shadow.getNumAtoms());
+    TrieJoinBounds high(shadow.getNumAtoms());
+    for (std::size_t atom = 0; atom < shadow.getNumAtoms(); ++atom) {
+        const std::size_t arity = shadow.getRelation(atom)->getArity();
+        low[atom].assign(arity, MIN_RAM_SIGNED);
+        high[atom].assign(arity, MAX_RAM_SIGNED);
+        for (std::size_t col = 0; col < arity; ++col) {
+            if (const Node* value = shadow.getValue(atom, col)) {
+                low[atom][col] = high[atom][col] = execute(value, ctxt);
+            }
+        }
+    }
+    evalTrieJoinVariable(cur, shadow, ctxt, 0, low, high);
+    return true;
+}
+
+bool Engine::evalTrieJoinVariable(const ram::TrieJoin& cur, const TrieJoin& shadow, Context& ctxt,
+        std::size_t var, TrieJoinBounds& low, TrieJoinBounds& high) {
+    if (var == shadow.getNumVariables()) {
+        return evalTrieJoinAtom(cur, shadow, ctxt, 0, low, high);
+    }
+
+    const auto& seeks = shadow.getSeeks(var);
+    auto seek = [&](std::size_t i, RamDomain value) -> std::optional<RamDomain> {
+        const auto& [atom, column, indexPos] = seeks[i];
+        low[atom][column] = value;
+        auto range = shadow.getRelation(atom)->range(indexPos, low[atom].data(), high[atom].data());
+        if (range.first == range.second) {
+            return std::nullopt;
+        }
+        return (*range.first)[column];
+    };
+
+    // enumerate the values of the variable all its atoms admit, in order
+    for (auto value = evaluator::leapfrogSeek(MIN_RAM_SIGNED, seeks.size(), seek); value;
+            value = *value == MAX_RAM_SIGNED ? std::nullopt
+                                             : evaluator::leapfrogSeek(*value + 1, seeks.size(), seek)) {
+        for (const auto& [atom, column, indexPos] : seeks) {
+            low[atom][column] = high[atom][column] = *value;
+        }
+        evalTrieJoinVariable(cur, shadow, ctxt, var + 1, low, high);
+        for (const auto& [atom, column, indexPos] : seeks) {
+            high[atom][column] = MAX_RAM_SIGNED;
+        }
+    }
+
+    // leave the columns of the variable unbounded for the next binding of the variables before
+    for (const auto& [atom, column, indexPos] : seeks) {
+        low[atom][column] = MIN_RAM_SIGNED;
+        high[atom][column] = MAX_RAM_SIGNED;
+    }
+    return true;
+}
+
+bool Engine::evalTrieJoinAtom(const ram::TrieJoin& cur, const TrieJoin& shadow, Context& ctxt,
+        std::size_t atom, const TrieJoinBounds& low, const TrieJoinBounds& high) {
+    if (atom == shadow.getNumAtoms()) {
+        return execute(shadow.getNestedOperation(), ctxt);
+    }
+
+    auto range =
+            shadow.getRelation(atom)->range(shadow.getIndexPos(atom), low[atom].data(), high[atom].data());
+    for (auto it = range.first; it != range.second; ++it) {
+        ctxt[cur.getTupleId(atom)] = *it;
+        if (!execute(shadow.getCondition(atom), ctxt)) {
+            continue;
+        }
+        // a break of the nested operation ends the enumeration of the innermost atom only
+        if (!evalTrieJoinAtom(cur, shadow, ctxt, atom + 1, low, high) || cur.isExistential(atom)) {
+            break;
+        }
+    }
+    return true;
+}
+
 template <typename Shadow>
 RamDomain Engine::initValue(const ram::Aggregator& aggregator, const Shadow& shadow, Context& ctxt) {
     if (const auto* ia = as<ram::IntrinsicAggregator>(aggregator)) {
@@ -1988,23 +2555,38 @@ void ifIntrinsic(const ram::Aggregator& aggregator, AggregateOp op, std::functio
     }
 }
 
-template <typename Aggregate, typename Shadow, typename Iter>
-RamDomain Engine::evalAggregate(
-        const Aggregate& aggregate, const Shadow& shadow, const Iter& ranges, Context& ctxt) {
-    bool shouldRunNested = false;
+/** Combine the accumulated value of an intrinsic aggregate with another value */
+RamDomain combineIntrinsic(AggregateOp op, RamDomain res, RamDomain val) {
+    switch (op) {
+        case AggregateOp::MIN: return std::min(res, val);
+        case AggregateOp::FMIN:
+            return ramBitCast(std::min(ramBitCast<RamFloat>(res), ramBitCast<RamFloat>(val)));
+        case AggregateOp::UMIN:
+            return ramBitCast(std::min(ramBitCast<RamUnsigned>(res), ramBitCast<RamUnsigned>(val)));
+
+        case AggregateOp::MAX: return std::max(res, val);
+        case AggregateOp::FMAX:
+            return ramBitCast(std::max(ramBitCast<RamFloat>(res), ramBitCast<RamFloat>(val)));
+        case AggregateOp::UMAX:
+            return ramBitCast(std::max(ramBitCast<RamUnsigned>(res), ramBitCast<RamUnsigned>(val)));
+
+        case AggregateOp::COUNT:
+        case AggregateOp::SUM: return res + val;
+        case AggregateOp::FSUM: return ramBitCast(ramBitCast<RamFloat>(res) + ramBitCast<RamFloat>(val));
+        case AggregateOp::USUM:
+            return ramBitCast(ramBitCast<RamUnsigned>(res) + ramBitCast<RamUnsigned>(val));
+
+        case AggregateOp::MEAN: fatal("This should never be executed");
+    }
+    fatal("Unhandled aggregate operation");
+}
 
+template <typename Aggregate, typename Shadow, typename Iter>
+void Engine::accumulateAggregate(const Aggregate& aggregate, const Shadow& shadow, const Iter& ranges,
+        Context& ctxt, AggregateState& state) {
     const Node& filter = *shadow.getCondition();
     const Node* expression = shadow.getExpr();
-    const Node& nestedOperation = *shadow.getNestedOperation();
-    // initialize result
-    RamDomain res = 0;
-
-    // Use for calculating mean.
-    std::pair<RamFloat, RamFloat> accumulateMean = {0, 0};
-
     const ram::Aggregator& aggregator = aggregate.getAggregator();
-    res = initValue(aggregator, shadow, ctxt);
-    shouldRunNested = runNested(aggregator);
 
     for (const auto& tuple : ranges) {
         ctxt[aggregate.getTupleId()] = tuple.data();
@@ -2013,14 +2595,14 @@ RamDomain Engine::evalAggregate(
             continue;
         }
 
-        shouldRunNested = true;
+        state.matched = true;
 
         bool isCount = false;
         ifIntrinsic(aggregator, AggregateOp::COUNT, [&]() { isCount = true; });
 
         // count is a special case.
         if (isCount) {
-            ++res;
+            ++state.res;
             continue;
         }
 
@@ -2029,42 +2611,17 @@ RamDomain Engine::evalAggregate(
         RamDomain val = execute(expression, ctxt);
 
         if (const auto* ia = as<ram::IntrinsicAggregator>(aggregator)) {
-            switch (ia->getFunction()) {
-                case AggregateOp::MIN: res = std::min(res, val); break;
-                case AggregateOp::FMIN:
-                    res = ramBitCast(std::min(ramBitCast<RamFloat>(res), ramBitCast<RamFloat>(val)));
-                    break;
-                case AggregateOp::UMIN:
-                    res = ramBitCast(std::min(ramBitCast<RamUnsigned>(res), ramBitCast<RamUnsigned>(val)));
-                    break;
-
-                case AggregateOp::MAX: res = std::max(res, val); break;
-                case AggregateOp::FMAX:
-                    res = ramBitCast(std::max(ramBitCast<RamFloat>(res), ramBitCast<RamFloat>(val)));
-                    break;
-                case AggregateOp::UMAX:
-                    res = ramBitCast(std::max(ramBitCast<RamUnsigned>(res), ramBitCast<RamUnsigned>(val)));
-                    break;
-
-                case AggregateOp::SUM: res += val; break;
-                case AggregateOp::FSUM:
-                    res = ramBitCast(ramBitCast<RamFloat>(res) + ramBitCast<RamFloat>(val));
-                    break;
-                case AggregateOp::USUM:
-                    res = ramBitCast(ramBitCast<RamUnsigned>(res) + ramBitCast<RamUnsigned>(val));
-                    break;
-
-                case AggregateOp::MEAN:
-                    accumulateMean.first += ramBitCast<RamFloat>(val);
-                    accumulateMean.second++;
-                    break;
-
-                case AggregateOp::COUNT: fatal("This should never be executed");
+            if (ia->getFunction() == AggregateOp::MEAN) {
+                state.mean.first += ramBitCast<RamFloat>(val);
+                state.mean.second++;
+            } else {
+                state.res = combineIntrinsic(ia->getFunction(), state.res, val);
             }
         } else if (const auto* uda = as<ram::UserDefinedAggregator>(aggregator)) {
             auto userFunctorPtr = reinterpret_cast<void (*)()>(shadow.getFunctionPointer());
             if (uda->isStateful() && userFunctorPtr) {
-                res = callStatefulAggregate(userFunctorPtr, &getSymbolTable(), &getRecordTable(), res, val);
+                state.res = callStatefulAggregate(
+                        userFunctorPtr, &getSymbolTable(), &getRecordTable(), state.res, val);
             } else {
                 fatal("stateless functors not supported in user-defined aggregates");
             }
@@ -2072,10 +2629,46 @@ RamDomain Engine::evalAggregate(
             fatal("Unhandled aggregator");
         }
     }
+}
+
+template <typename Shadow>
+void Engine::mergeAggregate(const ram::Aggregator& aggregator, const Shadow& shadow, AggregateState& state,
+        const AggregateState& partial) {
+    if (!partial.matched) {
+        return;
+    }
+    // the first partial result replaces the initial value, which must not be counted twice
+    if (!state.matched) {
+        state = partial;
+        return;
+    }
+
+    if (const auto* ia = as<ram::IntrinsicAggregator>(aggregator)) {
+        if (ia->getFunction() == AggregateOp::MEAN) {
+            state.mean.first += partial.mean.first;
+            state.mean.second += partial.mean.second;
+        } else {
+            state.res = combineIntrinsic(ia->getFunction(), state.res, partial.res);
+        }
+    } else if (isA<ram::UserDefinedAggregator>(aggregator)) {
+        // as in the synthesised reduction, the aggregate function itself is the (associative) merge
+        auto userFunctorPtr = reinterpret_cast<void (*)()>(shadow.getFunctionPointer());
+        state.res = callStatefulAggregate(
+                userFunctorPtr, &getSymbolTable(), &getRecordTable(), state.res, partial.res);
+    } else {
+        fatal("Unhandled aggregator");
+    }
+}
+
+template <typename Aggregate, typename Shadow>
+RamDomain Engine::finishAggregate(
+        const Aggregate& aggregate, const Shadow& shadow, const AggregateState& state, Context& ctxt) {
+    const ram::Aggregator& aggregator = aggregate.getAggregator();
+    RamDomain res = state.res;
 
     ifIntrinsic(aggregator, AggregateOp::MEAN, [&]() {
-        if (accumulateMean.second != 0) {
-            res = ramBitCast(accumulateMean.first / accumulateMean.second);
+        if (state.mean.second != 0) {
+            res = ramBitCast(state.mean.first / state.mean.second);
         }
     });
 
@@ -2084,54 +2677,109 @@ RamDomain Engine::evalAggregate(
     tuple[0] = res;
     ctxt[aggregate.getTupleId()] = tuple.data();
 
-    if (!shouldRunNested) {
+    if (!state.matched && !runNested(aggregator)) {
         return true;
     } else {
-        return execute(&nestedOperation, ctxt);
+        return execute(shadow.getNestedOperation(), ctxt);
     }
 }
-template <typename Rel>
-RamDomain Engine::evalParallelAggregate(
-        const Rel& rel, const ram::ParallelAggregate& cur, const ParallelAggregate& shadow, Context& ctxt) {
-    // TODO (rdowavic): make parallel
-    auto viewContext = shadow.getViewContext();
 
+template <typename Aggregate, typename Shadow, typename Iter>
+RamDomain Engine::evalAggregate(
+        const Aggregate& aggregate, const Shadow& shadow, const Iter& ranges, Context& ctxt) {
+    AggregateState state{initValue(aggregate.getAggregator(), shadow, ctxt)};
+    accumulateAggregate(aggregate, shadow, ranges, ctxt, state);
+    return finishAggregate(aggregate, shadow, state, ctxt);
+}
+
+template <typename Aggregate, typename Shadow>
+RamDomain Engine::evalCount(
+        const Aggregate& aggregate, const Shadow& shadow, std::size_t count, Context& ctxt) {
+    AggregateState state{static_cast<RamDomain>(count)};
+    state.matched = count > 0;
+    return finishAggregate(aggregate, shadow, state, ctxt);
+}
+
+template <typename Aggregate, typename Shadow>
+RamDomain Engine::evalParallelCount(
+        const Aggregate& aggregate, const Shadow& shadow, std::size_t count, Context& ctxt) {
     Context newCtxt(ctxt);
-    auto viewInfo = viewContext->getViewInfoForNested();
-    for (const auto& info : viewInfo) {
+    for (const auto& info : shadow.getViewContext()->getViewInfoForNested()) {
         newCtxt.createView(*getRelationHandle(info[0]), info[1], info[2]);
     }
-    return evalAggregate(cur, shadow, rel.scan(), newCtxt);
+    return evalCount(aggregate, shadow, count, newCtxt);
 }
 
-template <typename Rel>
-RamDomain Engine::evalParallelIndexAggregate(
-        const ram::ParallelIndexAggregate& cur, const ParallelIndexAggregate& shadow, Context& ctxt) {
-    // TODO (rdowavic): make parallel
-    auto viewContext = shadow.getViewContext();
+template <typename Aggregate, typename Shadow, typename Stream>
+RamDomain Engine::evalPartitionedAggregate(
+        const Aggregate& aggregate, const Shadow& shadow, const Stream& pStream, Context& ctxt) {
+    const ram::Aggregator& aggregator = aggregate.getAggregator();
+    auto viewInfo = shadow.getViewContext()->getViewInfoForNested();
+
+    // every thread aggregates the partitions it picks up; the partial results are merged afterwards
+    AggregateState state{initValue(aggregator, shadow, ctxt)};
+    PARALLEL_START
+        Context newCtxt(ctxt);
+        for (const auto& info : viewInfo) {
+            newCtxt.createView(*getRelationHandle(info[0]), info[1], info[2]);
+        }
+        AggregateState partial{initValue(aggregator, shadow, newCtxt)};
+#if defined _OPENMP && _OPENMP < 200805
+        auto count = std::distance(pStream.begin(), pStream.end());
+        auto b = pStream.begin();
+        pfor_partitions(int i = 0; i < count; i++) {
+            auto it = b + i;
+#else
+        pfor_partitions(auto it = pStream.begin(); it < pStream.end(); it++) {
+#endif
+            accumulateAggregate(aggregate, shadow, *it, newCtxt, partial);
+        }
+#ifdef _OPENMP
+#pragma omp critical(aggregate)
+#endif
+        mergeAggregate(aggregator, shadow, state, partial);
+    PARALLEL_END
 
     Context newCtxt(ctxt);
-    auto viewInfo = viewContext->getViewInfoForNested();
     for (const auto& info : viewInfo) {
         newCtxt.createView(*getRelationHandle(info[0]), info[1], info[2]);
     }
-    // init temporary tuple for this level
+    return finishAggregate(aggregate, shadow, state, newCtxt);
+}
+
+template <typename Rel>
+RamDomain Engine::evalParallelAggregate(
+        const Rel& rel, const ram::ParallelAggregate& cur, const ParallelAggregate& shadow, Context& ctxt) {
+    if (isPlainCount(cur)) {
+        return evalParallelCount(cur, shadow, rel.size(), ctxt);
+    }
+    auto pStream = rel.partitionScan(numOfThreads * 20);
+    return evalPartitionedAggregate(cur, shadow, pStream, ctxt);
+}
+
+template <typename Rel>
+RamDomain Engine::evalParallelIndexAggregate(const Rel& rel, const ram::ParallelIndexAggregate& cur,
+        const ParallelIndexAggregate& shadow, Context& ctxt) {
+    countSearch(cur);
+    // create pattern tuple for range query
     constexpr std::size_t Arity = Rel::Arity;
     const auto& superInfo = shadow.getSuperInst();
-    // get lower and upper boundaries for iteration
     souffle::Tuple<RamDomain, Arity> low;
     souffle::Tuple<RamDomain, Arity> high;
     CAL_SEARCH_BOUND(superInfo, low, high);
 
-    std::size_t viewId = shadow.getViewId();
-    auto view = Rel::castView(newCtxt.getView(viewId));
-
-    return evalAggregate(cur, shadow, view->range(low, high), newCtxt);
+    std::size_t indexPos = shadow.getViewId();
+    if (isPlainCount(cur)) {
+        return evalParallelCount(cur, shadow, rel.count(indexPos, low, high), ctxt);
+    }
+    auto pStream = rel.partitionRange(indexPos, low, high, numOfThreads * 20);
+    return evalPartitionedAggregate(cur, shadow, pStream, ctxt);
 }
 
 template <typename Rel>
 RamDomain Engine::evalIndexAggregate(
         const ram::IndexAggregate& cur, const IndexAggregate& shadow, Context& ctxt) {
+    countSearch(cur);
     // init temporary tuple for this level
     const std::size_t Arity = Rel::Arity;
     const auto& superInfo = shadow.getSuperInst();
@@ -2142,6 +2790,10 @@ RamDomain Engine::evalIndexAggregate(
     std::size_t viewId = shadow.getViewId();
     auto view = Rel::castView(ctxt.getView(viewId));
 
+    // counting the tuples in range does not need to visit them
+    if (isPlainCount(cur)) {
+        return evalCount(cur, shadow, view->count(low, high), ctxt);
+    }
     return evalAggregate(cur, shadow, view->range(low, high), ctxt);
 }
 
@@ -22,6 +22,7 @@
 #include "interpreter/Index.h"
 #include "interpreter/Node.h"
 #include "interpreter/Relation.h"
+#include "ram/IndexOperation.h"
 #include "ram/TranslationUnit.h"
 #include "ram/analysis/Index.h"
 #include "souffle/RamTypes.h"
@@ -33,7 +34,9 @@
 #include "souffle/utility/ContainerUtil.h"
 #include <atomic>
 #include <cstddef>
+#include <cstdint>
 #include <deque>
+#include <functional>
 #include <map>
 #include <memory>
 
@@ -41,6 +44,7 @@
 
 #include <regex>
 #include <string>
+#include <utility>
 #include <vector>
 #ifdef _OPENMP
 #include <omp.h>
@@ -63,6 +67,12 @@ class Engine {
     friend NodeGenerator;
 
 public:
+    /**
+     * Hook consulted at every stratum boundary with the name of the stratum about to run.
+     * Returning true means the stratum has been evaluated elsewhere and is skipped.
+     */
+    using StratumHandoff = std::function<bool(const std::string&)>;
+
     Engine(ram::TranslationUnit& tUnit, const std::size_t numThreads);
 
     /** @brief Execute the main program */
@@ -89,6 +99,16 @@ public:
     /** @brief Return a reference to the relation on the given index */
     RelationHandle& getRelationHandle(const std::size_t idx);
 
+    /** @brief Install a hook that may take over the evaluation of strata */
+    void setStratumHandoff(StratumHandoff handoff) {
+        stratumHandoff = std::move(handoff);
+    }
+
+    /** @brief Return the number of threads used by the engine */
+    std::size_t getNumberOfThreads() const {
+        return numOfThreads;
+    }
+
 private:
     /** @brief Generate intermediate representation from RAM */
     void generateIR();
@@ -117,6 +137,13 @@ private:
     VecOwn<RelationHandle>& getRelationMap();
     /** @brief Create and add relation into the runtime environment.  */
     void createRelation(const ram::Relation& id, const std::size_t idx);
+    /** @brief Record the memory held by relations and tables at the end of a stratum */
+    void profileMemoryUsage(const std::string& stratum);
+    /** @brief Count an execution of an index operation if search frequencies are profiled */
+    void countSearch(const ram::IndexOperation& op);
+
+    /** @brief Merge a relation into a relation with lattice attributes */
+    RamDomain evalMergeLattice(const MergeLattice& shadow, Context& ctxt);
 
     // -- Defines template for specialized interpreter operation -- */
     template <typename Rel>
@@ -132,6 +159,27 @@ private:
     RamDomain evalParallelScan(
             const Rel& rel, const ram::ParallelScan& cur, const ParallelScan& shadow, Context& ctxt);
 
+    /** Buffers of a batch scan; the scanned tuples are stored column by column */
+    struct ScanBatch {
+        ScanBatch(std::size_t arity, std::size_t insertArity)
+                : columns(arity * BatchScan::batchSize), mask(BatchScan::batchSize),
+                  selection(BatchScan::batchSize), tuple(arity),
+                  inserted(insertArity * BatchScan::batchSize) {}
+
+        std::vector<RamDomain> columns;
+        std::size_t size = 0;
+        std::vector<std::uint8_t> mask;
+        std::vector<std::size_t> selection;
+        std::vector<RamDomain> tuple;
+        std::vector<RamDomain> inserted;
+    };
+
+    template <typename Rel>
+    RamDomain evalBatchScan(const Rel& rel, const BatchScan& shadow, Context& ctxt);
+
+    /** Evaluates the filters and the insert of a batch scan over the given batch, and empties it */
+    void evalBatch(const BatchScan& shadow, ScanBatch& batch, Context& ctxt);
+
     template <typename Rel>
     RamDomain evalEstimateJoinSize(
             const Rel& rel, const ram::EstimateJoinSize& cur, const EstimateJoinSize& shadow, Context& ctxt);
@@ -157,20 +205,65 @@ private:
     RamDomain evalParallelIndexIfExists(const Rel& rel, const ram::ParallelIndexIfExists& cur,
             const ParallelIndexIfExists& shadow, Context& ctxt);
 
+    /** The bounds of the searches of the atoms of a trie join, in attribute order */
+    using TrieJoinBounds = std::vector<std::vector<RamDomain>>;
+
+    RamDomain evalTrieJoin(const ram::TrieJoin& cur, const TrieJoin& shadow, Context& ctxt);
+
+    /** @brief Bind the given join variable and the ones after it to the values all their atoms admit */
+    bool evalTrieJoinVariable(const ram::TrieJoin& cur, const TrieJoin& shadow, Context& ctxt,
+            std::size_t var, TrieJoinBounds& low, TrieJoinBounds& high);
+
+    /** @brief Bind the tuples of the given atom and the ones after it once all join variables are bound */
+    bool evalTrieJoinAtom(const ram::TrieJoin& cur, const TrieJoin& shadow, Context& ctxt, std::size_t atom,
+            const TrieJoinBounds& low, const TrieJoinBounds& high);
+
     template <typename Shadow>
     RamDomain initValue(const ram::Aggregator& aggregator, const Shadow& shadow, Context& ctxt);
 
+    /** Partial result of an aggregate over a subset of the tuples */
+    struct AggregateState {
+        RamDomain res;
+        /** Sum and count for the mean */
+        std::pair<RamFloat, RamFloat> mean{0, 0};
+        /** Whether any tuple passed the filter */
+        bool matched = false;
+    };
+
+    template <typename Aggregate, typename Shadow, typename Iter>
+    void accumulateAggregate(const Aggregate& aggregate, const Shadow& shadow, const Iter& ranges,
+            Context& ctxt, AggregateState& state);
+
+    template <typename Shadow>
+    void mergeAggregate(const ram::Aggregator& aggregator, const Shadow& shadow, AggregateState& state,
+            const AggregateState& partial);
+
+    template <typename Aggregate, typename Shadow>
+    RamDomain finishAggregate(
+            const Aggregate& aggregate, const Shadow& shadow, const AggregateState& state, Context& ctxt);
+
     template <typename Aggregate, typename Shadow, typename Iter>
     RamDomain evalAggregate(
             const Aggregate& aggregate, const Shadow& shadow, const Iter& ranges, Context& ctxt);
 
+    template <typename Aggregate, typename Shadow>
+    RamDomain evalCount(const Aggregate& aggregate, const Shadow& shadow, std::size_t count, Context& ctxt);
+
+    template <typename Aggregate, typename Shadow>
+    RamDomain evalParallelCount(
+            const Aggregate& aggregate, const Shadow& shadow, std::size_t count, Context& ctxt);
+
+    template <typename Aggregate, typename Shadow, typename Stream>
+    RamDomain evalPartitionedAggregate(
+            const Aggregate& aggregate, const Shadow& shadow, const Stream& pStream, Context& ctxt);
+
     template <typename Rel>
     RamDomain evalParallelAggregate(const Rel& rel, const ram::ParallelAggregate& cur,
             const ParallelAggregate& shadow, Context& ctxt);
 
     template <typename Rel>
-    RamDomain evalParallelIndexAggregate(
-            const ram::ParallelIndexAggregate& cur, const ParallelIndexAggregate& shadow, Context& ctxt);
+    RamDomain evalParallelIndexAggregate(const Rel& rel, const ram::ParallelIndexAggregate& cur,
+            const ParallelIndexAggregate& shadow, Context& ctxt);
 
     template <typename Rel>
     RamDomain evalIndexAggregate(const ram::IndexAggregate& cur, const IndexAggregate& shadow, Context& ctxt);
@@ -191,6 +284,8 @@ private:
     /** If profile is enable in this program */
     const bool profileEnabled;
     const bool frequencyCounterEnabled;
+    /** If scans are evaluated in batches of tuples */
+    const bool vectorizeEnabled;
     /** subroutines */
     std::map<std::string /*name*/, Own<Node>> subroutine;
     /** main program */
@@ -205,6 +300,8 @@ private:
     std::map<std::string, std::deque<std::atomic<std::size_t>>> frequencies;
     /** Profile for relation reads */
     std::map<std::string, std::atomic<std::size_t>> reads;
+    /** Profile for the executions of index operations */
+    std::map<const ram::IndexOperation*, std::atomic<std::size_t>> searches;
     /** DLL */
     std::vector<void*> dll;
     /** IndexAnalysis */
@@ -220,6 +317,8 @@ private:
 
     /** map for Relation to ID. */
     std::unordered_map<std::string, std::size_t> relToIdMap;
+    /** Hook taking over strata, if any */
+    StratumHandoff stratumHandoff;
 };
 
 }  // namespace souffle::interpreter
@@ -245,9 +245,29 @@ NodePtr NodeGenerator::visit_(type_identity<ram::ExistenceCheck>, const ram::Exi
         }
     }
     const auto& ramRelation = lookup(exists.getRelation());
+    auto* rel = getRelationHandle(encodeRelation(exists.getRelation()));
+
+    // the searched tuple is in the order of the index, the values of a Bloom filter in attribute order
+    const auto signature = engine.isa.getSearchSignature(&exists);
+    const auto bloomFilter = engine.isa.getIndexSelection(exists.getRelation()).getBloomFilterNum(signature);
+    std::vector<std::size_t> bloomFilterColumns;
+    if (bloomFilter) {
+        const auto order = (*rel)->getIndexOrder(encodeIndexPos(exists));
+        for (std::size_t attr = 0; attr < signature.arity(); ++attr) {
+            if (signature[attr] == ram::analysis::AttributeConstraint::None) {
+                continue;
+            }
+            for (std::size_t i = 0; i < signature.arity(); ++i) {
+                if (order[i] == attr) {
+                    bloomFilterColumns.push_back(i);
+                }
+            }
+        }
+    }
+
     NodeType type = constructNodeType(global, "ExistenceCheck", ramRelation);
     return mk<ExistenceCheck>(type, &exists, isTotal, encodeView(&exists), std::move(superOp),
-            ramRelation.isTemp(), ramRelation.getName());
+            ramRelation.isTemp(), ramRelation.getName(), rel, bloomFilter, std::move(bloomFilterColumns));
 }
 
 NodePtr NodeGenerator::visit_(
@@ -281,6 +301,46 @@ NodePtr NodeGenerator::visit_(type_identity<ram::Constraint>, const ram::Constra
         default: break;
     }
 
+    // fuse numeric comparisons of tuple elements and constants into a single node
+    auto toOperand = [](const Node& node, TupleConstraint::Operand& operand) {
+        if (node.getType() == I_TupleElement) {
+            const auto& element = static_cast<const TupleElement&>(node);
+            operand = {false, 0, element.getTupleId(), element.getElement()};
+            return true;
+        }
+        if (node.getType() == I_NumericConstant) {
+            operand = {true, static_cast<const ram::NumericConstant*>(node.getShadow())->getConstant(), 0, 0};
+            return true;
+        }
+        return false;
+    };
+    switch (relOp.getOperator()) {
+        case BinaryConstraintOp::EQ:
+        case BinaryConstraintOp::FEQ:
+        case BinaryConstraintOp::NE:
+        case BinaryConstraintOp::FNE:
+        case BinaryConstraintOp::LT:
+        case BinaryConstraintOp::ULT:
+        case BinaryConstraintOp::FLT:
+        case BinaryConstraintOp::LE:
+        case BinaryConstraintOp::ULE:
+        case BinaryConstraintOp::FLE:
+        case BinaryConstraintOp::GT:
+        case BinaryConstraintOp::UGT:
+        case BinaryConstraintOp::FGT:
+        case BinaryConstraintOp::GE:
+        case BinaryConstraintOp::UGE:
+        case BinaryConstraintOp::FGE: {
+            TupleConstraint::Operand lhs{};
+            TupleConstraint::Operand rhs{};
+            if (toOperand(*left, lhs) && toOperand(*right, rhs)) {
+                return mk<TupleConstraint>(I_TupleConstraint, &relOp, relOp.getOperator(), lhs, rhs);
+            }
+            break;
+        }
+        default: break;
+    }
+
     return mk<Constraint>(I_Constraint, &relOp, std::move(left), std::move(right));
 }
 
@@ -299,16 +359,25 @@ NodePtr NodeGenerator::visit_(type_identity<ram::Scan>, const ram::Scan& scan) {
     orderingContext.addTupleWithDefaultOrder(scan.getTupleId(), scan);
     std::size_t relId = encodeRelation(scan.getRelation());
     auto rel = getRelationHandle(relId);
+    NodePtr nested = visit_(type_identity<ram::TupleOperation>(), scan);
+    if (NodePtr batch = generateBatchScan(scan, rel, nested)) {
+        return batch;
+    }
     NodeType type = constructNodeType(global, "Scan", lookup(scan.getRelation()));
-    return mk<Scan>(type, &scan, rel, visit_(type_identity<ram::TupleOperation>(), scan));
+    return mk<Scan>(type, &scan, rel, std::move(nested));
 }
 
 NodePtr NodeGenerator::visit_(type_identity<ram::ParallelScan>, const ram::ParallelScan& pScan) {
     orderingContext.addTupleWithDefaultOrder(pScan.getTupleId(), pScan);
     std::size_t relId = encodeRelation(pScan.getRelation());
     auto rel = getRelationHandle(relId);
+    NodePtr nested = visit_(type_identity<ram::TupleOperation>(), pScan);
+    if (NodePtr batch = generateBatchScan(pScan, rel, nested)) {
+        static_cast<BatchScan&>(*batch).setViewContext(parentQueryViewContext);
+        return batch;
+    }
     NodeType type = constructNodeType(global, "ParallelScan", lookup(pScan.getRelation()));
-    auto res = mk<ParallelScan>(type, &pScan, rel, visit_(type_identity<ram::TupleOperation>(), pScan));
+    auto res = mk<ParallelScan>(type, &pScan, rel, std::move(nested));
     res->setViewContext(parentQueryViewContext);
     return res;
 }
@@ -375,6 +444,40 @@ NodePtr NodeGenerator::visit_(
     return res;
 }
 
+NodePtr NodeGenerator::visit_(type_identity<ram::TrieJoin>, const ram::TrieJoin& join) {
+    std::vector<RelationHandle*> rels;
+    std::vector<std::size_t> indexPos;
+    std::vector<std::vector<TrieJoin::Seek>> seeks(join.getNumVariables());
+    std::vector<NodePtrVec> values;
+    NodePtrVec conditions;
+    for (std::size_t atom = 0; atom < join.getNumAtoms(); ++atom) {
+        const std::string& name = join.getRelation(atom);
+        rels.push_back(getRelationHandle(encodeRelation(name)));
+
+        // the searches of the atom seek its join columns in order, then bind all of them
+        const auto& indexSelection = engine.isa.getIndexSelection(name);
+        const auto signatures = engine.isa.getSearchSignatures(&join, atom);
+        const auto columns = join.getJoinColumns(atom);
+        for (std::size_t i = 0; i < columns.size(); ++i) {
+            const std::size_t var = join.getVariables(atom)[columns[i]];
+            seeks[var].push_back({atom, columns[i], indexSelection.getLexOrderNum(signatures[i])});
+        }
+        indexPos.push_back(indexSelection.getLexOrderNum(signatures.back()));
+
+        // the tuples are enumerated through the virtual interface of the relation, in attribute order
+        orderingContext.addNewTuple(join.getTupleId(atom), getArity(name));
+
+        NodePtrVec atomValues;
+        for (const auto* value : join.getValues(atom)) {
+            atomValues.push_back(dispatch(*value));
+        }
+        values.push_back(std::move(atomValues));
+        conditions.push_back(dispatch(join.getCondition(atom)));
+    }
+    return mk<TrieJoin>(I_TrieJoin, &join, std::move(rels), std::move(indexPos), std::move(seeks),
+            std::move(values), std::move(conditions), dispatch(join.getOperation()));
+}
+
 NodePtr NodeGenerator::visit_(
         type_identity<ram::UnpackRecord>, const ram::UnpackRecord& unpack) {  // get reference
     orderingContext.addNewTuple(unpack.getTupleId(), unpack.getArity());
@@ -478,7 +581,7 @@ NodePtr NodeGenerator::visit_(
     /* Resolve functor to actual function pointer now */
     void* functionPtr = resolveFunctionPointers(piAggregate);
     auto res = mk<ParallelIndexAggregate>(type, &piAggregate, rel, std::move(expr), std::move(cond),
-            std::move(nested), std::move(init), functionPtr, encodeView(&piAggregate),
+            std::move(nested), std::move(init), functionPtr, encodeIndexPos(piAggregate),
             std::move(indexOperation));
     res->setViewContext(parentQueryViewContext);
     return res;
@@ -489,6 +592,18 @@ NodePtr NodeGenerator::visit_(type_identity<ram::Break>, const ram::Break& break
 }
 
 NodePtr NodeGenerator::visit_(type_identity<ram::Filter>, const ram::Filter& filter) {
+    // fuse a filter guarding a plain insert, unless the filter is profiled;
+    // inserts into the LLM query relation are skipped by the insert case and stay unfused
+    const auto* insert = as<ram::Insert>(filter.getOperation());
+    if (insert != nullptr && !isA<ram::GuardedInsert>(insert) &&
+            insert->getRelation() != "R_5coref4java8Callable16getBelongedClass" &&
+            !(engine.profileEnabled && engine.frequencyCounterEnabled && !filter.getProfileText().empty())) {
+        SuperInstruction superOp = getInsertSuperInstInfo(*insert);
+        std::size_t relId = encodeRelation(insert->getRelation());
+        auto rel = getRelationHandle(relId);
+        NodeType type = constructNodeType(global, "FilteredInsert", lookup(insert->getRelation()));
+        return mk<FilteredInsert>(type, &filter, rel, std::move(superOp), dispatch(filter.getCondition()));
+    }
     return mk<Filter>(I_Filter, &filter, dispatch(filter.getCondition()), dispatch(filter.getOperation()));
 }
 
@@ -579,6 +694,12 @@ NodePtr NodeGenerator::visit_(type_identity<ram::Clear>, const ram::Clear& clear
     return mk<Clear>(I_Clear, &clear, rel);
 }
 
+NodePtr NodeGenerator::visit_(type_identity<ram::Compact>, const ram::Compact& compact) {
+    std::size_t relId = encodeRelation(compact.getRelation());
+    auto rel = getRelationHandle(relId);
+    return mk<Compact>(I_Compact, &compact, rel);
+}
+
 NodePtr NodeGenerator::visit_(
         type_identity<ram::EstimateJoinSize>, const ram::EstimateJoinSize& estimateJoinSize) {
     std::size_t relId = encodeRelation(estimateJoinSize.getRelation());
@@ -646,12 +767,48 @@ NodePtr NodeGenerator::visit_(type_identity<ram::Query>, const ram::Query& query
     return res;
 }
 
+NodePtr NodeGenerator::visit_(type_identity<ram::Merge>, const ram::Merge& merge) {
+    std::size_t src = encodeRelation(merge.getSourceRelation());
+    std::size_t target = encodeRelation(merge.getTargetRelation());
+    return mk<Merge>(I_Merge, &merge, src, target);
+}
+
 NodePtr NodeGenerator::visit_(type_identity<ram::MergeExtend>, const ram::MergeExtend& extend) {
     std::size_t src = encodeRelation(extend.getFirstRelation());
     std::size_t target = encodeRelation(extend.getSecondRelation());
     return mk<MergeExtend>(I_MergeExtend, &extend, src, target);
 }
 
+NodePtr NodeGenerator::visit_(type_identity<ram::MergeLattice>, const ram::MergeLattice& merge) {
+    std::size_t src = encodeRelation(merge.getSourceRelation());
+    std::size_t target = encodeRelation(merge.getTargetRelation());
+    std::optional<std::size_t> delta;
+    if (!merge.getDeltaRelation().empty()) {
+        delta = encodeRelation(merge.getDeltaRelation());
+    }
+
+    // both relations are searched by the non-lattice attributes
+    ram::analysis::SearchSignature signature = engine.isa.getSearchSignature(&merge);
+    if (signature.empty()) {
+        signature = ram::analysis::SearchSignature::getFullSearchSignature(signature.arity());
+    }
+    std::size_t sourceIndexPos =
+            engine.isa.getIndexSelection(merge.getSourceRelation()).getLexOrderNum(signature);
+    std::size_t targetIndexPos =
+            engine.isa.getIndexSelection(merge.getTargetRelation()).getLexOrderNum(signature);
+
+    // the least upper bounds combine the tuples 0 and 1, which are given in attribute order
+    std::size_t arity = getArity(merge.getTargetRelation());
+    orderingContext.addNewTuple(0, arity);
+    orderingContext.addNewTuple(1, arity);
+    NodePtrVec lubs;
+    for (const auto* lub : merge.getLubs()) {
+        lubs.push_back(dispatch(*lub));
+    }
+    return mk<MergeLattice>(I_MergeLattice, &merge, src, target, delta, sourceIndexPos, targetIndexPos,
+            std::move(lubs));
+}
+
 NodePtr NodeGenerator::visit_(type_identity<ram::Swap>, const ram::Swap& swap) {
     std::size_t src = encodeRelation(swap.getFirstRelation());
     std::size_t target = encodeRelation(swap.getSecondRelation());
@@ -923,6 +1080,54 @@ SuperInstruction NodeGenerator::getEraseSuperInstInfo(const ram::Erase& exist) {
     return superOp;
 }
 
+NodePtr NodeGenerator::generateBatchScan(const ram::Scan& scan, RelationHandle* rel, NodePtr& nested) {
+    if (!engine.vectorizeEnabled || (engine.profileEnabled && engine.frequencyCounterEnabled)) {
+        return nullptr;
+    }
+
+    // split the conditions into constraints evaluated over the columns and the others
+    std::vector<const TupleConstraint*> constraints;
+    std::vector<const Node*> conditions;
+    std::function<void(const Node*)> addCondition = [&](const Node* condition) {
+        if (condition->getType() == I_Conjunction) {
+            for (const auto& child : static_cast<const Conjunction*>(condition)->getChildren()) {
+                addCondition(child.get());
+            }
+        } else if (condition->getType() == I_TupleConstraint) {
+            constraints.push_back(static_cast<const TupleConstraint*>(condition));
+        } else if (condition->getType() != I_True) {
+            conditions.push_back(condition);
+        }
+    };
+    const Node* node = nested.get();
+    while (node->getType() == I_Filter) {
+        const auto* filter = static_cast<const Filter*>(node);
+        addCondition(filter->getCondition());
+        node = filter->getNestedOperation();
+    }
+    const auto* insert = dynamic_cast<const Insert*>(node);
+    if (insert == nullptr || !insert->getRelation()->supportsBatchInsert()) {
+        return nullptr;
+    }
+    if (const auto* guarded = dynamic_cast<const GuardedInsert*>(insert)) {
+        addCondition(guarded->getCondition());
+    }
+
+    // inserts are deferred to the end of a batch unless the conditions read the target relation
+    std::string target;
+    std::set<std::string> read = {scan.getRelation()};
+    visit(scan.getOperation(), [&](const ram::Insert& ramInsert) { target = ramInsert.getRelation(); });
+    visit(scan.getOperation(),
+            [&](const ram::AbstractExistenceCheck& check) { read.insert(check.getRelation()); });
+    visit(scan.getOperation(), [&](const ram::EmptinessCheck& check) { read.insert(check.getRelation()); });
+    visit(scan.getOperation(), [&](const ram::RelationSize& size) { read.insert(size.getRelation()); });
+    const bool deferInsert = !contains(read, target);
+
+    NodeType type = constructNodeType(global, "BatchScan", lookup(scan.getRelation()));
+    return mk<BatchScan>(type, &scan, rel, std::move(nested), scan.getTupleId(), std::move(constraints),
+            std::move(conditions), insert, deferInsert);
+}
+
 // -- Definition of OrderingContext --
 
 NodeGenerator::OrderingContext::OrderingContext(NodeGenerator& generator) : generator(generator) {}
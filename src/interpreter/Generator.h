@@ -29,6 +29,7 @@
 #include "ram/Break.h"
 #include "ram/Call.h"
 #include "ram/Clear.h"
+#include "ram/Compact.h"
 #include "ram/Condition.h"
 #include "ram/Conjunction.h"
 #include "ram/Constraint.h"
@@ -40,6 +41,7 @@
 #include "ram/Expression.h"
 #include "ram/False.h"
 #include "ram/Filter.h"
+#include "ram/GuardedInsert.h"
 #include "ram/IO.h"
 #include "ram/IfExists.h"
 #include "ram/IndexAggregate.h"
@@ -52,7 +54,9 @@
 #include "ram/LogSize.h"
 #include "ram/LogTimer.h"
 #include "ram/Loop.h"
+#include "ram/Merge.h"
 #include "ram/MergeExtend.h"
+#include "ram/MergeLattice.h"
 #include "ram/Negation.h"
 #include "ram/NestedIntrinsicOperator.h"
 #include "ram/NestedOperation.h"
@@ -79,6 +83,7 @@
 #include "ram/SubroutineArgument.h"
 #include "ram/SubroutineReturn.h"
 #include "ram/Swap.h"
+#include "ram/TrieJoin.h"
 #include "ram/True.h"
 #include "ram/TupleElement.h"
 #include "ram/TupleOperation.h"
@@ -94,10 +99,12 @@
 #include <algorithm>
 #include <array>
 #include <cstddef>
+#include <functional>
 #include <iterator>
 #include <map>
 #include <memory>
 #include <queue>
+#include <set>
 #include <string>
 #include <typeinfo>
 #include <unordered_map>
@@ -187,6 +194,8 @@ public:
     NodePtr visit_(
             type_identity<ram::ParallelIndexIfExists>, const ram::ParallelIndexIfExists& piIfExists) override;
 
+    NodePtr visit_(type_identity<ram::TrieJoin>, const ram::TrieJoin& join) override;
+
     NodePtr visit_(type_identity<ram::UnpackRecord>, const ram::UnpackRecord& unpack) override;
 
     NodePtr visit_(type_identity<ram::Aggregate>, const ram::Aggregate& aggregate) override;
@@ -227,6 +236,7 @@ public:
     NodePtr visit_(type_identity<ram::DebugInfo>, const ram::DebugInfo& dbg) override;
 
     NodePtr visit_(type_identity<ram::Clear>, const ram::Clear& clear) override;
+    NodePtr visit_(type_identity<ram::Compact>, const ram::Compact& compact) override;
 
     NodePtr visit_(
             type_identity<ram::EstimateJoinSize>, const ram::EstimateJoinSize& estimateJoinSize) override;
@@ -237,8 +247,12 @@ public:
 
     NodePtr visit_(type_identity<ram::Query>, const ram::Query& query) override;
 
+    NodePtr visit_(type_identity<ram::Merge>, const ram::Merge& merge) override;
+
     NodePtr visit_(type_identity<ram::MergeExtend>, const ram::MergeExtend& extend) override;
 
+    NodePtr visit_(type_identity<ram::MergeLattice>, const ram::MergeLattice& merge) override;
+
     NodePtr visit_(type_identity<ram::Swap>, const ram::Swap& swap) override;
 
     NodePtr visit_(type_identity<ram::Assign>, const ram::Assign& assign) override;
@@ -347,6 +361,13 @@ private:
     SuperInstruction getInsertSuperInstInfo(const ram::Insert& exist);
     SuperInstruction getEraseSuperInstInfo(const ram::Erase& exist);
 
+    /**
+     * @brief Fuse a scan whose nested operation is a chain of filters ending in an insert into a batch
+     * scan owning the nested operation, if batch evaluation is enabled; otherwise return null and
+     * leave the nested operation.
+     */
+    NodePtr generateBatchScan(const ram::Scan& scan, RelationHandle* rel, NodePtr& nested);
+
     NodePtr mkInit(const ram::AbstractAggregate& aggregate);
     void* resolveFunctionPointers(const ram::AbstractAggregate& aggregate);
 
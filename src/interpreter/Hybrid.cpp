@@ -0,0 +1,165 @@
+/*
+ * Souffle - A Datalog Compiler
+ * Copyright (c) 2026, The Souffle Developers. All rights reserved.
+ * Licensed under the Universal Permissive License v 1.0 as shown at:
+ * - https://opensource.org/licenses/UPL
+ * - <souffle root>/licenses/SOUFFLE-UPL.txt
+ */
+
+/************************************************************************
+ *
+ * @file Hybrid.cpp
+ *
+ * Implements the hand-off from the interpreter to compiled strata.
+ *
+ ***********************************************************************/
+
+#include "interpreter/Hybrid.h"
+#include "Global.h"
+#include "interpreter/Relation.h"
+#include "ram/AutoIncrement.h"
+#include "ram/IO.h"
+#include "ram/Relation.h"
+#include "ram/utility/Visitor.h"
+#include "souffle/RamTypes.h"
+#include "souffle/SymbolTable.h"
+#include <iostream>
+#include <utility>
+#include <vector>
+
+#ifdef _MSC_VER
+#define dlopen(libname, flags) LoadLibrary((libname))
+#define dlsym(lib, fn) GetProcAddress(static_cast<HMODULE>(lib), (fn))
+#else
+#include <dlfcn.h>
+#endif
+
+namespace souffle::interpreter {
+
+namespace {
+const std::string stratumPrefix = "stratum_";
+}
+
+CompiledStrata::CompiledStrata(
+        Engine& engine, const ram::Program& program, std::string library, std::string factory)
+        : engine(engine), ramProgram(program), library(std::move(library)), factory(std::move(factory)) {}
+
+bool CompiledStrata::isSupported(const ram::Program& program) {
+    // Records and ADTs live in the record table of the engine and would have to be re-packed
+    // with their full type structure; provenance annotations are not exposed by the interface.
+    for (const ram::Relation* rel : program.getRelations()) {
+        for (const std::string& type : rel->getAttributeTypes()) {
+            if (type.empty() || type[0] == 'r' || type[0] == '+') {
+                return false;
+            }
+        }
+        if (rel->getArity() > 0 && rel->getAttributeNames().back() == "@level_number") {
+            return false;
+        }
+    }
+
+    // The auto-increment counter cannot be carried over to the compiled program, and
+    // relations spilled by the engine are unknown to it.
+    bool hasCounter = false;
+    visit(program, [&](const ram::AutoIncrement&) { hasCounter = true; });
+    bool hasSpill = false;
+    visit(program, [&](const ram::IO& io) { hasSpill |= io.get("operation") == "spill"; });
+    return !hasCounter && !hasSpill;
+}
+
+void CompiledStrata::setBuilt(bool success) {
+    state = success ? BuildState::Built : BuildState::Failed;
+}
+
+bool CompiledStrata::operator()(const std::string& stratum) {
+    if (program == nullptr) {
+        if (state.load() != BuildState::Built || !switchToCompiled()) {
+            return false;
+        }
+    }
+
+    std::vector<RamDomain> args;
+    std::vector<RamDomain> ret;
+    program->executeSubroutine(stratum.substr(stratumPrefix.size()), args, ret);
+    return true;
+}
+
+bool CompiledStrata::switchToCompiled() {
+    const bool verbose = engine.getGlobal().config().has("verbose");
+    auto fail = [&](const std::string& reason) {
+        state = BuildState::Failed;
+        if (verbose) {
+            std::cerr << "Hybrid execution stays in the interpreter: " << reason << "\n";
+        }
+        return false;
+    };
+
+    // Temporary relations are not visible through the interface; only switch once they are drained.
+    for (const ram::Relation* rel : ramProgram.getRelations()) {
+        if (rel->isTemp()) {
+            auto& handle = engine.getRelationHandle(engine.getRelIDMap().at(rel->getName()));
+            if (handle->size() != 0) {
+                return false;
+            }
+        }
+    }
+
+    // The library stays loaded until the process exits, since the compiled program outlives the engine.
+    void* handle = dlopen(library.c_str(), RTLD_NOW | RTLD_LOCAL);
+    if (handle == nullptr) {
+        return fail("cannot load `" + library + "`");
+    }
+    using ProgramCreator = SouffleProgram* (*)();
+    auto create = reinterpret_cast<ProgramCreator>(dlsym(handle, factory.c_str()));
+    if (create == nullptr) {
+        return fail("cannot find `" + factory + "` in `" + library + "`");
+    }
+
+    Own<SouffleProgram> compiled(create());
+    compiled->setNumThreads(engine.getNumberOfThreads());
+    compiled->setPerformIO(true);
+    compiled->setPruneImdtRels(true);
+    for (const ram::Relation* rel : ramProgram.getRelations()) {
+        if (!rel->isTemp() && compiled->getRelation(rel->getName()) == nullptr) {
+            return fail("relation `" + rel->getName() + "` is missing in the compiled program");
+        }
+    }
+
+    // Transfer the content of all relations; only symbols need to be re-encoded.
+    SymbolTable& symbols = engine.getSymbolTable();
+    std::size_t transferred = 0;
+    for (const ram::Relation* rel : ramProgram.getRelations()) {
+        if (rel->isTemp()) {
+            continue;
+        }
+        auto& source = *engine.getRelationHandle(engine.getRelIDMap().at(rel->getName()));
+        souffle::Relation* target = compiled->getRelation(rel->getName());
+        if (source.size() == 0) {
+            continue;
+        }
+
+        const auto& types = rel->getAttributeTypes();
+        const std::size_t arity = source.getArity();
+        SymbolTable& targetSymbols = target->getSymbolTable();
+        souffle::tuple tuple(target);
+        for (const RamDomain* data : source) {
+            for (std::size_t i = 0; i < arity; ++i) {
+                tuple[i] = (i < types.size() && types[i][0] == 's')
+                                   ? targetSymbols.encode(symbols.decode(data[i]))
+                                   : data[i];
+            }
+            target->insert(tuple);
+        }
+        transferred += source.size();
+        source.purge();
+    }
+
+    if (verbose) {
+        std::cout << "Hybrid execution: switched to compiled strata, transferred " << transferred
+                  << " tuples\n";
+    }
+    program = std::move(compiled);
+    return true;
+}
+
+}  // namespace souffle::interpreter
@@ -0,0 +1,80 @@
+/*
+ * Souffle - A Datalog Compiler
+ * Copyright (c) 2026, The Souffle Developers. All rights reserved.
+ * Licensed under the Universal Permissive License v 1.0 as shown at:
+ * - https://opensource.org/licenses/UPL
+ * - <souffle root>/licenses/SOUFFLE-UPL.txt
+ */
+
+/************************************************************************
+ *
+ * @file Hybrid.h
+ *
+ * Declares the hand-off from the interpreter to a compiled version of
+ * the same RAM program, used by the hybrid execution mode.
+ *
+ ***********************************************************************/
+
+#pragma once
+
+#include "interpreter/Engine.h"
+#include "ram/Program.h"
+#include "souffle/SouffleInterface.h"
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <string>
+
+namespace souffle::interpreter {
+
+/**
+ * @class CompiledStrata
+ * @brief Switches the evaluation of the remaining strata to a compiled program.
+ *
+ * The compiled program is built in the background as a shared library from the
+ * same RAM program the engine interprets. Once the build has finished, the next
+ * stratum boundary loads the library, copies the state of all relations from the
+ * engine into the compiled program and from then on runs every stratum through
+ * SouffleProgram::executeSubroutine.
+ *
+ * Install an instance as the stratum hand-off of the engine.
+ */
+class CompiledStrata {
+public:
+    /**
+     * @param engine the engine whose relations are transferred
+     * @param program the RAM program interpreted by the engine
+     * @param library path of the shared library to load
+     * @param factory name of the C function creating the compiled program
+     */
+    CompiledStrata(Engine& engine, const ram::Program& program, std::string library, std::string factory);
+
+    /** @brief Check whether relations of the program can be transferred at all */
+    static bool isSupported(const ram::Program& program);
+
+    /** @brief Report the outcome of the background build */
+    void setBuilt(bool success);
+
+    /** @brief Return true once the remaining strata run compiled */
+    bool hasSwitched() const {
+        return program != nullptr;
+    }
+
+    /** @brief Stratum hand-off: run the given stratum compiled if possible */
+    bool operator()(const std::string& stratum);
+
+private:
+    enum class BuildState { Pending, Built, Failed };
+
+    /** @brief Load the shared library and transfer all relations */
+    bool switchToCompiled();
+
+    Engine& engine;
+    const ram::Program& ramProgram;
+    std::string library;
+    std::string factory;
+    std::atomic<BuildState> state{BuildState::Pending};
+    Own<SouffleProgram> program;
+};
+
+}  // namespace souffle::interpreter
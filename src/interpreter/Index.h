@@ -20,6 +20,7 @@
 #include "souffle/datastructure/EquivalenceRelation.h"
 #include "souffle/datastructure/UnionFind.h"
 #include "souffle/utility/ContainerUtil.h"
+#include "souffle/utility/Iteration.h"
 #include "souffle/utility/MiscUtil.h"
 #include "souffle/utility/StreamUtil.h"
 #include <array>
@@ -192,6 +193,11 @@ public:
             }
             return {data.lower_bound(low, hints), data.upper_bound(high, hints)};
         }
+
+        /** Counts the elements in the given range within this index. */
+        std::size_t count(const Tuple& low, const Tuple& high) {
+            return countRange(data, range(low, high));
+        }
     };
 
 public:
@@ -238,6 +244,14 @@ public:
         return data.insert(order.encode(tuple));
     }
 
+    /**
+     * Inserts the given range of encoded tuples, which is sorted in the order of this index.
+     */
+    template <typename Iter>
+    void insertSorted(const Iter& a, const Iter& b) {
+        data.insertSorted(a, b);
+    }
+
     /**
      * Inserts all elements of the given index.
      */
@@ -278,6 +292,14 @@ public:
         return {data.lower_bound(low), data.upper_bound(high)};
     }
 
+    /**
+     * Counts the elements in the range [low,high]; takes logarithmic time
+     * if the underlying data structure supports it.
+     */
+    std::size_t count(const Tuple& low, const Tuple& high) const {
+        return countRange(data, range(low, high));
+    }
+
     /**
      * Retruns a partitioned list of iterators for parallel computation
      */
@@ -313,6 +335,20 @@ public:
         data.clear();
     }
 
+    /**
+     * Compacts the storage of the content of this index, if the underlying data structure supports it.
+     */
+    void compact() {
+        data.compact();
+    }
+
+    /**
+     * Obtains the number of bytes held by this index.
+     */
+    std::size_t getMemoryUsage() const {
+        return sizeof(*this) - sizeof(data) + data.getMemoryUsage();
+    }
+
     void printStats(std::ostream& o) const {
         data.printStats(o);
     }
@@ -396,6 +432,10 @@ public:
         souffle::range<iterator> range(const Tuple& /* l */, const Tuple& /* h */) const {
             return {iterator(data), iterator()};
         }
+
+        std::size_t count(const Tuple& /* l */, const Tuple& /* h */) const {
+            return data ? 1 : 0;
+        }
     };
 
 public:
@@ -439,6 +479,10 @@ public:
         return {this->begin(), this->end()};
     }
 
+    std::size_t count(const Tuple& /* l */, const Tuple& /* h */) const {
+        return size();
+    }
+
     std::vector<souffle::range<iterator>> partitionScan(std::size_t /* partitionCount */) const {
         std::vector<souffle::range<iterator>> res;
         res.push_back(scan());
@@ -454,6 +498,10 @@ public:
         data = false;
     }
 
+    std::size_t getMemoryUsage() const {
+        return sizeof(*this);
+    }
+
     void printStats(std::ostream&) const {}
 };
 
@@ -178,6 +178,11 @@ public:
         loadDataIfNeeded();
     }
 
+    // an insert loads the data from the API, which must see the relations as they are at that point
+    bool supportsBatchInsert() const override {
+        return false;
+    }
+
     bool contains(const RamDomain* tuple) const override {
         loadDataIfNeeded();
         return internalRelation->contains(tuple);
@@ -202,6 +207,24 @@ public:
         internalRelation->printStats(o);
     }
 
+    std::vector<std::size_t> getIndexMemoryUsage() const override {
+        // accounting must not trigger a query
+        if (!dataLoaded) {
+            return {};
+        }
+        return internalRelation->getIndexMemoryUsage();
+    }
+
+    std::size_t getNumberOfIndexes() const override {
+        return internalRelation->getNumberOfIndexes();
+    }
+
+    std::pair<Iterator, Iterator> range(
+            std::size_t indexPos, const RamDomain* low, const RamDomain* high) const override {
+        loadDataIfNeeded();
+        return internalRelation->range(indexPos, low, high);
+    }
+
     Order getIndexOrder(std::size_t idx) const override {
         loadDataIfNeeded();
         return internalRelation->getIndexOrder(idx);
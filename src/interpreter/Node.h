@@ -25,6 +25,7 @@
 
 #include "interpreter/Util.h"
 #include "ram/Relation.h"
+#include "souffle/BinaryConstraintOps.h"
 #include "souffle/RamTypes.h"
 #include "souffle/utility/ContainerUtil.h"
 #include "souffle/utility/MiscUtil.h"
@@ -36,7 +37,9 @@
 #include <array>
 #include <cassert>
 #include <cstddef>
+#include <cstdint>
 #include <memory>
+#include <optional>
 #include <regex>
 #include <string>
 #include <unordered_map>
@@ -49,6 +52,7 @@ class Node;
 }
 
 namespace interpreter {
+class Insert;
 class ViewContext;
 struct RelationWrapper;
 
@@ -78,15 +82,18 @@ struct RelationWrapper;
     FOR_EACH(Expand, ExistenceCheck)\
     FOR_EACH_PROVENANCE(Expand, ProvenanceExistenceCheck)\
     Forward(Constraint)\
+    Forward(TupleConstraint)\
     Forward(TupleOperation)\
     FOR_EACH(Expand, Scan)\
     FOR_EACH(Expand, ParallelScan)\
+    FOR_EACH(Expand, BatchScan)\
     FOR_EACH(Expand, IndexScan)\
     FOR_EACH(Expand, ParallelIndexScan)\
     FOR_EACH(Expand, IfExists)\
     FOR_EACH(Expand, ParallelIfExists)\
     FOR_EACH(Expand, IndexIfExists)\
     FOR_EACH(Expand, ParallelIndexIfExists)\
+    Forward(TrieJoin)\
     Forward(UnpackRecord)\
     FOR_EACH(Expand, Aggregate)\
     FOR_EACH(Expand, ParallelAggregate)\
@@ -96,6 +103,7 @@ struct RelationWrapper;
     Forward(Filter)\
     FOR_EACH(Expand, GuardedInsert)\
     FOR_EACH(Expand, Insert)\
+    FOR_EACH(Expand, FilteredInsert)\
     FOR_EACH_BTREE_DELETE(Expand, Erase)\
     Forward(SubroutineReturn)\
     Forward(Sequence)\
@@ -107,11 +115,14 @@ struct RelationWrapper;
     Forward(LogTimer)\
     Forward(DebugInfo)\
     Forward(Clear)\
+    Forward(Compact)\
     FOR_EACH(Expand, EstimateJoinSize)\
     Forward(LogSize)\
     Forward(IO)\
     Forward(Query)\
+    Forward(Merge)\
     Forward(MergeExtend)\
+    Forward(MergeLattice)\
     Forward(Swap)\
     Forward(Call)
 
@@ -137,12 +148,38 @@ enum NodeType {
 #define EXPAND_TOKEN_ENTRY(Structure, arity, auxiliaryArity, tok) \
     {__TO_STRING(I_##tok##_##Structure##_##arity##_##auxiliaryArity), I_##tok##_##Structure##_##arity##_##auxiliaryArity},
 
+/**
+ * Tests whether the given relation stores its tuples in 32-bit columns.
+ *
+ * On 64-bit builds, b-tree relations whose attributes are all identifiers of symbols,
+ * records or ADTs keep their values in half the space, unless disabled by the
+ * no-narrow-storage option.
+ */
+inline bool hasNarrowStorage(Global& glb, const ram::Relation& rel) {
+    if (sizeof(RamDomain) <= sizeof(uint32_t) || glb.config().has("no-narrow-storage")) {
+        return false;
+    }
+    if (rel.isNullary() || rel.getAuxiliaryArity() > 0) {
+        return false;
+    }
+    if (rel.getRepresentation() != RelationRepresentation::DEFAULT &&
+            rel.getRepresentation() != RelationRepresentation::BTREE) {
+        return false;
+    }
+    for (std::size_t i = 0; i < rel.getArity(); ++i) {
+        if (!rel.isIdentifierAttribute(i)) {
+            return false;
+        }
+    }
+    return true;
+}
+
 /**
  * Construct interpreterNodeType by looking at the representation and the arity of the given rel.
  *
  * Add reflective from string to NodeType.
  */
-inline NodeType constructNodeType(Global&, std::string tokBase, const ram::Relation& rel) {
+inline NodeType constructNodeType(Global& glb, std::string tokBase, const ram::Relation& rel) {
 
     static const std::unordered_map<std::string, NodeType> map = {
             FOR_EACH_INTERPRETER_TOKEN(SINGLE_TOKEN_ENTRY, EXPAND_TOKEN_ENTRY)
@@ -157,6 +194,12 @@ inline NodeType constructNodeType(Global&, std::string tokBase, const ram::Relat
         return map.at("I_" + tokBase + "_Eqrel_" + arity + "_" + auxiliaryArity);
     } else if(rel.getRepresentation() == RelationRepresentation::BTREE_DELETE) {
         return map.at("I_" + tokBase + "_BtreeDelete_" + arity + "_" + auxiliaryArity);
+    } else if(rel.getRepresentation() == RelationRepresentation::BTREE_COMPRESSED) {
+        return map.at("I_" + tokBase + "_BtreeCompressed_" + arity + "_" + auxiliaryArity);
+    } else if(rel.getRepresentation() == RelationRepresentation::HASHSET) {
+        return map.at("I_" + tokBase + "_Hashset_" + arity + "_" + auxiliaryArity);
+    } else if(hasNarrowStorage(glb, rel)) {
+        return map.at("I_" + tokBase + "_BtreeNarrow_" + arity + "_" + auxiliaryArity);
     } else  {
         return map.at("I_" + tokBase + "_Btree_" + arity + "_" + auxiliaryArity);
     }
@@ -614,12 +657,16 @@ public:
 /**
  * @class ExistenceCheck
  */
-class ExistenceCheck : public Node, public SuperOperation, public ViewOperation {
+class ExistenceCheck : public Node, public SuperOperation, public ViewOperation, public RelationalOperation {
 public:
     ExistenceCheck(enum NodeType ty, const ram::Node* sdw, bool totalSearch, std::size_t viewId,
-            SuperInstruction superInst, bool tempRelation, std::string relationName)
+            SuperInstruction superInst, bool tempRelation, std::string relationName,
+            RelationHandle* relHandle, std::optional<std::size_t> bloomFilter,
+            std::vector<std::size_t> bloomFilterColumns)
             : Node(ty, sdw), SuperOperation(std::move(superInst)), ViewOperation(viewId),
-              totalSearch(totalSearch), tempRelation(tempRelation), relationName(std::move(relationName)) {}
+              RelationalOperation(relHandle), totalSearch(totalSearch), tempRelation(tempRelation),
+              relationName(std::move(relationName)), bloomFilter(bloomFilter),
+              bloomFilterColumns(std::move(bloomFilterColumns)) {}
 
     bool isTotalSearch() const {
         return totalSearch;
@@ -633,10 +680,22 @@ public:
         return relationName;
     }
 
+    /** @brief The position of the Bloom filter of the relation guarding the search, if any */
+    const std::optional<std::size_t>& getBloomFilter() const {
+        return bloomFilter;
+    }
+
+    /** @brief The positions in the searched tuple of the attributes of the Bloom filter */
+    const std::vector<std::size_t>& getBloomFilterColumns() const {
+        return bloomFilterColumns;
+    }
+
 private:
     const bool totalSearch;
     const bool tempRelation;
     const std::string relationName;
+    const std::optional<std::size_t> bloomFilter;
+    const std::vector<std::size_t> bloomFilterColumns;
 };
 
 /**
@@ -657,6 +716,44 @@ class Constraint : public BinaryNode {
     using BinaryNode::BinaryNode;
 };
 
+/**
+ * @class TupleConstraint
+ * @brief Fused numeric constraint whose operands are tuple elements or constants.
+ *
+ * Replaces a Constraint node together with its two operand nodes, so that the
+ * comparison is evaluated without dispatching on the operands.
+ */
+class TupleConstraint : public Node {
+public:
+    /** @brief Operand of the comparison: either a constant or an element of a tuple in the context */
+    struct Operand {
+        bool isConstant;
+        RamDomain constant;
+        std::size_t tupleId;
+        std::size_t element;
+    };
+
+    TupleConstraint(enum NodeType ty, const ram::Node* sdw, BinaryConstraintOp op, Operand lhs, Operand rhs)
+            : Node(ty, sdw), op(op), lhs(lhs), rhs(rhs) {}
+
+    BinaryConstraintOp getOperator() const {
+        return op;
+    }
+
+    const Operand& getLhs() const {
+        return lhs;
+    }
+
+    const Operand& getRhs() const {
+        return rhs;
+    }
+
+private:
+    const BinaryConstraintOp op;
+    const Operand lhs;
+    const Operand rhs;
+};
+
 /**
  * @class TupleOperation
  */
@@ -680,6 +777,59 @@ class ParallelScan : public Scan, public AbstractParallel {
     using Scan::Scan;
 };
 
+/**
+ * @class BatchScan
+ * @brief Fused scan whose nested operation is a chain of filters ending in an insert.
+ *
+ * The scanned tuples are copied into column-major batches. Fused numeric constraints
+ * are evaluated column by column over a batch, the remaining conditions tuple by tuple
+ * on the tuples passing them, and the inserted tuples are collected and inserted once
+ * per batch when no condition reads the target relation. The nested operation is kept
+ * to own the conditions and the insert; its shadow is a RAM scan or parallel scan.
+ */
+class BatchScan : public Scan, public AbstractParallel {
+public:
+    /** Number of tuples in a batch */
+    static constexpr std::size_t batchSize = 1024;
+
+    BatchScan(enum NodeType ty, const ram::Node* sdw, RelationHandle* relHandle, Own<Node> nested,
+            std::size_t tupleId, std::vector<const TupleConstraint*> constraints,
+            std::vector<const Node*> conditions, const Insert* insert, bool deferInsert)
+            : Scan(ty, sdw, relHandle, std::move(nested)), tupleId(tupleId),
+              constraints(std::move(constraints)), conditions(std::move(conditions)), insert(insert),
+              deferInsert(deferInsert) {}
+
+    std::size_t getTupleId() const {
+        return tupleId;
+    }
+
+    /** The constraints evaluated over the columns of a batch */
+    const std::vector<const TupleConstraint*>& getConstraints() const {
+        return constraints;
+    }
+
+    /** The conditions evaluated on each tuple passing the constraints */
+    const std::vector<const Node*>& getConditions() const {
+        return conditions;
+    }
+
+    const Insert& getInsert() const {
+        return *insert;
+    }
+
+    /** Whether the inserted tuples are collected and inserted once per batch */
+    bool isInsertDeferred() const {
+        return deferInsert;
+    }
+
+private:
+    const std::size_t tupleId;
+    const std::vector<const TupleConstraint*> constraints;
+    const std::vector<const Node*> conditions;
+    const Insert* const insert;
+    const bool deferInsert;
+};
+
 /**
  * @class IndexScan
  */
@@ -738,6 +888,70 @@ class ParallelIndexIfExists : public IndexIfExists, public AbstractParallel {
     using IndexIfExists::IndexIfExists;
 };
 
+/**
+ * @class TrieJoin
+ */
+class TrieJoin : public Node, public NestedOperation {
+public:
+    using RelationHandle = Own<RelationWrapper>;
+
+    /** The column of an atom sought for a join variable, and the index answering the search */
+    struct Seek {
+        std::size_t atom;
+        std::size_t column;
+        std::size_t indexPos;
+    };
+
+    /**
+     * @param relHandles .. the relation of each atom
+     * @param indexPos   .. the index enumerating the tuples of each atom once all variables are bound
+     * @param seeks      .. the seeks of each join variable
+     * @param values     .. the fixed value of each column of each atom, or a null pointer
+     * @param conditions .. the condition of each atom
+     */
+    TrieJoin(enum NodeType ty, const ram::Node* sdw, std::vector<RelationHandle*> relHandles,
+            std::vector<std::size_t> indexPos, std::vector<std::vector<Seek>> seeks,
+            std::vector<VecOwn<Node>> values, VecOwn<Node> conditions, Own<Node> nested)
+            : Node(ty, sdw), NestedOperation(std::move(nested)), relHandles(std::move(relHandles)),
+              indexPos(std::move(indexPos)), seeks(std::move(seeks)), values(std::move(values)),
+              conditions(std::move(conditions)) {}
+
+    std::size_t getNumAtoms() const {
+        return relHandles.size();
+    }
+
+    std::size_t getNumVariables() const {
+        return seeks.size();
+    }
+
+    RelationWrapper* getRelation(std::size_t atom) const {
+        return relHandles[atom]->get();
+    }
+
+    std::size_t getIndexPos(std::size_t atom) const {
+        return indexPos[atom];
+    }
+
+    const std::vector<Seek>& getSeeks(std::size_t var) const {
+        return seeks[var];
+    }
+
+    const Node* getValue(std::size_t atom, std::size_t column) const {
+        return values[atom][column].get();
+    }
+
+    const Node* getCondition(std::size_t atom) const {
+        return conditions[atom].get();
+    }
+
+protected:
+    const std::vector<RelationHandle*> relHandles;
+    const std::vector<std::size_t> indexPos;
+    const std::vector<std::vector<Seek>> seeks;
+    const std::vector<VecOwn<Node>> values;
+    const VecOwn<Node> conditions;
+};
+
 /**
  * @class UnpackRecord
  */
@@ -855,6 +1069,16 @@ public:
             : Insert(ty, sdw, relHandle, std::move(superInst)), ConditionalOperation(std::move(condition)) {}
 };
 
+/**
+ * @class FilteredInsert
+ * @brief Fused filter whose nested operation is an insert.
+ *
+ * Evaluated like a guarded insert; its shadow is the RAM filter it replaces.
+ */
+class FilteredInsert : public GuardedInsert {
+    using GuardedInsert::GuardedInsert;
+};
+
 /**
  * @class SubroutineReturn
  */
@@ -929,6 +1153,15 @@ public:
             : Node(ty, sdw), RelationalOperation(handle) {}
 };
 
+/**
+ * @class Compact
+ */
+class Compact : public Node, public RelationalOperation {
+public:
+    Compact(enum NodeType ty, const ram::Node* sdw, RelationHandle* handle)
+            : Node(ty, sdw), RelationalOperation(handle) {}
+};
+
 /**
  * @class EstimateJoinSize
  */
@@ -979,6 +1212,15 @@ class Query : public UnaryNode, public AbstractParallel {
     using UnaryNode::UnaryNode;
 };
 
+/**
+ * @class Merge
+ */
+class Merge : public Node, public BinRelOperation {
+public:
+    Merge(enum NodeType ty, const ram::Node* sdw, std::size_t src, std::size_t target)
+            : Node(ty, sdw), BinRelOperation(src, target) {}
+};
+
 /**
  * @class MergeExtend
  */
@@ -988,6 +1230,38 @@ public:
             : Node(ty, sdw), BinRelOperation(src, target) {}
 };
 
+/**
+ * @class MergeLattice
+ */
+class MergeLattice : public CompoundNode, public BinRelOperation {
+public:
+    MergeLattice(enum NodeType ty, const ram::Node* sdw, std::size_t src, std::size_t target,
+            std::optional<std::size_t> delta, std::size_t sourceIndexPos, std::size_t targetIndexPos,
+            VecOwn<Node> lubs)
+            : CompoundNode(ty, sdw, std::move(lubs)), BinRelOperation(src, target), delta(delta),
+              sourceIndexPos(sourceIndexPos), targetIndexPos(targetIndexPos) {}
+
+    /** @brief get the delta relation, if changes are recorded */
+    inline std::optional<std::size_t> getDeltaId() const {
+        return delta;
+    }
+
+    /** @brief get the index of the source relation grouping tuples by their non-lattice attributes */
+    inline std::size_t getSourceIndexPos() const {
+        return sourceIndexPos;
+    }
+
+    /** @brief get the index of the target relation grouping tuples by their non-lattice attributes */
+    inline std::size_t getTargetIndexPos() const {
+        return targetIndexPos;
+    }
+
+private:
+    const std::optional<std::size_t> delta;
+    const std::size_t sourceIndexPos;
+    const std::size_t targetIndexPos;
+};
+
 /**
  * @class Swap
  */
@@ -45,6 +45,15 @@ public:
     void printStats(std::ostream& o) const override {
         o << "NullRelation: " << getName() << std::endl;
     }
+    std::vector<std::size_t> getIndexMemoryUsage() const override {
+        return {};
+    }
+    std::size_t getNumberOfIndexes() const override {
+        return 0;
+    }
+    std::pair<Iterator, Iterator> range(std::size_t, const RamDomain*, const RamDomain*) const override {
+        return {begin(), end()};
+    }
     souffle::interpreter::Order getIndexOrder(std::size_t) const override {
         return souffle::interpreter::Order::create(getArity());
     }
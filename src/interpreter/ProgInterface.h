@@ -29,9 +29,11 @@
 #include "souffle/SouffleInterface.h"
 #include "souffle/SymbolTable.h"
 #include "souffle/utility/MiscUtil.h"
+#include <algorithm>
 #include <cassert>
 #include <cstddef>
 #include <cstdint>
+#include <functional>
 #include <iosfwd>
 #include <map>
 #include <memory>
@@ -63,6 +65,59 @@ public:
         return relation.contains(t.data);
     }
 
+    /** Insert a batch of tuples */
+    void insertBatch(const RamDomain* data, std::size_t count, bool columnMajor = false) override {
+        const std::size_t arity = relation.getArity();
+        if (!columnMajor) {
+            relation.insertBatch(data, count);
+            return;
+        }
+        std::vector<RamDomain> row(arity);
+        for (std::size_t i = 0; i < count; i++) {
+            for (std::size_t j = 0; j < arity; j++) {
+                row[j] = data[j * count + i];
+            }
+            relation.insert(row.data());
+        }
+    }
+
+    /** Scan the relation in batches of tuples */
+    void scanBatch(const std::function<void(const RamDomain*, std::size_t)>& consumer, std::size_t batchSize,
+            bool columnMajor = false) const override {
+        scanBatches(relation.begin(), relation.end(), relation.getArity(), consumer, batchSize, columnMajor);
+    }
+
+    /** Look up the tuples matching a binding pattern through an index */
+    souffle::range<iterator> lookup(
+            const std::string& pattern, const tuple& lower, const tuple& upper) const override {
+        assert(pattern.size() == getArity() && "wrong pattern length");
+        const std::size_t arity = getArity();
+        // indexes compare attributes as signed numbers, which does not order floats and unsigned numbers
+        for (std::size_t i = 0; i < arity; i++) {
+            if (pattern[i] == 'r' && (types[i][0] == 'f' || types[i][0] == 'u')) {
+                return souffle::Relation::lookup(pattern, lower, upper);
+            }
+        }
+        // hash indexes only answer patterns binding all attributes
+        const bool ordered = relation.hasOrderedIndexes();
+        const bool bound = pattern.find_first_not_of('b') == std::string::npos;
+        for (std::size_t pos = 0; pos < relation.getNumberOfIndexes(); pos++) {
+            if (ordered ? !coversPattern(pattern, relation.getIndexOrder(pos)) : !bound) {
+                continue;
+            }
+            std::vector<RamDomain> low(arity);
+            std::vector<RamDomain> high(arity);
+            for (std::size_t i = 0; i < arity; i++) {
+                low[i] = pattern[i] == 'f' ? MIN_RAM_SIGNED : lower[i];
+                high[i] = pattern[i] == 'f' ? MAX_RAM_SIGNED : (pattern[i] == 'b' ? lower[i] : upper[i]);
+            }
+            auto range = relation.range(pos, low.data(), high.data());
+            return {iterator(mk<RelInterface::iterator_base>(id, this, range.first)),
+                    iterator(mk<RelInterface::iterator_base>(id, this, range.second))};
+        }
+        return souffle::Relation::lookup(pattern, lower, upper);
+    }
+
     /** Iterator to first tuple */
     iterator begin() const override {
         return RelInterface::iterator(mk<RelInterface::iterator_base>(id, this, relation.begin()));
@@ -110,6 +165,11 @@ public:
         return relation.size();
     }
 
+    /** Get number of bytes held by each index */
+    std::vector<std::size_t> getIndexMemoryUsage() const override {
+        return relation.getIndexMemoryUsage();
+    }
+
     /** Eliminate all the tuples in relation*/
     void purge() override {
         relation.purge();
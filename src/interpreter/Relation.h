@@ -20,7 +20,10 @@
 #include "ram/analysis/Index.h"
 #include "souffle/RamTypes.h"
 #include "souffle/SouffleInterface.h"
+#include "souffle/datastructure/BloomFilter.h"
 #include "souffle/utility/MiscUtil.h"
+#include "souffle/utility/ParallelUtil.h"
+#include <algorithm>
 #include <cstddef>
 #include <cstdint>
 #include <deque>
@@ -28,6 +31,7 @@
 #include <memory>
 #include <set>
 #include <string>
+#include <type_traits>
 #include <utility>
 #include <vector>
 
@@ -107,12 +111,34 @@ public:
 
     virtual void insert(const RamDomain*) = 0;
 
+    /** Insert the given number of tuples, stored one after the other */
+    virtual void insertBatch(const RamDomain* tuples, std::size_t count) {
+        for (std::size_t i = 0; i < count; ++i) {
+            insert(tuples + i * arity);
+        }
+    }
+
+    /** Tests whether inserts may be batched, i.e. deferred and reordered, without changing the result */
+    virtual bool supportsBatchInsert() const {
+        return true;
+    }
+
     virtual bool contains(const RamDomain*) const = 0;
 
     virtual std::size_t size() const = 0;
 
     virtual void purge() = 0;
 
+    /** Insert all tuples of the given relation */
+    virtual void merge(const RelationWrapper& other) {
+        for (const RamDomain* tuple : other) {
+            insert(tuple);
+        }
+    }
+
+    /** Compact the storage of the tuples inserted so far, if the indexes support it */
+    virtual void compact() {}
+
     const std::string& getName() const {
         return relName;
     }
@@ -127,6 +153,24 @@ public:
 
     virtual void printStats(std::ostream& o) const = 0;
 
+    /** Return the number of bytes held by each index of the relation */
+    virtual std::vector<std::size_t> getIndexMemoryUsage() const = 0;
+
+    /** Return the number of indexes of the relation */
+    virtual std::size_t getNumberOfIndexes() const = 0;
+
+    /** Tests whether the indexes answer range queries, rather than only searches binding all attributes */
+    virtual bool hasOrderedIndexes() const {
+        return true;
+    }
+
+    /**
+     * Return the tuples of an index between the two given tuples, which are
+     * given in attribute order rather than in the order of the index.
+     */
+    virtual std::pair<Iterator, Iterator> range(
+            std::size_t indexPos, const RamDomain* low, const RamDomain* high) const = 0;
+
     // -- Defines methods and interfaces for Interpreter execution. --
 public:
     using IndexViewPtr = Own<ViewWrapper>;
@@ -205,6 +249,17 @@ public:
 
         // Use the first index as default main index
         main = indexes[0].get();
+
+        for (const auto& search : indexSelection.getBloomFilters()) {
+            std::vector<std::size_t> columns;
+            for (std::size_t i = 0; i < getArity(); ++i) {
+                if (search[i] != ram::analysis::AttributeConstraint::None) {
+                    columns.push_back(i);
+                }
+            }
+            filterColumns.push_back(std::move(columns));
+            filters.push_back(mk<BloomFilter>());
+        }
     }
 
     Relation(Relation& other) = delete;
@@ -220,6 +275,34 @@ public:
         insert(constructTuple(data));
     }
 
+    void insertBatch(const RamDomain* tuples, std::size_t count) override {
+        // insert into one index after the other, and into the other indexes only the new tuples
+        std::vector<Tuple> fresh;
+        fresh.reserve(count);
+        for (std::size_t i = 0; i < count; ++i) {
+            Tuple tuple = constructTuple(tuples + i * Arity);
+            if (main->insert(tuple)) {
+                fresh.push_back(tuple);
+            }
+        }
+        for (std::size_t i = 1; i < indexes.size(); ++i) {
+            for (const auto& tuple : fresh) {
+                indexes[i]->insert(tuple);
+            }
+        }
+        for (const auto& tuple : fresh) {
+            insertIntoFilters(tuple);
+        }
+    }
+
+    void merge(const RelationWrapper& other) override {
+        if (const auto* rel = dynamic_cast<const Relation*>(&other)) {
+            merge(*rel);
+        } else {
+            RelationWrapper::merge(other);
+        }
+    }
+
     bool contains(const RamDomain* data) const override {
         return contains(constructTuple(data));
     }
@@ -279,6 +362,35 @@ public:
         return Iterator(new iterator_base(main->end(), main->getOrder()));
     }
 
+    std::size_t getNumberOfIndexes() const override {
+        return indexes.size();
+    }
+
+    void compact() override {
+        using Data = Structure<Arity, AuxiliaryArity>;
+        if constexpr (std::is_same_v<Data, BtreeCompressed<Arity, AuxiliaryArity>>) {
+            const std::size_t numIndexes = indexes.size();
+            PARALLEL_START
+            pfor(std::size_t i = 0; i < numIndexes; ++i) {
+                indexes[i]->compact();
+            }
+            PARALLEL_END
+        }
+    }
+
+    bool hasOrderedIndexes() const override {
+        return !std::is_same_v<Structure<Arity, AuxiliaryArity>, Hashset<Arity, AuxiliaryArity>>;
+    }
+
+    std::pair<Iterator, Iterator> range(
+            std::size_t indexPos, const RamDomain* low, const RamDomain* high) const override {
+        const Index& index = *indexes[indexPos];
+        const Order& order = index.getOrder();
+        auto range = index.range(order.encode(constructTuple(low)), order.encode(constructTuple(high)));
+        return {Iterator(new iterator_base(range.begin(), order)),
+                Iterator(new iterator_base(range.end(), order))};
+    }
+
     // -----
     // Following section defines and implement interfaces for interpreter execution.
     //
@@ -296,6 +408,7 @@ public:
         for (std::size_t i = 1; i < indexes.size(); ++i) {
             indexes[i]->insert(tuple);
         }
+        insertIntoFilters(tuple);
         return true;
     }
 
@@ -308,6 +421,63 @@ public:
         }
     }
 
+    /**
+     * Add all entries of the given relation to this relation.
+     *
+     * B-tree indexes are merged with the index of the given relation that has the same
+     * order, or with its tuples sorted in the order of the index, in parallel.
+     */
+    void merge(const Relation<Arity, AuxiliaryArity, Structure>& other) {
+        using Data = Structure<Arity, AuxiliaryArity>;
+        if constexpr (Arity > 0 && (std::is_same_v<Data, Btree<Arity, AuxiliaryArity>> ||
+                                           std::is_same_v<Data, BtreeCompressed<Arity, AuxiliaryArity>> ||
+                                           std::is_same_v<Data, BtreeNarrow<Arity, AuxiliaryArity>>)) {
+            if (other.empty()) {
+                return;
+            }
+            // the last task adds the tuples to the Bloom filters, which may already contain some of them
+            const std::size_t numIndexes = indexes.size();
+            PARALLEL_START
+            pfor(std::size_t i = 0; i <= numIndexes; ++i) {
+                if (i == numIndexes) {
+                    if (!filters.empty()) {
+                        const Order& otherOrder = other.main->getOrder();
+                        for (const auto& tuple : other.scan()) {
+                            insertIntoFilters(otherOrder.decode(tuple));
+                        }
+                    }
+                    continue;
+                }
+                Index& index = *indexes[i];
+                const Order& order = index.getOrder();
+                const Index* sorted = nullptr;
+                for (const auto& candidate : other.indexes) {
+                    if (candidate->getOrder() == order) {
+                        sorted = candidate.get();
+                        break;
+                    }
+                }
+                if (sorted != nullptr) {
+                    index.insertSorted(sorted->begin(), sorted->end());
+                    continue;
+                }
+                const Order& otherOrder = other.main->getOrder();
+                std::vector<Tuple> tuples;
+                tuples.reserve(other.size());
+                for (const auto& tuple : other.scan()) {
+                    tuples.push_back(order.encode(otherOrder.decode(tuple)));
+                }
+                const typename Index::Comparator cmp;
+                std::sort(tuples.begin(), tuples.end(),
+                        [&](const Tuple& a, const Tuple& b) { return cmp.less(a, b); });
+                index.insertSorted(tuples.begin(), tuples.end());
+            }
+            PARALLEL_END
+        } else {
+            insert(other);
+        }
+    }
+
     /**
      * Tests whether this relation contains the given tuple.
      */
@@ -322,6 +492,14 @@ public:
         return indexes[indexPos]->contains(low, high);
     }
 
+    /**
+     * Tests whether this relation may contain a tuple whose values in the attributes of a Bloom filter
+     * have the given hash (see BloomFilter::hash); if not, it does not.
+     */
+    bool mayContain(std::size_t filterPos, std::uint64_t hash) const {
+        return filters[filterPos]->mayContain(hash);
+    }
+
     /**
      * Obtains a pair of iterators to scan the entire relation.
      *
@@ -345,6 +523,13 @@ public:
         return indexes[indexPos]->range(low, high);
     }
 
+    /**
+     * Counts the tuples in the interval between the two given entries.
+     */
+    std::size_t count(const std::size_t& indexPos, const Tuple& low, const Tuple& high) const {
+        return indexes[indexPos]->count(low, high);
+    }
+
     /**
      * Returns a partitioned list of iterators coving elements in range [low, high]
      */
@@ -359,6 +544,7 @@ public:
      */
     void swap(Relation<Arity, AuxiliaryArity, Structure>& other) {
         indexes.swap(other.indexes);
+        filters.swap(other.filters);
     }
 
     /**
@@ -382,6 +568,9 @@ public:
         for (auto& idx : indexes) {
             idx->clear();
         }
+        for (auto& filter : filters) {
+            filter->clear();
+        }
     }
 
     /**
@@ -402,12 +591,40 @@ public:
         }
     }
 
+    std::vector<std::size_t> getIndexMemoryUsage() const override {
+        std::vector<std::size_t> res;
+        for (const auto& idx : indexes) {
+            res.push_back(idx->getMemoryUsage());
+        }
+        return res;
+    }
+
 protected:
+    static std::uint64_t hashColumns(const std::vector<std::size_t>& columns, const Tuple& tuple) {
+        std::uint64_t hash = BloomFilter::seed;
+        for (std::size_t column : columns) {
+            hash = BloomFilter::mix(hash, tuple[column]);
+        }
+        return hash;
+    }
+
+    void insertIntoFilters(const Tuple& tuple) {
+        for (std::size_t i = 0; i < filters.size(); ++i) {
+            filters[i]->insert(hashColumns(filterColumns[i], tuple));
+        }
+    }
+
     // a map of managed indexes
     VecOwn<Index> indexes;
 
     // a pointer to the main index within the managed index
     Index* main;
+
+    // the attributes of the searches guarded by Bloom filters
+    std::vector<std::vector<std::size_t>> filterColumns;
+
+    // the Bloom filters of the searches, in the order of the index selection
+    VecOwn<BloomFilter> filters;
 };
 
 template <std::size_t _Arity, std::size_t _AuxiliaryArity>
@@ -458,6 +675,18 @@ Own<RelationWrapper> createBTreeRelation(
 Own<RelationWrapper> createBTreeDeleteRelation(
         const ram::Relation& id, const ram::analysis::IndexCluster& indexSelection);
 
+// A factory for BTree based relation with compressed leaves.
+Own<RelationWrapper> createBTreeCompressedRelation(
+        const ram::Relation& id, const ram::analysis::IndexCluster& indexSelection);
+
+// A factory for BTree based relation storing tuples in 32-bit columns.
+Own<RelationWrapper> createBTreeNarrowRelation(
+        const ram::Relation& id, const ram::analysis::IndexCluster& indexSelection);
+
+// A factory for hash set based relation.
+Own<RelationWrapper> createHashsetRelation(
+        const ram::Relation& id, const ram::analysis::IndexCluster& indexSelection);
+
 // A factory for BTree provenance index.
 Own<RelationWrapper> createProvenanceRelation(
         const ram::Relation& id, const ram::analysis::IndexCluster& indexSelection);
@@ -19,8 +19,11 @@
 #include "souffle/RamTypes.h"
 #include "souffle/datastructure/BTree.h"
 #include "souffle/datastructure/BTreeDelete.h"
+#include "souffle/datastructure/CompressedBTree.h"
 #include "souffle/datastructure/Brie.h"
+#include "souffle/datastructure/ConcurrentInsertOnlyHashSet.h"
 #include "souffle/datastructure/EquivalenceRelation.h"
+#include "souffle/datastructure/NarrowIndex.h"
 #include "souffle/utility/ContainerUtil.h"
 #include "souffle/utility/MiscUtil.h"
 
@@ -117,6 +120,78 @@ namespace souffle::interpreter {
     func(BtreeDelete, 21, 0, __VA_ARGS__) \
     func(BtreeDelete, 22, 0, __VA_ARGS__)
 
+#define FOR_EACH_BTREE_COMPRESSED(func, ...)\
+    func(BtreeCompressed, 1, 0, __VA_ARGS__) \
+    func(BtreeCompressed, 2, 0, __VA_ARGS__) \
+    func(BtreeCompressed, 3, 0, __VA_ARGS__) \
+    func(BtreeCompressed, 4, 0, __VA_ARGS__) \
+    func(BtreeCompressed, 5, 0, __VA_ARGS__) \
+    func(BtreeCompressed, 6, 0, __VA_ARGS__) \
+    func(BtreeCompressed, 7, 0, __VA_ARGS__) \
+    func(BtreeCompressed, 8, 0, __VA_ARGS__) \
+    func(BtreeCompressed, 9, 0, __VA_ARGS__) \
+    func(BtreeCompressed, 10, 0, __VA_ARGS__) \
+    func(BtreeCompressed, 11, 0, __VA_ARGS__) \
+    func(BtreeCompressed, 12, 0, __VA_ARGS__) \
+    func(BtreeCompressed, 13, 0, __VA_ARGS__) \
+    func(BtreeCompressed, 14, 0, __VA_ARGS__) \
+    func(BtreeCompressed, 15, 0, __VA_ARGS__) \
+    func(BtreeCompressed, 16, 0, __VA_ARGS__) \
+    func(BtreeCompressed, 17, 0, __VA_ARGS__) \
+    func(BtreeCompressed, 18, 0, __VA_ARGS__) \
+    func(BtreeCompressed, 19, 0, __VA_ARGS__) \
+    func(BtreeCompressed, 20, 0, __VA_ARGS__) \
+    func(BtreeCompressed, 21, 0, __VA_ARGS__) \
+    func(BtreeCompressed, 22, 0, __VA_ARGS__)
+
+#define FOR_EACH_BTREE_NARROW(func, ...)\
+    func(BtreeNarrow, 1, 0, __VA_ARGS__) \
+    func(BtreeNarrow, 2, 0, __VA_ARGS__) \
+    func(BtreeNarrow, 3, 0, __VA_ARGS__) \
+    func(BtreeNarrow, 4, 0, __VA_ARGS__) \
+    func(BtreeNarrow, 5, 0, __VA_ARGS__) \
+    func(BtreeNarrow, 6, 0, __VA_ARGS__) \
+    func(BtreeNarrow, 7, 0, __VA_ARGS__) \
+    func(BtreeNarrow, 8, 0, __VA_ARGS__) \
+    func(BtreeNarrow, 9, 0, __VA_ARGS__) \
+    func(BtreeNarrow, 10, 0, __VA_ARGS__) \
+    func(BtreeNarrow, 11, 0, __VA_ARGS__) \
+    func(BtreeNarrow, 12, 0, __VA_ARGS__) \
+    func(BtreeNarrow, 13, 0, __VA_ARGS__) \
+    func(BtreeNarrow, 14, 0, __VA_ARGS__) \
+    func(BtreeNarrow, 15, 0, __VA_ARGS__) \
+    func(BtreeNarrow, 16, 0, __VA_ARGS__) \
+    func(BtreeNarrow, 17, 0, __VA_ARGS__) \
+    func(BtreeNarrow, 18, 0, __VA_ARGS__) \
+    func(BtreeNarrow, 19, 0, __VA_ARGS__) \
+    func(BtreeNarrow, 20, 0, __VA_ARGS__) \
+    func(BtreeNarrow, 21, 0, __VA_ARGS__) \
+    func(BtreeNarrow, 22, 0, __VA_ARGS__)
+
+#define FOR_EACH_HASHSET(func, ...)\
+    func(Hashset, 1, 0, __VA_ARGS__) \
+    func(Hashset, 2, 0, __VA_ARGS__) \
+    func(Hashset, 3, 0, __VA_ARGS__) \
+    func(Hashset, 4, 0, __VA_ARGS__) \
+    func(Hashset, 5, 0, __VA_ARGS__) \
+    func(Hashset, 6, 0, __VA_ARGS__) \
+    func(Hashset, 7, 0, __VA_ARGS__) \
+    func(Hashset, 8, 0, __VA_ARGS__) \
+    func(Hashset, 9, 0, __VA_ARGS__) \
+    func(Hashset, 10, 0, __VA_ARGS__) \
+    func(Hashset, 11, 0, __VA_ARGS__) \
+    func(Hashset, 12, 0, __VA_ARGS__) \
+    func(Hashset, 13, 0, __VA_ARGS__) \
+    func(Hashset, 14, 0, __VA_ARGS__) \
+    func(Hashset, 15, 0, __VA_ARGS__) \
+    func(Hashset, 16, 0, __VA_ARGS__) \
+    func(Hashset, 17, 0, __VA_ARGS__) \
+    func(Hashset, 18, 0, __VA_ARGS__) \
+    func(Hashset, 19, 0, __VA_ARGS__) \
+    func(Hashset, 20, 0, __VA_ARGS__) \
+    func(Hashset, 21, 0, __VA_ARGS__) \
+    func(Hashset, 22, 0, __VA_ARGS__)
+
 // Brie is disabled for now.
 #define FOR_EACH_BRIE(func, ...)
     /* func(Brie, 0, __VA_ARGS__) \ */
@@ -147,6 +222,9 @@ namespace souffle::interpreter {
 #define FOR_EACH(func, ...)                 \
     FOR_EACH_BTREE(func, __VA_ARGS__)       \
     FOR_EACH_BTREE_DELETE(func, __VA_ARGS__)\
+    FOR_EACH_BTREE_COMPRESSED(func, __VA_ARGS__)\
+    FOR_EACH_BTREE_NARROW(func, __VA_ARGS__)\
+    FOR_EACH_HASHSET(func, __VA_ARGS__)     \
     FOR_EACH_BRIE(func, __VA_ARGS__)        \
     FOR_EACH_PROVENANCE(func, __VA_ARGS__)  \
     FOR_EACH_EQREL(func, __VA_ARGS__)
@@ -165,6 +243,9 @@ struct comparator;
 
 template <unsigned First, unsigned... Rest>
 struct comparator<First, Rest...> {
+    // tuples are ordered by their first column first, enabling the SIMD search in b-tree nodes
+    static constexpr std::size_t leading_column = First;
+
     template <typename T>
     int operator()(const T& a, const T& b) const {
         return (a[First] < b[First]) ? -1 : ((a[First] > b[First]) ? 1 : comparator<Rest...>()(a, b));
@@ -281,9 +362,9 @@ struct ProvenanceUpdater {
     }
 };
 
-// Alias for btree_set
+// Alias for btree_set, allocating the nodes of each index from an arena of its own
 template <std::size_t Arity, std::size_t AuxiliaryArity>
-using Btree = btree_set<t_tuple<Arity>, comparator<Arity>, std::allocator<t_tuple<Arity>>, 256,
+using Btree = btree_set<t_tuple<Arity>, comparator<Arity>, NodeArena, 256,
         typename detail::default_strategy<t_tuple<Arity>>::type, comparator<Arity - AuxiliaryArity>,
         Updater<Arity, AuxiliaryArity>>;
 
@@ -293,12 +374,56 @@ using BtreeDelete = btree_delete_set<t_tuple<Arity>, comparator<Arity>, std::all
         typename detail::default_strategy<t_tuple<Arity>>::type, comparator<Arity - AuxiliaryArity>,
         Updater<Arity, AuxiliaryArity>>;
 
+// Alias for compressed_btree_set
+template <std::size_t Arity, std::size_t AuxiliaryArity>
+using BtreeCompressed = compressed_btree_set<t_tuple<Arity>, comparator<Arity>>;
+
+// Alias for btree_set storing tuples in 32-bit columns
+template <std::size_t Arity, std::size_t AuxiliaryArity>
+using BtreeNarrow = narrow_index<narrow_codec<t_tuple<Arity>>,
+        btree_set<typename narrow_codec<t_tuple<Arity>>::stored_type,
+                narrow_comparator<narrow_codec<t_tuple<Arity>>, comparator<Arity>>, NodeArena>>;
+
+// Adapter of TupleHashSet to the interface of an index
+// Note: hash sets are unordered, the bounds of a search must be the same tuple.
+template <std::size_t Arity, std::size_t AuxiliaryArity>
+struct Hashset : public TupleHashSet<Arity> {
+    using Base = TupleHashSet<Arity>;
+    using element_type = typename Base::element_type;
+    using iterator = typename Base::iterator;
+
+    // hash sets have no hints; probing does not depend on previous accesses
+    struct operation_hints {};
+
+    using Base::contains;
+
+    bool contains(const element_type& tuple, operation_hints&) const {
+        return contains(tuple);
+    }
+
+    iterator lower_bound(const element_type& tuple) const {
+        return this->find(tuple);
+    }
+
+    iterator lower_bound(const element_type& tuple, operation_hints&) const {
+        return lower_bound(tuple);
+    }
+
+    iterator upper_bound(const element_type& tuple) const {
+        return this->equalRange(tuple).end();
+    }
+
+    iterator upper_bound(const element_type& tuple, operation_hints&) const {
+        return upper_bound(tuple);
+    }
+};
+
 // Alias for Trie
 template <std::size_t Arity, std::size_t AuxiliaryArity>
 using Brie = Trie<Arity>;
 
 template <std::size_t Arity, std::size_t AuxiliaryArity>
-using Provenance = btree_set<t_tuple<Arity>, comparator<Arity>, std::allocator<t_tuple<Arity>>, 256,
+using Provenance = btree_set<t_tuple<Arity>, comparator<Arity>, NodeArena, 256,
         typename detail::default_strategy<t_tuple<Arity>>::type, comparator<Arity - AuxiliaryArity>,
         ProvenanceUpdater<Arity, AuxiliaryArity>>;
 
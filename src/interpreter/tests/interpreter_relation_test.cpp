@@ -20,10 +20,14 @@
 #include "interpreter/Relation.h"
 #include "ram/analysis/Index.h"
 #include "souffle/SouffleInterface.h"
+#include "souffle/datastructure/BloomFilter.h"
 #include "souffle/datastructure/SymbolTableImpl.h"
+#include <cstddef>
 #include <iosfwd>
+#include <set>
 #include <string>
 #include <utility>
+#include <vector>
 
 namespace souffle::interpreter::test {
 
@@ -287,4 +291,437 @@ TEST(Reordering, Iteration) {
     }
 }
 
+TEST(Relation2, MemoryUsage) {
+    SymbolTableImpl symbolTable;
+
+    // create an index selection with two indexes
+    SignatureOrderMap mapping;
+    SearchSignature first(2);
+    first[0] = AttributeConstraint::Equal;
+    SearchSignature second(2);
+    second[1] = AttributeConstraint::Equal;
+    SearchSet searches = {first, second};
+    LexOrder firstOrder = {0, 1};
+    LexOrder secondOrder = {1, 0};
+    OrderCollection orders = {firstOrder, secondOrder};
+    mapping.insert({first, firstOrder});
+    mapping.insert({second, secondOrder});
+    IndexCluster indexSelection(mapping, searches, orders);
+
+    Relation<2, 0, interpreter::Btree> rel("test", indexSelection);
+    const auto empty = rel.getIndexMemoryUsage();
+    EXPECT_EQ(2, empty.size());
+
+    for (RamDomain i = 0; i < 1000; ++i) {
+        rel.insert(souffle::Tuple<RamDomain, 2>{i, i});
+    }
+    const auto full = rel.getIndexMemoryUsage();
+    EXPECT_EQ(2, full.size());
+    EXPECT_TRUE(full[0] > empty[0]);
+    EXPECT_TRUE(full[1] > empty[1]);
+
+    RelInterface relInt(rel, symbolTable, "test", {"i", "i"}, {"i", "i"}, 2);
+    EXPECT_EQ(full[0] + full[1], relInt.getMemoryUsage());
+}
+
+TEST(Relation2, Merge) {
+    // the target has the orders {0, 1} and {1, 0}, the source only the order {1, 0}
+    auto cluster = [](const OrderCollection& orders) {
+        SignatureOrderMap mapping;
+        SearchSet searches;
+        for (const auto& order : orders) {
+            SearchSignature search(2);
+            search[order[0]] = AttributeConstraint::Equal;
+            searches.insert(search);
+            mapping.insert({search, order});
+        }
+        return IndexCluster(mapping, searches, orders);
+    };
+    const IndexCluster targetSelection = cluster({{0, 1}, {1, 0}});
+    const IndexCluster sourceSelection = cluster({{1, 0}});
+
+    // small sources are inserted into the indexes, large ones are merged into new indexes
+    for (RamDomain added : {10, 5000}) {
+        Relation<2, 0, interpreter::Btree> target("target", targetSelection);
+        Relation<2, 0, interpreter::Btree> source("source", sourceSelection);
+        std::set<std::pair<RamDomain, RamDomain>> expected;
+        for (RamDomain i = 0; i < 1000; ++i) {
+            target.insert(souffle::Tuple<RamDomain, 2>{i, 2 * i});
+            expected.insert({i, 2 * i});
+        }
+        for (RamDomain i = 0; i < added; ++i) {
+            source.insert(souffle::Tuple<RamDomain, 2>{i % 1500, i});
+            expected.insert({i % 1500, i});
+        }
+
+        RelationWrapper& wrapper = target;
+        wrapper.merge(source);
+        EXPECT_EQ(expected.size(), target.size());
+
+        // both indexes contain all tuples, in their respective order
+        for (std::size_t index = 0; index < 2; ++index) {
+            const RamDomain low[] = {MIN_RAM_SIGNED, MIN_RAM_SIGNED};
+            const RamDomain high[] = {MAX_RAM_SIGNED, MAX_RAM_SIGNED};
+            std::set<std::pair<RamDomain, RamDomain>> contents;
+            std::size_t count = 0;
+            auto range = wrapper.range(index, low, high);
+            for (auto it = range.first; it != range.second; ++it, ++count) {
+                contents.insert({(*it)[0], (*it)[1]});
+            }
+            EXPECT_EQ(expected.size(), count);
+            EXPECT_TRUE(contents == expected);
+        }
+    }
+}
+
+TEST(Relation2, BloomFilter) {
+    // a single index in the order {1, 0}, and a filter guarding the searches on the second attribute
+    SignatureOrderMap mapping;
+    SearchSignature existenceCheck = SearchSignature::getFullSearchSignature(2);
+    SearchSignature second(2);
+    second[1] = AttributeConstraint::Equal;
+    SearchSet searches = {existenceCheck, second};
+    LexOrder order = {1, 0};
+    OrderCollection orders = {order};
+    mapping.insert({existenceCheck, order});
+    mapping.insert({second, order});
+    IndexCluster indexSelection(mapping, searches, orders);
+    indexSelection.setBloomFilters({second});
+    EXPECT_EQ(0, *indexSelection.getBloomFilterNum(second));
+    EXPECT_FALSE(indexSelection.getBloomFilterNum(existenceCheck).has_value());
+
+    Relation<2, 0, interpreter::Btree> target("target", indexSelection);
+    Relation<2, 0, interpreter::Btree> source("source", indexSelection);
+    for (RamDomain i = 0; i < 1000; ++i) {
+        target.insert(souffle::Tuple<RamDomain, 2>{i, 2 * i});
+        source.insert(souffle::Tuple<RamDomain, 2>{i, 2 * i + 1});
+    }
+
+    // inserted values are never filtered, most absent ones are
+    std::size_t positives = 0;
+    for (RamDomain i = 0; i < 1000; ++i) {
+        EXPECT_TRUE(target.mayContain(0, BloomFilter::hash(2 * i)));
+        positives += target.mayContain(0, BloomFilter::hash(2 * i + 1)) ? 1 : 0;
+    }
+    EXPECT_TRUE(positives < 50);
+
+    // merging adds the values of the source
+    RelationWrapper& wrapper = target;
+    wrapper.merge(source);
+    for (RamDomain i = 0; i < 1000; ++i) {
+        EXPECT_TRUE(target.mayContain(0, BloomFilter::hash(2 * i + 1)));
+    }
+
+    // swapping exchanges the filters, purging clears them
+    source.purge();
+    target.swap(source);
+    EXPECT_TRUE(source.mayContain(0, BloomFilter::hash(7)));
+    EXPECT_FALSE(target.mayContain(0, BloomFilter::hash(7)));
+    source.purge();
+    EXPECT_FALSE(source.mayContain(0, BloomFilter::hash(7)));
+}
+
+TEST(Relation2, Hashset) {
+    SymbolTableImpl symbolTable;
+
+    // hash sets are only searched by full tuples
+    SignatureOrderMap mapping;
+    SearchSignature existenceCheck = SearchSignature::getFullSearchSignature(2);
+    SearchSet searches = {existenceCheck};
+    LexOrder order = {1, 0};
+    OrderCollection orders = {order};
+    mapping.insert({existenceCheck, order});
+    IndexCluster indexSelection(mapping, searches, orders);
+
+    Relation<2, 0, interpreter::Hashset> rel("test", indexSelection);
+    std::set<std::pair<RamDomain, RamDomain>> expected;
+    for (RamDomain i = 0; i < 1000; ++i) {
+        EXPECT_TRUE(rel.insert(souffle::Tuple<RamDomain, 2>{i, i % 10}));
+        EXPECT_FALSE(rel.insert(souffle::Tuple<RamDomain, 2>{i, i % 10}));
+        expected.insert({i, i % 10});
+    }
+    EXPECT_EQ(expected.size(), rel.size());
+    EXPECT_FALSE(rel.hasOrderedIndexes());
+
+    // searches for full tuples yield at most the searched tuple
+    RelationWrapper& wrapper = rel;
+    const RamDomain present[] = {42, 2};
+    const RamDomain absent[] = {42, 3};
+    auto range = wrapper.range(0, present, present);
+    EXPECT_TRUE(range.first != range.second);
+    EXPECT_EQ(42, (*range.first)[0]);
+    EXPECT_EQ(2, (*range.first)[1]);
+    EXPECT_TRUE(++range.first == range.second);
+    auto missing = wrapper.range(0, absent, absent);
+    EXPECT_TRUE(missing.first == missing.second);
+
+    // partitions cover all tuples exactly once
+    std::set<std::pair<RamDomain, RamDomain>> contents;
+    std::size_t count = 0;
+    for (const auto& chunk : rel.partitionScan(16)) {
+        for (const auto& tuple : chunk) {
+            contents.insert({tuple[1], tuple[0]});
+            ++count;
+        }
+    }
+    EXPECT_EQ(expected.size(), count);
+    EXPECT_TRUE(contents == expected);
+
+    // lookups not binding all attributes are answered by a scan
+    RelInterface relInt(rel, symbolTable, "test", {"i", "i"}, {"x", "y"}, 6);
+    std::size_t matches = 0;
+    for (const auto& t : relInt.lookup("fb", tuple(&relInt, {0, 3}), tuple(&relInt, {0, 3}))) {
+        EXPECT_EQ(3, t[0] % 10);
+        ++matches;
+    }
+    EXPECT_EQ(100, matches);
+    matches = 0;
+    for (const auto& t : relInt.lookup("bb", tuple(&relInt, {42, 2}), tuple(&relInt, {42, 2}))) {
+        EXPECT_EQ(42, t[0]);
+        ++matches;
+    }
+    EXPECT_EQ(1, matches);
+
+    // merging into a B-tree relation inserts the tuples one by one
+    Relation<2, 0, interpreter::Btree> target("target", indexSelection);
+    static_cast<RelationWrapper&>(target).merge(rel);
+    EXPECT_EQ(expected.size(), target.size());
+}
+
+TEST(Relation2, BtreeCompressed) {
+    // the relation has the orders {0, 1} and {1, 0}
+    SignatureOrderMap mapping;
+    SearchSignature first(2);
+    first[0] = AttributeConstraint::Equal;
+    SearchSignature second(2);
+    second[1] = AttributeConstraint::Equal;
+    SearchSet searches = {first, second};
+    LexOrder firstOrder = {0, 1};
+    LexOrder secondOrder = {1, 0};
+    OrderCollection orders = {firstOrder, secondOrder};
+    mapping.insert({first, firstOrder});
+    mapping.insert({second, secondOrder});
+    IndexCluster indexSelection(mapping, searches, orders);
+
+    Relation<2, 0, interpreter::BtreeCompressed> rel("test", indexSelection);
+    Relation<2, 0, interpreter::BtreeCompressed> source("source", indexSelection);
+    std::set<std::pair<RamDomain, RamDomain>> expected;
+    for (RamDomain i = 0; i < 1000; ++i) {
+        EXPECT_TRUE(rel.insert(souffle::Tuple<RamDomain, 2>{i, i % 10}));
+        expected.insert({i, i % 10});
+    }
+    RelationWrapper& wrapper = rel;
+    const auto staged = wrapper.getIndexMemoryUsage();
+    wrapper.compact();
+    const auto compacted = wrapper.getIndexMemoryUsage();
+    EXPECT_TRUE(compacted[0] < staged[0]);
+    EXPECT_TRUE(compacted[1] < staged[1]);
+
+    // tuples inserted after the compaction are found next to the compressed ones
+    EXPECT_FALSE(rel.insert(souffle::Tuple<RamDomain, 2>{42, 2}));
+    for (RamDomain i = 500; i < 1500; ++i) {
+        source.insert(souffle::Tuple<RamDomain, 2>{i, i % 7});
+        expected.insert({i, i % 7});
+    }
+    wrapper.merge(source);
+    EXPECT_EQ(expected.size(), rel.size());
+    std::size_t withSecond3 = 0;
+    for (const auto& t : expected) {
+        withSecond3 += (t.second == 3) ? 1 : 0;
+    }
+
+    for (bool compact : {false, true}) {
+        if (compact) {
+            wrapper.compact();
+        }
+        for (std::size_t index = 0; index < 2; ++index) {
+            const RamDomain low[] = {MIN_RAM_SIGNED, MIN_RAM_SIGNED};
+            const RamDomain high[] = {MAX_RAM_SIGNED, MAX_RAM_SIGNED};
+            std::set<std::pair<RamDomain, RamDomain>> contents;
+            std::size_t count = 0;
+            auto range = wrapper.range(index, low, high);
+            for (auto it = range.first; it != range.second; ++it, ++count) {
+                contents.insert({(*it)[0], (*it)[1]});
+            }
+            EXPECT_EQ(expected.size(), count);
+            EXPECT_TRUE(contents == expected);
+        }
+
+        // searches on the second attribute go through the second index
+        const RamDomain low[] = {MIN_RAM_SIGNED, 3};
+        const RamDomain high[] = {MAX_RAM_SIGNED, 3};
+        auto range = wrapper.range(1, low, high);
+        std::size_t matches = 0;
+        for (auto it = range.first; it != range.second; ++it, ++matches) {
+            EXPECT_EQ(3, (*it)[1]);
+        }
+        EXPECT_EQ(withSecond3, matches);
+    }
+}
+
+TEST(Relation2, BtreeNarrow) {
+    // the relation has the orders {0, 1} and {1, 0}
+    SignatureOrderMap mapping;
+    SearchSignature first(2);
+    first[0] = AttributeConstraint::Equal;
+    SearchSignature second(2);
+    second[1] = AttributeConstraint::Equal;
+    SearchSet searches = {first, second};
+    LexOrder firstOrder = {0, 1};
+    LexOrder secondOrder = {1, 0};
+    OrderCollection orders = {firstOrder, secondOrder};
+    mapping.insert({first, firstOrder});
+    mapping.insert({second, secondOrder});
+    IndexCluster indexSelection(mapping, searches, orders);
+
+    Relation<2, 0, interpreter::BtreeNarrow> rel("test", indexSelection);
+    Relation<2, 0, interpreter::BtreeNarrow> source("source", indexSelection);
+    std::set<std::pair<RamDomain, RamDomain>> expected;
+    for (RamDomain i = 0; i < 1000; ++i) {
+        EXPECT_TRUE(rel.insert(souffle::Tuple<RamDomain, 2>{i, -(i % 10)}));
+        expected.insert({i, -(i % 10)});
+    }
+    EXPECT_FALSE(rel.insert(souffle::Tuple<RamDomain, 2>{42, -2}));
+    for (RamDomain i = 500; i < 1500; ++i) {
+        source.insert(souffle::Tuple<RamDomain, 2>{i, -(i % 7)});
+        expected.insert({i, -(i % 7)});
+    }
+    RelationWrapper& wrapper = rel;
+    wrapper.merge(source);
+    EXPECT_EQ(expected.size(), rel.size());
+
+    // unconstrained attributes are searched with the limits of the domain
+    for (std::size_t index = 0; index < 2; ++index) {
+        const RamDomain low[] = {MIN_RAM_SIGNED, MIN_RAM_SIGNED};
+        const RamDomain high[] = {MAX_RAM_SIGNED, MAX_RAM_SIGNED};
+        std::set<std::pair<RamDomain, RamDomain>> contents;
+        auto range = wrapper.range(index, low, high);
+        for (auto it = range.first; it != range.second; ++it) {
+            contents.insert({(*it)[0], (*it)[1]});
+        }
+        EXPECT_TRUE(contents == expected);
+    }
+
+    std::size_t withSecond3 = 0;
+    for (const auto& t : expected) {
+        withSecond3 += (t.second == -3) ? 1 : 0;
+    }
+    const RamDomain low[] = {MIN_RAM_SIGNED, -3};
+    const RamDomain high[] = {MAX_RAM_SIGNED, -3};
+    auto range = wrapper.range(1, low, high);
+    std::size_t matches = 0;
+    for (auto it = range.first; it != range.second; ++it, ++matches) {
+        EXPECT_EQ(-3, (*it)[1]);
+    }
+    EXPECT_EQ(withSecond3, matches);
+}
+
+TEST(Relation2, Batch) {
+    SymbolTableImpl symbolTable;
+
+    // store the tuples in the order {1, 0}, which the batches must not expose
+    SignatureOrderMap mapping;
+    SearchSignature existenceCheck = SearchSignature::getFullSearchSignature(2);
+    SearchSet searches = {existenceCheck};
+    LexOrder order = {1, 0};
+    OrderCollection orders = {order};
+    mapping.insert({existenceCheck, order});
+    IndexCluster indexSelection(mapping, searches, orders);
+
+    Relation<2, 0, interpreter::Btree> rel("test", indexSelection);
+    RelInterface relInt(rel, symbolTable, "test", {"i", "s"}, {"x", "y"}, 4);
+
+    // insert the pairs (i, "s<i>") row by row, and the pairs (i, "t<i>") column by column
+    constexpr std::size_t count = 1000;
+    std::vector<std::string> symbols(count);
+    std::vector<RamDomain> encoded(count);
+    std::vector<RamDomain> rows(2 * count);
+    for (std::size_t i = 0; i < count; ++i) {
+        symbols[i] = "s" + std::to_string(i);
+    }
+    symbolTable.encodeBatch(symbols.data(), count, encoded.data());
+    for (std::size_t i = 0; i < count; ++i) {
+        rows[2 * i] = RamDomain(i);
+        rows[2 * i + 1] = encoded[i];
+    }
+    relInt.insertBatch(rows.data(), count);
+
+    std::vector<RamDomain> columns(2 * count);
+    for (std::size_t i = 0; i < count; ++i) {
+        symbols[i] = "t" + std::to_string(i);
+        columns[i] = RamDomain(i);
+    }
+    symbolTable.encodeBatch(symbols.data(), count, columns.data() + count);
+    relInt.insertBatch(columns.data(), count, true);
+    EXPECT_EQ(2 * count, relInt.size());
+
+    // scanning in either layout yields the same tuples as the iterator
+    std::vector<RamDomain> expected;
+    for (const auto& t : relInt) {
+        expected.push_back(t[0]);
+        expected.push_back(t[1]);
+    }
+    for (bool columnMajor : {false, true}) {
+        std::vector<RamDomain> scanned;
+        std::size_t batches = 0;
+        relInt.scanBatch(
+                [&](const RamDomain* batch, std::size_t size) {
+                    ++batches;
+                    for (std::size_t i = 0; i < size; ++i) {
+                        scanned.push_back(columnMajor ? batch[i] : batch[2 * i]);
+                        scanned.push_back(columnMajor ? batch[size + i] : batch[2 * i + 1]);
+                    }
+                },
+                300, columnMajor);
+        EXPECT_EQ(7, batches);
+        EXPECT_TRUE(scanned == expected);
+    }
+
+    std::vector<std::string> decoded(2);
+    const RamDomain pair[] = {expected[1], expected[3]};
+    symbolTable.decodeBatch(pair, 2, decoded.data());
+    EXPECT_EQ(symbolTable.decode(expected[1]), decoded[0]);
+    EXPECT_EQ(symbolTable.decode(expected[3]), decoded[1]);
+}
+
+TEST(Relation2, Lookup) {
+    SymbolTableImpl symbolTable;
+
+    // index the pairs by their second attribute only
+    SignatureOrderMap mapping;
+    SearchSignature second(2);
+    second[1] = AttributeConstraint::Equal;
+    SearchSet searches = {second};
+    LexOrder order = {1, 0};
+    OrderCollection orders = {order};
+    mapping.insert({second, order});
+    IndexCluster indexSelection(mapping, searches, orders);
+
+    Relation<2, 0, interpreter::Btree> rel("test", indexSelection);
+    for (RamDomain i = 0; i < 100; ++i) {
+        rel.insert(souffle::Tuple<RamDomain, 2>{i, i % 10});
+    }
+    RelInterface relInt(rel, symbolTable, "test", {"i", "u"}, {"x", "y"}, 5);
+
+    auto count = [&](const std::string& pattern, std::initializer_list<RamDomain> lower,
+                         std::initializer_list<RamDomain> upper) {
+        std::size_t n = 0;
+        for (const auto& t : relInt.lookup(pattern, tuple(&relInt, lower), tuple(&relInt, upper))) {
+            EXPECT_TRUE(t[0] % 10 == t[1]);
+            ++n;
+        }
+        return n;
+    };
+
+    // answered by the index
+    EXPECT_EQ(10, count("fb", {0, 3}, {0, 3}));
+    EXPECT_EQ(0, count("fb", {0, 10}, {0, 10}));
+    EXPECT_EQ(1, count("rb", {40, 3}, {50, 3}));
+    EXPECT_EQ(100, count("ff", {0, 0}, {0, 0}));
+    // answered by a scan
+    EXPECT_EQ(1, count("bf", {42, 0}, {42, 0}));
+    EXPECT_EQ(20, count("fr", {0, 2}, {0, 3}));
+    EXPECT_EQ(0, count("fr", {0, 3}, {0, 2}));
+}
+
 }  // namespace souffle::interpreter::test
@@ -0,0 +1,151 @@
+/*
+ * Souffle - A Datalog Compiler
+ * Copyright (c) 2026, The Souffle Developers. All rights reserved
+ * Licensed under the Universal Permissive License v 1.0 as shown at:
+ * - https://opensource.org/licenses/UPL
+ * - <souffle root>/licenses/SOUFFLE-UPL.txt
+ */
+
+/************************************************************************
+ *
+ * @file query_server_test.cpp
+ *
+ * Tests the answers of the query server over evaluated interpreter relations.
+ *
+ ***********************************************************************/
+
+#include "tests/test.h"
+
+#include "interpreter/ProgInterface.h"
+#include "interpreter/Relation.h"
+#include "ram/analysis/Index.h"
+#include "souffle/QueryServer.h"
+#include "souffle/RamTypes.h"
+#include "souffle/SouffleInterface.h"
+#include "souffle/datastructure/RecordTableImpl.h"
+#include "souffle/datastructure/SymbolTableImpl.h"
+#include <limits>
+#include <sstream>
+#include <string>
+
+namespace souffle::interpreter::test {
+
+using ::souffle::ram::analysis::AttributeConstraint;
+using ::souffle::ram::analysis::IndexCluster;
+using ::souffle::ram::analysis::LexOrder;
+using ::souffle::ram::analysis::OrderCollection;
+using ::souffle::ram::analysis::SearchSet;
+using ::souffle::ram::analysis::SearchSignature;
+using ::souffle::ram::analysis::SignatureOrderMap;
+
+/** A program consisting of a single evaluated relation */
+class SingleRelationProgram : public SouffleProgram {
+public:
+    SingleRelationProgram(souffle::Relation& rel, SymbolTable& symbolTable)
+            : symbolTable(symbolTable) {
+        addRelation(rel.getName(), rel, false, true);
+    }
+    void runAll(std::string, std::string, bool, bool) override {}
+    void loadAll(std::string) override {}
+    void printAll(std::string) override {}
+    void dumpInputs() override {}
+    void dumpOutputs() override {}
+    SymbolTable& getSymbolTable() override {
+        return symbolTable;
+    }
+    RecordTable& getRecordTable() override {
+        return recordTable;
+    }
+
+private:
+    SymbolTable& symbolTable;
+    SpecializedRecordTable<0> recordTable;
+};
+
+TEST(QueryServer, Lookups) {
+    SymbolTableImpl symbolTable;
+
+    // index the pairs by their first attribute
+    SignatureOrderMap mapping;
+    SearchSignature first(2);
+    first[0] = AttributeConstraint::Equal;
+    SearchSet searches = {first};
+    LexOrder order = {0, 1};
+    OrderCollection orders = {order};
+    mapping.insert({first, order});
+    IndexCluster indexSelection(mapping, searches, orders);
+
+    Relation<2, 0, interpreter::Btree> rel("edge", indexSelection);
+    for (RamDomain i = 0; i < 20; ++i) {
+        rel.insert(souffle::Tuple<RamDomain, 2>{symbolTable.encode("n" + std::to_string(i % 4)), i % 5});
+    }
+    RelInterface relInt(rel, symbolTable, "edge", {"s:node", "i:number"}, {"x", "y"}, 0);
+    SingleRelationProgram prog(relInt, symbolTable);
+
+    std::stringstream in;
+    in << "size edge\n"
+       << "edge(\"n1\", Y)\n"
+       << "edge(X, 3)\n"
+       << "edge(\"unknown\", _)\n"
+       << "edge(X, \"a\")\n"
+       << "path(X, Y)\n"
+       << "quit\n"
+       << "size edge\n";
+    std::stringstream out;
+    QueryServer(prog).serve(in, out);
+
+    // all pairs (i % 4, i % 5) are distinct
+    EXPECT_EQ(out.str(),
+            "20\nend 1\n"
+            "n1\t0\nn1\t1\nn1\t2\nn1\t3\nn1\t4\nend 5\n"
+            "n0\t3\nn1\t3\nn2\t3\nn3\t3\nend 4\n"
+            "end 0\n"
+            "error: invalid constant \"a\" for attribute y\n"
+            "error: unknown relation path\n");
+}
+
+TEST(QueryServer, Constants) {
+    SymbolTableImpl symbolTable;
+
+    // index the pairs by their second attribute
+    SignatureOrderMap mapping;
+    SearchSignature second(2);
+    second[1] = AttributeConstraint::Equal;
+    SearchSet searches = {second};
+    LexOrder order = {1, 0};
+    OrderCollection orders = {order};
+    mapping.insert({second, order});
+    IndexCluster indexSelection(mapping, searches, orders);
+
+    Relation<2, 0, interpreter::Btree> rel("value", indexSelection);
+    const RamFloat inf = std::numeric_limits<RamFloat>::infinity();
+    const RamFloat nan = std::numeric_limits<RamFloat>::quiet_NaN();
+    rel.insert(souffle::Tuple<RamDomain, 2>{symbolTable.encode("say \"hi\""), ramBitCast<RamDomain>(inf)});
+    rel.insert(souffle::Tuple<RamDomain, 2>{symbolTable.encode("back\\slash"), ramBitCast<RamDomain>(-inf)});
+    rel.insert(souffle::Tuple<RamDomain, 2>{symbolTable.encode("a, b"), ramBitCast<RamDomain>(nan)});
+    RelInterface relInt(rel, symbolTable, "value", {"s:name", "f:value"}, {"x", "y"}, 0);
+    SingleRelationProgram prog(relInt, symbolTable);
+
+    // inf and nan are constants of float attributes only; symbols unescape quotes and backslashes
+    std::stringstream in;
+    in << "value(X, inf)\n"
+       << "value(X, -inf)\n"
+       << "value(X, NaN)\n"
+       << "value(inf, -inf)\n"
+       << "value(\"say \\\"hi\\\"\", Y)\n"
+       << "value(\"back\\\\slash\", Y)\n"
+       << "value(\"a, b\", Y)\n";
+    std::stringstream out;
+    QueryServer(prog).serve(in, out);
+
+    EXPECT_EQ(out.str(),
+            "say \"hi\"\tinf\nend 1\n"
+            "back\\slash\t-inf\nend 1\n"
+            "a, b\tnan\nend 1\n"
+            "back\\slash\t-inf\nend 1\n"
+            "say \"hi\"\tinf\nend 1\n"
+            "back\\slash\t-inf\nend 1\n"
+            "a, b\tnan\nend 1\n");
+}
+
+}  // namespace souffle::interpreter::test
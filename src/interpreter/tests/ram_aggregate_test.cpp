@@ -0,0 +1,167 @@
+/*
+ * Souffle - A Datalog Compiler
+ * Copyright (c) 2026, The Souffle Developers. All rights reserved
+ * Licensed under the Universal Permissive License v 1.0 as shown at:
+ * - https://opensource.org/licenses/UPL
+ * - <souffle root>/licenses/SOUFFLE-UPL.txt
+ */
+
+/************************************************************************
+ *
+ * @file ram_aggregate_test.cpp
+ *
+ * Tests the evaluation of (parallel) aggregates in the interpreter.
+ *
+ ***********************************************************************/
+
+#include "tests/test.h"
+
+#include "AggregateOp.h"
+#include "Global.h"
+#include "RelationTag.h"
+#include "interpreter/Engine.h"
+#include "ram/Aggregate.h"
+#include "ram/Condition.h"
+#include "ram/Constraint.h"
+#include "ram/Expression.h"
+#include "ram/IndexAggregate.h"
+#include "ram/Insert.h"
+#include "ram/IntrinsicAggregator.h"
+#include "ram/ParallelAggregate.h"
+#include "ram/ParallelIndexAggregate.h"
+#include "ram/Program.h"
+#include "ram/Query.h"
+#include "ram/Relation.h"
+#include "ram/Sequence.h"
+#include "ram/SignedConstant.h"
+#include "ram/Statement.h"
+#include "ram/TranslationUnit.h"
+#include "ram/True.h"
+#include "ram/TupleElement.h"
+#include "ram/UndefValue.h"
+#include "reports/DebugReport.h"
+#include "reports/ErrorReport.h"
+#include "souffle/BinaryConstraintOps.h"
+#include "souffle/RamTypes.h"
+#include "souffle/utility/ContainerUtil.h"
+#include <cstddef>
+#include <functional>
+#include <map>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace souffle::interpreter::test {
+
+using namespace ram;
+
+/** Number of tuples (i, i % 10) in the aggregated relation */
+constexpr RamSigned EDGES = 10000;
+
+/**
+ * Fill the relation edge with the pairs (i, i % 10), run the aggregate produced
+ * by the given function and return the single value it inserted into the relation out.
+ */
+RamDomain aggregate(std::size_t jobs, const std::function<Own<Operation>(Own<Operation>)>& makeAggregate) {
+    Global glb;
+    glb.config().set("jobs", std::to_string(jobs));
+
+    VecOwn<ram::Relation> rels;
+    rels.push_back(mk<ram::Relation>("edge", 2, 0, std::vector<std::string>{"x", "y"},
+            std::vector<std::string>{"i:number", "i:number"}, RelationRepresentation::BTREE));
+    rels.push_back(mk<ram::Relation>("out", 1, 0, std::vector<std::string>{"x"},
+            std::vector<std::string>{"i:number"}, RelationRepresentation::BTREE));
+
+    VecOwn<Statement> statements;
+    for (RamSigned i = 0; i < EDGES; ++i) {
+        statements.push_back(mk<ram::Query>(mk<ram::Insert>("edge",
+                toVector<Own<Expression>>(mk<SignedConstant>(i), mk<SignedConstant>(i % 10)))));
+    }
+    auto insert = mk<ram::Insert>("out", toVector<Own<Expression>>(mk<ram::TupleElement>(0, 0)));
+    statements.push_back(mk<ram::Query>(makeAggregate(std::move(insert))));
+
+    std::map<std::string, Own<Statement>> subs;
+    Own<Program> prog =
+            mk<Program>(std::move(rels), mk<ram::Sequence>(std::move(statements)), std::move(subs));
+
+    ErrorReport errReport;
+    DebugReport debugReport(glb);
+    TranslationUnit translationUnit(glb, std::move(prog), errReport, debugReport);
+
+    Own<Engine> interpreter = mk<Engine>(translationUnit, jobs);
+    interpreter->executeMain();
+    auto& out = *interpreter->getRelationHandle(interpreter->getRelIDMap().at("out"));
+    return out.size() == 1 ? (*out.begin())[0] : MIN_RAM_SIGNED;
+}
+
+/** Aggregate x over all tuples of edge with x > 100 */
+RamDomain scanAggregate(std::size_t jobs, AggregateOp op, bool parallel) {
+    return aggregate(jobs, [&](Own<Operation> nested) -> Own<Operation> {
+        auto condition = mk<ram::Constraint>(
+                BinaryConstraintOp::GT, mk<ram::TupleElement>(0, 0), mk<SignedConstant>(100));
+        if (parallel) {
+            return mk<ram::ParallelAggregate>(std::move(nested), mk<IntrinsicAggregator>(op), "edge",
+                    mk<ram::TupleElement>(0, 0), std::move(condition), 0);
+        }
+        return mk<ram::Aggregate>(std::move(nested), mk<IntrinsicAggregator>(op), "edge",
+                mk<ram::TupleElement>(0, 0), std::move(condition), 0);
+    });
+}
+
+/** Aggregate x over all tuples of edge with y = 3 */
+RamDomain indexAggregate(std::size_t jobs, AggregateOp op, bool parallel) {
+    return aggregate(jobs, [&](Own<Operation> nested) -> Own<Operation> {
+        RamPattern pattern;
+        pattern.first.push_back(mk<UndefValue>());
+        pattern.first.push_back(mk<SignedConstant>(3));
+        pattern.second.push_back(mk<UndefValue>());
+        pattern.second.push_back(mk<SignedConstant>(3));
+        if (parallel) {
+            return mk<ram::ParallelIndexAggregate>(std::move(nested), mk<IntrinsicAggregator>(op), "edge",
+                    mk<ram::TupleElement>(0, 0), mk<ram::True>(), std::move(pattern), 0);
+        }
+        return mk<ram::IndexAggregate>(std::move(nested), mk<IntrinsicAggregator>(op), "edge",
+                mk<ram::TupleElement>(0, 0), mk<ram::True>(), std::move(pattern), 0);
+    });
+}
+
+TEST(ParallelAggregate, Scan) {
+    for (AggregateOp op : {AggregateOp::COUNT, AggregateOp::SUM, AggregateOp::MIN, AggregateOp::MAX}) {
+        const RamDomain expected = scanAggregate(1, op, false);
+        EXPECT_EQ(scanAggregate(1, op, true), expected);
+        EXPECT_EQ(scanAggregate(4, op, true), expected);
+    }
+    EXPECT_EQ(scanAggregate(4, AggregateOp::COUNT, true), EDGES - 101);
+    EXPECT_EQ(scanAggregate(4, AggregateOp::MIN, true), 101);
+    EXPECT_EQ(scanAggregate(4, AggregateOp::MAX, true), EDGES - 1);
+}
+
+TEST(ParallelAggregate, IndexScan) {
+    for (AggregateOp op : {AggregateOp::COUNT, AggregateOp::SUM, AggregateOp::MIN, AggregateOp::MAX}) {
+        const RamDomain expected = indexAggregate(1, op, false);
+        EXPECT_EQ(indexAggregate(1, op, true), expected);
+        EXPECT_EQ(indexAggregate(4, op, true), expected);
+    }
+    EXPECT_EQ(indexAggregate(4, AggregateOp::COUNT, true), EDGES / 10);
+    EXPECT_EQ(indexAggregate(4, AggregateOp::MIN, true), 3);
+}
+
+TEST(Aggregate, Count) {
+    // counting without a condition is answered from the size of the relation or range
+    for (bool parallel : {false, true}) {
+        RamDomain count = aggregate(4, [&](Own<Operation> nested) -> Own<Operation> {
+            auto function = mk<IntrinsicAggregator>(AggregateOp::COUNT);
+            if (parallel) {
+                return mk<ram::ParallelAggregate>(
+                        std::move(nested), std::move(function), "edge", mk<UndefValue>(), mk<ram::True>(), 0);
+            }
+            return mk<ram::Aggregate>(
+                    std::move(nested), std::move(function), "edge", mk<UndefValue>(), mk<ram::True>(), 0);
+        });
+        EXPECT_EQ(count, EDGES);
+        EXPECT_EQ(indexAggregate(4, AggregateOp::COUNT, parallel), EDGES / 10);
+    }
+}
+
+}  // namespace souffle::interpreter::test
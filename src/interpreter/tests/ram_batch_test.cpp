@@ -0,0 +1,193 @@
+/*
+ * Souffle - A Datalog Compiler
+ * Copyright (c) 2026, The Souffle Developers. All rights reserved
+ * Licensed under the Universal Permissive License v 1.0 as shown at:
+ * - https://opensource.org/licenses/UPL
+ * - <souffle root>/licenses/SOUFFLE-UPL.txt
+ */
+
+/************************************************************************
+ *
+ * @file ram_batch_test.cpp
+ *
+ * Tests the evaluation of scans in batches of tuples.
+ *
+ ***********************************************************************/
+
+#include "tests/test.h"
+
+#include "FunctorOps.h"
+#include "Global.h"
+#include "RelationTag.h"
+#include "interpreter/Engine.h"
+#include "interpreter/tests/ram_test_util.h"
+#include "ram/Conjunction.h"
+#include "ram/ExistenceCheck.h"
+#include "ram/Expression.h"
+#include "ram/Filter.h"
+#include "ram/Insert.h"
+#include "ram/IntrinsicOperator.h"
+#include "ram/Negation.h"
+#include "ram/ParallelScan.h"
+#include "ram/Program.h"
+#include "ram/Query.h"
+#include "ram/Relation.h"
+#include "ram/Scan.h"
+#include "ram/Sequence.h"
+#include "ram/Statement.h"
+#include "ram/TranslationUnit.h"
+#include "ram/UndefValue.h"
+#include "reports/DebugReport.h"
+#include "reports/ErrorReport.h"
+#include "souffle/BinaryConstraintOps.h"
+#include "souffle/RamTypes.h"
+#include "souffle/utility/ContainerUtil.h"
+#include <cstddef>
+#include <map>
+#include <memory>
+#include <set>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace souffle::interpreter::test {
+
+using namespace ram;
+
+using Pairs = std::set<std::pair<RamDomain, RamDomain>>;
+
+/** Number of edges, spanning several batches and ending in a partial one */
+constexpr RamSigned numEdges = 5000;
+
+RamSigned target(RamSigned source) {
+    return source * 7 % 1000 - 300;
+}
+
+/** Tests whether the given relation has a pair whose first value is the given one */
+Own<Condition> hasFirst(const std::string& rel, Own<Expression> first) {
+    return mk<ram::ExistenceCheck>(rel, toVector<Own<Expression>>(std::move(first), mk<ram::UndefValue>()));
+}
+
+/** Scans the edges, keeping those satisfying the condition and inserting the given values into out */
+Own<ram::Operation> filteredCopy(Own<Condition> condition, VecOwn<Expression> values, bool parallel = false) {
+    auto nested = mk<ram::Filter>(std::move(condition), mk<ram::Insert>("out", std::move(values)));
+    if (parallel) {
+        return mk<ram::ParallelScan>("edge", 0, std::move(nested));
+    }
+    return mk<ram::Scan>("edge", 0, std::move(nested));
+}
+
+/**
+ * Evaluates the given query over the edges (i, target(i)), scanning in batches if
+ * requested, and returns the pairs of out.
+ */
+Pairs evaluateQuery(Own<ram::Operation> query, bool vectorize, std::size_t jobs = 1) {
+    Global glb;
+    glb.config().set("jobs", std::to_string(jobs));
+    if (vectorize) {
+        glb.config().set("vectorize");
+    }
+
+    VecOwn<ram::Relation> rels;
+    for (const std::string name : {"edge", "out"}) {
+        rels.push_back(mk<ram::Relation>(name, 2, 0, std::vector<std::string>{"x", "y"},
+                std::vector<std::string>{"i:number", "i:number"}, RelationRepresentation::BTREE));
+    }
+
+    VecOwn<Statement> statements;
+    for (RamSigned i = 0; i < numEdges; ++i) {
+        statements.push_back(mk<ram::Query>(
+                mk<ram::Insert>("edge", toVector<Own<Expression>>(constant(i), constant(target(i))))));
+    }
+    statements.push_back(mk<ram::Query>(std::move(query)));
+
+    std::map<std::string, Own<Statement>> subs;
+    Own<Program> prog =
+            mk<Program>(std::move(rels), mk<ram::Sequence>(std::move(statements)), std::move(subs));
+
+    ErrorReport errReport;
+    DebugReport debugReport(glb);
+    TranslationUnit translationUnit(glb, std::move(prog), errReport, debugReport);
+
+    Own<Engine> interpreter = mk<Engine>(translationUnit, jobs);
+    interpreter->executeMain();
+    Pairs res;
+    for (const RamDomain* tuple : *interpreter->getRelationHandle(interpreter->getRelIDMap().at("out"))) {
+        res.insert({tuple[0], tuple[1]});
+    }
+    return res;
+}
+
+TEST(BatchScan, Constraints) {
+    auto query = [](bool parallel) {
+        return filteredCopy(mk<ram::Conjunction>(compare(BinaryConstraintOp::LT, x(), y()),
+                                    compare(BinaryConstraintOp::NE, y(), constant(405))),
+                toVector<Own<Expression>>(y(), x()), parallel);
+    };
+    Pairs expected;
+    for (RamSigned i = 0; i < numEdges; ++i) {
+        if (i < target(i) && target(i) != 405) {
+            expected.insert({target(i), i});
+        }
+    }
+    EXPECT_FALSE(expected.empty());
+
+    EXPECT_EQ(expected, evaluateQuery(query(false), false));
+    EXPECT_EQ(expected, evaluateQuery(query(false), true));
+    EXPECT_EQ(expected, evaluateQuery(query(true), true, 4));
+}
+
+TEST(BatchScan, Conditions) {
+    // the anti-join is evaluated tuple by tuple on the tuples passing the constraint
+    auto query = [] {
+        return filteredCopy(mk<ram::Conjunction>(mk<ram::Negation>(hasFirst("edge", y())),
+                                    compare(BinaryConstraintOp::GT, x(), constant(100))),
+                toVector<Own<Expression>>(x(), y()));
+    };
+    Pairs expected;
+    for (RamSigned i = 101; i < numEdges; ++i) {
+        if (target(i) < 0) {
+            expected.insert({i, target(i)});
+        }
+    }
+    EXPECT_FALSE(expected.empty());
+
+    EXPECT_EQ(expected, evaluateQuery(query(), false));
+    EXPECT_EQ(expected, evaluateQuery(query(), true));
+}
+
+TEST(BatchScan, ReadTarget) {
+    // each target is inserted with its least source only, as out is checked before each insert
+    auto query = [] {
+        return filteredCopy(mk<ram::Negation>(hasFirst("out", y())), toVector<Own<Expression>>(y(), x()));
+    };
+    std::map<RamSigned, RamSigned> least;
+    for (RamSigned i = numEdges - 1; i >= 0; --i) {
+        least[target(i)] = i;
+    }
+    Pairs expected(least.begin(), least.end());
+
+    EXPECT_EQ(expected, evaluateQuery(query(), false));
+    EXPECT_EQ(expected, evaluateQuery(query(), true));
+}
+
+TEST(BatchScan, Expressions) {
+    auto query = [] {
+        auto successor =
+                mk<ram::IntrinsicOperator>(FunctorOp::ADD, toVector<Own<Expression>>(x(), constant(1)));
+        return filteredCopy(compare(BinaryConstraintOp::GE, y(), constant(600)),
+                toVector<Own<Expression>>(std::move(successor), constant(2)));
+    };
+    Pairs expected;
+    for (RamSigned i = 0; i < numEdges; ++i) {
+        if (target(i) >= 600) {
+            expected.insert({i + 1, 2});
+        }
+    }
+    EXPECT_FALSE(expected.empty());
+
+    EXPECT_EQ(expected, evaluateQuery(query(), false));
+    EXPECT_EQ(expected, evaluateQuery(query(), true));
+}
+
+}  // namespace souffle::interpreter::test
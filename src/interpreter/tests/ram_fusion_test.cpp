@@ -0,0 +1,104 @@
+/*
+ * Souffle - A Datalog Compiler
+ * Copyright (c) 2026, The Souffle Developers. All rights reserved
+ * Licensed under the Universal Permissive License v 1.0 as shown at:
+ * - https://opensource.org/licenses/UPL
+ * - <souffle root>/licenses/SOUFFLE-UPL.txt
+ */
+
+/************************************************************************
+ *
+ * @file ram_fusion_test.cpp
+ *
+ * Tests the evaluation of fused interpreter nodes.
+ *
+ ***********************************************************************/
+
+#include "tests/test.h"
+
+#include "Global.h"
+#include "RelationTag.h"
+#include "interpreter/Engine.h"
+#include "interpreter/tests/ram_test_util.h"
+#include "ram/Expression.h"
+#include "ram/Filter.h"
+#include "ram/Insert.h"
+#include "ram/Program.h"
+#include "ram/Query.h"
+#include "ram/Relation.h"
+#include "ram/Scan.h"
+#include "ram/Sequence.h"
+#include "ram/Statement.h"
+#include "ram/TranslationUnit.h"
+#include "reports/DebugReport.h"
+#include "reports/ErrorReport.h"
+#include "souffle/BinaryConstraintOps.h"
+#include "souffle/RamTypes.h"
+#include "souffle/utility/ContainerUtil.h"
+#include <cstddef>
+#include <map>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace souffle::interpreter::test {
+
+using namespace ram;
+
+/**
+ * Scan the pairs (1,2), (2,2), (3,1) and (-1,5), keep those satisfying the given
+ * constraint and return the number of kept pairs.
+ */
+std::size_t countFiltered(const std::string& type, Own<Condition> condition) {
+    Global glb;
+    glb.config().set("jobs", "1");
+
+    VecOwn<ram::Relation> rels;
+    for (const std::string name : {"edge", "out"}) {
+        rels.push_back(mk<ram::Relation>(name, 2, 0, std::vector<std::string>{"x", "y"},
+                std::vector<std::string>{type, type}, RelationRepresentation::BTREE));
+    }
+
+    VecOwn<Statement> statements;
+    for (auto [a, b] : std::vector<std::pair<RamSigned, RamSigned>>{{1, 2}, {2, 2}, {3, 1}, {-1, 5}}) {
+        statements.push_back(mk<ram::Query>(mk<ram::Insert>(
+                "edge", toVector<Own<Expression>>(constant(a), constant(b)))));
+    }
+    VecOwn<Expression> values = toVector<Own<Expression>>(x(), y());
+    statements.push_back(mk<ram::Query>(mk<ram::Scan>(
+            "edge", 0, mk<ram::Filter>(std::move(condition), mk<ram::Insert>("out", std::move(values))))));
+
+    std::map<std::string, Own<Statement>> subs;
+    Own<Program> prog =
+            mk<Program>(std::move(rels), mk<ram::Sequence>(std::move(statements)), std::move(subs));
+
+    ErrorReport errReport;
+    DebugReport debugReport(glb);
+
+    TranslationUnit translationUnit(glb, std::move(prog), errReport, debugReport);
+
+    Own<Engine> interpreter = mk<Engine>(translationUnit, 1);
+    interpreter->executeMain();
+    return interpreter->getRelationHandle(interpreter->getRelIDMap().at("out"))->size();
+}
+
+TEST(TupleConstraint, Elements) {
+    EXPECT_EQ(countFiltered("i:number", compare(BinaryConstraintOp::EQ, x(), y())), 1);
+    EXPECT_EQ(countFiltered("i:number", compare(BinaryConstraintOp::NE, x(), y())), 3);
+    EXPECT_EQ(countFiltered("i:number", compare(BinaryConstraintOp::LT, x(), y())), 2);
+    EXPECT_EQ(countFiltered("i:number", compare(BinaryConstraintOp::GE, x(), y())), 2);
+}
+
+TEST(TupleConstraint, Constant) {
+    EXPECT_EQ(countFiltered("i:number", compare(BinaryConstraintOp::GT, x(), constant(1))), 2);
+    EXPECT_EQ(countFiltered("i:number", compare(BinaryConstraintOp::LE, constant(2), y())), 3);
+}
+
+TEST(TupleConstraint, Unsigned) {
+    // -1 is the largest value when compared as unsigned
+    EXPECT_EQ(countFiltered("u:unsigned", compare(BinaryConstraintOp::ULT, x(), constant(3))), 2);
+    EXPECT_EQ(countFiltered("u:unsigned", compare(BinaryConstraintOp::UGT, x(), y())), 2);
+}
+
+}  // namespace souffle::interpreter::test
@@ -0,0 +1,135 @@
+/*
+ * Souffle - A Datalog Compiler
+ * Copyright (c) 2026, The Souffle Developers. All rights reserved
+ * Licensed under the Universal Permissive License v 1.0 as shown at:
+ * - https://opensource.org/licenses/UPL
+ * - <souffle root>/licenses/SOUFFLE-UPL.txt
+ */
+
+/************************************************************************
+ *
+ * @file ram_lattice_test.cpp
+ *
+ * Tests merging tuples into relations with lattice attributes in the interpreter.
+ *
+ ***********************************************************************/
+
+#include "tests/test.h"
+
+#include "FunctorOps.h"
+#include "Global.h"
+#include "RelationTag.h"
+#include "interpreter/Engine.h"
+#include "ram/Expression.h"
+#include "ram/Insert.h"
+#include "ram/IntrinsicOperator.h"
+#include "ram/MergeLattice.h"
+#include "ram/Program.h"
+#include "ram/Query.h"
+#include "ram/Relation.h"
+#include "ram/Sequence.h"
+#include "ram/SignedConstant.h"
+#include "ram/Statement.h"
+#include "ram/TranslationUnit.h"
+#include "ram/TupleElement.h"
+#include "reports/DebugReport.h"
+#include "reports/ErrorReport.h"
+#include "souffle/RamTypes.h"
+#include "souffle/utility/ContainerUtil.h"
+#include <cstddef>
+#include <map>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace souffle::interpreter::test {
+
+using namespace ram;
+
+using Pairs = std::map<RamDomain, RamDomain>;
+
+/** Insert the pair (x, y) into the given relation */
+Own<Statement> insertPair(const std::string& rel, RamSigned x, RamSigned y) {
+    return mk<ram::Query>(
+            mk<ram::Insert>(rel, toVector<Own<Expression>>(mk<SignedConstant>(x), mk<SignedConstant>(y))));
+}
+
+Pairs contents(Engine& engine, const std::string& rel) {
+    Pairs result;
+    for (const RamDomain* tuple : *engine.getRelationHandle(engine.getRelIDMap().at(rel))) {
+        result[tuple[0]] = tuple[1];
+    }
+    return result;
+}
+
+/**
+ * Merge the pairs of @new_a into the lattice relation a, whose second attribute is
+ * ordered by the maximum, and return the resulting contents of a and @delta_a.
+ */
+std::pair<Pairs, Pairs> mergeLattice(
+        std::size_t jobs, const Pairs& a, const std::vector<std::pair<RamDomain, RamDomain>>& updates) {
+    Global glb;
+    glb.config().set("jobs", std::to_string(jobs));
+
+    VecOwn<ram::Relation> rels;
+    for (const std::string name : {"a", "@new_a", "@delta_a"}) {
+        const std::size_t auxiliaryArity = name == "@new_a" ? 0 : 1;
+        rels.push_back(mk<ram::Relation>(name, 2, auxiliaryArity, std::vector<std::string>{"x", "y"},
+                std::vector<std::string>{"i:number", "i:number"}, RelationRepresentation::BTREE));
+    }
+
+    VecOwn<Statement> statements;
+    for (const auto& [x, y] : a) {
+        statements.push_back(insertPair("a", x, y));
+    }
+    for (const auto& [x, y] : updates) {
+        statements.push_back(insertPair("@new_a", x, y));
+    }
+    VecOwn<Expression> lubs;
+    lubs.push_back(mk<ram::IntrinsicOperator>(FunctorOp::MAX,
+            toVector<Own<Expression>>(mk<ram::TupleElement>(0, 1), mk<ram::TupleElement>(1, 1))));
+    statements.push_back(mk<ram::MergeLattice>("a", "@new_a", "@delta_a", std::move(lubs)));
+
+    std::map<std::string, Own<Statement>> subs;
+    Own<Program> prog =
+            mk<Program>(std::move(rels), mk<ram::Sequence>(std::move(statements)), std::move(subs));
+
+    ErrorReport errReport;
+    DebugReport debugReport(glb);
+    TranslationUnit translationUnit(glb, std::move(prog), errReport, debugReport);
+
+    Own<Engine> interpreter = mk<Engine>(translationUnit, jobs);
+    interpreter->executeMain();
+    return {contents(*interpreter, "a"), contents(*interpreter, "@delta_a")};
+}
+
+TEST(MergeLattice, Groups) {
+    // the new tuples of a group are combined before they are merged into the relation
+    const Pairs a = {{1, 5}, {2, 3}};
+    const std::vector<std::pair<RamDomain, RamDomain>> updates = {{1, 2}, {2, 1}, {3, 4}, {1, 7}, {3, 9}};
+    for (std::size_t jobs : {1, 4}) {
+        auto [merged, delta] = mergeLattice(jobs, a, updates);
+        EXPECT_TRUE(merged == (Pairs{{1, 7}, {2, 3}, {3, 9}}));
+        // the tuple of group 2 is unchanged
+        EXPECT_TRUE(delta == (Pairs{{1, 7}, {3, 9}}));
+    }
+}
+
+TEST(MergeLattice, Parallel) {
+    // 500 groups of 20 tuples each
+    std::vector<std::pair<RamDomain, RamDomain>> updates;
+    Pairs expected;
+    for (RamDomain i = 0; i < 10000; ++i) {
+        updates.push_back({i % 500, i});
+        expected[i % 500] = i;
+    }
+    for (std::size_t jobs : {1, 4}) {
+        auto [merged, delta] = mergeLattice(jobs, {}, updates);
+        EXPECT_EQ(merged.size(), 500);
+        EXPECT_TRUE(merged == expected);
+        EXPECT_TRUE(delta == expected);
+    }
+}
+
+}  // namespace souffle::interpreter::test
@@ -0,0 +1,50 @@
+/*
+ * Souffle - A Datalog Compiler
+ * Copyright (c) 2026, The Souffle Developers. All rights reserved
+ * Licensed under the Universal Permissive License v 1.0 as shown at:
+ * - https://opensource.org/licenses/UPL
+ * - <souffle root>/licenses/SOUFFLE-UPL.txt
+ */
+
+/************************************************************************
+ *
+ * @file ram_test_util.h
+ *
+ * Helpers building the RAM expressions and conditions of the interpreter tests.
+ *
+ ***********************************************************************/
+
+#pragma once
+
+#include "ram/Condition.h"
+#include "ram/Constraint.h"
+#include "ram/Expression.h"
+#include "ram/SignedConstant.h"
+#include "ram/TupleElement.h"
+#include "souffle/BinaryConstraintOps.h"
+#include "souffle/RamTypes.h"
+#include "souffle/utility/Types.h"
+#include <utility>
+
+namespace souffle::interpreter::test {
+
+/** The first element of the scanned tuple */
+inline Own<ram::Expression> x() {
+    return mk<ram::TupleElement>(0, 0);
+}
+
+/** The second element of the scanned tuple */
+inline Own<ram::Expression> y() {
+    return mk<ram::TupleElement>(0, 1);
+}
+
+inline Own<ram::Expression> constant(RamSigned value) {
+    return mk<ram::SignedConstant>(value);
+}
+
+inline Own<ram::Condition> compare(
+        BinaryConstraintOp op, Own<ram::Expression> lhs, Own<ram::Expression> rhs) {
+    return mk<ram::Constraint>(op, std::move(lhs), std::move(rhs));
+}
+
+}  // namespace souffle::interpreter::test
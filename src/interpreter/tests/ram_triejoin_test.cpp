@@ -0,0 +1,281 @@
+/*
+ * Souffle - A Datalog Compiler
+ * Copyright (c) 2026, The Souffle Developers. All rights reserved
+ * Licensed under the Universal Permissive License v 1.0 as shown at:
+ * - https://opensource.org/licenses/UPL
+ * - <souffle root>/licenses/SOUFFLE-UPL.txt
+ */
+
+/************************************************************************
+ *
+ * @file ram_triejoin_test.cpp
+ *
+ * Tests the rewriting of cyclic joins into trie joins and their evaluation.
+ *
+ ***********************************************************************/
+
+#include "tests/test.h"
+
+#include "Global.h"
+#include "RelationTag.h"
+#include "interpreter/Engine.h"
+#include "ram/Conjunction.h"
+#include "ram/Constraint.h"
+#include "ram/ExistenceCheck.h"
+#include "ram/Expression.h"
+#include "ram/Filter.h"
+#include "ram/IndexIfExists.h"
+#include "ram/IndexScan.h"
+#include "ram/Insert.h"
+#include "ram/ParallelScan.h"
+#include "ram/Program.h"
+#include "ram/Query.h"
+#include "ram/Relation.h"
+#include "ram/Scan.h"
+#include "ram/Sequence.h"
+#include "ram/SignedConstant.h"
+#include "ram/Statement.h"
+#include "ram/TranslationUnit.h"
+#include "ram/TrieJoin.h"
+#include "ram/True.h"
+#include "ram/TupleElement.h"
+#include "ram/UndefValue.h"
+#include "ram/transform/Parallel.h"
+#include "ram/transform/TrieJoin.h"
+#include "ram/utility/Visitor.h"
+#include "reports/DebugReport.h"
+#include "reports/ErrorReport.h"
+#include "souffle/BinaryConstraintOps.h"
+#include "souffle/RamTypes.h"
+#include "souffle/utility/ContainerUtil.h"
+#include <cstddef>
+#include <map>
+#include <memory>
+#include <set>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace souffle::interpreter::test {
+
+using namespace ram;
+
+using Edges = std::vector<std::pair<RamSigned, RamSigned>>;
+
+/** A small graph with several triangles, some of them sharing edges */
+Edges graph() {
+    Edges res;
+    for (RamSigned i = 0; i < 12; ++i) {
+        res.push_back({i, (i + 1) % 12});
+        res.push_back({i, (i * 5 + 2) % 12});
+        res.push_back({(i * 7) % 12, i});
+    }
+    return res;
+}
+
+/** The triangles x -> y -> z -> x of the given edges */
+std::set<std::vector<RamDomain>> triangles(const Edges& edges) {
+    std::set<std::pair<RamSigned, RamSigned>> set(edges.begin(), edges.end());
+    std::set<std::vector<RamDomain>> res;
+    for (auto [x, y] : set) {
+        for (auto [u, z] : set) {
+            if (u == y && set.count({z, x}) > 0) {
+                res.insert({x, y, z});
+            }
+        }
+    }
+    return res;
+}
+
+/** Search pattern binding the given columns of a relation of the given arity */
+RamPattern pattern(std::size_t arity, std::map<std::size_t, std::pair<std::size_t, std::size_t>> elements) {
+    RamPattern res;
+    for (std::size_t col = 0; col < arity; ++col) {
+        if (contains(elements, col)) {
+            auto [id, element] = elements[col];
+            res.first.push_back(mk<ram::TupleElement>(id, element));
+            res.second.push_back(mk<ram::TupleElement>(id, element));
+        } else {
+            res.first.push_back(mk<ram::UndefValue>());
+            res.second.push_back(mk<ram::UndefValue>());
+        }
+    }
+    return res;
+}
+
+/** Inserts the triangles x -> y -> z -> x of the edge relations A, B and C into out */
+Own<ram::Operation> triangleQuery(bool existential) {
+    VecOwn<ram::Expression> values;
+    values.push_back(mk<ram::TupleElement>(0, 0));
+    values.push_back(mk<ram::TupleElement>(0, 1));
+    values.push_back(mk<ram::TupleElement>(1, 1));
+    if (existential) {
+        return mk<ram::Scan>("A", 0,
+                mk<ram::IndexScan>("B", 1, pattern(2, {{0, {0, 1}}}),
+                        mk<ram::IndexIfExists>("C", 2, mk<ram::True>(),
+                                pattern(2, {{0, {1, 1}}, {1, {0, 0}}}),
+                                mk<ram::Insert>("out", std::move(values)))));
+    }
+    return mk<ram::Scan>("A", 0,
+            mk<ram::IndexScan>("B", 1, pattern(2, {{0, {0, 1}}}),
+                    mk<ram::IndexScan>("C", 2, pattern(2, {{0, {1, 1}}, {1, {0, 0}}}),
+                            mk<ram::Insert>("out", std::move(values)))));
+}
+
+/** Creates a program inserting the given edges into the relations A, B and C before the given query */
+Own<Program> edgeProgram(const Edges& edges, Own<ram::Operation> query) {
+    VecOwn<ram::Relation> rels;
+    for (const std::string name : {"A", "B", "C"}) {
+        rels.push_back(mk<ram::Relation>(name, 2, 0, std::vector<std::string>{"x", "y"},
+                std::vector<std::string>{"i:number", "i:number"}, RelationRepresentation::BTREE));
+    }
+    rels.push_back(mk<ram::Relation>("out", 3, 0, std::vector<std::string>{"x", "y", "z"},
+            std::vector<std::string>{"i:number", "i:number", "i:number"}, RelationRepresentation::BTREE));
+
+    VecOwn<Statement> statements;
+    for (const std::string name : {"A", "B", "C"}) {
+        for (auto [x, y] : edges) {
+            statements.push_back(mk<ram::Query>(mk<ram::Insert>(
+                    name, toVector<Own<ram::Expression>>(mk<SignedConstant>(x), mk<SignedConstant>(y)))));
+        }
+    }
+    statements.push_back(mk<ram::Query>(std::move(query)));
+
+    std::map<std::string, Own<Statement>> subs;
+    return mk<Program>(std::move(rels), mk<ram::Sequence>(std::move(statements)), std::move(subs));
+}
+
+/** Executes the given translation unit and returns the tuples of out */
+std::set<std::vector<RamDomain>> execute(TranslationUnit& translationUnit, std::size_t jobs) {
+    Own<Engine> interpreter = mk<Engine>(translationUnit, jobs);
+    interpreter->executeMain();
+    std::set<std::vector<RamDomain>> res;
+    for (const RamDomain* tuple : *interpreter->getRelationHandle(interpreter->getRelIDMap().at("out"))) {
+        res.insert({tuple[0], tuple[1], tuple[2]});
+    }
+    return res;
+}
+
+/**
+ * Evaluates the given query over the given edges, after rewriting its cyclic joins
+ * if requested, and returns the tuples of out.
+ */
+std::set<std::vector<RamDomain>> evaluateQuery(
+        const Edges& edges, Own<ram::Operation> query, bool rewrite, bool& rewritten) {
+    Global glb;
+    glb.config().set("jobs", "1");
+
+    ErrorReport errReport;
+    DebugReport debugReport(glb);
+    TranslationUnit translationUnit(glb, edgeProgram(edges, std::move(query)), errReport, debugReport);
+    if (rewrite) {
+        transform::TrieJoinTransformer().apply(translationUnit);
+    }
+    rewritten = visitExists(translationUnit.getProgram(), [](const ram::TrieJoin&) { return true; });
+    return execute(translationUnit, 1);
+}
+
+TEST(TrieJoin, Triangles) {
+    const Edges edges = graph();
+    bool rewritten = false;
+
+    const auto nested = evaluateQuery(edges, triangleQuery(false), false, rewritten);
+    EXPECT_FALSE(rewritten);
+    EXPECT_EQ(nested, triangles(edges));
+    EXPECT_FALSE(nested.empty());
+
+    const auto joined = evaluateQuery(edges, triangleQuery(false), true, rewritten);
+    EXPECT_TRUE(rewritten);
+    EXPECT_EQ(joined, nested);
+}
+
+TEST(TrieJoin, Existential) {
+    const Edges edges = graph();
+    bool rewritten = false;
+
+    const auto nested = evaluateQuery(edges, triangleQuery(true), false, rewritten);
+    const auto joined = evaluateQuery(edges, triangleQuery(true), true, rewritten);
+    EXPECT_TRUE(rewritten);
+    EXPECT_EQ(joined, nested);
+}
+
+TEST(TrieJoin, ExistenceCheck) {
+    // the closing edge of a triangle is checked by a filter when its tuple is not used
+    auto query = [](bool conjunction) {
+        VecOwn<ram::Expression> values;
+        values.push_back(mk<ram::TupleElement>(0, 0));
+        values.push_back(mk<ram::TupleElement>(0, 1));
+        values.push_back(mk<ram::TupleElement>(1, 1));
+        Own<ram::Condition> condition = mk<ram::ExistenceCheck>("C",
+                toVector<Own<ram::Expression>>(mk<ram::TupleElement>(1, 1), mk<ram::TupleElement>(0, 0)));
+        if (conjunction) {
+            auto distinct = mk<ram::Constraint>(
+                    BinaryConstraintOp::NE, mk<ram::TupleElement>(0, 0), mk<ram::TupleElement>(1, 1));
+            condition = mk<ram::Conjunction>(std::move(distinct), std::move(condition));
+        }
+        return mk<ram::Scan>("A", 0,
+                mk<ram::IndexScan>("B", 1, pattern(2, {{0, {0, 1}}}),
+                        mk<ram::Filter>(std::move(condition), mk<ram::Insert>("out", std::move(values)))));
+    };
+    const Edges edges = graph();
+
+    for (bool conjunction : {false, true}) {
+        bool rewritten = false;
+        const auto nested = evaluateQuery(edges, query(conjunction), false, rewritten);
+        const auto joined = evaluateQuery(edges, query(conjunction), true, rewritten);
+        EXPECT_TRUE(rewritten);
+        EXPECT_EQ(joined, nested);
+        EXPECT_FALSE(joined.empty());
+    }
+}
+
+TEST(TrieJoin, NegativeValues) {
+    Edges edges;
+    for (auto [x, y] : graph()) {
+        edges.push_back({x - 6, y * 1000 - 3000});
+        edges.push_back({y * 1000 - 3000, x - 6});
+    }
+    edges.push_back({MIN_RAM_SIGNED, MAX_RAM_SIGNED});
+    edges.push_back({MAX_RAM_SIGNED, MIN_RAM_SIGNED});
+    edges.push_back({MIN_RAM_SIGNED, MIN_RAM_SIGNED});
+    edges.push_back({MAX_RAM_SIGNED, MAX_RAM_SIGNED});
+    bool rewritten = false;
+
+    const auto joined = evaluateQuery(edges, triangleQuery(false), true, rewritten);
+    EXPECT_TRUE(rewritten);
+    EXPECT_EQ(joined, triangles(edges));
+}
+
+TEST(TrieJoin, Acyclic) {
+    // a path x -> y -> z is joined by the nest of scans
+    VecOwn<ram::Expression> values;
+    values.push_back(mk<ram::TupleElement>(0, 0));
+    values.push_back(mk<ram::TupleElement>(0, 1));
+    values.push_back(mk<ram::TupleElement>(2, 1));
+    auto query = mk<ram::Scan>("A", 0,
+            mk<ram::IndexScan>("B", 1, pattern(2, {{0, {0, 1}}}),
+                    mk<ram::IndexScan>("C", 2, pattern(2, {{0, {1, 1}}}),
+                            mk<ram::Insert>("out", std::move(values)))));
+
+    bool rewritten = true;
+    evaluateQuery(graph(), std::move(query), true, rewritten);
+    EXPECT_FALSE(rewritten);
+}
+
+TEST(TrieJoin, Parallel) {
+    // trie joins are evaluated sequentially, so with several jobs the scans are parallelised instead
+    Global glb;
+    glb.config().set("jobs", "4");
+    const Edges edges = graph();
+
+    ErrorReport errReport;
+    DebugReport debugReport(glb);
+    TranslationUnit translationUnit(glb, edgeProgram(edges, triangleQuery(false)), errReport, debugReport);
+    EXPECT_FALSE(transform::TrieJoinTransformer().apply(translationUnit));
+    EXPECT_TRUE(transform::ParallelTransformer().apply(translationUnit));
+    EXPECT_FALSE(visitExists(translationUnit.getProgram(), [](const ram::TrieJoin&) { return true; }));
+    EXPECT_TRUE(visitExists(translationUnit.getProgram(), [](const ram::ParallelScan&) { return true; }));
+    EXPECT_EQ(execute(translationUnit, 4), triangles(edges));
+}
+
+}  // namespace souffle::interpreter::test
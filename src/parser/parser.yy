@@ -143,7 +143,9 @@
 %token BRIE_QUALIFIER            "BRIE datastructure qualifier"
 %token BTREE_QUALIFIER           "BTREE datastructure qualifier"
 %token BTREE_DELETE_QUALIFIER    "BTREE_DELETE datastructure qualifier"
+%token BTREE_COMPRESSED_QUALIFIER "BTREE_COMPRESSED datastructure qualifier"
 %token EQREL_QUALIFIER           "equivalence relation qualifier"
+%token HASHSET_QUALIFIER         "HASHSET datastructure qualifier"
 %token OVERRIDABLE_QUALIFIER     "relation qualifier overidable"
 %token INLINE_QUALIFIER          "relation qualifier inline"
 %token NO_INLINE_QUALIFIER       "relation qualifier no_inline"
@@ -719,10 +721,18 @@ relation_tags
     {
       $$ = driver.addReprTag(RelationTag::BTREE_DELETE, @2, $1);
     }
+  | relation_tags BTREE_COMPRESSED_QUALIFIER
+    {
+      $$ = driver.addReprTag(RelationTag::BTREE_COMPRESSED, @2, $1);
+    }
   | relation_tags EQREL_QUALIFIER
     {
       $$ = driver.addReprTag(RelationTag::EQREL, @2, $1);
     }
+  | relation_tags HASHSET_QUALIFIER
+    {
+      $$ = driver.addReprTag(RelationTag::HASHSET, @2, $1);
+    }
   /* Deprecated Qualifiers */
   | relation_tags OUTPUT_QUALIFIER
     {
@@ -1916,6 +1926,7 @@ ident_token
   | AS                        { $$ = makeTokenTree(ast::TokenKind::Ident, "as"); }
   | AUTOINC                   { $$ = makeTokenTree(ast::TokenKind::Ident, "autoinc"); }
   | BRIE_QUALIFIER            { $$ = makeTokenTree(ast::TokenKind::Ident, "brie"); }
+  | BTREE_COMPRESSED_QUALIFIER { $$ = makeTokenTree(ast::TokenKind::Ident, "btree_compressed"); }
   | BTREE_DELETE_QUALIFIER    { $$ = makeTokenTree(ast::TokenKind::Ident, "btree_delete"); }
   | BTREE_QUALIFIER           { $$ = makeTokenTree(ast::TokenKind::Ident, "btree"); }
   | BW_AND                    { $$ = makeTokenTree(ast::TokenKind::Ident, "band"); }
@@ -1930,6 +1941,7 @@ ident_token
   | COUNT                     { $$ = makeTokenTree(ast::TokenKind::Ident, "count"); }
   | EQREL_QUALIFIER           { $$ = makeTokenTree(ast::TokenKind::Ident, "eqrel"); }
   | FALSELIT                  { $$ = makeTokenTree(ast::TokenKind::Ident, "false"); }
+  | HASHSET_QUALIFIER         { $$ = makeTokenTree(ast::TokenKind::Ident, "hashset"); }
   | INLINE_QUALIFIER          { $$ = makeTokenTree(ast::TokenKind::Ident, "inline"); }
   | INPUT_QUALIFIER           { $$ = makeTokenTree(ast::TokenKind::Ident, "input"); }
   | L_AND                     { $$ = makeTokenTree(ast::TokenKind::Ident, "land"); }
@@ -0,0 +1,62 @@
+/*
+ * Souffle - A Datalog Compiler
+ * Copyright (c) 2026, The Souffle Developers. All rights reserved
+ * Licensed under the Universal Permissive License v 1.0 as shown at:
+ * - https://opensource.org/licenses/UPL
+ * - <souffle root>/licenses/SOUFFLE-UPL.txt
+ */
+
+/************************************************************************
+ *
+ * @file Compact.h
+ *
+ * Defines the RAM statement compacting the storage of a relation
+ *
+ ***********************************************************************/
+
+#pragma once
+
+#include "ram/Relation.h"
+#include "ram/RelationStatement.h"
+#include "souffle/utility/MiscUtil.h"
+#include "souffle/utility/StreamUtil.h"
+#include <memory>
+#include <ostream>
+#include <string>
+#include <utility>
+
+namespace souffle::ram {
+
+/**
+ * @class Compact
+ * @brief Compact the storage of a relation
+ *
+ * Relations with compressed leaves encode the tuples inserted since the
+ * last compaction; other relations are not affected. The content of the
+ * relation does not change.
+ *
+ * For example:
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~
+ * COMPACT A
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~
+ */
+class Compact : public RelationStatement {
+public:
+    Compact(std::string rel) : RelationStatement(NK_Compact, rel) {}
+
+    Compact* cloning() const override {
+        return new Compact(relation);
+    }
+
+    static bool classof(const Node* n) {
+        return n->getKind() == NK_Compact;
+    }
+
+protected:
+    void print(std::ostream& os, int tabpos) const override {
+        os << times(" ", tabpos);
+        os << "COMPACT " << relation << std::endl;
+    }
+};
+
+}  // namespace souffle::ram
@@ -0,0 +1,71 @@
+/*
+ * Souffle - A Datalog Compiler
+ * Copyright (c) 2026, The Souffle Developers. All rights reserved
+ * Licensed under the Universal Permissive License v 1.0 as shown at:
+ * - https://opensource.org/licenses/UPL
+ * - <souffle root>/licenses/SOUFFLE-UPL.txt
+ */
+
+/************************************************************************
+ *
+ * @file Merge.h
+ *
+ ***********************************************************************/
+
+#pragma once
+
+#include "ram/BinRelationStatement.h"
+#include "ram/Node.h"
+#include "souffle/utility/MiscUtil.h"
+#include "souffle/utility/StreamUtil.h"
+#include <ostream>
+#include <string>
+#include <utility>
+
+namespace souffle::ram {
+
+/**
+ * @class Merge
+ * @brief Insert all tuples of a relation into another relation
+ *
+ * Both relations are stored in sorted indexes, so that the tuples of the
+ * source relation can be merged into each index of the target relation in
+ * a single pass instead of being inserted one by one.
+ *
+ * The following example merges A into B:
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~
+ * MERGE B WITH A
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~
+ */
+class Merge : public BinRelationStatement {
+public:
+    Merge(std::string tRef, std::string sRef)
+            : BinRelationStatement(NK_Merge, std::move(sRef), std::move(tRef)) {}
+
+    /** @brief Get source relation */
+    const std::string& getSourceRelation() const {
+        return getFirstRelation();
+    }
+
+    /** @brief Get target relation */
+    const std::string& getTargetRelation() const {
+        return getSecondRelation();
+    }
+
+    Merge* cloning() const override {
+        return new Merge(second, first);
+    }
+
+    static bool classof(const Node* n) {
+        return n->getKind() == NK_Merge;
+    }
+
+protected:
+    void print(std::ostream& os, int tabpos) const override {
+        os << times(" ", tabpos);
+        os << "MERGE " << getTargetRelation() << " WITH " << getSourceRelation();
+        os << std::endl;
+    }
+};
+
+}  // namespace souffle::ram
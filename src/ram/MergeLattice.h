@@ -0,0 +1,119 @@
+/*
+ * Souffle - A Datalog Compiler
+ * Copyright (c) 2026, The Souffle Developers. All rights reserved
+ * Licensed under the Universal Permissive License v 1.0 as shown at:
+ * - https://opensource.org/licenses/UPL
+ * - <souffle root>/licenses/SOUFFLE-UPL.txt
+ */
+
+/************************************************************************
+ *
+ * @file MergeLattice.h
+ *
+ ***********************************************************************/
+
+#pragma once
+
+#include "ram/BinRelationStatement.h"
+#include "ram/Expression.h"
+#include "ram/Node.h"
+#include "souffle/utility/ContainerUtil.h"
+#include "souffle/utility/MiscUtil.h"
+#include "souffle/utility/StreamUtil.h"
+#include <cassert>
+#include <memory>
+#include <ostream>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace souffle::ram {
+
+/**
+ * @class MergeLattice
+ * @brief Merge the tuples of a relation into a relation with lattice attributes
+ *
+ * The tuples of the source relation are grouped by their non-lattice attributes,
+ * and the lattice attributes of each group are combined with their least upper
+ * bound. The result is combined with the tuple of the same group in the target
+ * relation, which is updated in place. Tuples that are new or changed in the
+ * target relation are also inserted into the optional delta relation.
+ *
+ * The least upper bound of the i-th lattice attribute is given by an expression
+ * over the elements t0.j and t1.j, where j is the position of the attribute.
+ *
+ * The following example merges @new_A into A and records the changes in @delta_A:
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~
+ * MERGE-LATTICE A WITH @new_A DELTA @delta_A LUB (@lub(t0.1,t1.1))
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~
+ */
+class MergeLattice : public BinRelationStatement {
+public:
+    MergeLattice(std::string tRef, std::string sRef, std::string dRef, VecOwn<Expression> lubs)
+            : BinRelationStatement(NK_MergeLattice, std::move(sRef), std::move(tRef)), delta(std::move(dRef)),
+              lubs(std::move(lubs)) {
+        assert(allValidPtrs(this->lubs));
+    }
+
+    /** @brief Get source relation */
+    const std::string& getSourceRelation() const {
+        return getFirstRelation();
+    }
+
+    /** @brief Get target relation */
+    const std::string& getTargetRelation() const {
+        return getSecondRelation();
+    }
+
+    /** @brief Get delta relation, or an empty string if changes are not recorded */
+    const std::string& getDeltaRelation() const {
+        return delta;
+    }
+
+    /** @brief Get least upper bounds of the lattice attributes */
+    std::vector<Expression*> getLubs() const {
+        return toPtrVector(lubs);
+    }
+
+    MergeLattice* cloning() const override {
+        return new MergeLattice(second, first, delta, clone(lubs));
+    }
+
+    void apply(const NodeMapper& map) override {
+        for (auto& lub : lubs) {
+            lub = map(std::move(lub));
+        }
+    }
+
+    static bool classof(const Node* n) {
+        return n->getKind() == NK_MergeLattice;
+    }
+
+protected:
+    void print(std::ostream& os, int tabpos) const override {
+        os << times(" ", tabpos);
+        os << "MERGE-LATTICE " << getTargetRelation() << " WITH " << getSourceRelation();
+        if (!delta.empty()) {
+            os << " DELTA " << delta;
+        }
+        os << " LUB (" << join(lubs, ",") << ")";
+        os << std::endl;
+    }
+
+    bool equal(const Node& node) const override {
+        const auto& other = asAssert<MergeLattice>(node);
+        return BinRelationStatement::equal(other) && delta == other.delta && equal_targets(lubs, other.lubs);
+    }
+
+    NodeVec getChildren() const override {
+        return toPtrVector<Node const>(lubs);
+    }
+
+    /** Delta relation */
+    const std::string delta;
+
+    /** Least upper bounds of the lattice attributes */
+    VecOwn<Expression> lubs;
+};
+
+}  // namespace souffle::ram
@@ -161,6 +161,7 @@ public:
                     NK_NestedIntrinsicOperator,
                 NK_LastTupleOperation,
 
+                NK_TrieJoin,
             NK_LastNestedOperation,
 
             NK_Project,
@@ -173,7 +174,9 @@ public:
             NK_Assign,
 
             NK_BinRelationStatement,
+                NK_Merge,
                 NK_MergeExtend,
+                NK_MergeLattice,
                 NK_Swap,
             NK_LastBinRelationStatement,
 
@@ -190,6 +193,7 @@ public:
             NK_Query,
             NK_RelationStatement,
                 NK_Clear,
+                NK_Compact,
                 NK_EstimateJoinSize,
                 NK_IO,
                 NK_LogRelationTimer,
@@ -65,6 +65,12 @@ public:
         return attributeNames;
     }
 
+    /** @brief Is the attribute an identifier of a symbol, record or ADT, whose values fit into 32 bits */
+    bool isIdentifierAttribute(std::size_t i) const {
+        const char qualifier = attributeTypes.at(i)[0];
+        return qualifier == 's' || qualifier == 'r' || qualifier == '+';
+    }
+
     /** @brief Is nullary relation */
     bool isNullary() const {
         return arity == 0;
@@ -0,0 +1,276 @@
+/*
+ * Souffle - A Datalog Compiler
+ * Copyright (c) 2026, The Souffle Developers. All rights reserved
+ * Licensed under the Universal Permissive License v 1.0 as shown at:
+ * - https://opensource.org/licenses/UPL
+ * - <souffle root>/licenses/SOUFFLE-UPL.txt
+ */
+
+/************************************************************************
+ *
+ * @file TrieJoin.h
+ *
+ * Defines a multi-way join of relations evaluated by leapfrog triejoin
+ *
+ ***********************************************************************/
+
+#pragma once
+
+#include "ram/Condition.h"
+#include "ram/Expression.h"
+#include "ram/IndexOperation.h"
+#include "ram/NestedOperation.h"
+#include "ram/Node.h"
+#include "ram/Operation.h"
+#include "ram/True.h"
+#include "ram/utility/Utils.h"
+#include "souffle/utility/ContainerUtil.h"
+#include "souffle/utility/MiscUtil.h"
+#include "souffle/utility/StreamUtil.h"
+#include "souffle/utility/StringUtil.h"
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <limits>
+#include <ostream>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace souffle::ram {
+
+/**
+ * @class TrieJoin
+ * @brief Joins several relations at once, binding one tuple of each
+ *
+ * Columns of the joined relations are either bound to join variables, shared by
+ * the columns of several relations, fixed to the value of an expression, which
+ * is independent of the joined tuples, or free. The join enumerates the values
+ * of the join variables in order, one variable after the other, by intersecting
+ * the values the relations of a variable admit given the values of the variables
+ * before (leapfrog triejoin). Once all variables are bound, the tuples of the
+ * relations are enumerated in the order of the relations, as a nest of index
+ * scans would. Relations marked as existential bind only the first of their
+ * tuples satisfying their condition, as IF EXISTS does.
+ *
+ * The number of bindings enumerated is bounded by the size of the result of the
+ * join, rather than by the intermediate results of a nest of binary joins, which
+ * makes a difference for cyclic joins. For example:
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~
+ *  QUERY
+ *   ...
+ *   TRIE JOIN t0 IN A, t1 IN B, t2 IN C ON t0.0 = t2.1 AND t0.1 = t1.0 AND t1.1 = t2.0
+ *    ...
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~
+ */
+class TrieJoin : public NestedOperation {
+public:
+    /** The variable of columns not bound to a join variable */
+    static constexpr std::size_t unbound = std::numeric_limits<std::size_t>::max();
+
+    /**
+     * @param relations   .. the joined relations
+     * @param tupleIds    .. the identifiers of the tuples bound for the relations
+     * @param variables   .. the join variable of each column of each relation, or unbound
+     * @param values      .. the fixed value of each column of each relation, or an undefined value
+     * @param existential .. whether a relation only binds the first of its tuples satisfying its condition
+     * @param conditions  .. the conditions of the relations
+     * @param nested      .. the nested operation
+     */
+    TrieJoin(std::vector<std::string> relations, std::vector<std::size_t> tupleIds,
+            std::vector<std::vector<std::size_t>> variables, std::vector<RamBound> values,
+            std::vector<bool> existential, VecOwn<Condition> conditions, Own<Operation> nested,
+            std::string profileText = "")
+            : NestedOperation(NK_TrieJoin, std::move(nested), std::move(profileText)),
+              relations(std::move(relations)), tupleIds(std::move(tupleIds)), variables(std::move(variables)),
+              values(std::move(values)), existential(std::move(existential)),
+              conditions(std::move(conditions)) {
+        assert(this->tupleIds.size() == this->relations.size());
+        assert(this->variables.size() == this->relations.size());
+        assert(this->values.size() == this->relations.size());
+        assert(this->existential.size() == this->relations.size());
+        assert(this->conditions.size() == this->relations.size());
+        assert(allValidPtrs(this->conditions));
+        for (std::size_t i = 0; i < this->relations.size(); ++i) {
+            assert(this->variables[i].size() == this->values[i].size() && "arity mismatch");
+            assert(allValidPtrs(this->values[i]));
+        }
+    }
+
+    /** @brief Get the number of joined relations */
+    std::size_t getNumAtoms() const {
+        return relations.size();
+    }
+
+    /** @brief Get the number of join variables */
+    std::size_t getNumVariables() const {
+        std::size_t res = 0;
+        for (const auto& atom : variables) {
+            for (std::size_t var : atom) {
+                if (var != unbound) {
+                    res = std::max(res, var + 1);
+                }
+            }
+        }
+        return res;
+    }
+
+    /** @brief Get the relation of an atom */
+    const std::string& getRelation(std::size_t atom) const {
+        return relations.at(atom);
+    }
+
+    /** @brief Get the identifier of the tuple of an atom */
+    std::size_t getTupleId(std::size_t atom) const {
+        return tupleIds.at(atom);
+    }
+
+    /** @brief Get the join variable of each column of an atom, or unbound */
+    const std::vector<std::size_t>& getVariables(std::size_t atom) const {
+        return variables.at(atom);
+    }
+
+    /** @brief Get the fixed value of each column of an atom, or an undefined value */
+    std::vector<Expression*> getValues(std::size_t atom) const {
+        return toPtrVector(values.at(atom));
+    }
+
+    /**
+     * @brief Get the columns of an atom bound to join variables, ordered by their variables
+     */
+    std::vector<std::size_t> getJoinColumns(std::size_t atom) const {
+        std::vector<std::size_t> res;
+        const auto& vars = variables.at(atom);
+        for (std::size_t col = 0; col < vars.size(); ++col) {
+            if (vars[col] != unbound) {
+                res.push_back(col);
+            }
+        }
+        std::sort(res.begin(), res.end(), [&](std::size_t a, std::size_t b) { return vars[a] < vars[b]; });
+        return res;
+    }
+
+    /** @brief Is the atom existential, binding only the first tuple satisfying its condition */
+    bool isExistential(std::size_t atom) const {
+        return existential.at(atom);
+    }
+
+    /** @brief Get the condition of an atom */
+    const Condition& getCondition(std::size_t atom) const {
+        return *conditions.at(atom);
+    }
+
+    void apply(const NodeMapper& map) override {
+        NestedOperation::apply(map);
+        for (auto& atom : values) {
+            for (auto& value : atom) {
+                value = map(std::move(value));
+            }
+        }
+        for (auto& cond : conditions) {
+            cond = map(std::move(cond));
+        }
+    }
+
+    TrieJoin* cloning() const override {
+        std::vector<RamBound> resValues;
+        for (const auto& atom : values) {
+            resValues.push_back(clone(atom));
+        }
+        return new TrieJoin(relations, tupleIds, variables, std::move(resValues), existential,
+                clone(conditions), clone(getOperation()), getProfileText());
+    }
+
+    static bool classof(const Node* n) {
+        return n->getKind() == NK_TrieJoin;
+    }
+
+protected:
+    void print(std::ostream& os, int tabpos) const override {
+        os << times(" ", tabpos);
+        os << "TRIE JOIN ";
+        for (std::size_t i = 0; i < relations.size(); ++i) {
+            os << (i > 0 ? ", " : "") << (existential[i] ? "EXISTS " : "");
+            os << "t" << tupleIds[i] << " IN " << relations[i];
+        }
+
+        // print the columns of each variable as a chain of equalities, followed by fixed columns
+        std::vector<std::string> constraints(getNumVariables());
+        for (std::size_t i = 0; i < relations.size(); ++i) {
+            for (std::size_t col = 0; col < variables[i].size(); ++col) {
+                const std::string element = "t" + std::to_string(tupleIds[i]) + "." + std::to_string(col);
+                const std::size_t var = variables[i][col];
+                if (var != unbound) {
+                    constraints[var] += (constraints[var].empty() ? "" : " = ") + element;
+                } else if (!isUndefValue(values[i][col].get())) {
+                    constraints.push_back(element + " = " + toString(*values[i][col]));
+                }
+            }
+        }
+        if (!constraints.empty()) {
+            os << " ON " << join(constraints, " AND ");
+        }
+
+        std::vector<const Condition*> where;
+        for (const auto& cond : conditions) {
+            if (!isA<True>(cond)) {
+                where.push_back(cond.get());
+            }
+        }
+        if (!where.empty()) {
+            os << " WHERE " << join(where, " AND ", [](std::ostream& out, const Condition* cond) {
+                out << *cond;
+            });
+        }
+        os << std::endl;
+        NestedOperation::print(os, tabpos + 1);
+    }
+
+    bool equal(const Node& node) const override {
+        const auto& other = asAssert<TrieJoin>(node);
+        if (values.size() != other.values.size()) {
+            return false;
+        }
+        for (std::size_t i = 0; i < values.size(); ++i) {
+            if (!equal_targets(values[i], other.values[i])) {
+                return false;
+            }
+        }
+        return NestedOperation::equal(other) && relations == other.relations &&
+               tupleIds == other.tupleIds && variables == other.variables &&
+               existential == other.existential && equal_targets(conditions, other.conditions);
+    }
+
+    NodeVec getChildren() const override {
+        auto res = NestedOperation::getChildren();
+        for (const auto& atom : values) {
+            for (const auto& value : atom) {
+                res.push_back(value.get());
+            }
+        }
+        for (const auto& cond : conditions) {
+            res.push_back(cond.get());
+        }
+        return res;
+    }
+
+    /** Joined relations */
+    std::vector<std::string> relations;
+
+    /** Identifiers of the tuples bound for the relations */
+    std::vector<std::size_t> tupleIds;
+
+    /** Join variable of each column of each relation */
+    std::vector<std::vector<std::size_t>> variables;
+
+    /** Fixed value of each column of each relation */
+    std::vector<RamBound> values;
+
+    /** Whether each relation binds only the first tuple satisfying its condition */
+    std::vector<bool> existential;
+
+    /** Condition of each relation */
+    VecOwn<Condition> conditions;
+};
+
+}  // namespace souffle::ram
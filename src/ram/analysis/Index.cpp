@@ -19,6 +19,7 @@
 #include "RelationTag.h"
 #include "ram/EstimateJoinSize.h"
 #include "ram/Expression.h"
+#include "ram/Negation.h"
 #include "ram/Node.h"
 #include "ram/Program.h"
 #include "ram/Relation.h"
@@ -27,6 +28,7 @@
 #include "ram/analysis/Relation.h"
 #include "ram/utility/Utils.h"
 #include "ram/utility/Visitor.h"
+#include "souffle/utility/ContainerUtil.h"
 #include "souffle/utility/StreamUtil.h"
 #include <algorithm>
 #include <cstdint>
@@ -402,11 +404,43 @@ void IndexAnalysis::run(const TranslationUnit& translationUnit) {
             relationToSearches[exists->getRelation()].insert(getSearchSignature(exists));
         } else if (const auto* provExists = as<ProvenanceExistenceCheck>(node)) {
             relationToSearches[provExists->getRelation()].insert(getSearchSignature(provExists));
+        } else if (const auto* join = as<TrieJoin>(node)) {
+            for (std::size_t atom = 0; atom < join->getNumAtoms(); ++atom) {
+                for (const auto& signature : getSearchSignatures(join, atom)) {
+                    relationToSearches[join->getRelation(atom)].insert(signature);
+                }
+            }
+        } else if (const auto* merge = as<MergeLattice>(node)) {
+            relationToSearches[merge->getSourceRelation()].insert(getSearchSignature(merge));
+            relationToSearches[merge->getTargetRelation()].insert(getSearchSignature(merge));
         } else if (const auto* ramRel = as<Relation>(node)) {
             relationToSearches[ramRel->getName()].insert(getSearchSignature(ramRel));
         }
     });
 
+    // anti-joins mostly probe for absent tuples, which a Bloom filter answers without searching an index;
+    // the filters hash the searched values, so the equality of the attributes must be that of their bits
+    visit(translationUnit.getProgram(), [&](const Negation& negation) {
+        const auto* exists = as<ExistenceCheck>(&negation.getOperand());
+        if (exists == nullptr) {
+            return;
+        }
+        const Relation& rel = relAnalysis->lookup(exists->getRelation());
+        const RelationRepresentation representation = rel.getRepresentation();
+        if (rel.isNullary() || rel.getAuxiliaryArity() > 0 ||
+                (representation != RelationRepresentation::DEFAULT &&
+                        representation != RelationRepresentation::BTREE)) {
+            return;
+        }
+        const SearchSignature signature = getSearchSignature(exists);
+        for (std::size_t i = 0; i < rel.getArity(); ++i) {
+            if (signature[i] != AttributeConstraint::None && rel.getAttributeTypes()[i][0] == 'f') {
+                return;
+            }
+        }
+        relationToFilters[rel.getName()].insert(signature);
+    });
+
     // A swap happen between rel A and rel B indicates A should include all indices of B, vice versa.
     visit(translationUnit.getProgram(), [&](const Swap& swap) {
         // Note: this naive approach will not work if there exists chain or cyclic swapping.
@@ -423,6 +457,12 @@ void IndexAnalysis::run(const TranslationUnit& translationUnit) {
 
         relationToSearches[relA].insert(searchesB.begin(), searchesB.end());
         relationToSearches[relB].insert(searchesA.begin(), searchesA.end());
+
+        // swapped relations keep the same filters
+        const auto filtersA = relationToFilters[relA];
+        const auto filtersB = relationToFilters[relB];
+        relationToFilters[relA].insert(filtersB.begin(), filtersB.end());
+        relationToFilters[relB].insert(filtersA.begin(), filtersA.end());
     });
 
     // remove all empty searches
@@ -441,7 +481,11 @@ void IndexAnalysis::run(const TranslationUnit& translationUnit) {
     for (auto& relToSearch : relationToSearches) {
         const std::string& relation = relToSearch.first;
         auto& searches = relToSearch.second;
-        indexCover.insert({relation, solver->solve(searches)});
+        IndexCluster cluster = solver->solve(searches);
+        if (contains(relationToFilters, relation)) {
+            cluster.setBloomFilters(relationToFilters.at(relation));
+        }
+        indexCover.insert({relation, std::move(cluster)});
     }
 }
 
@@ -467,6 +511,14 @@ void IndexAnalysis::print(std::ostream& os) const {
             os << join(order, "<") << "\n";
             os << "\n";
         }
+
+        /* print Bloom filters */
+        if (!selection.getBloomFilters().empty()) {
+            os << "\tNumber of Bloom Filters: " << selection.getBloomFilters().size() << "\n";
+            for (auto& search : selection.getBloomFilters()) {
+                os << "\t\t" << search << "\n";
+            }
+        }
     }
 }
 
@@ -552,6 +604,41 @@ SearchSignature IndexAnalysis::getSearchSignature(const ExistenceCheck* existChe
     return searchSignature(rel->getArity(), existCheck->getValues());
 }
 
+SearchSignature IndexAnalysis::getSearchSignature(const MergeLattice* merge) const {
+    const Relation* rel = &relAnalysis->lookup(merge->getTargetRelation());
+    const std::size_t arity = rel->getArity();
+
+    // the non-lattice attributes are bound, the lattice attributes are free
+    SearchSignature keys(arity);
+    for (std::size_t i = 0; i < arity - rel->getAuxiliaryArity(); ++i) {
+        keys[i] = AttributeConstraint::Equal;
+    }
+    return keys;
+}
+
+std::vector<SearchSignature> IndexAnalysis::getSearchSignatures(
+        const TrieJoin* join, std::size_t atom) const {
+    const auto values = join->getValues(atom);
+
+    // fixed attributes are bound throughout
+    SearchSignature keys(values.size());
+    for (std::size_t i = 0; i < values.size(); ++i) {
+        if (!isUndefValue(values[i])) {
+            keys[i] = AttributeConstraint::Equal;
+        }
+    }
+
+    // each join variable is sought by a range given the variables before, and bound thereafter
+    std::vector<SearchSignature> res;
+    for (std::size_t col : join->getJoinColumns(atom)) {
+        keys[col] = AttributeConstraint::Inequal;
+        res.push_back(keys);
+        keys[col] = AttributeConstraint::Equal;
+    }
+    res.push_back(keys);
+    return res;
+}
+
 SearchSignature IndexAnalysis::getSearchSignature(const Relation* ramRel) const {
     return SearchSignature::getFullSearchSignature(ramRel->getArity());
 }
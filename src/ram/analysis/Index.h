@@ -20,9 +20,11 @@
 #include "ram/EstimateJoinSize.h"
 #include "ram/ExistenceCheck.h"
 #include "ram/IndexOperation.h"
+#include "ram/MergeLattice.h"
 #include "ram/ProvenanceExistenceCheck.h"
 #include "ram/Relation.h"
 #include "ram/TranslationUnit.h"
+#include "ram/TrieJoin.h"
 #include "ram/analysis/Relation.h"
 #include "souffle/utility/MiscUtil.h"
 #include <algorithm>
@@ -32,6 +34,7 @@
 #include <list>
 #include <map>
 #include <memory>
+#include <optional>
 #include <set>
 #include <string>
 #include <unordered_map>
@@ -477,10 +480,29 @@ public:
         return static_cast<std::size_t>(std::distance(orders.begin(), it));
     }
 
+    /** @brief Get the searches guarded by Bloom filters of their equality attributes */
+    const SearchCollection& getBloomFilters() const {
+        return bloomFilters;
+    }
+
+    /** @brief Get the position of the Bloom filter guarding a search, if any */
+    std::optional<std::size_t> getBloomFilterNum(const SearchSignature& cols) const {
+        auto it = std::find(bloomFilters.begin(), bloomFilters.end(), cols);
+        if (it == bloomFilters.end()) {
+            return std::nullopt;
+        }
+        return static_cast<std::size_t>(std::distance(bloomFilters.begin(), it));
+    }
+
+    void setBloomFilters(const SearchSet& filters) {
+        bloomFilters.assign(filters.begin(), filters.end());
+    }
+
 private:
     SignatureOrderMap indexSelection;
     SearchCollection searches;
     OrderCollection orders;
+    SearchCollection bloomFilters;
 };
 
 /**
@@ -529,6 +551,22 @@ public:
      */
     SearchSignature getSearchSignature(const ProvenanceExistenceCheck* existCheck) const;
 
+    /**
+     * @Brief Get the index signature grouping the tuples of a lattice merge by their non-lattice attributes
+     * @param Lattice merge
+     * @result index signature of the source and the target relation of the merge
+     */
+    SearchSignature getSearchSignature(const MergeLattice* merge) const;
+
+    /**
+     * @Brief Get the index signatures of the searches of an atom of a trie join
+     * @param Trie join
+     * @param Atom of the trie join
+     * @result one signature per join variable of the atom, seeking the values of the variable given the
+     * variables before, followed by the signature looking up the tuples once all variables are bound
+     */
+    std::vector<SearchSignature> getSearchSignatures(const TrieJoin* join, std::size_t atom) const;
+
     /**
      * @Brief Get the default index signature for a relation (the total-order index)
      * @param ramRel RAM-relation
@@ -555,6 +593,9 @@ private:
     Own<IndexSelectionStrategy> solver;
     std::map<std::string, IndexCluster> indexCover;
     std::map<std::string, SearchSet> relationToSearches;
+
+    /** searches of negated existence checks, i.e. anti-joins, guarded by Bloom filters */
+    std::map<std::string, SearchSet> relationToFilters;
 };
 
 }  // namespace souffle::ram::analysis
@@ -0,0 +1,223 @@
+/*
+ * Souffle - A Datalog Compiler
+ * Copyright (c) 2026, The Souffle Developers. All rights reserved
+ * Licensed under the Universal Permissive License v 1.0 as shown at:
+ * - https://opensource.org/licenses/UPL
+ * - <souffle root>/licenses/SOUFFLE-UPL.txt
+ */
+
+/************************************************************************
+ *
+ * @file LayoutAdvisor.cpp
+ *
+ * Implementation of the layout advisor analysis
+ *
+ ***********************************************************************/
+
+#include "ram/analysis/LayoutAdvisor.h"
+#include "Global.h"
+#include "RelationTag.h"
+#include "ram/Program.h"
+#include "ram/Relation.h"
+#include "souffle/profile/ProfileDatabase.h"
+#include "souffle/utility/MiscUtil.h"
+#include "souffle/utility/StreamUtil.h"
+#include "souffle/utility/StringUtil.h"
+#include <cmath>
+#include <exception>
+#include <set>
+#include <utility>
+#include <vector>
+
+namespace souffle::ram::analysis {
+
+namespace {
+
+/** Relations of at least this size whose searches only bind attributes are recommended to be bries */
+constexpr std::size_t BRIE_MIN_SIZE = 1000000;
+
+/** Get the name of the relation a temporary relation such as @delta_A belongs to */
+std::string getBaseRelationName(const std::string& relation) {
+    if (relation.empty() || relation[0] != '@') {
+        return relation;
+    }
+    const std::size_t separator = relation.find('_');
+    return separator == std::string::npos ? relation : relation.substr(separator + 1);
+}
+
+bool hasInequality(const SearchSignature& signature) {
+    for (std::size_t i = 0; i < signature.arity(); ++i) {
+        if (signature[i] == AttributeConstraint::Inequal) {
+            return true;
+        }
+    }
+    return false;
+}
+
+}  // namespace
+
+void LayoutAdvisorAnalysis::run(const TranslationUnit& translationUnit) {
+    const auto& config = translationUnit.global().config();
+    if (!config.has("layout-advisor")) {
+        return;
+    }
+
+    Own<profile::ProfileDatabase> db;
+    try {
+        db = mk<profile::ProfileDatabase>(config.get("layout-advisor"));
+    } catch (const std::exception& e) {
+        fatal("exception whilst reading profile DB: %s", e.what());
+    }
+
+    // executions of index operations: {relation: {signature: count}}
+    if (const auto* relations = as<profile::DirectoryEntry>(db->lookupEntry({"program", "index-searches"}))) {
+        for (const auto& relation : relations->getKeys()) {
+            const auto* signatures = relations->readDirectoryEntry(relation);
+            if (signatures == nullptr) {
+                continue;
+            }
+            for (const auto& signature : signatures->getKeys()) {
+                if (const auto* count = as<profile::SizeEntry>(signatures->readEntry(signature))) {
+                    searches[relation][signature] = count->getSize();
+                }
+            }
+        }
+    }
+
+    // sizes of relations: tuples of non-recursive rules plus the tuples of each iteration
+    if (const auto* relations = as<profile::DirectoryEntry>(db->lookupEntry({"program", "relation"}))) {
+        for (const auto& relation : relations->getKeys()) {
+            const auto* entry = relations->readDirectoryEntry(relation);
+            if (entry == nullptr) {
+                continue;
+            }
+            std::size_t size = 0;
+            if (const auto* tuples = as<profile::SizeEntry>(entry->readEntry("num-tuples"))) {
+                size += tuples->getSize();
+            }
+            if (const auto* iterations = entry->readDirectoryEntry("iteration")) {
+                for (const auto& iteration : iterations->getKeys()) {
+                    const auto* iter = iterations->readDirectoryEntry(iteration);
+                    if (iter == nullptr) {
+                        continue;
+                    }
+                    if (const auto* tuples = as<profile::SizeEntry>(iter->readEntry("num-tuples"))) {
+                        size += tuples->getSize();
+                    }
+                }
+            }
+            sizes[relation] = size;
+        }
+    }
+}
+
+void LayoutAdvisorAnalysis::print(std::ostream& os) const {
+    for (const auto& [relation, counts] : searches) {
+        os << "Relation " << relation;
+        if (auto size = getRelationSize(relation)) {
+            os << " (" << *size << " tuples)";
+        }
+        os << "\n";
+        for (const auto& [signature, count] : counts) {
+            os << "\t" << signature << ": " << count << " searches\n";
+        }
+    }
+}
+
+bool LayoutAdvisorAnalysis::hasSearchStatistics(const std::string& relation) const {
+    return searches.count(relation) > 0;
+}
+
+std::size_t LayoutAdvisorAnalysis::getSearchCount(
+        const std::string& relation, const SearchSignature& signature) const {
+    auto counts = searches.find(relation);
+    if (counts == searches.end()) {
+        return 0;
+    }
+    auto count = counts->second.find(toString(signature));
+    return count == counts->second.end() ? 0 : count->second;
+}
+
+std::optional<std::size_t> LayoutAdvisorAnalysis::getRelationSize(const std::string& relation) const {
+    auto size = sizes.find(getBaseRelationName(relation));
+    if (size == sizes.end()) {
+        return std::nullopt;
+    }
+    return size->second;
+}
+
+bool LayoutAdvisorAnalysis::preferFilteredScan(
+        const std::string& relation, const SearchSignature& signature) const {
+    auto counts = searches.find(relation);
+    if (counts == searches.end() || counts->second.count(toString(signature)) == 0) {
+        return false;
+    }
+    auto size = getRelationSize(relation);
+    if (!size) {
+        return false;
+    }
+    // a filtered scan costs |R| per search, building the index |R| * log |R|
+    const double count = static_cast<double>(getSearchCount(relation, signature));
+    return count <= std::log2(static_cast<double>(*size) + 1);
+}
+
+void LayoutAdvisorAnalysis::printAdvice(std::ostream& os, const TranslationUnit& translationUnit) const {
+    const auto& indexAnalysis = translationUnit.getAnalysis<IndexAnalysis>();
+    if (searches.empty()) {
+        os << "The profile contains no index statistics; record it with --profile-frequency.\n";
+        return;
+    }
+
+    for (const Relation* rel : translationUnit.getProgram().getRelations()) {
+        const std::string& name = rel->getName();
+        if (rel->isNullary() || !hasSearchStatistics(name)) {
+            continue;
+        }
+        const IndexCluster cluster = indexAnalysis.getIndexSelection(name);
+        auto size = getRelationSize(name);
+
+        os << "Relation " << name;
+        if (size) {
+            os << " (" << *size << " tuples)";
+        }
+        os << "\n";
+
+        // searches that are still in the program use one of the selected indexes; existence
+        // checks are not counted by the profile
+        const auto& counts = searches.at(name);
+        std::set<std::string> current;
+        bool onlyEqualities = true;
+        for (const SearchSignature& search : cluster.getSearches()) {
+            const std::string signature = toString(search);
+            current.insert(signature);
+            onlyEqualities = onlyEqualities && !hasInequality(search);
+            os << "\tsearch " << signature << ": ";
+            if (counts.count(signature) > 0) {
+                os << counts.at(signature) << " executions";
+            } else {
+                os << "not profiled";
+            }
+            os << ", index " << join(cluster.getLexOrder(search), "<") << "\n";
+        }
+        for (const auto& [signature, count] : counts) {
+            if (current.count(signature) == 0) {
+                os << "\tsearch " << signature << ": " << count << " executions, filtered scan\n";
+            }
+        }
+
+        // bries store tuples sharing prefixes compactly, but only support searches binding attributes
+        if (rel->isTemp() || rel->getAuxiliaryArity() > 0 || !size) {
+            continue;
+        }
+        const RelationRepresentation representation = rel->getRepresentation();
+        const bool isBtree = representation == RelationRepresentation::DEFAULT ||
+                             representation == RelationRepresentation::BTREE;
+        if (isBtree && onlyEqualities && rel->getArity() > 1 && *size >= BRIE_MIN_SIZE) {
+            os << "\trecommended representation: brie (large relation searched by equalities only)\n";
+        } else if (representation == RelationRepresentation::BRIE && !onlyEqualities) {
+            os << "\trecommended representation: btree (searched by inequalities)\n";
+        }
+    }
+}
+
+}  // namespace souffle::ram::analysis
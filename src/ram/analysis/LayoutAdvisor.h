@@ -0,0 +1,85 @@
+/*
+ * Souffle - A Datalog Compiler
+ * Copyright (c) 2026, The Souffle Developers. All rights reserved
+ * Licensed under the Universal Permissive License v 1.0 as shown at:
+ * - https://opensource.org/licenses/UPL
+ * - <souffle root>/licenses/SOUFFLE-UPL.txt
+ */
+
+/************************************************************************
+ *
+ * @file LayoutAdvisor.h
+ *
+ * Advises on the data-structures of relations using the search frequencies
+ * and relation sizes of a profile.
+ *
+ ***********************************************************************/
+
+#pragma once
+
+#include "ram/TranslationUnit.h"
+#include "ram/analysis/Index.h"
+#include <cstddef>
+#include <map>
+#include <optional>
+#include <ostream>
+#include <string>
+
+namespace souffle::ram::analysis {
+
+/**
+ * @class LayoutAdvisorAnalysis
+ * @brief A RAM analysis loading the index statistics of a profile
+ *
+ * The profile is given by the layout-advisor option and must have been recorded with
+ * frequency counters enabled, so that it contains the number of executions of the
+ * index operations of each relation and search signature.
+ *
+ * An index for a search signature is only worth building if it is searched more often
+ * than the logarithm of the size of the relation; otherwise scanning and filtering the
+ * relation for each search is cheaper than building and maintaining the index.
+ */
+class LayoutAdvisorAnalysis : public Analysis {
+public:
+    LayoutAdvisorAnalysis() : Analysis(name) {}
+
+    static constexpr const char* name = "layout-advisor";
+
+    void run(const TranslationUnit& translationUnit) override;
+
+    /** @brief Print the loaded statistics */
+    void print(std::ostream& os) const override;
+
+    /** @brief Check whether the profile contains the searches of a relation */
+    bool hasSearchStatistics(const std::string& relation) const;
+
+    /** @brief Get the number of executions of index operations with the signature, or 0 if unknown */
+    std::size_t getSearchCount(const std::string& relation, const SearchSignature& signature) const;
+
+    /**
+     * @brief Get the profiled size of a relation
+     *
+     * Temporary relations (e.g. @delta_A and @new_A) are approximated by the size of the
+     * relation they belong to.
+     */
+    std::optional<std::size_t> getRelationSize(const std::string& relation) const;
+
+    /** @brief Check whether filtered scans are cheaper than an index for the searches of a signature */
+    bool preferFilteredScan(const std::string& relation, const SearchSignature& signature) const;
+
+    /**
+     * @brief Print recommendations for the indexes and representations of the relations
+     *
+     * Searches that no longer occur in the program have been replaced by filtered scans.
+     */
+    void printAdvice(std::ostream& os, const TranslationUnit& translationUnit) const;
+
+private:
+    /** Number of executions of index operations, per relation and search signature */
+    std::map<std::string, std::map<std::string, std::size_t>> searches;
+
+    /** Profiled sizes of relations */
+    std::map<std::string, std::size_t> sizes;
+};
+
+}  // namespace souffle::ram::analysis
@@ -40,6 +40,7 @@
 #include "ram/ProvenanceExistenceCheck.h"
 #include "ram/Scan.h"
 #include "ram/StringConstant.h"
+#include "ram/TrieJoin.h"
 #include "ram/SubroutineArgument.h"
 #include "ram/SubroutineReturn.h"
 #include "ram/True.h"
@@ -139,6 +140,18 @@ std::optional<std::size_t> LevelAnalysis::getLevel(const Node* node) const {
             return max(level, dispatch(indexIfExists.getCondition()));
         }
 
+        // trie join
+        maybe_level visit_(type_identity<TrieJoin>, const TrieJoin& join) override {
+            maybe_level level = std::nullopt;
+            for (std::size_t atom = 0; atom < join.getNumAtoms(); ++atom) {
+                for (const auto* value : join.getValues(atom)) {
+                    level = max(level, dispatch(*value));
+                }
+                level = max(level, dispatch(join.getCondition(atom)));
+            }
+            return level;
+        }
+
         // aggregate
         maybe_level visit_(type_identity<Aggregate>, const Aggregate& aggregate) override {
             return max(dispatch(aggregate.getExpression()), dispatch(aggregate.getCondition()));
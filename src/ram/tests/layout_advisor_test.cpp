@@ -0,0 +1,238 @@
+/*
+ * Souffle - A Datalog Compiler
+ * Copyright (c) 2026, The Souffle Developers. All rights reserved
+ * Licensed under the Universal Permissive License v 1.0 as shown at:
+ * - https://opensource.org/licenses/UPL
+ * - <souffle root>/licenses/SOUFFLE-UPL.txt
+ */
+
+/************************************************************************
+ *
+ * @file layout_advisor_test.cpp
+ *
+ * Tests the advice derived from the index searches of a profile and the
+ * replacement of rarely executed searches by filtered scans.
+ *
+ ***********************************************************************/
+
+#include "tests/test.h"
+
+#include "AggregateOp.h"
+#include "Global.h"
+#include "RelationTag.h"
+#include "ram/Aggregate.h"
+#include "ram/Expression.h"
+#include "ram/Filter.h"
+#include "ram/IfExists.h"
+#include "ram/IndexAggregate.h"
+#include "ram/IndexIfExists.h"
+#include "ram/IndexScan.h"
+#include "ram/Insert.h"
+#include "ram/IntrinsicAggregator.h"
+#include "ram/Operation.h"
+#include "ram/Program.h"
+#include "ram/Query.h"
+#include "ram/Relation.h"
+#include "ram/Scan.h"
+#include "ram/Sequence.h"
+#include "ram/SignedConstant.h"
+#include "ram/Statement.h"
+#include "ram/TranslationUnit.h"
+#include "ram/True.h"
+#include "ram/TupleElement.h"
+#include "ram/UndefValue.h"
+#include "ram/analysis/Index.h"
+#include "ram/analysis/LayoutAdvisor.h"
+#include "ram/transform/ReplaceRareSearches.h"
+#include "ram/utility/Visitor.h"
+#include "reports/DebugReport.h"
+#include "reports/ErrorReport.h"
+#include "souffle/profile/EventProcessor.h"
+#include "souffle/profile/ProfileDatabase.h"
+#include "souffle/utility/ContainerUtil.h"
+#include "souffle/utility/StringUtil.h"
+#include <cstddef>
+#include <filesystem>
+#include <fstream>
+#include <map>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace souffle::ram::test {
+
+using namespace analysis;
+
+/** Tuples of the profiled relations; a search is rare if executed at most log2(1001) ~ 9.97 times */
+constexpr std::size_t numTuples = 1000;
+
+/**
+ * Writes a profile in which edge is searched rarely on either attribute and by a
+ * range on its first one, path is searched frequently on its first attribute, and
+ * the size of noSize is unknown. The profile is recorded from the events logged by
+ * the engines.
+ */
+std::string writeProfile() {
+    auto& events = profile::EventProcessorSingleton::instance();
+    profile::ProfileDatabase db;
+    events.process(db, "@index-searches;edge;10", std::size_t(2));
+    events.process(db, "@index-searches;edge;01", std::size_t(9));
+    events.process(db, "@index-searches;edge;20", std::size_t(1));
+    events.process(db, "@index-searches;path;10", std::size_t(500));
+    events.process(db, "@index-searches;noSize;10", std::size_t(1));
+    // the tuples of edge are split over its non-recursive rules and an iteration
+    events.process(db, "@n-nonrecursive-relation;edge;[1:1-1:10]", numTuples / 2);
+    events.process(db, "@n-recursive-relation;edge;[2:1-2:10]", numTuples / 2, std::size_t(0));
+    events.process(db, "@n-nonrecursive-relation;path;[3:1-3:10]", numTuples);
+
+    const auto path = std::filesystem::temp_directory_path() / "souffle_layout_advisor_test.json";
+    std::ofstream file(path);
+    db.print(file);
+    return path.string();
+}
+
+SearchSignature signature(const std::string& constraints) {
+    SearchSignature res(constraints.size());
+    for (std::size_t i = 0; i < constraints.size(); ++i) {
+        if (constraints[i] == '1') {
+            res[i] = AttributeConstraint::Equal;
+        } else if (constraints[i] == '2') {
+            res[i] = AttributeConstraint::Inequal;
+        }
+    }
+    return res;
+}
+
+/** Pattern binding attribute i of a binary relation to the given bounds */
+RamPattern pattern(std::size_t i, RamSigned lower, RamSigned upper) {
+    RamPattern res;
+    for (std::size_t j = 0; j < 2; ++j) {
+        res.first.push_back(j == i ? Own<Expression>(mk<SignedConstant>(lower)) : mk<UndefValue>());
+        res.second.push_back(j == i ? Own<Expression>(mk<SignedConstant>(upper)) : mk<UndefValue>());
+    }
+    return res;
+}
+
+Own<Operation> insertTuple() {
+    return mk<Insert>("out", toVector<Own<Expression>>(mk<TupleElement>(0, 0), mk<TupleElement>(0, 1)));
+}
+
+/** Runs the given test with a translation unit of the given queries, advised by the profile if requested */
+template <typename F>
+void withTranslationUnit(VecOwn<Operation> queries, bool profiled, F test) {
+    Global glb;
+    const std::string profile = writeProfile();
+    if (profiled) {
+        glb.config().set("layout-advisor", profile);
+    }
+
+    VecOwn<Relation> rels;
+    for (const std::string name : {"edge", "path", "noSize", "out"}) {
+        rels.push_back(mk<Relation>(name, 2, 0, std::vector<std::string>{"x", "y"},
+                std::vector<std::string>{"i:number", "i:number"}, RelationRepresentation::BTREE));
+    }
+    VecOwn<Statement> statements;
+    for (auto& query : queries) {
+        statements.push_back(mk<Query>(std::move(query)));
+    }
+    std::map<std::string, Own<Statement>> subs;
+    Own<Program> prog = mk<Program>(std::move(rels), mk<Sequence>(std::move(statements)), std::move(subs));
+
+    ErrorReport errReport;
+    DebugReport debugReport(glb);
+    TranslationUnit translationUnit(glb, std::move(prog), errReport, debugReport);
+    test(translationUnit);
+    std::filesystem::remove(profile);
+}
+
+TEST(LayoutAdvisor, Statistics) {
+    withTranslationUnit({}, true, [&](TranslationUnit& tu) {
+        const auto& advisor = tu.getAnalysis<LayoutAdvisorAnalysis>();
+        EXPECT_TRUE(advisor.hasSearchStatistics("edge"));
+        EXPECT_FALSE(advisor.hasSearchStatistics("out"));
+        EXPECT_EQ(advisor.getSearchCount("path", signature("10")), 500);
+        EXPECT_EQ(advisor.getSearchCount("path", signature("01")), 0);
+        EXPECT_EQ(advisor.getSearchCount("out", signature("10")), 0);
+
+        // temporaries are approximated by their base relation
+        EXPECT_EQ(*advisor.getRelationSize("edge"), numTuples);
+        EXPECT_EQ(*advisor.getRelationSize("@delta_edge"), numTuples);
+        EXPECT_FALSE(advisor.getRelationSize("noSize").has_value());
+    });
+}
+
+TEST(LayoutAdvisor, PreferFilteredScan) {
+    withTranslationUnit({}, true, [&](TranslationUnit& tu) {
+        const auto& advisor = tu.getAnalysis<LayoutAdvisorAnalysis>();
+        // executed fewer times than log2 of the size of the relation
+        EXPECT_TRUE(advisor.preferFilteredScan("edge", signature("10")));
+        EXPECT_TRUE(advisor.preferFilteredScan("edge", signature("01")));
+        // frequent searches
+        EXPECT_FALSE(advisor.preferFilteredScan("path", signature("10")));
+        // searches missing from the profile, or of relations without a size or without a profile
+        EXPECT_FALSE(advisor.preferFilteredScan("edge", signature("11")));
+        EXPECT_FALSE(advisor.preferFilteredScan("noSize", signature("10")));
+        EXPECT_FALSE(advisor.preferFilteredScan("out", signature("10")));
+    });
+
+    withTranslationUnit({}, false, [&](TranslationUnit& tu) {
+        const auto& advisor = tu.getAnalysis<LayoutAdvisorAnalysis>();
+        EXPECT_FALSE(advisor.hasSearchStatistics("edge"));
+        EXPECT_FALSE(advisor.preferFilteredScan("edge", signature("10")));
+    });
+}
+
+/** Rare equality searches of edge */
+VecOwn<Operation> rareSearches() {
+    VecOwn<Operation> res;
+    res.push_back(mk<IndexScan>("edge", 0, pattern(0, 1, 1), insertTuple()));
+    res.push_back(mk<IndexIfExists>("edge", 0, mk<True>(), pattern(1, 3, 3), insertTuple()));
+    res.push_back(mk<IndexAggregate>(insertTuple(), mk<IntrinsicAggregator>(AggregateOp::COUNT), "edge",
+            mk<UndefValue>(), mk<True>(), pattern(1, 3, 3), 0));
+    return res;
+}
+
+TEST(ReplaceRareSearches, Equalities) {
+    withTranslationUnit(rareSearches(), true, [&](TranslationUnit& tu) {
+        EXPECT_TRUE(transform::ReplaceRareSearchesTransformer().apply(tu));
+        const Program& program = tu.getProgram();
+        EXPECT_FALSE(visitExists(program, [](const IndexOperation&) { return true; }));
+
+        // the patterns are checked by the conditions of the scans
+        EXPECT_TRUE(visitExists(program, [](const Scan& scan) {
+            const auto* filter = as<Filter>(scan.getOperation());
+            return filter != nullptr && toString(filter->getCondition()) == "(t0.0 = NUMBER(1))";
+        }));
+        EXPECT_TRUE(visitExists(program, [](const IfExists& ifExists) {
+            return toString(ifExists.getCondition()) == "((t0.1 = NUMBER(3)) AND TRUE)";
+        }));
+        EXPECT_TRUE(visitExists(program, [](const Aggregate& aggregate) {
+            return toString(aggregate.getCondition()) == "((t0.1 = NUMBER(3)) AND TRUE)";
+        }));
+    });
+
+    // without a profile, even rare searches are kept
+    withTranslationUnit(rareSearches(), false, [&](TranslationUnit& tu) {
+        EXPECT_FALSE(transform::ReplaceRareSearchesTransformer().apply(tu));
+        EXPECT_FALSE(visitExists(tu.getProgram(), [](const Scan&) { return true; }));
+    });
+}
+
+TEST(ReplaceRareSearches, Unchanged) {
+    // a rare range search, a frequent search and a search of a relation without a size
+    VecOwn<Operation> queries;
+    queries.push_back(mk<IndexScan>("edge", 0, pattern(0, 1, 5), insertTuple()));
+    queries.push_back(mk<IndexScan>("path", 0, pattern(0, 1, 1), insertTuple()));
+    queries.push_back(mk<IndexIfExists>("noSize", 0, mk<True>(), pattern(0, 1, 1), insertTuple()));
+
+    withTranslationUnit(std::move(queries), true, [&](TranslationUnit& tu) {
+        EXPECT_FALSE(transform::ReplaceRareSearchesTransformer().apply(tu));
+        std::size_t searches = 0;
+        visit(tu.getProgram(), [&](const IndexOperation&) { ++searches; });
+        EXPECT_EQ(searches, 3);
+        EXPECT_FALSE(visitExists(tu.getProgram(), [](const Scan&) { return true; }));
+    });
+}
+
+}  // namespace souffle::ram::test
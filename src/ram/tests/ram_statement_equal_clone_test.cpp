@@ -20,6 +20,7 @@
 #include "RelationTag.h"
 #include "ram/Break.h"
 #include "ram/Clear.h"
+#include "ram/Compact.h"
 #include "ram/Condition.h"
 #include "ram/Constraint.h"
 #include "ram/DebugInfo.h"
@@ -35,7 +36,9 @@
 #include "ram/LogSize.h"
 #include "ram/LogTimer.h"
 #include "ram/Loop.h"
+#include "ram/Merge.h"
 #include "ram/MergeExtend.h"
+#include "ram/MergeLattice.h"
 #include "ram/Negation.h"
 #include "ram/Operation.h"
 #include "ram/Parallel.h"
@@ -92,6 +95,36 @@ TEST(Clear, CloneAndEquals) {
     delete c;
 }
 
+TEST(Compact, CloneAndEquals) {
+    // COMPACT A
+    Compact a("A");
+    Compact b("A");
+    EXPECT_EQ(a, b);
+    EXPECT_NE(&a, &b);
+
+    Compact* c = a.cloning();
+    EXPECT_EQ(a, *c);
+    EXPECT_NE(&a, c);
+    delete c;
+
+    Compact d("B");
+    EXPECT_NE(a, d);
+}
+
+TEST(Merge, CloneAndEquals) {
+    // MERGE B WITH A
+    Merge a("B", "A");
+    Merge b("B", "A");
+    EXPECT_EQ(a, b);
+    EXPECT_NE(&a, &b);
+    EXPECT_NE(a, Merge("A", "B"));
+
+    Merge* c = a.cloning();
+    EXPECT_EQ(a, *c);
+    EXPECT_NE(&a, c);
+    delete c;
+}
+
 TEST(MergeExtend, CloneAndEquals) {
     // MERGE B WITH A
     Relation A("A", 1, 1, {"x"}, {"i"}, RelationRepresentation::DEFAULT);
@@ -107,6 +140,26 @@ TEST(MergeExtend, CloneAndEquals) {
     delete c;
 }
 
+TEST(MergeLattice, CloneAndEquals) {
+    // MERGE-LATTICE B WITH A DELTA C LUB (max(t0.1,t1.1))
+    auto lub = [] {
+        return toVector<Own<Expression>>(mk<IntrinsicOperator>(
+                FunctorOp::MAX, toVector<Own<Expression>>(mk<TupleElement>(0, 1), mk<TupleElement>(1, 1))));
+    };
+    MergeLattice a("B", "A", "C", lub());
+    MergeLattice b("B", "A", "C", lub());
+    EXPECT_EQ(a, b);
+    EXPECT_NE(&a, &b);
+
+    MergeLattice* c = a.cloning();
+    EXPECT_EQ(a, *c);
+    EXPECT_NE(&a, c);
+    delete c;
+
+    MergeLattice d("B", "A", "", lub());
+    EXPECT_NE(a, d);
+}
+
 TEST(Swap, CloneAndEquals) {
     // SWAP(A,B)
     Relation A("A", 1, 1, {"x"}, {"i"}, RelationRepresentation::DEFAULT);
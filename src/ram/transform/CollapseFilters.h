@@ -17,6 +17,7 @@
 #include "ram/Program.h"
 #include "ram/TranslationUnit.h"
 #include "ram/transform/Transformer.h"
+#include <set>
 #include <string>
 
 namespace souffle::ram::transform {
@@ -51,6 +52,10 @@ public:
         return "CollapseFiltersTransformer";
     }
 
+    std::set<std::string> getPreservedAnalyses() const override {
+        return declarationAnalyses();
+    }
+
     /**
      * @brief Collapse consecutive filter operations
      * @param program Program that is transformed
@@ -17,6 +17,7 @@
 #include "ram/Program.h"
 #include "ram/TranslationUnit.h"
 #include "ram/transform/Transformer.h"
+#include <set>
 #include <string>
 
 namespace souffle::ram::transform {
@@ -52,6 +53,10 @@ public:
         return "EliminateDuplicatesTransformer";
     }
 
+    std::set<std::string> getPreservedAnalyses() const override {
+        return declarationAnalyses();
+    }
+
     /**
      * @brief Eliminate duplicated conjunctive terms
      * @param program Program that is transformed
@@ -18,6 +18,7 @@
 #include "ram/TranslationUnit.h"
 #include "ram/analysis/Level.h"
 #include "ram/transform/Transformer.h"
+#include <set>
 #include <string>
 
 namespace souffle::ram::transform {
@@ -37,6 +38,10 @@ public:
         return "HoistAggregateTransformer";
     }
 
+    std::set<std::string> getPreservedAnalyses() const override {
+        return declarationAnalyses();
+    }
+
     /**
      * @brief Apply hoistAggregate to the whole program
      * @param RAM program
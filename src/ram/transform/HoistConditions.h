@@ -18,6 +18,7 @@
 #include "ram/TranslationUnit.h"
 #include "ram/analysis/Level.h"
 #include "ram/transform/Transformer.h"
+#include <set>
 #include <string>
 
 namespace souffle::ram::transform {
@@ -67,6 +68,10 @@ public:
         return "HoistConditionsTransformer";
     }
 
+    std::set<std::string> getPreservedAnalyses() const override {
+        return declarationAnalyses();
+    }
+
     /**
      * @brief Hoist filter operations.
      * @param program that is transformed
@@ -20,6 +20,7 @@
 #include "ram/TranslationUnit.h"
 #include "ram/transform/Transformer.h"
 #include <memory>
+#include <set>
 #include <string>
 
 namespace souffle::ram::transform {
@@ -57,6 +58,10 @@ public:
         return "IfConversionTransformer";
     }
 
+    std::set<std::string> getPreservedAnalyses() const override {
+        return declarationAnalyses();
+    }
+
     /**
      * @brief Rewrite IndexScan operations
      * @param indexScan An index operation
@@ -22,6 +22,7 @@
 #include "ram/analysis/Level.h"
 #include "ram/transform/Transformer.h"
 #include <memory>
+#include <set>
 #include <string>
 
 namespace souffle::ram::transform {
@@ -64,6 +65,10 @@ public:
         return "IfExistsConversionTransformer";
     }
 
+    std::set<std::string> getPreservedAnalyses() const override {
+        return declarationAnalyses();
+    }
+
     /**
      * @brief Rewrite Scan operations
      * @param A scan operation
@@ -96,7 +96,8 @@ ExpressionPair MakeIndexTransformer::getLowerUpperExpression(Condition* c, std::
         bool provenance = rel.getAuxiliaryArity() > 0;  // rep == RelationRepresentation::PROVENANCE;
         auto rep = rel.getRepresentation();
         bool btree = (rep == RelationRepresentation::BTREE || rep == RelationRepresentation::DEFAULT ||
-                      rep == RelationRepresentation::BTREE_DELETE);
+                      rep == RelationRepresentation::BTREE_DELETE ||
+                      rep == RelationRepresentation::BTREE_COMPRESSED);
         auto op = binRelOp->getOperator();
 
         // don't index FEQ in interpreter mode
@@ -13,14 +13,20 @@
  ***********************************************************************/
 
 #include "ram/transform/Parallel.h"
+#include "ram/AbstractExistenceCheck.h"
 #include "ram/Condition.h"
+#include "ram/EmptinessCheck.h"
+#include "ram/Erase.h"
 #include "ram/Expression.h"
 #include "ram/IntrinsicAggregator.h"
 #include "ram/Node.h"
 #include "ram/Operation.h"
 #include "ram/Program.h"
 #include "ram/Relation.h"
+#include "ram/RelationOperation.h"
+#include "ram/RelationSize.h"
 #include "ram/Statement.h"
+#include "ram/TrieJoin.h"
 #include "ram/utility/NodeMapper.h"
 #include "ram/utility/Visitor.h"
 #include "souffle/utility/ContainerUtil.h"
@@ -28,6 +34,7 @@
 
 #include <functional>
 #include <memory>
+#include <string>
 #include <utility>
 #include <vector>
 
@@ -41,8 +48,25 @@ bool ParallelTransformer::parallelizeOperations(Program& program) {
     forEachQuery(program, [&](Query& query) {
         // guardedInsert cannot be parallelized
         if (visitExists(query, [&](const GuardedInsert&) { return true; })) return;
-        // erase cannot be parallelized
-        if (visitExists(query, [&](const Erase&) { return true; })) return;
+        // erase can only be parallelized if the query does not read the erased relation
+        bool readsErased = false;
+        visit(query, [&](const Erase& erase) {
+            const std::string& name = erase.getRelation();
+            readsErased = readsErased || visitExists(query, [&](const Node& node) {
+                if (const auto* op = as<RelationOperation>(node)) return op->getRelation() == name;
+                if (const auto* join = as<TrieJoin>(node)) {
+                    for (std::size_t atom = 0; atom < join->getNumAtoms(); ++atom) {
+                        if (join->getRelation(atom) == name) return true;
+                    }
+                    return false;
+                }
+                if (const auto* check = as<AbstractExistenceCheck>(node)) return check->getRelation() == name;
+                if (const auto* check = as<EmptinessCheck>(node)) return check->getRelation() == name;
+                if (const auto* size = as<RelationSize>(node)) return size->getRelation() == name;
+                return false;
+            });
+        });
+        if (readsErased) return;
 
         query.apply(nodeMapper<Node>([&](auto&& go, Own<Node> node) -> Own<Node> {
             if (const Scan* scan = as<Scan>(node)) {
@@ -18,6 +18,7 @@
 #include "ram/TranslationUnit.h"
 #include "ram/analysis/Relation.h"
 #include "ram/transform/Transformer.h"
+#include <set>
 #include <string>
 
 namespace souffle::ram::transform {
@@ -49,6 +50,10 @@ public:
         return "ParallelTransformer";
     }
 
+    std::set<std::string> getPreservedAnalyses() const override {
+        return declarationAnalyses();
+    }
+
     /**
      * @brief Parallelize operations
      * @param program Program that is transformed
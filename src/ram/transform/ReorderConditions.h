@@ -18,6 +18,7 @@
 #include "ram/TranslationUnit.h"
 #include "ram/analysis/Complexity.h"
 #include "ram/transform/Transformer.h"
+#include <set>
 #include <string>
 
 namespace souffle::ram::transform {
@@ -57,6 +58,10 @@ public:
         return "ReorderConditionsTransformer";
     }
 
+    std::set<std::string> getPreservedAnalyses() const override {
+        return declarationAnalyses();
+    }
+
     /**
      * @brief Reorder conjunctive terms in filter operations
      * @param program Program that is transformed
@@ -0,0 +1,96 @@
+/*
+ * Souffle - A Datalog Compiler
+ * Copyright (c) 2026, The Souffle Developers. All rights reserved
+ * Licensed under the Universal Permissive License v 1.0 as shown at:
+ * - https://opensource.org/licenses/UPL
+ * - <souffle root>/licenses/SOUFFLE-UPL.txt
+ */
+
+/************************************************************************
+ *
+ * @file ReplaceRareSearches.cpp
+ *
+ ***********************************************************************/
+
+#include "ram/transform/ReplaceRareSearches.h"
+#include "ram/Aggregate.h"
+#include "ram/Conjunction.h"
+#include "ram/Constraint.h"
+#include "ram/Expression.h"
+#include "ram/Filter.h"
+#include "ram/IfExists.h"
+#include "ram/IndexAggregate.h"
+#include "ram/IndexIfExists.h"
+#include "ram/IndexScan.h"
+#include "ram/Node.h"
+#include "ram/Relation.h"
+#include "ram/Scan.h"
+#include "ram/TupleElement.h"
+#include "ram/utility/NodeMapper.h"
+#include "ram/utility/Utils.h"
+#include "ram/utility/Visitor.h"
+#include "souffle/BinaryConstraintOps.h"
+#include "souffle/utility/MiscUtil.h"
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+namespace souffle::ram::transform {
+
+Own<Condition> ReplaceRareSearchesTransformer::getPatternCondition(const IndexOperation& search) const {
+    const Relation& rel = relAnalysis->lookup(search.getRelation());
+    const auto& [lower, upper] = search.getRangePattern();
+    VecOwn<Condition> conditions;
+    for (std::size_t i = 0; i < lower.size(); ++i) {
+        if (isUndefValue(lower[i]) && isUndefValue(upper[i])) {
+            continue;
+        }
+        // only equalities are replaced; ranges would need the types of their bounds
+        if (*lower[i] != *upper[i]) {
+            return nullptr;
+        }
+        const bool isFloat = rel.getAttributeTypes()[i][0] == 'f';
+        conditions.push_back(mk<Constraint>(isFloat ? BinaryConstraintOp::FEQ : BinaryConstraintOp::EQ,
+                mk<TupleElement>(search.getTupleId(), i), clone(lower[i])));
+    }
+    return toCondition(conditions);
+}
+
+bool ReplaceRareSearchesTransformer::replaceRareSearches(Program& program) {
+    bool changed = false;
+    forEachQueryMap(program, [&](auto&& go, Own<Node> node) -> Own<Node> {
+        if (const auto* search = as<IndexOperation>(node)) {
+            const std::string& relation = search->getRelation();
+            Own<Condition> condition;
+            if (advisor->preferFilteredScan(relation, idxAnalysis->getSearchSignature(search))) {
+                condition = getPatternCondition(*search);
+            }
+            if (condition != nullptr) {
+                const std::size_t tupleId = search->getTupleId();
+                if (const auto* indexScan = as<IndexScan>(search)) {
+                    changed = true;
+                    node = mk<Scan>(relation, tupleId,
+                            mk<Filter>(std::move(condition), clone(indexScan->getOperation())),
+                            indexScan->getProfileText());
+                } else if (const auto* indexIfExists = as<IndexIfExists>(search)) {
+                    changed = true;
+                    node = mk<IfExists>(relation, tupleId,
+                            mk<Conjunction>(std::move(condition), clone(indexIfExists->getCondition())),
+                            clone(indexIfExists->getOperation()), indexIfExists->getProfileText());
+                } else if (const auto* indexAggregate = as<IndexAggregate>(search)) {
+                    changed = true;
+                    node = mk<Aggregate>(clone(indexAggregate->getOperation()),
+                            clone(indexAggregate->getAggregator()), relation,
+                            clone(indexAggregate->getExpression()),
+                            mk<Conjunction>(std::move(condition), clone(indexAggregate->getCondition())),
+                            tupleId);
+                }
+            }
+        }
+        node->apply(go);
+        return node;
+    });
+    return changed;
+}
+
+}  // namespace souffle::ram::transform
@@ -0,0 +1,88 @@
+/*
+ * Souffle - A Datalog Compiler
+ * Copyright (c) 2026, The Souffle Developers. All rights reserved
+ * Licensed under the Universal Permissive License v 1.0 as shown at:
+ * - https://opensource.org/licenses/UPL
+ * - <souffle root>/licenses/SOUFFLE-UPL.txt
+ */
+
+/************************************************************************
+ *
+ * @file ReplaceRareSearches.h
+ *
+ ***********************************************************************/
+
+#pragma once
+
+#include "ram/Condition.h"
+#include "ram/IndexOperation.h"
+#include "ram/Operation.h"
+#include "ram/Program.h"
+#include "ram/TranslationUnit.h"
+#include "ram/analysis/Index.h"
+#include "ram/analysis/LayoutAdvisor.h"
+#include "ram/analysis/Relation.h"
+#include "ram/transform/Transformer.h"
+#include <set>
+#include <string>
+
+namespace souffle::ram::transform {
+
+/**
+ * @class ReplaceRareSearchesTransformer
+ * @brief Replace index operations that are rarely executed by filtered scans
+ *
+ * Uses the search frequencies of a profile (see LayoutAdvisorAnalysis) to find the
+ * equality searches for which scanning the relation is cheaper than building and
+ * maintaining an index. Their operations are rewritten to scans whose condition
+ * checks the search pattern, so that the index is not selected anymore.
+ *
+ * For example,
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~
+ *  QUERY
+ *   ...
+ *    FOR t1 IN A ON INDEX t1.0 = t0.1
+ *     ...
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~
+ *
+ * will be rewritten to
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~
+ *  QUERY
+ *   ...
+ *    FOR t1 IN A
+ *     IF (t1.0 = t0.1)
+ *      ...
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~
+ */
+class ReplaceRareSearchesTransformer : public Transformer {
+public:
+    std::string getName() const override {
+        return "ReplaceRareSearchesTransformer";
+    }
+
+    std::set<std::string> getPreservedAnalyses() const override {
+        return {analysis::RelationAnalysis::name, analysis::LayoutAdvisorAnalysis::name};
+    }
+
+    /** @brief Replace the rarely executed index operations of the program */
+    bool replaceRareSearches(Program& program);
+
+protected:
+    /** @brief Get the condition checking the equalities of a search pattern, or nullptr for ranges */
+    Own<Condition> getPatternCondition(const IndexOperation& search) const;
+
+    bool transform(TranslationUnit& translationUnit) override {
+        advisor = &translationUnit.getAnalysis<analysis::LayoutAdvisorAnalysis>();
+        idxAnalysis = &translationUnit.getAnalysis<analysis::IndexAnalysis>();
+        relAnalysis = &translationUnit.getAnalysis<analysis::RelationAnalysis>();
+        return replaceRareSearches(translationUnit.getProgram());
+    }
+
+    const analysis::LayoutAdvisorAnalysis* advisor{nullptr};
+    const analysis::IndexAnalysis* idxAnalysis{nullptr};
+    const analysis::RelationAnalysis* relAnalysis{nullptr};
+};
+
+}  // namespace souffle::ram::transform
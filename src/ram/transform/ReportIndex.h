@@ -25,6 +25,7 @@
 #include "ram/transform/Transformer.h"
 #include <cstddef>
 #include <memory>
+#include <set>
 #include <string>
 #include <utility>
 #include <vector>
@@ -43,6 +44,10 @@ public:
         return "ReportIndexTransformer";
     }
 
+    std::set<std::string> getPreservedAnalyses() const override {
+        return declarationAnalyses();
+    }
+
 protected:
     bool transform(TranslationUnit& translationUnit) override {
         translationUnit.getAnalysis<analysis::IndexAnalysis>();
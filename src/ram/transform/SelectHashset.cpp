@@ -0,0 +1,76 @@
+/*
+ * Souffle - A Datalog Compiler
+ * Copyright (c) 2026, The Souffle Developers. All rights reserved
+ * Licensed under the Universal Permissive License v 1.0 as shown at:
+ * - https://opensource.org/licenses/UPL
+ * - <souffle root>/licenses/SOUFFLE-UPL.txt
+ */
+
+/************************************************************************
+ *
+ * @file SelectHashset.cpp
+ *
+ ***********************************************************************/
+
+#include "ram/transform/SelectHashset.h"
+#include "RelationTag.h"
+#include "ram/IO.h"
+#include "ram/Node.h"
+#include "ram/utility/Visitor.h"
+#include "souffle/utility/MiscUtil.h"
+#include "souffle/utility/NodeMapper.h"
+#include <utility>
+
+namespace souffle::ram::transform {
+
+bool SelectHashsetTransformer::isEligible(const Relation& rel) const {
+    if (rel.isNullary() || rel.getAuxiliaryArity() > 0) {
+        return false;
+    }
+    for (const std::string& type : rel.getAttributeTypes()) {
+        if (type[0] == 'f') {
+            return false;
+        }
+    }
+    const auto fullSearch = analysis::SearchSignature::getFullSearchSignature(rel.getArity());
+    for (const auto& search : idxAnalysis->getIndexSelection(rel.getName()).getSearches()) {
+        if (search != fullSearch) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool SelectHashsetTransformer::selectHashset(Program& program) {
+    outputRelations.clear();
+    visit(program, [&](const IO& io) {
+        if (io.get("operation") == "output") {
+            outputRelations.insert(io.getRelation());
+        }
+    });
+
+    bool changed = false;
+    program.apply(nodeMapper<Node>([&](auto&&, Own<Node> node) -> Own<Node> {
+        const auto* rel = as<Relation>(node);
+        if (rel == nullptr) {
+            return node;
+        }
+        const RelationRepresentation representation = rel->getRepresentation();
+        RelationRepresentation selected = representation;
+        if (representation == RelationRepresentation::HASHSET && !isEligible(*rel)) {
+            selected = RelationRepresentation::BTREE;
+        } else if (automatic && representation == RelationRepresentation::DEFAULT &&
+                   outputRelations.count(rel->getName()) == 0 && isEligible(*rel)) {
+            selected = RelationRepresentation::HASHSET;
+        }
+        if (selected == representation) {
+            return node;
+        }
+        changed = true;
+        return mk<Relation>(rel->getName(), rel->getArity(), rel->getAuxiliaryArity(),
+                rel->getAttributeNames(), rel->getAttributeTypes(), selected);
+    }));
+    return changed;
+}
+
+}  // namespace souffle::ram::transform
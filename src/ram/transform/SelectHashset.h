@@ -0,0 +1,71 @@
+/*
+ * Souffle - A Datalog Compiler
+ * Copyright (c) 2026, The Souffle Developers. All rights reserved
+ * Licensed under the Universal Permissive License v 1.0 as shown at:
+ * - https://opensource.org/licenses/UPL
+ * - <souffle root>/licenses/SOUFFLE-UPL.txt
+ */
+
+/************************************************************************
+ *
+ * @file SelectHashset.h
+ *
+ ***********************************************************************/
+
+#pragma once
+
+#include "ram/Program.h"
+#include "ram/Relation.h"
+#include "ram/TranslationUnit.h"
+#include "ram/analysis/Index.h"
+#include "ram/transform/Transformer.h"
+#include <set>
+#include <string>
+
+namespace souffle::ram::transform {
+
+/**
+ * @class SelectHashsetTransformer
+ * @brief Select the hash set representation for relations only searched by full tuples
+ *
+ * A hash set answers existence checks and searches binding all attributes in
+ * constant time, but cannot answer any other search. Relations tagged with the
+ * hash set representation that do not qualify, i.e. that have searches (see
+ * IndexAnalysis) not binding every attribute, fall back to a B-tree.
+ *
+ * If automatic selection is enabled, qualifying relations of the default
+ * representation are switched to a hash set as well. Output relations keep
+ * their default representation so that they are written in order, and relations
+ * with float attributes are excluded since the synthesised B-trees consider -0.0
+ * and 0.0 to be equal.
+ */
+class SelectHashsetTransformer : public Transformer {
+public:
+    explicit SelectHashsetTransformer(bool automatic = false) : automatic(automatic) {}
+
+    std::string getName() const override {
+        return "SelectHashsetTransformer";
+    }
+
+    /** @brief Select the representations of the relations of the program */
+    bool selectHashset(Program& program);
+
+protected:
+    /** @brief Check whether the given relation can be stored in a hash set */
+    bool isEligible(const Relation& rel) const;
+
+    bool transform(TranslationUnit& translationUnit) override {
+        idxAnalysis = &translationUnit.getAnalysis<analysis::IndexAnalysis>();
+        return selectHashset(translationUnit.getProgram());
+    }
+
+    const analysis::IndexAnalysis* idxAnalysis{nullptr};
+
+    /** Whether relations of the default representation are switched to hash sets */
+    const bool automatic;
+
+    /** Relations written by output statements */
+    std::set<std::string> outputRelations;
+};
+
+}  // namespace souffle::ram::transform
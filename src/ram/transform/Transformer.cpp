@@ -19,6 +19,7 @@
 #include "ram/Node.h"
 #include "ram/Program.h"
 #include "ram/TranslationUnit.h"
+#include "ram/analysis/Relation.h"
 #include "ram/transform/Meta.h"
 #include "reports/DebugReport.h"
 #include "reports/ErrorReport.h"
@@ -26,6 +27,8 @@
 #include <chrono>
 #include <cstdlib>
 #include <iostream>
+#include <set>
+#include <string>
 #include <type_traits>
 
 namespace souffle::ram::transform {
@@ -40,9 +43,10 @@ bool Transformer::apply(TranslationUnit& translationUnit) {
     bool changed = transform(translationUnit);
     auto end = std::chrono::high_resolution_clock::now();
 
-    // invalidate analyses in case the program has changed
-    if (changed) {
-        translationUnit.invalidateAnalyses();
+    // invalidate analyses in case the program has changed; meta transformers leave this to
+    // their sub-transformers
+    if (changed && !isA<MetaTransformer>(this)) {
+        translationUnit.invalidateAnalyses(getPreservedAnalyses());
     }
 
     // print runtime & change info for transformer in verbose mode
@@ -76,4 +80,8 @@ bool Transformer::apply(TranslationUnit& translationUnit) {
     return changed;
 }
 
+std::set<std::string> Transformer::declarationAnalyses() {
+    return {analysis::RelationAnalysis::name};
+}
+
 }  // namespace souffle::ram::transform
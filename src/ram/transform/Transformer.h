@@ -17,6 +17,7 @@
 #pragma once
 
 #include "ram/TranslationUnit.h"
+#include <set>
 #include <string>
 
 namespace souffle::ram::transform {
@@ -57,7 +58,20 @@ public:
      */
     virtual std::string getName() const = 0;
 
+    /**
+     * @Brief get names of the analyses that stay valid when the transformer changes the program
+     *
+     * All other analyses are invalidated after a change; by default, none stays valid.
+     * Transformers opt in to keeping the analyses their changes cannot affect.
+     */
+    virtual std::set<std::string> getPreservedAnalyses() const {
+        return {};
+    }
+
 protected:
+    /** Analyses of the relation declarations, valid while no declaration changes */
+    static std::set<std::string> declarationAnalyses();
+
     /**
      * @Brief transform the translation unit / used by apply
      * @Param translationUnit that will be transformed.
@@ -0,0 +1,355 @@
+/*
+ * Souffle - A Datalog Compiler
+ * Copyright (c) 2026, The Souffle Developers. All rights reserved
+ * Licensed under the Universal Permissive License v 1.0 as shown at:
+ * - https://opensource.org/licenses/UPL
+ * - <souffle root>/licenses/SOUFFLE-UPL.txt
+ */
+
+/************************************************************************
+ *
+ * @file TrieJoin.cpp
+ *
+ ***********************************************************************/
+
+#include "ram/transform/TrieJoin.h"
+#include "RelationTag.h"
+#include "ram/AbstractIfExists.h"
+#include "ram/AutoIncrement.h"
+#include "ram/Condition.h"
+#include "ram/ExistenceCheck.h"
+#include "ram/Expression.h"
+#include "ram/Filter.h"
+#include "ram/IndexOperation.h"
+#include "ram/Node.h"
+#include "ram/Query.h"
+#include "ram/Relation.h"
+#include "ram/RelationOperation.h"
+#include "ram/TrieJoin.h"
+#include "ram/True.h"
+#include "ram/TupleElement.h"
+#include "ram/UndefValue.h"
+#include "ram/utility/NodeMapper.h"
+#include "ram/utility/Utils.h"
+#include "ram/utility/Visitor.h"
+#include "souffle/utility/ContainerUtil.h"
+#include "souffle/utility/MiscUtil.h"
+#include <algorithm>
+#include <map>
+#include <set>
+#include <string>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+namespace souffle::ram::transform {
+
+namespace {
+
+/** A column of an atom of a join, given by the position of the atom and of the attribute */
+using Column = std::pair<std::size_t, std::size_t>;
+
+/** Columns equated with each other by the searches of a nest */
+struct EquivalenceClass {
+    /** The first column of the class, bound by the outermost of its atoms */
+    Column root;
+
+    /** The value the class is fixed to, if any */
+    const Expression* value;
+
+    /** The atoms with a column in the class */
+    std::set<std::size_t> atoms;
+};
+
+/** An atom of a join */
+struct Atom {
+    std::string relation;
+
+    /** The identifier of the tuple bound for the atom */
+    std::size_t tupleId;
+
+    /** Whether the atom only binds the first of its tuples satisfying its condition */
+    bool existential;
+
+    /** The condition of the atom, if any */
+    const Condition* condition;
+};
+
+/** Check whether the relation is stored in B-trees answering the range searches of a trie join */
+bool isJoinable(const Relation& rel) {
+    const RelationRepresentation representation = rel.getRepresentation();
+    return !rel.isNullary() && rel.getAuxiliaryArity() == 0 &&
+           (representation == RelationRepresentation::DEFAULT ||
+                   representation == RelationRepresentation::BTREE);
+}
+
+/** Check whether attributes of the given type are ordered as signed numbers by both evaluators */
+bool isSignedOrder(const std::string& type) {
+    return type[0] != 'f' && type[0] != 'u';
+}
+
+}  // namespace
+
+bool TrieJoinTransformer::isCyclic(std::vector<std::vector<std::size_t>> edges) {
+    for (auto& edge : edges) {
+        std::sort(edge.begin(), edge.end());
+    }
+
+    // GYO reduction: drop variables of a single edge and edges contained in another one until neither applies
+    bool changed = true;
+    while (changed) {
+        changed = false;
+
+        std::map<std::size_t, std::size_t> occurrences;
+        for (const auto& edge : edges) {
+            for (std::size_t var : edge) {
+                occurrences[var]++;
+            }
+        }
+        for (auto& edge : edges) {
+            auto end = std::remove_if(
+                    edge.begin(), edge.end(), [&](std::size_t var) { return occurrences[var] == 1; });
+            if (end != edge.end()) {
+                edge.erase(end, edge.end());
+                changed = true;
+            }
+        }
+
+        for (std::size_t i = 0; i < edges.size() && !changed; ++i) {
+            for (std::size_t j = 0; j < edges.size() && !changed; ++j) {
+                if (edges[i].empty() || (i != j && std::includes(edges[j].begin(), edges[j].end(),
+                                                           edges[i].begin(), edges[i].end()))) {
+                    edges.erase(edges.begin() + i);
+                    changed = true;
+                }
+            }
+        }
+    }
+    return !edges.empty();
+}
+
+Own<Operation> TrieJoinTransformer::rewriteNest(const TupleOperation* outer, std::size_t freshTupleId) const {
+    // the atoms of the join, the filters between them, and the operation following the last of them
+    std::vector<Atom> atoms;
+    std::vector<const Condition*> filters;
+    std::vector<const Condition*> pending;
+    std::vector<VecOwn<Condition>> terms;
+    const Operation* rest = nullptr;
+
+    std::map<std::size_t, std::size_t> atomOfTuple;
+    std::map<Column, std::size_t> classOf;
+    std::vector<EquivalenceClass> classes;
+
+    // an expression is a fixed value if it does not depend on the atoms of the join and is evaluated once
+    auto isFixed = [&](const Expression& expr) {
+        bool fixed = true;
+        visit(expr, [&](const TupleElement& element) {
+            fixed = fixed && !contains(atomOfTuple, element.getTupleId());
+        });
+        visit(expr, [&](const AutoIncrement&) { fixed = false; });
+        return fixed;
+    };
+
+    // add an atom if each of its searched columns is equated with a column of an earlier atom, which is
+    // not existential, or with a fixed value; atoms of existence checks must share a join variable
+    auto addAtom = [&](const Atom& atom, const std::vector<Expression*>& lower,
+                           const std::vector<Expression*>& upper, bool isCheck) {
+        const Relation& rel = relAnalysis->lookup(atom.relation);
+        if (!isJoinable(rel)) {
+            return false;
+        }
+
+        const std::size_t pos = atoms.size();
+        std::map<std::size_t, std::size_t> links;
+        std::map<std::size_t, const Expression*> values;
+        for (std::size_t col = 0; col < lower.size(); ++col) {
+            if (isUndefValue(lower[col]) && isUndefValue(upper[col])) {
+                continue;
+            }
+            if (isUndefValue(lower[col]) || isUndefValue(upper[col]) || *lower[col] != *upper[col]) {
+                return false;
+            }
+            const auto* element = as<TupleElement>(lower[col]);
+            if (element != nullptr && contains(atomOfTuple, element->getTupleId())) {
+                const Column other{atomOfTuple.at(element->getTupleId()), element->getElement()};
+                const Relation& otherRel = relAnalysis->lookup(atoms[other.first].relation);
+                const std::size_t cls = classOf.at(other);
+                if (atoms[other.first].existential || !isSignedOrder(rel.getAttributeTypes()[col]) ||
+                        !isSignedOrder(otherRel.getAttributeTypes()[other.second]) ||
+                        std::any_of(links.begin(), links.end(),
+                                [&](const auto& link) { return link.second == cls; })) {
+                    return false;
+                }
+                links[col] = cls;
+            } else if (isFixed(*lower[col])) {
+                values[col] = lower[col];
+            } else {
+                return false;
+            }
+        }
+        if (isCheck && std::none_of(links.begin(), links.end(), [&](const auto& link) {
+                return classes[link.second].value == nullptr;
+            })) {
+            return false;
+        }
+
+        atoms.push_back(atom);
+        atomOfTuple[atom.tupleId] = pos;
+        for (std::size_t col = 0; col < rel.getArity(); ++col) {
+            const Column column{pos, col};
+            if (contains(links, col)) {
+                classOf[column] = links[col];
+                classes[links[col]].atoms.insert(pos);
+            } else {
+                classOf[column] = classes.size();
+                classes.push_back({column, contains(values, col) ? values[col] : nullptr, {pos}});
+            }
+        }
+        return true;
+    };
+
+    // collect the atoms of the nest up to the first operation that cannot be joined
+    const Operation* cur = outer;
+    while (true) {
+        if (const auto* filter = as<Filter>(cur)) {
+            // existence checks of filters are existential atoms binding fresh tuples
+            bool absorbed = false;
+            terms.push_back(toConjunctionList(&filter->getCondition()));
+            for (const auto& term : terms.back()) {
+                const auto* check = as<ExistenceCheck>(term);
+                if (check != nullptr && addAtom({check->getRelation(), freshTupleId, true, nullptr},
+                                                check->getValues(), check->getValues(), true)) {
+                    ++freshTupleId;
+                    absorbed = true;
+                } else {
+                    pending.push_back(term.get());
+                }
+            }
+            cur = &filter->getOperation();
+            if (absorbed) {
+                filters.insert(filters.end(), pending.begin(), pending.end());
+                pending.clear();
+                rest = cur;
+            }
+            continue;
+        }
+
+        const Node::NodeKind kind = cur->getKind();
+        if (kind != Node::NK_Scan && kind != Node::NK_IndexScan && kind != Node::NK_IfExists &&
+                kind != Node::NK_IndexIfExists) {
+            break;
+        }
+        const auto* op = as<RelationOperation>(cur);
+        const auto* exists = as<AbstractIfExists>(op);
+        std::vector<Expression*> lower;
+        std::vector<Expression*> upper;
+        if (const auto* search = as<IndexOperation>(op)) {
+            std::tie(lower, upper) = search->getRangePattern();
+        }
+        const Atom atom{op->getRelation(), op->getTupleId(), exists != nullptr,
+                exists != nullptr ? &exists->getCondition() : nullptr};
+        if (!addAtom(atom, lower, upper, false)) {
+            break;
+        }
+        filters.insert(filters.end(), pending.begin(), pending.end());
+        pending.clear();
+        rest = cur = &op->getOperation();
+    }
+    if (atoms.size() < 3) {
+        return nullptr;
+    }
+
+    // classes shared by several atoms, not fixed to a value, are the join variables, in order of binding
+    std::map<std::size_t, std::size_t> variableOf;
+    std::vector<std::vector<std::size_t>> variables(atoms.size());
+    std::vector<RamBound> values(atoms.size());
+    for (std::size_t atom = 0; atom < atoms.size(); ++atom) {
+        const std::size_t arity = relAnalysis->lookup(atoms[atom].relation).getArity();
+        for (std::size_t col = 0; col < arity; ++col) {
+            const std::size_t cls = classOf.at({atom, col});
+            const EquivalenceClass& eqClass = classes[cls];
+            std::size_t var = TrieJoin::unbound;
+            if (eqClass.value == nullptr && eqClass.atoms.size() > 1) {
+                if (eqClass.root == Column{atom, col}) {
+                    const std::size_t next = variableOf.size();
+                    variableOf[cls] = next;
+                }
+                var = variableOf.at(cls);
+            }
+            variables[atom].push_back(var);
+            values[atom].push_back(eqClass.value != nullptr ? clone(eqClass.value) : mk<UndefValue>());
+        }
+    }
+
+    // the join only pays off for cyclic joins, in which every atom shares a variable
+    std::vector<std::vector<std::size_t>> edges;
+    for (const auto& atomVariables : variables) {
+        std::vector<std::size_t> edge;
+        for (std::size_t var : atomVariables) {
+            if (var != TrieJoin::unbound) {
+                edge.push_back(var);
+            }
+        }
+        if (edge.empty()) {
+            return nullptr;
+        }
+        edges.push_back(std::move(edge));
+    }
+    if (!isCyclic(std::move(edges))) {
+        return nullptr;
+    }
+
+    std::vector<std::string> relations;
+    std::vector<std::size_t> tupleIds;
+    std::vector<bool> existential;
+    VecOwn<Condition> conditions;
+    for (const auto& atom : atoms) {
+        relations.push_back(atom.relation);
+        tupleIds.push_back(atom.tupleId);
+        existential.push_back(atom.existential);
+        if (atom.condition != nullptr) {
+            conditions.push_back(clone(atom.condition));
+        } else {
+            conditions.push_back(mk<True>());
+        }
+    }
+
+    // the filters between the atoms are checked once all atoms are bound
+    Own<Operation> nested = clone(rest);
+    for (auto it = filters.rbegin(); it != filters.rend(); ++it) {
+        nested = mk<Filter>(clone(*it), std::move(nested));
+    }
+
+    return mk<TrieJoin>(std::move(relations), std::move(tupleIds), std::move(variables), std::move(values),
+            std::move(existential), std::move(conditions), std::move(nested));
+}
+
+bool TrieJoinTransformer::convertJoins(Program& program) {
+    bool changed = false;
+    forEachQuery(program, [&](Query& query) {
+        // existence checks joined by a trie join bind tuples of their own
+        std::size_t freshTupleId = 0;
+        visit(query, [&](const TupleOperation& op) {
+            freshTupleId = std::max(freshTupleId, op.getTupleId() + 1);
+        });
+
+        query.apply(nodeMapper<Node>([&](auto&& go, Own<Node> node) -> Own<Node> {
+            if (const auto* outer = as<TupleOperation>(node)) {
+                if (auto join = rewriteNest(outer, freshTupleId)) {
+                    visit(*join, [&](const TrieJoin& cur) {
+                        for (std::size_t atom = 0; atom < cur.getNumAtoms(); ++atom) {
+                            freshTupleId = std::max(freshTupleId, cur.getTupleId(atom) + 1);
+                        }
+                    });
+                    changed = true;
+                    node = std::move(join);
+                }
+            }
+            node->apply(go);
+            return node;
+        }));
+    });
+    return changed;
+}
+
+}  // namespace souffle::ram::transform
@@ -0,0 +1,104 @@
+/*
+ * Souffle - A Datalog Compiler
+ * Copyright (c) 2026, The Souffle Developers. All rights reserved
+ * Licensed under the Universal Permissive License v 1.0 as shown at:
+ * - https://opensource.org/licenses/UPL
+ * - <souffle root>/licenses/SOUFFLE-UPL.txt
+ */
+
+/************************************************************************
+ *
+ * @file TrieJoin.h
+ *
+ ***********************************************************************/
+
+#pragma once
+
+#include "Global.h"
+#include "ram/Operation.h"
+#include "ram/Program.h"
+#include "ram/TranslationUnit.h"
+#include "ram/TupleOperation.h"
+#include "ram/analysis/Relation.h"
+#include "ram/transform/Transformer.h"
+#include <cstddef>
+#include <set>
+#include <string>
+#include <vector>
+
+namespace souffle::ram::transform {
+
+/**
+ * @class TrieJoinTransformer
+ * @brief Replaces nests of scans joining relations cyclically by a trie join
+ *
+ * A nest of scans, index scans and existence checks, possibly interleaved with
+ * filters, whose index searches equate attributes of the scanned tuples with
+ * each other or with values independent of them, is a join. If the hypergraph of
+ * the join, whose edges are the scanned relations and whose vertices are the
+ * attributes they share, is cyclic, the nest is rewritten into a TrieJoin; the
+ * filters are moved below it. For example,
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~
+ *  QUERY
+ *   FOR t0 IN A
+ *    FOR t1 IN B ON INDEX t1.0 = t0.1
+ *     IF EXISTS t2 IN C ON INDEX t2.0 = t1.1 AND t2.1 = t0.0
+ *      ...
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~
+ *
+ * will be rewritten to
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~
+ *  QUERY
+ *   TRIE JOIN t0 IN A, t1 IN B, EXISTS t2 IN C ON t0.0 = t2.1 AND t0.1 = t1.0 AND t1.1 = t2.0
+ *    ...
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~
+ *
+ * Only B-tree relations without auxiliary attributes take part, and only
+ * attributes ordered as signed numbers are joined, such that the order of the
+ * indexes matches the order of the join variables in both evaluators. The nest
+ * is cut before the first operation that does not qualify.
+ *
+ * Trie joins are evaluated sequentially, so the program is left unchanged when
+ * it is evaluated by several threads: the nests are parallelised by the
+ * ParallelTransformer instead.
+ */
+class TrieJoinTransformer : public Transformer {
+public:
+    std::string getName() const override {
+        return "TrieJoinTransformer";
+    }
+
+    std::set<std::string> getPreservedAnalyses() const override {
+        return declarationAnalyses();
+    }
+
+    /**
+     * @brief Rewrite a nest of scans starting at the given operation
+     * @param outer The outermost operation of the nest
+     * @param freshTupleId The first tuple identifier not used by the query
+     * @result The trie join, or a null pointer if the nest is not a cyclic join
+     */
+    Own<Operation> rewriteNest(const TupleOperation* outer, std::size_t freshTupleId) const;
+
+    /** @brief Rewrite the cyclic joins of all queries of the program */
+    bool convertJoins(Program& program);
+
+protected:
+    bool transform(TranslationUnit& translationUnit) override {
+        // a job count of 0 means all cores are used
+        if (translationUnit.global().config().get("jobs", "1") != "1") {
+            return false;
+        }
+        relAnalysis = &translationUnit.getAnalysis<analysis::RelationAnalysis>();
+        return convertJoins(translationUnit.getProgram());
+    }
+
+    /** @brief Check whether the hypergraph with the given edges of join variables is cyclic */
+    static bool isCyclic(std::vector<std::vector<std::size_t>> edges);
+
+    const analysis::RelationAnalysis* relAnalysis{nullptr};
+};
+
+}  // namespace souffle::ram::transform
@@ -28,6 +28,7 @@
 #include "ram/Break.h"
 #include "ram/Call.h"
 #include "ram/Clear.h"
+#include "ram/Compact.h"
 #include "ram/Condition.h"
 #include "ram/Conjunction.h"
 #include "ram/Constraint.h"
@@ -55,7 +56,9 @@
 #include "ram/LogSize.h"
 #include "ram/LogTimer.h"
 #include "ram/Loop.h"
+#include "ram/Merge.h"
 #include "ram/MergeExtend.h"
+#include "ram/MergeLattice.h"
 #include "ram/Negation.h"
 #include "ram/NestedIntrinsicOperator.h"
 #include "ram/NestedOperation.h"
@@ -85,6 +88,7 @@
 #include "ram/SubroutineArgument.h"
 #include "ram/SubroutineReturn.h"
 #include "ram/Swap.h"
+#include "ram/TrieJoin.h"
 #include "ram/True.h"
 #include "ram/TupleElement.h"
 #include "ram/TupleOperation.h"
@@ -166,17 +170,21 @@ struct Visitor : souffle::detail::VisitorBase<R, NodeType, Params...> {
         SOUFFLE_VISITOR_FORWARD(Aggregate);
         SOUFFLE_VISITOR_FORWARD(ParallelIndexAggregate);
         SOUFFLE_VISITOR_FORWARD(IndexAggregate);
+        SOUFFLE_VISITOR_FORWARD(TrieJoin);
 
         // Statements
         SOUFFLE_VISITOR_FORWARD(Assign);
         SOUFFLE_VISITOR_FORWARD(IO);
         SOUFFLE_VISITOR_FORWARD(Query);
         SOUFFLE_VISITOR_FORWARD(Clear);
+        SOUFFLE_VISITOR_FORWARD(Compact);
         SOUFFLE_VISITOR_FORWARD(LogSize);
         SOUFFLE_VISITOR_FORWARD(EstimateJoinSize);
 
         SOUFFLE_VISITOR_FORWARD(Swap);
+        SOUFFLE_VISITOR_FORWARD(Merge);
         SOUFFLE_VISITOR_FORWARD(MergeExtend);
+        SOUFFLE_VISITOR_FORWARD(MergeLattice);
 
         // Control-flow
         SOUFFLE_VISITOR_FORWARD(Program);
@@ -198,6 +206,7 @@ protected:
     SOUFFLE_VISITOR_LINK(IO, RelationStatement);
     SOUFFLE_VISITOR_LINK(Query, Statement);
     SOUFFLE_VISITOR_LINK(Clear, RelationStatement);
+    SOUFFLE_VISITOR_LINK(Compact, RelationStatement);
     SOUFFLE_VISITOR_LINK(LogSize, RelationStatement);
     SOUFFLE_VISITOR_LINK(EstimateJoinSize, RelationStatement);
 
@@ -205,7 +214,9 @@ protected:
     SOUFFLE_VISITOR_LINK(Assign, Statement);
 
     SOUFFLE_VISITOR_LINK(Swap, BinRelationStatement);
+    SOUFFLE_VISITOR_LINK(Merge, BinRelationStatement);
     SOUFFLE_VISITOR_LINK(MergeExtend, BinRelationStatement);
+    SOUFFLE_VISITOR_LINK(MergeLattice, BinRelationStatement);
     SOUFFLE_VISITOR_LINK(BinRelationStatement, Statement);
 
     SOUFFLE_VISITOR_LINK(Sequence, ListStatement);
@@ -242,6 +253,7 @@ protected:
     SOUFFLE_VISITOR_LINK(ParallelIndexAggregate, IndexAggregate);
     SOUFFLE_VISITOR_LINK(IndexOperation, RelationOperation);
     SOUFFLE_VISITOR_LINK(TupleOperation, NestedOperation);
+    SOUFFLE_VISITOR_LINK(TrieJoin, NestedOperation);
     SOUFFLE_VISITOR_LINK(Filter, AbstractConditional);
     SOUFFLE_VISITOR_LINK(Break, AbstractConditional);
     SOUFFLE_VISITOR_LINK(AbstractConditional, NestedOperation);
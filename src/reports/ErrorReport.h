@@ -22,6 +22,7 @@
 #include <cassert>
 #include <cstdlib>
 #include <iostream>
+#include <mutex>
 #include <optional>
 #include <set>
 #include <string>
@@ -208,7 +209,7 @@ public:
 
     ErrorReport(WarnSet warns) : warns(warns) {}
 
-    ErrorReport(const ErrorReport& other) = default;
+    ErrorReport(const ErrorReport& other) : diagnostics(other.diagnostics), warns(other.warns) {}
 
     std::size_t getNumErrors() const {
         return std::count_if(diagnostics.begin(), diagnostics.end(),
@@ -226,19 +227,23 @@ public:
 
     /** Adds an error with the given message and location */
     void addError(const std::string& message, SrcLocation location) {
-        diagnostics.insert(
-                Diagnostic(Diagnostic::Type::ERROR, DiagnosticMessage(message, std::move(location))));
+        addDiagnostic(Diagnostic(Diagnostic::Type::ERROR, DiagnosticMessage(message, std::move(location))));
     }
 
     /** Adds a warning with the given message and location */
     void addWarning(const WarnType type, const std::string& message, SrcLocation location) {
         if (warns.test(type)) {
-            diagnostics.insert(
+            addDiagnostic(
                     Diagnostic(Diagnostic::Type::WARNING, DiagnosticMessage(message, std::move(location))));
         }
     }
 
+    /**
+     * Adds a diagnostic; may be called concurrently, e.g. by checks running over clauses in
+     * parallel. Diagnostics are kept sorted, so the report does not depend on the order of calls.
+     */
     void addDiagnostic(const Diagnostic& diagnostic) {
+        std::lock_guard<std::mutex> guard(lock);
         diagnostics.insert(diagnostic);
     }
 
@@ -265,6 +270,7 @@ public:
 private:
     std::set<Diagnostic> diagnostics;
     WarnSet warns;
+    std::mutex lock;
 };
 
 }  // end of namespace souffle
@@ -19,6 +19,7 @@ if not JSON_DATA_TEXT:
       "link_options": "-pthread -ldl -lstdc++fs /usr/lib/x86_64-linux-gnu/libsqlite3.so /usr/lib/x86_64-linux-gnu/libz.so /usr/lib/x86_64-linux-gnu/libncurses.so",
       "rpaths": "/usr/lib/x86_64-linux-gnu:/usr/lib/x86_64-linux-gnu",
       "outname_fmt": "-o {}",
+      "objname_fmt": "-c -o {}",
       "libdir_fmt": "-L{}",
       "libname_fmt": "-l{}",
       "rpath_fmt": "-Wl,-rpath,{}",
@@ -29,6 +30,8 @@ if not JSON_DATA_TEXT:
     }"""
 
 import argparse
+import concurrent.futures
+import hashlib
 import json
 import os
 import pathlib
@@ -56,6 +59,7 @@ def capture_command_output(cmd, descr, verbose=False):
 
 conf = json.loads(JSON_DATA_TEXT)
 OUTNAME_FMT = conf['outname_fmt']
+OBJNAME_FMT = conf.get('objname_fmt', "-c -o {}")
 LIBDIR_FMT = conf['libdir_fmt']
 LIBNAME_FMT = conf['libname_fmt']
 RPATH_FMT = conf['rpath_fmt']
@@ -74,6 +78,10 @@ parser.add_argument('-L', action='append', default=[], metavar='LIBDIR', dest='l
 parser.add_argument('-g', action='store_true', dest='debug', help="Debug build type")
 parser.add_argument('-s', metavar='LANG', dest='swiglang', choices=["java", "python"], help="use SWIG interface to generate into LANG language")
 parser.add_argument('-v', action='store_true', dest='verbose', help="Verbose output")
+parser.add_argument('-j', metavar='N', dest='jobs', type=int, default=1, help="Compile up to N source files in parallel, 0 for one job per CPU")
+parser.add_argument('--cache-dir', metavar='DIR', dest='cache_dir', type=lambda p: pathlib.Path(p).absolute(), help="Reuse object files of unchanged sources across builds, and keep a precompiled `CompiledSouffle.h` in DIR")
+parser.add_argument('--shared', action='store_true', dest='shared', help="Build a shared library of the embedded program instead of an executable")
+parser.add_argument('--no-pch', action='store_true', dest='no_pch', help="Do not use a precompiled header when a cache directory is given")
 parser.add_argument('source', nargs='+', metavar='SOURCE', type=lambda p: pathlib.Path(p).absolute(), help="C++ source files")
 parser.add_argument('-o', metavar='BINARY', dest='output', type=lambda p: pathlib.Path(p).absolute(), help="Binary file name")
 
@@ -181,41 +189,160 @@ if args.swiglang:
         # move generated files to same directory as cpp file
         os.sys.exit(0)
 else:
-    exepath = pathlib.Path("{}{}".format(args.output, exeext))
+    if args.shared:
+        exepath = args.output
+    else:
+        exepath = pathlib.Path("{}{}".format(args.output, exeext))
 
-    cmd = []
-    cmd.append('"{}"'.format(conf['compiler']))
-    cmd.append(conf['definitions'])
-    cmd.append(conf['compile_options'])
-    cmd.append(conf['includes'])
-    cmd.append(conf['std_flag'])
-    cmd.append(conf['cxx_flags'])
+    flags = []
+    flags.append(conf['definitions'])
+    flags.append(conf['compile_options'])
+    flags.append(conf['includes'])
+    flags.append(conf['std_flag'])
+    flags.append(conf['cxx_flags'])
 
     if args.debug:
-        cmd.append(conf['debug_cxx_flags'])
+        flags.append(conf['debug_cxx_flags'])
     else:
-        cmd.append(conf['release_cxx_flags'])
-
-    cmd.append(OUTNAME_FMT.format(exepath))
-    for f in args.source:
-        cmd.append(str(f))
+        flags.append(conf['release_cxx_flags'])
 
-    cmd.append(conf['link_options'])
-    cmd.extend(list(map(lambda rpath: RPATH_FMT.format(rpath), RPATHS)))
-    cmd.extend(list(map(lambda libdir: LIBDIR_FMT.format(libdir), args.lib_dirs)))
-    cmd.extend(list(map(lambda libname: LIBNAME_FMT.format(libname), args.lib_names)))
-
-    cmd = " ".join(cmd)
+    if args.shared:
+        if conf['compiler_id'] == "MSVC":
+            flags.append("/D__EMBEDDED_SOUFFLE__")
+        else:
+            flags.append("-fPIC -D__EMBEDDED_SOUFFLE__")
 
-    if args.verbose:
-        sys.stderr.write(cmd + "\n")
+    link_flags = []
+    if args.shared:
+        link_flags.append("/LD" if conf['compiler_id'] == "MSVC" else "-shared")
+    link_flags.append(conf['link_options'])
+    link_flags.extend(list(map(lambda rpath: RPATH_FMT.format(rpath), RPATHS)))
+    link_flags.extend(list(map(lambda libdir: LIBDIR_FMT.format(libdir), args.lib_dirs)))
+    link_flags.extend(list(map(lambda libname: LIBNAME_FMT.format(libname), args.lib_names)))
 
     if exepath.exists():
         exepath.unlink()
 
-    status = subprocess.run(cmd, capture_output=True, text=True, shell=True)
-    if status.returncode != 0:
-        sys.stdout.write(status.stdout)
-        sys.stderr.write(status.stderr)
+    if len(args.source) == 1 and not args.cache_dir:
+        # single translation unit: compile and link in one step
+        cmd = ['"{}"'.format(conf['compiler'])]
+        cmd.extend(flags)
+        cmd.append(OUTNAME_FMT.format(exepath))
+        cmd.append(str(args.source[0]))
+        cmd.extend(link_flags)
+        cmd = " ".join(cmd)
+
+        if args.verbose:
+            sys.stderr.write(cmd + "\n")
+
+        status = subprocess.run(cmd, capture_output=True, text=True, shell=True)
+        if status.returncode != 0:
+            sys.stdout.write(status.stdout)
+            sys.stderr.write(status.stderr)
+
+        os.sys.exit(status.returncode)
+
+    jobs = args.jobs if args.jobs > 0 else (os.cpu_count() or 1)
+    compile_flags = " ".join(flags)
+
+    # Feed the compiler flags and the souffle headers into every cache key, so that
+    # a different configuration or an upgraded souffle never reuses stale objects.
+    key_base = hashlib.sha256()
+    key_base.update(conf['compiler'].encode())
+    key_base.update(compile_flags.encode())
+    if souffle_include_dir and (souffle_include_dir / "CompiledSouffle.h").exists():
+        header_stat = (souffle_include_dir / "CompiledSouffle.h").stat()
+        key_base.update("{}:{}".format(header_stat.st_mtime_ns, header_stat.st_size).encode())
+
+    # hash a source file together with the local headers it includes
+    def source_digest(src):
+        digest = key_base.copy()
+        pending = [pathlib.Path(src)]
+        visited = set()
+        while pending:
+            path = pending.pop()
+            if path in visited or not path.is_file():
+                continue
+            visited.add(path)
+            content = path.read_bytes()
+            digest.update(str(path.name).encode())
+            digest.update(content)
+            for line in content.decode(errors='replace').splitlines():
+                line = line.strip()
+                if line.startswith("#include \""):
+                    pending.append(path.parent / line[len("#include \""):].split('"')[0])
+        return digest.hexdigest()
+
+    objdir_handle = None
+    if args.cache_dir:
+        objdir = args.cache_dir / "objects"
+        objdir.mkdir(parents=True, exist_ok=True)
+    else:
+        objdir_handle = tempfile.TemporaryDirectory()
+        objdir = pathlib.Path(objdir_handle.name)
 
-    os.sys.exit(status.returncode)
+    # Precompile `CompiledSouffle.h` with the global defines of the generated program.
+    pch_flags = ""
+    if args.cache_dir and not args.no_pch and conf['compiler_id'] in ("GNU", "Clang", "AppleClang"):
+        defines = []
+        for f in args.source:
+            for candidate in (f, f.with_suffix(".hpp")):
+                if not candidate.is_file():
+                    continue
+                for line in candidate.read_text(errors='replace').splitlines():
+                    if line.startswith("#define ") and line not in defines:
+                        defines.append(line)
+        pch_text = "\n".join(["#pragma once"] + defines + ["#include \"souffle/CompiledSouffle.h\"", ""])
+        pch_key = key_base.copy()
+        pch_key.update(pch_text.encode())
+        pch_dir = args.cache_dir / "pch" / pch_key.hexdigest()
+        pch_header = pch_dir / "souffle_pch.h"
+        if conf['compiler_id'] == "GNU":
+            pch_file = pch_dir / "souffle_pch.h.gch"
+            pch_flags = "-include \"{}\"".format(pch_header)
+        else:
+            pch_file = pch_dir / "souffle_pch.h.pch"
+            pch_flags = "-include-pch \"{}\"".format(pch_file)
+        if not pch_file.exists():
+            pch_dir.mkdir(parents=True, exist_ok=True)
+            pch_header.write_text(pch_text)
+            tmp_pch = pch_file.with_suffix(".tmp{}".format(os.getpid()))
+            cmd = '"{}" {} -x c++-header "{}" -o "{}"'.format(conf['compiler'], compile_flags, pch_header, tmp_pch)
+            launch_command(cmd, "Precompilation of CompiledSouffle.h", verbose=args.verbose)
+            os.replace(tmp_pch, pch_file)
+
+    # compile a single source file into an object file, unless an identical one is cached
+    def compile_object(src):
+        obj = objdir / "{}{}".format(source_digest(src), ".obj" if conf['compiler_id'] == "MSVC" else ".o")
+        if obj.exists():
+            if args.verbose:
+                sys.stderr.write("Reusing cached object for {}\n".format(src))
+            return obj
+        tmp_obj = obj.with_name(obj.name + ".tmp{}".format(os.getpid()))
+        cmd = ['"{}"'.format(conf['compiler'])]
+        cmd.append(compile_flags)
+        cmd.append(pch_flags)
+        cmd.append(OBJNAME_FMT.format(tmp_obj))
+        cmd.append(str(src))
+        launch_command(" ".join(cmd), "Compilation of {}".format(src.name), verbose=args.verbose)
+        os.replace(tmp_obj, obj)
+        return obj
+
+    try:
+        with concurrent.futures.ThreadPoolExecutor(max_workers=jobs) as pool:
+            objects = list(pool.map(compile_object, args.source))
+
+        cmd = ['"{}"'.format(conf['compiler'])]
+        cmd.append(conf['cxx_flags'])
+        cmd.append(OUTNAME_FMT.format(exepath))
+        cmd.extend('"{}"'.format(obj) for obj in objects)
+        cmd.extend(link_flags)
+        launch_command(" ".join(cmd), "Link of C++ objects", verbose=args.verbose)
+    except RuntimeError as e:
+        sys.stderr.write("{}\n".format(e))
+        os.sys.exit(1)
+    finally:
+        if objdir_handle:
+            objdir_handle.cleanup()
+
+    os.sys.exit(0)
@@ -12,6 +12,7 @@
 #include "souffle/SouffleInterface.h"
 #include "souffle/utility/MiscUtil.h"
 #include "souffle/utility/StreamUtil.h"
+#include "souffle/utility/StringUtil.h"
 #include "synthesiser/Utils.h"
 #include <algorithm>
 #include <cassert>
@@ -44,8 +45,8 @@ std::string Relation::getTypeAttributeString(const std::vector<std::string>& att
     return type.str();
 }
 
-Own<Relation> Relation::getSynthesiserRelation(
-        const ram::Relation& ramRel, const ram::analysis::IndexCluster& indexSelection) {
+Own<Relation> Relation::getSynthesiserRelation(const ram::Relation& ramRel,
+        const ram::analysis::IndexCluster& indexSelection, bool narrowStorage) {
     Relation* rel;
 
     bool hasProvenance = ramRel.getArity() > 0 && ramRel.getAttributeNames().back() == "@level_number";
@@ -55,13 +56,17 @@ Own<Relation> Relation::getSynthesiserRelation(
     } else if (ramRel.isNullary()) {
         rel = new NullaryRelation(ramRel, indexSelection);
     } else if (ramRel.getRepresentation() == RelationRepresentation::BTREE) {
-        rel = new DirectRelation(ramRel, indexSelection, false, false, false);
+        rel = new DirectRelation(ramRel, indexSelection, false, false, false, false, narrowStorage);
     } else if (ramRel.getRepresentation() == RelationRepresentation::BTREE_DELETE) {
         rel = new DirectRelation(ramRel, indexSelection, false, false, true);
+    } else if (ramRel.getRepresentation() == RelationRepresentation::BTREE_COMPRESSED) {
+        rel = new DirectRelation(ramRel, indexSelection, false, false, false, true);
     } else if (ramRel.getRepresentation() == RelationRepresentation::BRIE) {
         rel = new BrieRelation(ramRel, indexSelection);
     } else if (ramRel.getRepresentation() == RelationRepresentation::EQREL) {
         rel = new EqrelRelation(ramRel, indexSelection);
+    } else if (ramRel.getRepresentation() == RelationRepresentation::HASHSET) {
+        rel = new HashsetRelation(ramRel, indexSelection);
     } else if (ramRel.getRepresentation() == RelationRepresentation::INFO) {
         rel = new InfoRelation(ramRel, indexSelection);
     } else {
@@ -69,7 +74,7 @@ Own<Relation> Relation::getSynthesiserRelation(
         if (ramRel.getArity() > 6) {
             rel = new IndirectRelation(ramRel, indexSelection);
         } else {
-            rel = new DirectRelation(ramRel, indexSelection, false, false, false);
+            rel = new DirectRelation(ramRel, indexSelection, false, false, false, false, narrowStorage);
         }
     }
 
@@ -169,6 +174,24 @@ void DirectRelation::computeIndices() {
     computedIndices = inds;
 }
 
+/** On 64-bit builds, b-tree relations with identifier columns store them in 32-bit slots if enabled */
+bool DirectRelation::hasNarrowStorage() const {
+    if (!narrowStorage || sizeof(RamDomain) <= sizeof(uint32_t) || hasAuxiliary || hasErase || isCompressed) {
+        return false;
+    }
+    return getArity() < 64 && getWideColumns() != (uint64_t(1) << getArity()) - 1;
+}
+
+uint64_t DirectRelation::getWideColumns() const {
+    uint64_t mask = 0;
+    for (std::size_t i = 0; i < getArity(); i++) {
+        if (!relation.isIdentifierAttribute(i)) {
+            mask |= uint64_t(1) << i;
+        }
+    }
+    return mask;
+}
+
 /** Generate type name of a direct indexed relation */
 std::string DirectRelation::getTypeNamespace() {
     // collect all attributes used in the lex-order
@@ -180,9 +203,12 @@ std::string DirectRelation::getTypeNamespace() {
     }
 
     std::stringstream res;
-    res << "t_btree_";
+    res << (isCompressed ? "t_btree_compressed_" : "t_btree_");
     res << hasErase << hasAuxiliary << hasProvenance << "_";
     res << getTypeAttributeString(relation.getAttributeTypes(), attributesUsed);
+    if (hasNarrowStorage()) {
+        res << "_narrow" << getWideColumns();
+    }
 
     for (auto& ind : getIndices()) {
         res << "__" << join(ind, "_");
@@ -192,6 +218,10 @@ std::string DirectRelation::getTypeNamespace() {
         res << "__" << search;
     }
 
+    for (auto& search : indexSelection.getBloomFilters()) {
+        res << "__bloom_" << search;
+    }
+
     return res.str();
 }
 
@@ -214,11 +244,33 @@ void DirectRelation::generateTypeStruct(GenDb& db) {
     std::ostream& def = cl.def();
 
     cl.addInclude("\"souffle/SouffleInterface.h\"");
+    cl.addInclude("<array>");
     if (hasErase) {
         cl.addInclude("\"souffle/datastructure/BTreeDelete.h\"");
+    } else if (isCompressed) {
+        cl.addInclude("\"souffle/datastructure/CompressedBTree.h\"");
     } else {
         cl.addInclude("\"souffle/datastructure/BTree.h\"");
     }
+    const bool isNarrow = hasNarrowStorage();
+    if (isNarrow) {
+        cl.addInclude("\"souffle/datastructure/NarrowIndex.h\"");
+    }
+
+    // searches of anti-joins are guarded by Bloom filters of their equality attributes
+    const auto& bloomFilters = indexSelection.getBloomFilters();
+    if (!bloomFilters.empty()) {
+        cl.addInclude("\"souffle/datastructure/BloomFilter.h\"");
+    }
+    auto bloomHash = [&](const std::string& tuple, const SearchSignature& search) {
+        std::vector<std::string> values;
+        for (std::size_t i = 0; i < arity; i++) {
+            if (search[i] != analysis::AttributeConstraint::None) {
+                values.push_back(tuple + "[" + std::to_string(i) + "]");
+            }
+        }
+        return "BloomFilter::hash(" + toString(join(values, ",")) + ")";
+    };
 
     // struct definition
     decl << "struct Type {\n";
@@ -227,6 +279,11 @@ void DirectRelation::generateTypeStruct(GenDb& db) {
     // stored tuple type
     decl << "using t_tuple = Tuple<RamDomain, " << arity << ">;\n";
 
+    // identifier columns are stored in 32-bit slots, the others keep their width
+    if (isNarrow) {
+        decl << "using t_codec = narrow_codec<t_tuple, " << getWideColumns() << "ull>;\n";
+    }
+
     // generate an updater class for provenance
     if (hasAuxiliary) {
         decl << "struct updater {\n";
@@ -281,6 +338,10 @@ void DirectRelation::generateTypeStruct(GenDb& db) {
 
         auto genstruct = [&](std::string name, std::size_t bound) {
             decl << "struct " << name << "{\n";
+            // signed leading columns can be searched vectorised in b-tree nodes
+            if (bound > 0 && typecasts[ind[0]] == "ramBitCast<RamSigned>") {
+                decl << "static constexpr std::size_t leading_column = " << ind[0] << ";\n";
+            }
             decl << " int operator()(const t_tuple& a, const t_tuple& b) const {\n";
             decl << "  return ";
             std::function<void(std::size_t)> gencmp = [&](std::size_t i) {
@@ -350,26 +411,42 @@ void DirectRelation::generateTypeStruct(GenDb& db) {
                 comparator_aux = comparator;
             }
             decl << "using t_ind_" << i << " = btree_set<t_tuple," << comparator
-                 << ",std::allocator<t_tuple>,256,typename "
+                 << ",NodeArena,256,typename "
                     "souffle::detail::default_strategy<t_tuple>::type,"
                  << comparator_aux << ",updater>;\n";
         } else {
             std::string btree_name = "btree";
+            // the nodes of plain b-trees are allocated from an arena per index
+            std::string allocator = ",NodeArena";
             if (hasErase) {
                 btree_name = "btree_delete";
+                allocator = "";
+            } else if (isCompressed) {
+                btree_name = "compressed_btree";
+                allocator = "";
             }
-            if (ind.size() == arity) {
-                decl << "using t_ind_" << i << " = " << btree_name << "_set<t_tuple," << comparator << ">;\n";
+            if (isNarrow) {
+                const std::string kind = (ind.size() == arity) ? "_set" : "_multiset";
+                decl << "using t_ind_" << i << " = narrow_index<t_codec, " << btree_name << kind
+                     << "<t_codec::stored_type, narrow_comparator<t_codec, " << comparator << ">" << allocator
+                     << ">>;\n";
+            } else if (ind.size() == arity) {
+                decl << "using t_ind_" << i << " = " << btree_name << "_set<t_tuple," << comparator
+                     << allocator << ">;\n";
             } else {
                 // without provenance, some indices may be not full, so we use btree_multiset for those
                 decl << "using t_ind_" << i << " = " << btree_name << "_multiset<t_tuple," << comparator
-                     << ">;\n";
+                     << allocator << ">;\n";
             }
         }
         decl << "t_ind_" << i << " ind_" << i << ";\n";
         def << "using t_ind_" << i << " = Type::t_ind_" << i << ";\n";
     }
 
+    for (std::size_t i = 0; i < bloomFilters.size(); i++) {
+        decl << "BloomFilter bloom_" << i << ";\n";
+    }
+
     // typedef master index iterator to be struct iterator
     decl << "using iterator = t_ind_" << masterIndex << "::iterator;\n";
     def << "using iterator = Type::iterator;\n";
@@ -421,6 +498,9 @@ void DirectRelation::generateTypeStruct(GenDb& db) {
                 << ");\n";
         }
     }
+    for (std::size_t i = 0; i < bloomFilters.size(); i++) {
+        def << "bloom_" << i << ".insert(" << bloomHash("t", bloomFilters[i]) << ");\n";
+    }
     def << "return true;\n";
     def << "} else return false;\n";
     def << "}\n";  // end of insert(t_tuple&, context&)
@@ -450,6 +530,12 @@ void DirectRelation::generateTypeStruct(GenDb& db) {
     // contains methods
     decl << "bool contains(const t_tuple& t, context& h) const;\n";
     def << "bool Type::contains(const t_tuple& t, context& h) const {\n";
+    if (auto filter = indexSelection.getBloomFilterNum(SearchSignature::getFullSearchSignature(arity))) {
+        def << "if (!bloom_" << *filter << ".mayContain("
+            << bloomHash("t", SearchSignature::getFullSearchSignature(arity)) << ")) {\n";
+        def << "return false;\n";
+        def << "}\n";
+    }
     def << "return ind_" << masterIndex << ".contains(t, h.hints_" << masterIndex << "_lower"
         << ");\n";
     def << "}\n";
@@ -515,6 +601,13 @@ void DirectRelation::generateTypeStruct(GenDb& db) {
             }
         }
 
+        // a search of an anti-join is empty if the Bloom filter does not contain its values
+        if (auto filter = indexSelection.getBloomFilterNum(search)) {
+            def << "if (!bloom_" << *filter << ".mayContain(" << bloomHash("lower", search) << ")) {\n";
+            def << "    return make_range(ind_" << indNum << ".end(), ind_" << indNum << ".end());\n";
+            def << "}\n";
+        }
+
         def << "t_comparator_" << indNum << " comparator;\n";
         def << "int cmp = comparator(lower, upper);\n";
 
@@ -567,8 +660,83 @@ void DirectRelation::generateTypeStruct(GenDb& db) {
     for (std::size_t i = 0; i < numIndexes; i++) {
         def << "ind_" << i << ".clear();\n";
     }
+    for (std::size_t i = 0; i < bloomFilters.size(); i++) {
+        def << "bloom_" << i << ".clear();\n";
+    }
     def << "}\n";
 
+    // compact method encoding the tuples inserted since the last compaction into compressed leaves
+    if (isCompressed) {
+        decl << "void compact();\n";
+        def << "void Type::compact() {\n";
+        for (std::size_t i = 0; i < numIndexes; i++) {
+            def << "ind_" << i << ".compact();\n";
+        }
+        def << "}\n";
+    }
+
+    // merge method inserting all tuples of another relation, merging them into each sorted index
+    decl << "template <typename R>\n";
+    decl << "void merge(const R& other) {\n";
+    if (hasAuxiliary || hasErase) {
+        decl << "context h;\n";
+        decl << "for (const auto& t : other) {\n";
+        decl << "insert(t, h);\n";
+        decl << "}\n";
+    } else {
+        cl.addInclude("\"souffle/utility/ParallelUtil.h\"");
+        cl.addInclude("<algorithm>");
+        cl.addInclude("<vector>");
+        auto sortBy = [&](const std::string& tuples, std::size_t i) {
+            decl << "{\n";
+            decl << "t_comparator_" << i << " comparator;\n";
+            decl << "auto less = [&](const t_tuple& a, const t_tuple& b) {\n";
+            decl << "return comparator.less(a, b);\n";
+            decl << "};\n";
+            decl << "if (!std::is_sorted(" << tuples << ".begin(), " << tuples << ".end(), less)) {\n";
+            decl << "std::sort(" << tuples << ".begin(), " << tuples << ".end(), less);\n";
+            decl << "}\n";
+            decl << "}\n";
+        };
+        decl << "std::vector<t_tuple> tuples;\n";
+        decl << "for (const auto& t : other) {\n";
+        decl << "tuples.push_back(t);\n";
+        decl << "}\n";
+        sortBy("tuples", masterIndex);
+        // the other indexes only receive the tuples that are new to the master index
+        decl << "std::vector<t_tuple> inserted;\n";
+        decl << "ind_" << masterIndex << ".insertSorted(tuples.begin(), tuples.end(), "
+             << "[&](const t_tuple& t) { inserted.push_back(t); });\n";
+        if (!bloomFilters.empty()) {
+            decl << "for (const auto& t : inserted) {\n";
+            for (std::size_t i = 0; i < bloomFilters.size(); i++) {
+                decl << "bloom_" << i << ".insert(" << bloomHash("t", bloomFilters[i]) << ");\n";
+            }
+            decl << "}\n";
+        }
+        if (numIndexes > 1) {
+            decl << "PARALLEL_START\n";
+            decl << "pfor(std::size_t i = 0; i < " << numIndexes << "; ++i) {\n";
+            decl << "switch (i) {\n";
+            for (std::size_t i = 0; i < numIndexes; i++) {
+                if (i == masterIndex) {
+                    continue;
+                }
+                decl << "case " << i << ": {\n";
+                decl << "std::vector<t_tuple> sorted(inserted);\n";
+                sortBy("sorted", i);
+                decl << "ind_" << i << ".insertSorted(sorted.begin(), sorted.end());\n";
+                decl << "break;\n";
+                decl << "}\n";
+            }
+            decl << "default: break;\n";
+            decl << "}\n";
+            decl << "}\n";
+            decl << "PARALLEL_END\n";
+        }
+    }
+    decl << "}\n";
+
     // begin and end iterators
     decl << "iterator begin() const;\n";
     def << "iterator Type::begin() const {\n";
@@ -580,6 +748,28 @@ void DirectRelation::generateTypeStruct(GenDb& db) {
     def << "return ind_" << masterIndex << ".end();\n";
     def << "}\n";
 
+    // lookup of binding patterns through the first index covering them, see souffle::Relation::lookup
+    decl << "template <typename F>\n";
+    decl << "bool lookup(const std::string& pattern, const t_tuple& lower, const t_tuple& upper, F&& f) const "
+            "{\n";
+    for (std::size_t i = 0; i < numIndexes; i++) {
+        if (provenanceIndexNumbers.find(i) != provenanceIndexNumbers.end()) {
+            continue;
+        }
+        decl << "if (souffle::Relation::coversPattern(pattern, std::array<std::size_t, " << inds[i].size()
+             << ">{{" << join(inds[i], ",") << "}})) {\n";
+        decl << "t_comparator_" << i << " comparator;\n";
+        decl << "if (comparator(lower, upper) > 0) {\n";
+        decl << "f(make_range(ind_" << i << ".end(), ind_" << i << ".end()));\n";
+        decl << "} else {\n";
+        decl << "f(make_range(ind_" << i << ".lower_bound(lower), ind_" << i << ".upper_bound(upper)));\n";
+        decl << "}\n";
+        decl << "return true;\n";
+        decl << "}\n";
+    }
+    decl << "return false;\n";
+    decl << "}\n";
+
     // copyIndex method
     if (!provenanceIndexNumbers.empty()) {
         decl << "void copyIndex();\n";
@@ -602,6 +792,16 @@ void DirectRelation::generateTypeStruct(GenDb& db) {
     }
     def << "}\n";
 
+    // getIndexMemoryUsage method
+    decl << "std::vector<std::size_t> getIndexMemoryUsage() const;\n";
+    def << "std::vector<std::size_t> Type::getIndexMemoryUsage() const {\n";
+    def << "return {";
+    for (std::size_t i = 0; i < numIndexes; i++) {
+        def << (i > 0 ? ", " : "") << "ind_" << i << ".getMemoryUsage()";
+    }
+    def << "};\n";
+    def << "}\n";
+
     // end struct
     decl << "};\n";
 
@@ -756,9 +956,10 @@ void IndirectRelation::generateTypeStruct(GenDb& db) {
         decl << "};\n";
 
         if (ind.size() == arity) {
-            decl << "using t_ind_" << i << " = btree_set<const t_tuple*," << comparator << ">;\n";
+            decl << "using t_ind_" << i << " = btree_set<const t_tuple*," << comparator << ",NodeArena>;\n";
         } else {
-            decl << "using t_ind_" << i << " = btree_multiset<const t_tuple*," << comparator << ">;\n";
+            decl << "using t_ind_" << i << " = btree_multiset<const t_tuple*," << comparator
+                 << ",NodeArena>;\n";
         }
 
         decl << "t_ind_" << i << " ind_" << i << ";\n";
@@ -978,6 +1179,19 @@ void IndirectRelation::generateTypeStruct(GenDb& db) {
     }
     def << "}\n";
 
+    // getIndexMemoryUsage method, attributing the tuple storage to the master index
+    decl << "std::vector<std::size_t> getIndexMemoryUsage() const;\n";
+    def << "std::vector<std::size_t> Type::getIndexMemoryUsage() const {\n";
+    def << "return {";
+    for (std::size_t i = 0; i < numIndexes; i++) {
+        def << (i > 0 ? ", " : "") << "ind_" << i << ".getMemoryUsage()";
+        if (i == masterIndex) {
+            def << " + dataTable.getMemoryUsage()";
+        }
+    }
+    def << "};\n";
+    def << "}\n";
+
     // end struct
     decl << "};\n";
 }
@@ -1288,6 +1502,16 @@ void BrieRelation::generateTypeStruct(GenDb& db) {
     }
     def << "}\n";
 
+    // getIndexMemoryUsage method
+    decl << "std::vector<std::size_t> getIndexMemoryUsage() const;\n";
+    def << "std::vector<std::size_t> Type::getIndexMemoryUsage() const {\n";
+    def << "return {";
+    for (std::size_t i = 0; i < numIndexes; i++) {
+        def << (i > 0 ? ", " : "") << "ind_" << i << ".getMemoryUsage()";
+    }
+    def << "};\n";
+    def << "}\n";
+
     // orderOut and orderIn methods for reordering tuples according to index orders
     for (std::size_t i = 0; i < numIndexes; i++) {
         auto ind = inds[i];
@@ -1312,6 +1536,195 @@ void BrieRelation::generateTypeStruct(GenDb& db) {
     decl << "};\n";
 }
 
+// -------- Hashset Relation --------
+
+/** Generate index set for a hash set relation, which stores tuples in attribute order */
+void HashsetRelation::computeIndices() {
+    assert(!indexSelection.getAllOrders().empty() && "No full index in relation");
+
+    LexOrder ind;
+    for (std::size_t i = 0; i < getArity(); i++) {
+        ind.push_back(i);
+    }
+    masterIndex = 0;
+
+    computedIndices = {ind};
+}
+
+/** Generate type name of a hash set relation */
+std::string HashsetRelation::getTypeNamespace() {
+    // tuples are hashed as raw values, the attribute types do not matter
+    return "t_hashset_" + std::to_string(getArity());
+}
+
+std::string HashsetRelation::getTypeName() {
+    return getTypeNamespace() + "::Type";
+}
+
+/** Generate type struct of a hash set relation */
+void HashsetRelation::generateTypeStruct(GenDb& db) {
+    std::size_t arity = getArity();
+
+    fs::path basename(uniqueCppIdent(getTypeNamespace(), 20));
+    GenDatastructure& cl = db.getDatastructure("Type", basename, std::make_optional(getTypeNamespace()));
+    std::ostream& decl = cl.decl();
+    std::ostream& def = cl.def();
+    cl.addInclude("\"souffle/SouffleInterface.h\"");
+    cl.addInclude("\"souffle/datastructure/ConcurrentInsertOnlyHashSet.h\"");
+
+    // struct definition
+    decl << "struct Type {\n";
+    decl << "static constexpr Relation::arity_type Arity = " << arity << ";\n";
+    decl << "using t_ind_0 = TupleHashSet<" << arity << ">;\n";
+    decl << "t_ind_0 ind_0;\n";
+    decl << "using t_tuple = t_ind_0::element_type;\n";
+    decl << "using iterator = t_ind_0::iterator;\n";
+    def << "using iterator = Type::iterator;\n";
+
+    // hash sets do not use operation hints
+    decl << "struct context {};\n";
+    def << "using context = Type::context;\n";
+
+    decl << "context createContext();\n";
+    def << "context Type::createContext() { return context(); }\n";
+
+    // insert methods
+    decl << "bool insert(const t_tuple& t);\n";
+    def << "bool Type::insert(const t_tuple& t) {\n";
+    def << "return ind_0.insert(t);\n";
+    def << "}\n";
+
+    decl << "bool insert(const t_tuple& t, context& h);\n";
+    def << "bool Type::insert(const t_tuple& t, context& /* h */) {\n";
+    def << "return ind_0.insert(t);\n";
+    def << "}\n";
+
+    decl << "bool insert(const RamDomain* ramDomain);\n";
+    def << "bool Type::insert(const RamDomain* ramDomain) {\n";
+    def << "t_tuple tuple;\n";
+    def << "std::copy(ramDomain, ramDomain + " << arity << ", tuple.begin());\n";
+    def << "return ind_0.insert(tuple);\n";
+    def << "}\n";
+
+    std::vector<std::string> decls;
+    std::vector<std::string> params;
+    for (std::size_t i = 0; i < arity; i++) {
+        decls.push_back("RamDomain a" + std::to_string(i));
+        params.push_back("a" + std::to_string(i));
+    }
+    decl << "bool insert(" << join(decls, ",") << ");\n";
+    def << "bool Type::insert(" << join(decls, ",") << ") {\nRamDomain data[";
+    def << arity << "] = {" << join(params, ",") << "};\n";
+    def << "return insert(data);\n";
+    def << "}\n";
+
+    // contains methods
+    decl << "bool contains(const t_tuple& t, context& h) const;\n";
+    def << "bool Type::contains(const t_tuple& t, context& /* h */) const {\n";
+    def << "return ind_0.contains(t);\n";
+    def << "}\n";
+
+    decl << "bool contains(const t_tuple& t) const;\n";
+    def << "bool Type::contains(const t_tuple& t) const {\n";
+    def << "return ind_0.contains(t);\n";
+    def << "}\n";
+
+    // size method
+    decl << "std::size_t size() const;\n";
+    def << "std::size_t Type::size() const {\n";
+    def << "return ind_0.size();\n";
+    def << "}\n";
+
+    // find methods
+    decl << "iterator find(const t_tuple& t, context& h) const;\n";
+    def << "iterator Type::find(const t_tuple& t, context& /* h */) const {\n";
+    def << "return ind_0.find(t);\n";
+    def << "}\n";
+
+    decl << "iterator find(const t_tuple& t) const;\n";
+    def << "iterator Type::find(const t_tuple& t) const {\n";
+    def << "return ind_0.find(t);\n";
+    def << "}\n";
+
+    // empty lowerUpperRange method
+    decl << "range<iterator> lowerUpperRange_0(const t_tuple& lower, const t_tuple& upper, context& h) "
+            "const;\n";
+    def << "range<iterator> Type::lowerUpperRange_0(const t_tuple& /* lower */, const t_tuple& /* upper */, "
+           "context& /* h */) const {\n";
+    def << "return range<iterator>(ind_0.begin(), ind_0.end());\n";
+    def << "}\n";
+
+    decl << "range<iterator> lowerUpperRange_0(const t_tuple& lower, const t_tuple& upper) const;\n";
+    def << "range<iterator> Type::lowerUpperRange_0(const t_tuple& /* lower */, const t_tuple& /* upper */) "
+           "const {\n";
+    def << "return range<iterator>(ind_0.begin(), ind_0.end());\n";
+    def << "}\n";
+
+    // lowerUpperRange methods; all searches bind every attribute
+    for (auto search : indexSelection.getSearches()) {
+        assert(search == analysis::SearchSignature::getFullSearchSignature(arity) &&
+                "hash sets only support searches for full tuples");
+
+        decl << "range<iterator> lowerUpperRange_" << search;
+        decl << "(const t_tuple& lower, const t_tuple& upper, context& h) const;\n";
+        def << "range<iterator> Type::lowerUpperRange_" << search;
+        def << "(const t_tuple& lower, const t_tuple& /* upper */, context& /* h */) const {\n";
+        def << "return ind_0.equalRange(lower);\n";
+        def << "}\n";
+
+        decl << "range<iterator> lowerUpperRange_" << search;
+        decl << "(const t_tuple& lower, const t_tuple& upper) const;\n";
+        def << "range<iterator> Type::lowerUpperRange_" << search;
+        def << "(const t_tuple& lower, const t_tuple& /* upper */) const {\n";
+        def << "return ind_0.equalRange(lower);\n";
+        def << "}\n";
+    }
+
+    // empty method
+    decl << "bool empty() const;\n";
+    def << "bool Type::empty() const {\n";
+    def << "return ind_0.empty();\n";
+    def << "}\n";
+
+    // partition method
+    decl << "std::vector<range<iterator>> partition() const;\n";
+    def << "std::vector<range<iterator>> Type::partition() const {\n";
+    def << "return ind_0.partition(10000);\n";
+    def << "}\n";
+
+    // purge method
+    decl << "void purge();\n";
+    def << "void Type::purge() {\n";
+    def << "ind_0.clear();\n";
+    def << "}\n";
+
+    // begin and end iterators
+    decl << "iterator begin() const;\n";
+    def << "iterator Type::begin() const {\n";
+    def << "return ind_0.begin();\n";
+    def << "}\n";
+
+    decl << "iterator end() const;\n";
+    def << "iterator Type::end() const {\n";
+    def << "return ind_0.end();\n";
+    def << "}\n";
+
+    decl << "void printStatistics(std::ostream& o) const;\n";
+    def << "void Type::printStatistics(std::ostream& o) const {\n";
+    def << "o << \" arity " << arity << " hashset index 0\\n\";\n";
+    def << "ind_0.printStats(o);\n";
+    def << "}\n";
+
+    // getIndexMemoryUsage method
+    decl << "std::vector<std::size_t> getIndexMemoryUsage() const;\n";
+    def << "std::vector<std::size_t> Type::getIndexMemoryUsage() const {\n";
+    def << "return {ind_0.getMemoryUsage()};\n";
+    def << "}\n";
+
+    // end class
+    decl << "};\n";
+}
+
 // -------- Eqrel Relation --------
 
 /** Generate index set for a eqrel relation, which should be empty */
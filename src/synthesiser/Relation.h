@@ -69,8 +69,8 @@ public:
     virtual void generateTypeStruct(GenDb& db) = 0;
 
     /** Factory method to generate a SynthesiserRelation */
-    static Own<Relation> getSynthesiserRelation(
-            const ram::Relation& ramRel, const ram::analysis::IndexCluster& indexSelection);
+    static Own<Relation> getSynthesiserRelation(const ram::Relation& ramRel,
+            const ram::analysis::IndexCluster& indexSelection, bool narrowStorage);
 
 protected:
     /** Ram relation referred to by this */
@@ -115,19 +115,33 @@ public:
 class DirectRelation : public Relation {
 public:
     DirectRelation(const ram::Relation& ramRel, const ram::analysis::IndexCluster& indexSelection,
-            bool hasAuxiliary, bool hasProvenance, bool hasErase)
+            bool hasAuxiliary, bool hasProvenance, bool hasErase, bool isCompressed = false,
+            bool narrowStorage = false)
             : Relation(ramRel, indexSelection), hasAuxiliary(hasAuxiliary), hasProvenance(hasProvenance),
-              hasErase(hasErase) {}
+              hasErase(hasErase), isCompressed(isCompressed), narrowStorage(narrowStorage) {}
 
     void computeIndices() override;
     std::string getTypeNamespace();
     std::string getTypeName() override;
     void generateTypeStruct(GenDb& db) override;
 
+    /** Whether the leaves of the indexes are compressed, providing a compact() member */
+    bool hasCompressedLeaves() const {
+        return isCompressed;
+    }
+
 private:
+    /** Whether identifier columns are stored in 32-bit slots */
+    bool hasNarrowStorage() const;
+
+    /** The mask of the columns keeping the full width of the domain in narrow storage */
+    uint64_t getWideColumns() const;
+
     const bool hasAuxiliary;
     const bool hasProvenance;
     const bool hasErase;
+    const bool isCompressed;
+    const bool narrowStorage;
 };
 
 class IndirectRelation : public Relation {
@@ -152,6 +166,17 @@ public:
     void generateTypeStruct(GenDb& db) override;
 };
 
+class HashsetRelation : public Relation {
+public:
+    HashsetRelation(const ram::Relation& ramRel, const ram::analysis::IndexCluster& indexSelection)
+            : Relation(ramRel, indexSelection) {}
+
+    void computeIndices() override;
+    std::string getTypeNamespace();
+    std::string getTypeName() override;
+    void generateTypeStruct(GenDb& db) override;
+};
+
 class EqrelRelation : public Relation {
 public:
     EqrelRelation(const ram::Relation& ramRel, const ram::analysis::IndexCluster& indexSelection)
@@ -28,6 +28,7 @@
 #include "ram/Break.h"
 #include "ram/Call.h"
 #include "ram/Clear.h"
+#include "ram/Compact.h"
 #include "ram/Condition.h"
 #include "ram/Conjunction.h"
 #include "ram/Constraint.h"
@@ -44,6 +45,7 @@
 #include "ram/IfExists.h"
 #include "ram/IndexAggregate.h"
 #include "ram/IndexIfExists.h"
+#include "ram/IndexOperation.h"
 #include "ram/IndexScan.h"
 #include "ram/Insert.h"
 #include "ram/IntrinsicAggregator.h"
@@ -52,7 +54,9 @@
 #include "ram/LogSize.h"
 #include "ram/LogTimer.h"
 #include "ram/Loop.h"
+#include "ram/Merge.h"
 #include "ram/MergeExtend.h"
+#include "ram/MergeLattice.h"
 #include "ram/Negation.h"
 #include "ram/NestedIntrinsicOperator.h"
 #include "ram/NestedOperation.h"
@@ -80,6 +84,7 @@
 #include "ram/SubroutineReturn.h"
 #include "ram/Swap.h"
 #include "ram/TranslationUnit.h"
+#include "ram/TrieJoin.h"
 #include "ram/True.h"
 #include "ram/TupleElement.h"
 #include "ram/TupleOperation.h"
@@ -150,6 +155,16 @@ std::size_t Synthesiser::lookupReadIdx(const std::string& txt) {
     }
 }
 
+/** Lookup index search counter */
+std::size_t Synthesiser::lookupSearchIdx(const std::string& txt) {
+    auto pos = searchIdxMap.find(txt);
+    if (pos == searchIdxMap.end()) {
+        const std::size_t idx = searchIdxMap.size();
+        return searchIdxMap[txt] = idx;
+    }
+    return pos->second;
+}
+
 /** Convert RAM identifier */
 const std::string Synthesiser::convertRamIdent(const std::string& name) {
     auto it = identifiers.find(name);
@@ -206,6 +221,10 @@ ram::RelationSet Synthesiser::getReferencedRelations(const Operation& op) {
             res.insert(lookup(provExists->getRelation()));
         } else if (auto insert = as<Insert>(node)) {
             res.insert(lookup(insert->getRelation()));
+        } else if (auto join = as<TrieJoin>(node)) {
+            for (std::size_t atom = 0; atom < join->getNumAtoms(); ++atom) {
+                res.insert(lookup(join->getRelation(atom)));
+            }
         }
     });
     return res;
@@ -372,6 +391,22 @@ void Synthesiser::emitCode(std::ostream& out, const Statement& stmt) {
 
             const auto& directives = io.getDirectives();
             const std::string& op = io.get("operation");
+
+            // spilling is part of the evaluation and independent of performIO
+            if (op == "spill" || op == "restore") {
+                synthesiser.currentClass->addInclude("\"souffle/io/Spill.h\"", true);
+                out << "try {";
+                out << "SpillManager::getInstance()." << op << "(*"
+                    << synthesiser.getRelationName(synthesiser.lookup(io.getRelation())) << ", ";
+                out << "std::map<std::string, std::string>(";
+                printDirectives(directives);
+                out << "), symTable, recordTable);\n";
+                out << "} catch (std::exception& e) {std::cerr << \"Error in " << op << " of "
+                    << io.getRelation() << ": \" << e.what() << '\\n';\nexit(1);\n}\n";
+                PRINT_END_COMMENT(out);
+                return;
+            }
+
             out << "if (performIO) {\n";
 
             // get some table details
@@ -607,6 +642,51 @@ void Synthesiser::emitCode(std::ostream& out, const Statement& stmt) {
             PRINT_END_COMMENT(out);
         }
 
+        void visit_(type_identity<Merge>, const Merge& merge, std::ostream& out) override {
+            const auto* source = synthesiser.lookup(merge.getSourceRelation());
+            const auto* target = synthesiser.lookup(merge.getTargetRelation());
+            const auto sourceName = synthesiser.getRelationName(source);
+            const auto targetName = synthesiser.getRelationName(target);
+            const auto targetCtxName = "READ_OP_CONTEXT(" + synthesiser.getOpContextName(*target) + ")";
+            auto relationType = Relation::getSynthesiserRelation(
+                    *target, isa->getIndexSelection(target->getName()), synthesiser.hasNarrowStorage());
+
+            PRINT_BEGIN_COMMENT(out);
+            if (isA<DirectRelation>(*relationType)) {
+                // the indexes of direct relations merge sorted ranges
+                out << targetName << "->merge(*" << sourceName << ");\n";
+            } else {
+                const std::size_t arity = target->getArity();
+                out << "[&](){\n";
+                out << "CREATE_OP_CONTEXT(" << synthesiser.getOpContextName(*target) << "," << targetName
+                    << "->createContext());\n";
+                out << "for (const auto& env0 : *" << sourceName << ") {\n";
+                out << "Tuple<RamDomain," << arity << "> tuple{{";
+                for (std::size_t i = 0; i < arity; ++i) {
+                    out << (i > 0 ? "," : "") << "env0[" << i << "]";
+                }
+                out << "}};\n";
+                out << targetName << "->insert(tuple," << targetCtxName << ");\n";
+                out << "}\n";
+                out << "}();\n";
+            }
+            PRINT_END_COMMENT(out);
+        }
+
+        void visit_(type_identity<Compact>, const Compact& compact, std::ostream& out) override {
+            const auto* rel = synthesiser.lookup(compact.getRelation());
+            auto relationType = Relation::getSynthesiserRelation(
+                    *rel, isa->getIndexSelection(rel->getName()), synthesiser.hasNarrowStorage());
+
+            PRINT_BEGIN_COMMENT(out);
+            // only direct relations with compressed leaves have tuples to compact
+            const auto* direct = as<DirectRelation>(*relationType);
+            if (direct != nullptr && direct->hasCompressedLeaves()) {
+                out << synthesiser.getRelationName(rel) << "->compact();\n";
+            }
+            PRINT_END_COMMENT(out);
+        }
+
         void visit_(type_identity<MergeExtend>, const MergeExtend& extend, std::ostream& out) override {
             PRINT_BEGIN_COMMENT(out);
             out << synthesiser.getRelationName(synthesiser.lookup(extend.getSourceRelation())) << "->"
@@ -616,6 +696,106 @@ void Synthesiser::emitCode(std::ostream& out, const Statement& stmt) {
             PRINT_END_COMMENT(out);
         }
 
+        void visit_(type_identity<MergeLattice>, const MergeLattice& merge, std::ostream& out) override {
+            const auto* source = synthesiser.lookup(merge.getSourceRelation());
+            const auto* target = synthesiser.lookup(merge.getTargetRelation());
+            const auto* delta =
+                    merge.getDeltaRelation().empty() ? nullptr : synthesiser.lookup(merge.getDeltaRelation());
+            const auto sourceName = synthesiser.getRelationName(source);
+            const auto targetName = synthesiser.getRelationName(target);
+            const auto sourceCtxName = "READ_OP_CONTEXT(" + synthesiser.getOpContextName(*source) + ")";
+            const auto targetCtxName = "READ_OP_CONTEXT(" + synthesiser.getOpContextName(*target) + ")";
+            const std::size_t arity = target->getArity();
+            const std::size_t firstLattice = arity - target->getAuxiliaryArity();
+            const auto keys = isa->getSearchSignature(&merge);
+            const auto lubs = merge.getLubs();
+            const std::string tupleType = "Tuple<RamDomain," + std::to_string(arity) + ">";
+
+            // bounds covering all tuples, and the tuples of the group of env0
+            VecOwn<Expression> unbounded;
+            VecOwn<Expression> group;
+            for (std::size_t i = 0; i < arity; ++i) {
+                unbounded.push_back(mk<UndefValue>());
+                if (i < firstLattice) {
+                    group.push_back(mk<TupleElement>(0, i));
+                } else {
+                    group.push_back(mk<UndefValue>());
+                }
+            }
+            auto allBounds = getPaddedRangeBounds(*source, toPtrVector(unbounded), toPtrVector(unbounded));
+            auto groupBounds = getPaddedRangeBounds(*target, toPtrVector(group), toPtrVector(group));
+
+            PRINT_BEGIN_COMMENT(out);
+            out << "[&](){\n";
+
+            // copy the source tuples, which the index orders by their non-lattice attributes
+            out << "std::vector<" << tupleType << "> tuples;\n";
+            out << "std::vector<std::size_t> groups;\n";
+            out << "{\n";
+            out << "CREATE_OP_CONTEXT(" << synthesiser.getOpContextName(*source) << "," << sourceName
+                << "->createContext());\n";
+            out << "for(const auto& env0 : " << sourceName << "->lowerUpperRange_" << keys << "("
+                << allBounds.first.str() << "," << allBounds.second.str() << "," << sourceCtxName << ")) {\n";
+            out << "if (tuples.empty() || !std::equal(env0.begin(), env0.begin() + " << firstLattice
+                << ", tuples.back().begin())) {\n";
+            out << "groups.push_back(tuples.size());\n";
+            out << "}\n";
+            out << "tuples.push_back(env0);\n";
+            out << "}\n";
+            out << "}\n";
+            out << "const std::size_t numGroups = groups.size();\n";
+            out << "groups.push_back(tuples.size());\n";
+            out << "std::vector<char> changed(numGroups, 0);\n";
+
+            // least upper bound of each group, combined with the tuple of the group in the target
+            out << "PARALLEL_START\n";
+            out << "CREATE_OP_CONTEXT(" << synthesiser.getOpContextName(*target) << "," << targetName
+                << "->createContext());\n";
+            if (delta != nullptr) {
+                out << "CREATE_OP_CONTEXT(" << synthesiser.getOpContextName(*delta) << ","
+                    << synthesiser.getRelationName(delta) << "->createContext());\n";
+            }
+            out << "pfor(std::size_t g = 0; g < numGroups; ++g) {\n";
+            out << "auto& env0 = tuples[groups[g]];\n";
+            out << "for (std::size_t t = groups[g] + 1; t < groups[g + 1]; ++t) {\n";
+            out << "const auto& env1 = tuples[t];\n";
+            for (std::size_t i = firstLattice; i < arity; ++i) {
+                out << "env0[" << i << "] = ";
+                dispatch(*lubs[i - firstLattice], out);
+                out << ";\n";
+            }
+            out << "}\n";
+            out << "auto existing = " << targetName << "->lowerUpperRange_" << keys << "("
+                << groupBounds.first.str() << "," << groupBounds.second.str() << "," << targetCtxName
+                << ");\n";
+            out << "if (existing.empty()) {\n";
+            out << "changed[g] = 1;\n";
+            out << "continue;\n";
+            out << "}\n";
+            out << "const " << tupleType << " env1 = *existing.begin();\n";
+            for (std::size_t i = firstLattice; i < arity; ++i) {
+                out << "env0[" << i << "] = ";
+                dispatch(*lubs[i - firstLattice], out);
+                out << ";\n";
+                out << "changed[g] |= static_cast<char>(env0[" << i << "] != env1[" << i << "]);\n";
+            }
+            out << "}\n";
+
+            // update the target relation in place and record the changes
+            out << "pfor(std::size_t g = 0; g < numGroups; ++g) {\n";
+            out << "if (changed[g] != 0) {\n";
+            out << targetName << "->insert(tuples[groups[g]]," << targetCtxName << ");\n";
+            if (delta != nullptr) {
+                out << synthesiser.getRelationName(delta) << "->insert(tuples[groups[g]],"
+                    << "READ_OP_CONTEXT(" << synthesiser.getOpContextName(*delta) << "));\n";
+            }
+            out << "}\n";
+            out << "}\n";
+            out << "PARALLEL_END\n";
+            out << "}();\n";
+            PRINT_END_COMMENT(out);
+        }
+
         void visit_(type_identity<Exit>, const Exit& exit, std::ostream& out) override {
             PRINT_BEGIN_COMMENT(out);
             out << "if(";
@@ -630,6 +810,10 @@ void Synthesiser::emitCode(std::ostream& out, const Statement& stmt) {
             out << " std::vector<RamDomain> args, ret;\n";
             out << synthesiser.convertStratumIdent(call.getName()) << ".run(args, ret);\n";
             out << "}\n";
+            if (glb.config().has("profile")) {
+                const std::string& name = call.getName();
+                out << "dumpMemoryUsage(" << raw_str(name.substr(name.find('_') + 1)) << ");\n";
+            }
             PRINT_END_COMMENT(out);
         }
 
@@ -682,6 +866,15 @@ void Synthesiser::emitCode(std::ostream& out, const Statement& stmt) {
             PRINT_END_COMMENT(out);
         }
 
+        /** Count the executions of an index operation if search frequencies are profiled */
+        void countSearch(const IndexOperation& search, std::ostream& out) {
+            if (glb.config().has("profile") && glb.config().has("profile-frequency")) {
+                const std::string key =
+                        search.getRelation() + ";" + toString(isa->getSearchSignature(&search));
+                out << "searches[" << synthesiser.lookupSearchIdx(key) << "]++;\n";
+            }
+        }
+
         // -- operations --
 
         void visit_(
@@ -719,10 +912,10 @@ void Synthesiser::emitCode(std::ostream& out, const Statement& stmt) {
                    #if defined _OPENMP && _OPENMP < 200805
                            auto count = std::distance(part.begin(), part.end());
                            auto base = part.begin();
-                           pfor(int index  = 0; index < count; index++) {
+                           pfor_partitions(int index  = 0; index < count; index++) {
                                auto it = base + index;
                    #else
-                           pfor(auto it = part.begin(); it < part.end(); it++) {
+                           pfor_partitions(auto it = part.begin(); it < part.end(); it++) {
                    #endif
                    )cpp";
             out << "try{\n";
@@ -803,10 +996,10 @@ void Synthesiser::emitCode(std::ostream& out, const Statement& stmt) {
                    #if defined _OPENMP && _OPENMP < 200805
                            auto count = std::distance(part.begin(), part.end());
                            auto base = part.begin();
-                           pfor(int index  = 0; index < count; index++) {
+                           pfor_partitions(int index  = 0; index < count; index++) {
                                auto it = base + index;
                    #else
-                           pfor(auto it = part.begin(); it < part.end(); it++) {
+                           pfor_partitions(auto it = part.begin(); it < part.end(); it++) {
                    #endif
                    )cpp";
             out << "try{\n";
@@ -840,6 +1033,7 @@ void Synthesiser::emitCode(std::ostream& out, const Statement& stmt) {
             assert(0 < rel->getArity() && "AstToRamTranslator failed/no index scans for nullaries");
 
             PRINT_BEGIN_COMMENT(out);
+            countSearch(iscan, out);
             auto ctxName = "READ_OP_CONTEXT(" + synthesiser.getOpContextName(*rel) + ")";
             auto rangeBounds = getPaddedRangeBounds(*rel, rangePatternLower, rangePatternUpper);
 
@@ -865,8 +1059,8 @@ void Synthesiser::emitCode(std::ostream& out, const Statement& stmt) {
                 indexNumber = isa->getIndexSelection(estimateJoinSize.getRelation()).getLexOrderNum(keys);
             }
 
-            auto relationType =
-                    Relation::getSynthesiserRelation(*rel, isa->getIndexSelection(rel->getName()));
+            auto relationType = Relation::getSynthesiserRelation(
+                    *rel, isa->getIndexSelection(rel->getName()), synthesiser.hasNarrowStorage());
             const std::string& type = relationType->getTypeName();
             auto indexName = relName + (type == "t_eqrel" ? "->ind" : "->ind_" + std::to_string(indexNumber));
 
@@ -990,6 +1184,7 @@ void Synthesiser::emitCode(std::ostream& out, const Statement& stmt) {
             preambleIssued = true;
 
             PRINT_BEGIN_COMMENT(out);
+            countSearch(piscan, out);
             auto rangeBounds = getPaddedRangeBounds(*rel, rangePatternLower, rangePatternUpper);
             out << "auto range = " << relName
                 << "->"
@@ -1003,10 +1198,10 @@ void Synthesiser::emitCode(std::ostream& out, const Statement& stmt) {
                    #if defined _OPENMP && _OPENMP < 200805
                            auto count = std::distance(part.begin(), part.end());
                            auto base = part.begin();
-                           pfor(int index  = 0; index < count; index++) {
+                           pfor_partitions(int index  = 0; index < count; index++) {
                                auto it = base + index;
                    #else
-                           pfor(auto it = part.begin(); it < part.end(); it++) {
+                           pfor_partitions(auto it = part.begin(); it < part.end(); it++) {
                    #endif
                    )cpp";
             out << "try{\n";
@@ -1024,6 +1219,7 @@ void Synthesiser::emitCode(std::ostream& out, const Statement& stmt) {
         void visit_(
                 type_identity<IndexIfExists>, const IndexIfExists& iifexists, std::ostream& out) override {
             PRINT_BEGIN_COMMENT(out);
+            countSearch(iifexists, out);
             const auto* rel = synthesiser.lookup(iifexists.getRelation());
             auto relName = synthesiser.getRelationName(rel);
             auto identifier = iifexists.getTupleId();
@@ -1058,6 +1254,7 @@ void Synthesiser::emitCode(std::ostream& out, const Statement& stmt) {
         void visit_(type_identity<ParallelIndexIfExists>, const ParallelIndexIfExists& piifexists,
                 std::ostream& out) override {
             PRINT_BEGIN_COMMENT(out);
+            countSearch(piifexists, out);
             const auto* rel = synthesiser.lookup(piifexists.getRelation());
             auto relName = synthesiser.getRelationName(rel);
             const auto& rangePatternLower = piifexists.getRangePattern().first;
@@ -1083,10 +1280,10 @@ void Synthesiser::emitCode(std::ostream& out, const Statement& stmt) {
                    #if defined _OPENMP && _OPENMP < 200805
                            auto count = std::distance(part.begin(), part.end());
                            auto base = part.begin();
-                           pfor(int index  = 0; index < count; index++) {
+                           pfor_partitions(int index  = 0; index < count; index++) {
                                auto it = base + index;
                    #else
-                           pfor(auto it = part.begin(); it < part.end(); it++) {
+                           pfor_partitions(auto it = part.begin(); it < part.end(); it++) {
                    #endif
                    )cpp";
             out << "try{";
@@ -1108,6 +1305,104 @@ void Synthesiser::emitCode(std::ostream& out, const Statement& stmt) {
             PRINT_END_COMMENT(out);
         }
 
+        void visit_(type_identity<TrieJoin>, const TrieJoin& join, std::ostream& out) override {
+            PRINT_BEGIN_COMMENT(out);
+            out << "{\n";
+
+            // the bounds of the searches of each atom, binding its fixed columns throughout
+            std::vector<std::string> relNames;
+            std::vector<std::string> ctxNames;
+            std::vector<std::vector<analysis::SearchSignature>> signatures;
+            for (std::size_t atom = 0; atom < join.getNumAtoms(); ++atom) {
+                const auto* rel = synthesiser.lookup(join.getRelation(atom));
+                relNames.push_back(synthesiser.getRelationName(rel));
+                ctxNames.push_back("READ_OP_CONTEXT(" + synthesiser.getOpContextName(*rel) + ")");
+                signatures.push_back(isa->getSearchSignatures(&join, atom));
+                const auto values = join.getValues(atom);
+                const auto bounds = getPaddedRangeBounds(*rel, values, values);
+                const std::size_t id = join.getTupleId(atom);
+                out << "auto low" << id << " = " << bounds.first.str() << ";\n";
+                out << "auto high" << id << " = " << bounds.second.str() << ";\n";
+            }
+
+            // the seeks of each join variable: the atom, the column, and the search of the column
+            std::vector<std::vector<std::tuple<std::size_t, std::size_t, std::size_t>>> seeks(
+                    join.getNumVariables());
+            for (std::size_t atom = 0; atom < join.getNumAtoms(); ++atom) {
+                const auto columns = join.getJoinColumns(atom);
+                for (std::size_t i = 0; i < columns.size(); ++i) {
+                    seeks[join.getVariables(atom)[columns[i]]].emplace_back(atom, columns[i], i);
+                }
+            }
+
+            // enumerate the values of each variable all its atoms admit, one variable after the other
+            for (std::size_t var = 0; var < seeks.size(); ++var) {
+                out << "auto seek" << var
+                    << " = [&](std::size_t i, RamDomain value) -> std::optional<RamDomain> {\n";
+                out << "switch (i) {\n";
+                for (std::size_t i = 0; i < seeks[var].size(); ++i) {
+                    const auto [atom, column, search] = seeks[var][i];
+                    const std::size_t id = join.getTupleId(atom);
+                    out << "case " << i << ": {\n";
+                    out << "low" << id << "[" << column << "] = value;\n";
+                    out << "auto range = " << relNames[atom] << "->lowerUpperRange_"
+                        << signatures[atom][search] << "(low" << id << ",high" << id << "," << ctxNames[atom]
+                        << ");\n";
+                    out << "if (range.empty()) return std::nullopt;\n";
+                    out << "return (*range.begin())[" << column << "];\n";
+                    out << "}\n";
+                }
+                out << "}\n";
+                out << "return std::nullopt;\n";
+                out << "};\n";
+
+                const std::string x = "x" + std::to_string(var);
+                const std::string count = std::to_string(seeks[var].size());
+                out << "for (auto " << x << " = souffle::evaluator::leapfrogSeek(MIN_RAM_SIGNED," << count
+                    << ",seek" << var << "); " << x << "; " << x << " = *" << x << " == MAX_RAM_SIGNED ? "
+                    << "std::nullopt : souffle::evaluator::leapfrogSeek(*" << x << " + 1," << count << ",seek"
+                    << var << ")) {\n";
+                for (const auto& [atom, column, search] : seeks[var]) {
+                    const std::size_t id = join.getTupleId(atom);
+                    out << "low" << id << "[" << column << "] = high" << id << "[" << column << "] = *" << x
+                        << ";\n";
+                }
+            }
+
+            // enumerate the tuples of the atoms once all variables are bound
+            for (std::size_t atom = 0; atom < join.getNumAtoms(); ++atom) {
+                const std::size_t id = join.getTupleId(atom);
+                out << "for(const auto& env" << id << " : " << relNames[atom] << "->lowerUpperRange_"
+                    << signatures[atom].back() << "(low" << id << ",high" << id << "," << ctxNames[atom]
+                    << ")) {\n";
+                out << "if( ";
+                dispatch(join.getCondition(atom), out);
+                out << ") {\n";
+            }
+            visit_(type_identity<NestedOperation>(), join, out);
+            for (std::size_t atom = join.getNumAtoms(); atom-- > 0;) {
+                if (join.isExistential(atom)) {
+                    out << "break;\n";
+                }
+                out << "}\n";
+                out << "}\n";
+            }
+
+            // leave the columns of each variable unbounded for the next binding of the variables before
+            for (std::size_t var = seeks.size(); var-- > 0;) {
+                for (const auto& [atom, column, search] : seeks[var]) {
+                    out << "high" << join.getTupleId(atom) << "[" << column << "] = MAX_RAM_SIGNED;\n";
+                }
+                out << "}\n";
+                for (const auto& [atom, column, search] : seeks[var]) {
+                    out << "low" << join.getTupleId(atom) << "[" << column << "] = MIN_RAM_SIGNED;\n";
+                }
+            }
+
+            out << "}\n";
+            PRINT_END_COMMENT(out);
+        }
+
         void visit_(type_identity<UnpackRecord>, const UnpackRecord& unpack, std::ostream& out) override {
             PRINT_BEGIN_COMMENT(out);
             auto arity = unpack.getArity();
@@ -1288,6 +1583,7 @@ void Synthesiser::emitCode(std::ostream& out, const Statement& stmt) {
             assert(!preambleIssued && "only first loop can be made parallel");
             preambleIssued = true;
             PRINT_BEGIN_COMMENT(out);
+            countSearch(aggregate, out);
             // get some properties
             const auto* rel = synthesiser.lookup(aggregate.getRelation());
             auto arity = rel->getArity();
@@ -1321,6 +1617,23 @@ void Synthesiser::emitCode(std::ostream& out, const Statement& stmt) {
                 return;
             }
 
+            // special case: counting the elements of a range of a B-tree index
+            std::string index = isCount && !keys.empty() && isTrue(&aggregate.getCondition())
+                                        ? getDirectIndex(*rel, keys)
+                                        : "";
+            if (!index.empty()) {
+                auto rangeBounds = getPaddedRangeBounds(
+                        *rel, aggregate.getRangePattern().first, aggregate.getRangePattern().second);
+                out << "env" << identifier << "[0] = countRange(" << index << "," << relName << "->"
+                    << "lowerUpperRange_" << keys << "(" << rangeBounds.first.str() << ","
+                    << rangeBounds.second.str() << "," << ctxName << "));\n";
+                out << "{\n";  // to match PARALLEL_END closing bracket
+                out << preamble.str();
+                visit_(type_identity<TupleOperation>(), aggregate, out);
+                PRINT_END_COMMENT(out);
+                return;
+            }
+
             // init result and reduction operation
             std::string init = initValue(aggregator);
             out << "bool shouldRunNested = " << (shouldRunNested(aggregator) ? "true" : "false") << ";\n";
@@ -1442,12 +1755,29 @@ void Synthesiser::emitCode(std::ostream& out, const Statement& stmt) {
             const auto* tupleElem = as<TupleElement>(aggregate.getExpression());
             return tupleElem && tupleElem->getTupleId() == identifier &&
                    keys[tupleElem->getElement()] != ram::analysis::AttributeConstraint::None &&
-                   (repr == RelationRepresentation::BTREE || repr == RelationRepresentation::DEFAULT);
+                   (repr == RelationRepresentation::BTREE || repr == RelationRepresentation::DEFAULT ||
+                           repr == RelationRepresentation::BTREE_COMPRESSED);
+        }
+
+        /**
+         * Returns the B-tree index of a direct relation answering range queries with the given
+         * signature, or an empty string if the relation is not stored in such indexes.
+         */
+        std::string getDirectIndex(const ram::Relation& rel, const ram::analysis::SearchSignature& keys) {
+            const auto& indexSelection = isa->getIndexSelection(rel.getName());
+            auto relationType =
+                    Relation::getSynthesiserRelation(rel, indexSelection, synthesiser.hasNarrowStorage());
+            if (!isA<DirectRelation>(*relationType)) {
+                return "";
+            }
+            return synthesiser.getRelationName(&rel) + "->ind_" +
+                   std::to_string(indexSelection.getLexOrderNum(keys));
         }
 
         void visit_(
                 type_identity<IndexAggregate>, const IndexAggregate& aggregate, std::ostream& out) override {
             PRINT_BEGIN_COMMENT(out);
+            countSearch(aggregate, out);
             // get some properties
             const auto* rel = synthesiser.lookup(aggregate.getRelation());
             auto arity = rel->getArity();
@@ -1479,6 +1809,21 @@ void Synthesiser::emitCode(std::ostream& out, const Statement& stmt) {
                 return;
             }
 
+            // special case: counting the elements of a range of a B-tree index
+            std::string index = isCount && !keys.empty() && isTrue(&aggregate.getCondition())
+                                        ? getDirectIndex(*rel, keys)
+                                        : "";
+            if (!index.empty()) {
+                auto rangeBounds = getPaddedRangeBounds(
+                        *rel, aggregate.getRangePattern().first, aggregate.getRangePattern().second);
+                out << "env" << identifier << "[0] = countRange(" << index << "," << relName << "->"
+                    << "lowerUpperRange_" << keys << "(" << rangeBounds.first.str() << ","
+                    << rangeBounds.second.str() << "," << ctxName << "));\n";
+                visit_(type_identity<TupleOperation>(), aggregate, out);
+                PRINT_END_COMMENT(out);
+                return;
+            }
+
             // init result
             std::string init = initValue(aggregator);
             out << "bool shouldRunNested = " << (shouldRunNested(aggregator) ? "true" : "false") << ";\n";
@@ -2516,6 +2861,11 @@ std::set<std::string> Synthesiser::accessedRelations(Statement& stmt) {
     std::set<std::string> accessed;
     visit(stmt, [&](const Insert& node) { accessed.insert(node.getRelation()); });
     visit(stmt, [&](const RelationOperation& node) { accessed.insert(node.getRelation()); });
+    visit(stmt, [&](const TrieJoin& node) {
+        for (std::size_t atom = 0; atom < node.getNumAtoms(); ++atom) {
+            accessed.insert(node.getRelation(atom));
+        }
+    });
     visit(stmt, [&](const RelationStatement& node) { accessed.insert(node.getRelation()); });
     visit(stmt, [&](const AbstractExistenceCheck& node) { accessed.insert(node.getRelation()); });
     visit(stmt, [&](const EmptinessCheck& node) { accessed.insert(node.getRelation()); });
@@ -2524,6 +2874,11 @@ std::set<std::string> Synthesiser::accessedRelations(Statement& stmt) {
         accessed.insert(node.getFirstRelation());
         accessed.insert(node.getSecondRelation());
     });
+    visit(stmt, [&](const MergeLattice& node) {
+        if (!node.getDeltaRelation().empty()) {
+            accessed.insert(node.getDeltaRelation());
+        }
+    });
     return accessed;
 }
 
@@ -2574,6 +2929,10 @@ void Synthesiser::generateCode(GenDb& db, const std::string& id, bool& withShare
         db.addGlobalInclude("\"souffle/provenance/Explain.h\"");
     }
 
+    if (glb.config().has("query-server")) {
+        db.addGlobalInclude("\"souffle/QueryServer.h\"");
+    }
+
     if (glb.config().has("live-profile")) {
         db.addGlobalInclude("<thread>");
         db.addGlobalInclude("\"souffle/profile/Tui.h\"");
@@ -2678,8 +3037,8 @@ void Synthesiser::generateCode(GenDb& db, const std::string& id, bool& withShare
 
     // synthesise data-structures for relations
     for (auto rel : prog.getRelations()) {
-        auto relationType =
-                Relation::getSynthesiserRelation(*rel, idxAnalysis.getIndexSelection(rel->getName()));
+        auto relationType = Relation::getSynthesiserRelation(
+                *rel, idxAnalysis.getIndexSelection(rel->getName()), hasNarrowStorage());
 
         std::string typeName = relationType->getTypeName();
         generateRelationTypeStruct(db, std::move(relationType));
@@ -2702,6 +3061,8 @@ void Synthesiser::generateCode(GenDb& db, const std::string& id, bool& withShare
         } else if (op == "printsize" || op == "output") {
             storeRelations.insert(io.getRelation());
             storeIOs.insert(&io);
+        } else if (op == "spill" || op == "restore") {
+            // spilled relations are neither loaded nor stored
         } else {
             assert("wrong I/O operation");
         }
@@ -2888,6 +3249,11 @@ void Synthesiser::generateCode(GenDb& db, const std::string& id, bool& withShare
         }
         mainClass.addField("std::size_t", "reads[" + std::to_string(numRead) + "]", Visibility::Private);
         constructor.setNextInitializer("reads", "");
+        std::size_t numSearches = 0;
+        visit(prog, [&](const IndexOperation&) { numSearches++; });
+        mainClass.addField(
+                "std::size_t", "searches[" + std::to_string(numSearches) + "]", Visibility::Private);
+        constructor.setNextInitializer("searches", "");
     }
 
     for (const auto& f : functors) {
@@ -2901,8 +3267,8 @@ void Synthesiser::generateCode(GenDb& db, const std::string& id, bool& withShare
         const std::string& datalogName = rel->getName();
         const std::string& cppName = getRelationName(*rel);
 
-        auto relationType =
-                Relation::getSynthesiserRelation(*rel, idxAnalysis.getIndexSelection(datalogName));
+        auto relationType = Relation::getSynthesiserRelation(
+                *rel, idxAnalysis.getIndexSelection(datalogName), hasNarrowStorage());
         const std::string& type = relationType->getTypeName();
 
         // defining table
@@ -2985,6 +3351,8 @@ void Synthesiser::generateCode(GenDb& db, const std::string& id, bool& withShare
 
     signalHandler->set();
 )_";
+    runFunction.body() << "souffle::setNumaPlacement(" << (glb.config().has("numa") ? "true" : "false")
+                       << ");\n";
     if (glb.config().has("verbose")) {
         runFunction.body() << "signalHandler->enableLogging();\n";
     }
@@ -3208,6 +3576,30 @@ void Synthesiser::generateCode(GenDb& db, const std::string& id, bool& withShare
                              << raw_str("@relation-reads;" + cur.first) << ", reads[" << cur.second
                              << "],0);\n";
         }
+        for (auto const& cur : searchIdxMap) {
+            dumpFreqs.body() << "  ProfileEventSingleton::instance().makeQuantityEvent("
+                             << raw_str("@index-searches;" + cur.first) << ", searches[" << cur.second
+                             << "],0);\n";
+        }
+
+        // memory snapshot taken at the end of each stratum
+        GenFunction& dumpMemoryUsage = mainClass.addFunction("dumpMemoryUsage", Visibility::Private);
+        dumpMemoryUsage.setRetType("void");
+        dumpMemoryUsage.setNextArg("const std::string&", "stratum");
+        dumpMemoryUsage.body()
+                << "const std::string prefix = \"@memory;\" + stratum + \";\";\n"
+                << "const auto snapshot = now();\n"
+                << "for (souffle::Relation* rel : getAllRelations()) {\n"
+                << "  const auto usage = rel->getIndexMemoryUsage();\n"
+                << "  for (std::size_t i = 0; i < usage.size(); ++i) {\n"
+                << "    ProfileEventSingleton::instance().makeMemoryEvent(prefix + \"relation;\" + "
+                   "rel->getName() + \";\" + std::to_string(i), snapshot, usage[i]);\n"
+                << "  }\n"
+                << "}\n"
+                << "ProfileEventSingleton::instance().makeMemoryEvent(prefix + \"symbol-table\", snapshot, "
+                   "symTable.getMemoryUsage());\n"
+                << "ProfileEventSingleton::instance().makeMemoryEvent(prefix + \"record-table\", snapshot, "
+                   "recordTable.getMemoryUsage());\n";
     }
 
     GenClass& factory = db.getClass("factory_" + classname, fs::path("factory_" + classname));
@@ -3237,6 +3629,9 @@ void Synthesiser::generateCode(GenDb& db, const std::string& id, bool& withShare
     factory_hook << "extern \"C\" {\n";
     factory_hook << db.getNS(false) << "::factory_" << classname << " __factory_" << classname
                  << "_instance;\n";
+    // unmangled entry point for loading the program as a shared library
+    factory_hook << "souffle::SouffleProgram* __new_" << classname << "() { return new " << db.getNS()
+                 << "::" << classname << "(); }\n";
     factory_hook << "}\n";
     factory_hook << "#endif\n";
     factory_hook << "} // namespace souffle\n";
@@ -3296,6 +3691,9 @@ void Synthesiser::generateCode(GenDb& db, const std::string& id, bool& withShare
     } else if (glb.config().get("provenance") == "explore") {
         hook << "explain(obj, true);\n";
     }
+    if (glb.config().has("query-server")) {
+        hook << "souffle::serveQueries(obj, " << raw_str(glb.config().get("query-server")) << ");\n";
+    }
     hook << "return 0;\n";
     hook << "} catch(std::exception &e) { souffle::SignalHandler::instance()->error(e.what());}\n";
     hook << "}\n";
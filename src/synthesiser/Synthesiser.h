@@ -57,6 +57,9 @@ private:
     /** Frequency profiling of non-existence checks */
     std::map<std::string, std::size_t> neIdxMap;
 
+    /** Frequency profiling of index searches, keyed by relation and search signature */
+    std::map<std::string, std::size_t> searchIdxMap;
+
     /** Cache for generated types for relations */
     std::set<std::string> typeCache;
 
@@ -126,6 +129,9 @@ protected:
     /** Lookup read counter */
     std::size_t lookupReadIdx(const std::string& txt);
 
+    /** Lookup index search counter */
+    std::size_t lookupSearchIdx(const std::string& txt);
+
     /** Lookup relation by relation name */
     const ram::Relation* lookup(const std::string& relName) {
         auto it = relationMap.find(relName);
@@ -133,6 +139,11 @@ protected:
         return it->second;
     }
 
+    /** Whether b-tree relations may store identifiers in 32-bit slots */
+    bool hasNarrowStorage() const {
+        return !glb.config().has("no-narrow-storage");
+    }
+
     /** Lookup symbol index */
     RamUnsigned convertSymbol2Idx(const std::string& symbol) const {
         auto it = symbolMap.find(symbol);
@@ -94,6 +94,15 @@ TEST(EqRelTest, Clear) {
     EXPECT_EQ(count, br.size());
 }
 
+TEST(EqRelTest, MemoryUsage) {
+    EqRel br;
+    const std::size_t empty = br.getMemoryUsage();
+    for (RamDomain i = 0; i < 1000; ++i) {
+        br.insert(i, i + 1);
+    }
+    EXPECT_TRUE(br.getMemoryUsage() > empty);
+}
+
 TEST(EqRelTest, Duplicates) {
     EqRel br;
     // test inserting same pair
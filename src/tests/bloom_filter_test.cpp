@@ -0,0 +1,94 @@
+/*
+ * Souffle - A Datalog Compiler
+ * Copyright (c) 2026, The Souffle Developers. All rights reserved
+ * Licensed under the Universal Permissive License v 1.0 as shown at:
+ * - https://opensource.org/licenses/UPL
+ * - <souffle root>/licenses/SOUFFLE-UPL.txt
+ */
+
+/************************************************************************
+ *
+ * @file bloom_filter_test.cpp
+ *
+ * Test the Bloom filters guarding the searches of relations.
+ *
+ ***********************************************************************/
+
+#include "tests/test.h"
+
+#include "souffle/RamTypes.h"
+#include "souffle/datastructure/BloomFilter.h"
+#include <cstddef>
+
+namespace souffle::test {
+
+TEST(BloomFilter, Hash) {
+    EXPECT_EQ(BloomFilter::seed, BloomFilter::hash());
+    EXPECT_EQ(BloomFilter::mix(BloomFilter::seed, 3), BloomFilter::hash(3));
+    EXPECT_EQ(BloomFilter::hash(1, 2), BloomFilter::hash(1, 2));
+    EXPECT_NE(BloomFilter::hash(1, 2), BloomFilter::hash(2, 1));
+    EXPECT_NE(BloomFilter::hash(0), BloomFilter::hash(0, 0));
+}
+
+TEST(BloomFilter, Insert) {
+    BloomFilter filter;
+    for (RamDomain i = 0; i < 10; ++i) {
+        EXPECT_FALSE(filter.mayContain(BloomFilter::hash(i)));
+    }
+
+    // no false negatives while the filter grows by several levels
+    const RamDomain n = 200000;
+    for (RamDomain i = 0; i < n; ++i) {
+        filter.insert(BloomFilter::hash(i, -i));
+    }
+    std::size_t missing = 0;
+    for (RamDomain i = 0; i < n; ++i) {
+        missing += filter.mayContain(BloomFilter::hash(i, -i)) ? 0 : 1;
+    }
+    EXPECT_EQ(0, missing);
+
+    // a small fraction of the absent values passes
+    std::size_t positives = 0;
+    for (RamDomain i = 0; i < n; ++i) {
+        positives += filter.mayContain(BloomFilter::hash(i, i + 1)) ? 1 : 0;
+    }
+    EXPECT_TRUE(positives < n / 50);
+
+    // memory grows with the number of values
+    EXPECT_TRUE(filter.getMemoryUsage() > n);
+    EXPECT_TRUE(filter.getMemoryUsage() < n * 16);
+
+    filter.clear();
+    EXPECT_FALSE(filter.mayContain(BloomFilter::hash(1, -1)));
+    EXPECT_TRUE(filter.getMemoryUsage() < 1000);
+}
+
+TEST(BloomFilter, Swap) {
+    BloomFilter a;
+    BloomFilter b;
+    a.insert(BloomFilter::hash(1));
+    b.insert(BloomFilter::hash(2));
+    a.swap(b);
+    EXPECT_TRUE(a.mayContain(BloomFilter::hash(2)));
+    EXPECT_TRUE(b.mayContain(BloomFilter::hash(1)));
+}
+
+TEST(BloomFilter, ParallelInsert) {
+    BloomFilter filter;
+    const int n = 400000;
+#pragma omp parallel for
+    for (int i = 0; i < n; ++i) {
+        filter.insert(BloomFilter::hash(i));
+    }
+
+    std::size_t missing = 0;
+    std::size_t positives = 0;
+    for (int i = 0; i < n; ++i) {
+        missing += filter.mayContain(BloomFilter::hash(i)) ? 0 : 1;
+        positives += filter.mayContain(BloomFilter::hash(n + i)) ? 1 : 0;
+    }
+    EXPECT_EQ(0, missing);
+    EXPECT_TRUE(positives < n / 50);
+}
+
+}  // namespace souffle::test
@@ -0,0 +1,121 @@
+/*
+ * Souffle - A Datalog Compiler
+ * Copyright (c) 2026, The Souffle Developers. All rights reserved
+ * Licensed under the Universal Permissive License v 1.0 as shown at:
+ * - https://opensource.org/licenses/UPL
+ * - <souffle root>/licenses/SOUFFLE-UPL.txt
+ */
+
+/************************************************************************
+ *
+ * @file btree_delete_test.cpp
+ *
+ * A test case testing the erasure of keys from B-trees supporting deletion.
+ *
+ ***********************************************************************/
+
+#include "tests/test.h"
+
+#include "souffle/datastructure/BTreeDelete.h"
+#include <algorithm>
+#include <random>
+#include <set>
+#include <vector>
+
+namespace souffle::test {
+
+using test_set = btree_delete_set<int, detail::comparator<int>, std::allocator<int>, 16>;
+
+TEST(BTreeDeleteSet, Erase) {
+    const int N = 10000;
+    test_set t;
+    for (int i = 0; i < N; i++) {
+        t.insert(i);
+    }
+    EXPECT_EQ(N, t.size());
+
+    // erase all odd keys
+    for (int i = 1; i < N; i += 2) {
+        EXPECT_EQ(1, t.erase(i));
+    }
+    EXPECT_EQ(0, t.erase(1));
+    EXPECT_EQ(N / 2, t.size());
+    EXPECT_TRUE(t.check());
+    for (int i = 0; i < N; i++) {
+        EXPECT_EQ(i % 2 == 0, t.contains(i));
+    }
+
+    // erase the remaining keys
+    for (int i = 0; i < N; i += 2) {
+        EXPECT_EQ(1, t.erase(i));
+    }
+    EXPECT_TRUE(t.empty());
+}
+
+TEST(BTreeDeleteSet, EraseBatch) {
+    const int N = 10000;
+    std::vector<int> keys;
+    test_set t;
+    for (int i = 0; i < N; i++) {
+        t.insert(i);
+        if (i % 3 != 0) {
+            keys.push_back(i);
+        }
+    }
+    // keys not contained in the set are not counted
+    keys.push_back(N);
+
+    std::mt19937 generator(42);
+    std::shuffle(keys.begin(), keys.end(), generator);
+    EXPECT_EQ(keys.size() - 1, t.erase(keys.begin(), keys.end()));
+    EXPECT_TRUE(t.check());
+
+    std::set<int> is(t.begin(), t.end());
+    std::set<int> should;
+    for (int i = 0; i < N; i += 3) {
+        should.insert(i);
+    }
+    EXPECT_EQ(should, is);
+}
+
+TEST(BTreeDeleteSet, ParallelErase) {
+    const int N = 100000;
+    std::vector<int> keys;
+    test_set t;
+    for (int i = 0; i < N; i++) {
+        t.insert(i);
+        if (i % 4 != 0) {
+            keys.push_back(i);
+        }
+    }
+    std::mt19937 generator(42);
+    std::shuffle(keys.begin(), keys.end(), generator);
+
+    // every thread erases a batch of keys and single keys
+    const int batch = static_cast<int>(keys.size()) / 2;
+    std::size_t erased = 0;
+#ifdef _OPENMP
+#pragma omp parallel for reduction(+ : erased)
+#endif
+    for (int idx = 0; idx < static_cast<int>(keys.size()); idx += 100) {
+        const int end = std::min(idx + 100, static_cast<int>(keys.size()));
+        if (idx < batch) {
+            erased += t.erase(keys.begin() + idx, keys.begin() + end);
+        } else {
+            for (int i = idx; i < end; ++i) {
+                erased += t.erase(keys[i]);
+            }
+        }
+    }
+    EXPECT_EQ(keys.size(), erased);
+    EXPECT_TRUE(t.check());
+
+    std::set<int> is(t.begin(), t.end());
+    std::set<int> should;
+    for (int i = 0; i < N; i += 4) {
+        should.insert(i);
+    }
+    EXPECT_EQ(should, is);
+}
+
+}  // namespace souffle::test
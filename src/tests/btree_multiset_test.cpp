@@ -382,6 +382,23 @@ TEST(BTreeMultiSet, Clear) {
     EXPECT_TRUE(t.empty());
 }
 
+TEST(BTreeMultiSet, Rank) {
+    using test_set = btree_multiset<int, detail::comparator<int>, std::allocator<int>, 16>;
+
+    test_set t;
+    for (int i = 0; i < 100; i++) {
+        for (int j = 0; j < 10; j++) {
+            t.insert(i);
+        }
+    }
+
+    // duplicates are counted individually
+    EXPECT_EQ(1000, t.rank(t.end()));
+    EXPECT_EQ(10, t.distance(t.lower_bound(42), t.upper_bound(42)));
+    EXPECT_EQ(420, t.rank(t.lower_bound(42)));
+    EXPECT_EQ(0, t.distance(t.lower_bound(200), t.end()));
+}
+
 using Entry = std::tuple<int, int64_t>;
 
 std::vector<Entry> getData(unsigned numEntries) {
@@ -20,7 +20,9 @@
 #include "souffle/utility/ContainerUtil.h"
 #include "souffle/utility/StreamUtil.h"
 #include <algorithm>
+#include <array>
 #include <chrono>
+#include <cstdint>
 #include <cstdlib>
 #include <functional>
 #include <iomanip>
@@ -30,7 +32,9 @@
 #include <set>
 #include <string>
 #include <system_error>
+#include <thread>
 #include <tuple>
+#include <type_traits>
 #include <unordered_set>
 #include <vector>
 #ifdef _OPENMP
@@ -484,6 +488,52 @@ TEST(BTreeSet, Load) {
     }
 }
 
+TEST(BTreeSet, Rank) {
+    using test_set = btree_set<int, detail::comparator<int>, std::allocator<int>, 16>;
+
+    std::vector<int> data;
+    for (int i = 0; i < 1000; i++) {
+        data.push_back(2 * i);
+    }
+    std::random_device rd;
+    std::mt19937 generator(rd());
+    shuffle(data.begin(), data.end(), generator);
+
+    test_set t;
+    EXPECT_EQ(0, t.rank(t.end()));
+    for (int x : data) {
+        t.insert(x);
+    }
+
+    // every position is preceded by the elements smaller than it
+    std::size_t expected = 0;
+    for (auto it = t.begin(); it != t.end(); ++it) {
+        EXPECT_EQ(expected, t.rank(it));
+        ++expected;
+    }
+    EXPECT_EQ(1000, t.rank(t.end()));
+    EXPECT_EQ(1000, t.size());
+    EXPECT_EQ(50, t.distance(t.lower_bound(100), t.lower_bound(200)));
+    EXPECT_EQ(49, t.distance(t.lower_bound(101), t.upper_bound(199)));
+
+    // insertions invalidate the cached counts
+    for (int i = 0; i < 100; i++) {
+        t.insert(2 * i + 1);
+    }
+    EXPECT_EQ(1100, t.size());
+    EXPECT_EQ(100, t.distance(t.lower_bound(100), t.lower_bound(200)));
+    EXPECT_EQ(1100, t.rank(t.end()));
+
+    // bulk-loaded trees are counted as well
+    std::sort(data.begin(), data.end());
+    auto loaded = test_set::load(data.begin(), data.end());
+    EXPECT_EQ(500, loaded.rank(loaded.find(1000)));
+
+    t.clear();
+    EXPECT_EQ(0, t.rank(t.end()));
+    EXPECT_EQ(0, t.size());
+}
+
 TEST(BTreeSet, Clear) {
     using test_set = btree_set<int, detail::comparator<int>, std::allocator<int>, 16>;
 
@@ -576,6 +626,129 @@ TEST(BTreeSet, ChunkSplitStress) {
     }
 }
 
+TEST(BTreeSet, InsertSorted) {
+    using test_set = btree_set<int, detail::comparator<int>, std::allocator<int>, 16>;
+
+    // small ranges are inserted one by one, large ranges are merged into a new tree
+    for (int existing : {0, 10, 1000}) {
+        for (int added : {1, 10, 1000, 5000}) {
+            test_set t;
+            std::set<int> expected;
+            for (int i = 0; i < existing; ++i) {
+                t.insert(3 * i);
+                expected.insert(3 * i);
+            }
+            std::vector<int> range;
+            for (int i = 0; i < added; ++i) {
+                range.push_back(2 * i);
+                range.push_back(2 * i);
+            }
+
+            std::vector<int> inserted;
+            t.insertSorted(range.begin(), range.end(), [&](int x) { inserted.push_back(x); });
+
+            std::vector<int> expectedInserted;
+            for (int x : range) {
+                if (expected.insert(x).second) {
+                    expectedInserted.push_back(x);
+                }
+            }
+            EXPECT_TRUE(t.check());
+            EXPECT_EQ(expected.size(), t.size());
+            EXPECT_TRUE(std::equal(t.begin(), t.end(), expected.begin(), expected.end()));
+            EXPECT_EQ(expectedInserted, inserted);
+
+            // the tree still supports insertions
+            t.insert(-1);
+            EXPECT_TRUE(t.contains(-1));
+            EXPECT_EQ(-1, *t.begin());
+        }
+    }
+}
+
+namespace {
+
+/** Orders arrays by their second, first and third column; searchable by the SIMD strategy */
+template <typename T>
+struct second_column_comparator {
+    static constexpr std::size_t leading_column = 1;
+
+    int operator()(const T& a, const T& b) const {
+        for (std::size_t i : {1, 0, 2}) {
+            if (a[i] != b[i]) {
+                return a[i] < b[i] ? -1 : 1;
+            }
+        }
+        return 0;
+    }
+    bool less(const T& a, const T& b) const {
+        return (*this)(a, b) < 0;
+    }
+    bool equal(const T& a, const T& b) const {
+        return (*this)(a, b) == 0;
+    }
+};
+
+}  // namespace
+
+TEMPLATE_TEST(BTreeSet, SimdSearch, typename T, T) {
+    using key = std::array<T, 3>;
+    second_column_comparator<key> comp;
+    std::mt19937 generator(42);
+    std::uniform_int_distribution<int> dist(-20, 20);
+    auto random_key = [&]() { return key{{T(dist(generator)), T(dist(generator) / 4), T(dist(generator))}}; };
+
+    for (std::size_t n : {0, 1, 3, 4, 7, 8, 9, 17, 33, 100}) {
+        std::vector<key> keys;
+        for (std::size_t i = 0; i < n; ++i) {
+            keys.push_back(random_key());
+        }
+        std::sort(keys.begin(), keys.end(), [&](const key& a, const key& b) { return comp.less(a, b); });
+        const key* a = keys.data();
+        const key* b = keys.data() + keys.size();
+
+        for (int i = 0; i < 200; ++i) {
+            const key k = i % 2 == 0 || n == 0 ? random_key() : keys[i % n];
+            EXPECT_EQ(detail::binary_search().lower_bound(k, a, b, comp),
+                    detail::simd_search().lower_bound(k, a, b, comp));
+            EXPECT_EQ(detail::binary_search().upper_bound(k, a, b, comp),
+                    detail::simd_search().upper_bound(k, a, b, comp));
+            auto pos = detail::simd_search()(k, a, b, comp);
+            if (std::binary_search(a, b, k, [&](const key& x, const key& y) { return comp.less(x, y); })) {
+                EXPECT_TRUE(pos != b && comp.equal(*pos, k));
+            } else {
+                EXPECT_EQ(detail::binary_search().lower_bound(k, a, b, comp), pos);
+            }
+        }
+    }
+
+    // the search strategy is selected by default for such keys
+    using test_set = btree_set<key, second_column_comparator<key>>;
+    static_assert(std::is_same_v<typename detail::default_strategy<key>::type, detail::simd_search>);
+    test_set t;
+    std::set<key, std::function<bool(const key&, const key&)>> expected(
+            [&](const key& x, const key& y) { return comp.less(x, y); });
+    for (int i = 0; i < 5000; ++i) {
+        const key k = random_key();
+        EXPECT_EQ(expected.insert(k).second, t.insert(k));
+    }
+    EXPECT_EQ(expected.size(), t.size());
+    EXPECT_TRUE(std::equal(t.begin(), t.end(), expected.begin(), expected.end()));
+    for (int i = 0; i < 1000; ++i) {
+        const key k = random_key();
+        EXPECT_EQ(expected.count(k) > 0, t.contains(k));
+        auto lower = t.lower_bound(k);
+        auto expectedLower = expected.lower_bound(k);
+        EXPECT_EQ(expectedLower == expected.end(), lower == t.end());
+        if (lower != t.end() && expectedLower != expected.end()) {
+            EXPECT_TRUE(comp.equal(*expectedLower, *lower));
+        }
+    }
+}
+
+INSTANTIATE_TEMPLATE_TEST(BTreeSet, SimdSearch, int32_t);
+INSTANTIATE_TEMPLATE_TEST(BTreeSet, SimdSearch, int64_t);
+
 using Entry = std::tuple<int, int64_t>;
 
 std::vector<Entry> getData(unsigned numEntries) {
@@ -867,5 +1040,49 @@ TEST(BTreeSet, ParallelScaling) {
     }
 }
 
+TEST(BTreeSet, ParallelRank) {
+    using test_set = btree_set<int>;
+    using op_context_type = test_set::operation_hints;
+
+    const int N = 100000;
+    const int numInserters = 3;
+    std::vector<int> data;
+    for (int i = 0; i < N; i++) {
+        data.push_back(i);
+    }
+    std::random_device rd;
+    std::mt19937 generator(rd());
+    std::shuffle(data.begin(), data.end(), generator);
+
+    // ranks requested while inserting cache counts that must not outlive the insertions
+    test_set t;
+    std::atomic<int> inserting{numInserters};
+    std::size_t maxRank = 0;
+    std::thread ranker([&]() {
+        while (inserting.load() > 0) {
+            maxRank = std::max(maxRank, t.rank(t.end()));
+        }
+    });
+    std::vector<std::thread> inserters;
+    for (int k = 0; k < numInserters; k++) {
+        inserters.emplace_back([&, k]() {
+            op_context_type ctxt;
+            for (int i = k; i < N; i += numInserters) {
+                t.insert(data[i], ctxt);
+            }
+            inserting--;
+        });
+    }
+    for (auto& inserter : inserters) {
+        inserter.join();
+    }
+    ranker.join();
+
+    EXPECT_TRUE(maxRank <= N);
+    EXPECT_EQ(N, t.size());
+    EXPECT_EQ(N, t.rank(t.end()));
+    EXPECT_EQ(N / 2, t.rank(t.find(N / 2)));
+}
+
 #endif
 }  // namespace souffle::test
@@ -0,0 +1,223 @@
+/*
+ * Souffle - A Datalog Compiler
+ * Copyright (c) 2026, The Souffle Developers. All rights reserved
+ * Licensed under the Universal Permissive License v 1.0 as shown at:
+ * - https://opensource.org/licenses/UPL
+ * - <souffle root>/licenses/SOUFFLE-UPL.txt
+ */
+
+/************************************************************************
+ *
+ * @file compressed_btree_test.cpp
+ *
+ * Test the b-tree with delta-encoded leaves.
+ *
+ ***********************************************************************/
+
+#include "tests/test.h"
+
+#include "souffle/RamTypes.h"
+#include "souffle/datastructure/CompressedBTree.h"
+#include "souffle/utility/ParallelUtil.h"
+#include <algorithm>
+#include <cstddef>
+#include <initializer_list>
+#include <iterator>
+#include <limits>
+#include <random>
+#include <set>
+#include <vector>
+
+namespace souffle::test {
+
+using tuple_t = Tuple<RamDomain, 3>;
+
+namespace {
+
+// orders tuples by their first column only
+struct first_column_comparator {
+    int operator()(const tuple_t& a, const tuple_t& b) const {
+        return (a[0] < b[0]) ? -1 : (a[0] > b[0]) ? 1 : 0;
+    }
+    bool less(const tuple_t& a, const tuple_t& b) const {
+        return a[0] < b[0];
+    }
+    bool equal(const tuple_t& a, const tuple_t& b) const {
+        return a[0] == b[0];
+    }
+};
+
+std::vector<tuple_t> contents(const compressed_btree_set<tuple_t>& set) {
+    return std::vector<tuple_t>(set.begin(), set.end());
+}
+
+}  // namespace
+
+TEST(CompressedBTreeSet, Basic) {
+    compressed_btree_set<tuple_t> set;
+    EXPECT_TRUE(set.empty());
+    EXPECT_TRUE(set.begin() == set.end());
+
+    EXPECT_TRUE(set.insert(tuple_t{{1, 2, 3}}));
+    EXPECT_TRUE(set.insert(tuple_t{{1, 2, -4}}));
+    EXPECT_FALSE(set.insert(tuple_t{{1, 2, 3}}));
+    EXPECT_EQ(2, set.size());
+
+    set.compact();
+    EXPECT_FALSE(set.hasStaged());
+    EXPECT_EQ(2, set.size());
+    EXPECT_FALSE(set.insert(tuple_t{{1, 2, 3}}));
+    EXPECT_TRUE(set.insert(tuple_t{{0, 0, 0}}));
+    EXPECT_TRUE(set.hasStaged());
+    EXPECT_EQ(3, set.size());
+
+    std::vector<tuple_t> expected = {tuple_t{{0, 0, 0}}, tuple_t{{1, 2, -4}}, tuple_t{{1, 2, 3}}};
+    EXPECT_EQ(expected, contents(set));
+    EXPECT_TRUE(set.contains(tuple_t{{1, 2, -4}}));
+    EXPECT_TRUE(set.contains(tuple_t{{0, 0, 0}}));
+    EXPECT_FALSE(set.contains(tuple_t{{1, 2, 0}}));
+    EXPECT_TRUE(set.find(tuple_t{{1, 2, 0}}) == set.end());
+    EXPECT_TRUE(*set.find(tuple_t{{1, 2, 3}}) == (tuple_t{{1, 2, 3}}));
+
+    set.clear();
+    EXPECT_TRUE(set.empty());
+    EXPECT_FALSE(set.contains(tuple_t{{1, 2, 3}}));
+}
+
+TEST(CompressedBTreeSet, Extremes) {
+    // deltas between the extreme values overflow the column type
+    const RamDomain lo = std::numeric_limits<RamDomain>::min();
+    const RamDomain hi = std::numeric_limits<RamDomain>::max();
+    compressed_btree_set<tuple_t> set;
+    std::set<tuple_t> reference;
+    for (RamDomain a : std::initializer_list<RamDomain>{lo, -1, 0, 1, hi}) {
+        for (RamDomain b : std::initializer_list<RamDomain>{lo, 0, hi}) {
+            for (RamDomain c : std::initializer_list<RamDomain>{lo, -7, 7, hi}) {
+                set.insert(tuple_t{{a, b, c}});
+                reference.insert(tuple_t{{a, b, c}});
+            }
+        }
+    }
+    set.compact();
+    EXPECT_EQ(std::vector<tuple_t>(reference.begin(), reference.end()), contents(set));
+}
+
+TEST(CompressedBTreeSet, Random) {
+    std::mt19937 gen(3);
+    std::uniform_int_distribution<RamDomain> dist(-50, 50);
+    compressed_btree_set<tuple_t, detail::comparator<tuple_t>, 8> set;
+    std::set<tuple_t> reference;
+
+    // alternate insertions and compactions, checking bounds against the reference
+    for (int round = 0; round < 5; ++round) {
+        for (int i = 0; i < 2000; ++i) {
+            tuple_t t{{dist(gen), dist(gen), dist(gen)}};
+            EXPECT_EQ(reference.insert(t).second, set.insert(t));
+        }
+        if (round % 2 == 0) {
+            set.compact();
+        }
+        EXPECT_EQ(reference.size(), set.size());
+        EXPECT_TRUE(std::equal(reference.begin(), reference.end(), set.begin(), set.end()));
+
+        decltype(set)::operation_hints hints;
+        for (int i = 0; i < 200; ++i) {
+            tuple_t low{{dist(gen), dist(gen), dist(gen)}};
+            tuple_t high{{low[0], dist(gen), dist(gen)}};
+            if (high < low) {
+                std::swap(low, high);
+            }
+            auto expected = std::distance(reference.lower_bound(low), reference.upper_bound(high));
+            auto found = std::distance(set.lower_bound(low, hints), set.upper_bound(high, hints));
+            EXPECT_EQ(expected, found);
+            EXPECT_EQ(reference.count(low) == 1, set.contains(low, hints));
+        }
+
+        // the chunks of a partition cover the set in order
+        std::vector<tuple_t> chunked;
+        for (const auto& chunk : set.partition(7)) {
+            chunked.insert(chunked.end(), chunk.begin(), chunk.end());
+        }
+        EXPECT_TRUE(std::equal(reference.begin(), reference.end(), chunked.begin(), chunked.end()));
+    }
+}
+
+TEST(CompressedBTreeSet, InsertSorted) {
+    compressed_btree_set<tuple_t> set;
+    for (RamDomain i = 0; i < 100; i += 2) {
+        set.insert(tuple_t{{i, i, i}});
+    }
+    set.compact();
+
+    std::vector<tuple_t> sorted;
+    for (RamDomain i = 0; i < 100; ++i) {
+        sorted.push_back(tuple_t{{i, i, i}});
+    }
+    std::size_t inserted = 0;
+    set.insertSorted(sorted.begin(), sorted.end(), [&](const tuple_t&) { ++inserted; });
+    EXPECT_EQ(50, inserted);
+    EXPECT_EQ(100, set.size());
+    EXPECT_EQ(sorted, contents(set));
+}
+
+TEST(CompressedBTreeMultiset, Duplicates) {
+    compressed_btree_multiset<tuple_t, first_column_comparator, 4> set;
+    for (RamDomain i = 0; i < 30; ++i) {
+        set.insert(tuple_t{{i % 3, i, -i}});
+    }
+    set.compact();
+    for (RamDomain i = 30; i < 45; ++i) {
+        set.insert(tuple_t{{i % 3, i, -i}});
+    }
+    EXPECT_EQ(45, set.size());
+
+    for (RamDomain k = 0; k < 3; ++k) {
+        tuple_t key{{k, 0, 0}};
+        auto range = make_range(set.lower_bound(key), set.upper_bound(key));
+        std::set<RamDomain> seen;
+        for (const auto& t : range) {
+            EXPECT_EQ(k, t[0]);
+            EXPECT_EQ(-t[1], t[2]);
+            seen.insert(t[1]);
+        }
+        EXPECT_EQ(15, seen.size());
+    }
+
+    set.compact();
+    EXPECT_FALSE(set.hasStaged());
+    EXPECT_EQ(45, std::distance(set.begin(), set.end()));
+}
+
+TEST(CompressedBTreeSet, ParallelInsert) {
+    compressed_btree_set<tuple_t> set;
+    for (RamDomain i = 0; i < 1000; ++i) {
+        set.insert(tuple_t{{i, 0, 0}});
+    }
+    set.compact();
+
+#pragma omp parallel for
+    for (RamDomain i = 0; i < 10000; ++i) {
+        set.insert(tuple_t{{i % 2000, 0, 0}});
+    }
+    EXPECT_EQ(2000, set.size());
+    set.compact();
+    EXPECT_EQ(2000, std::distance(set.begin(), set.end()));
+}
+
+TEST(CompressedBTreeSet, MemoryUsage) {
+    // a wide relation of sorted tuples sharing their leading columns
+    using wide_t = Tuple<RamDomain, 8>;
+    compressed_btree_set<wide_t> compressed;
+    btree_set<wide_t> plain;
+    for (RamDomain i = 0; i < 100000; ++i) {
+        wide_t t{{i / 1000, i / 100, 7, 7, i, i * 2, 3, i % 10}};
+        compressed.insert(t);
+        plain.insert(t);
+    }
+    compressed.compact();
+    EXPECT_EQ(plain.size(), compressed.size());
+    EXPECT_TRUE(std::equal(plain.begin(), plain.end(), compressed.begin(), compressed.end()));
+    EXPECT_LT(compressed.getMemoryUsage() * 3, plain.getMemoryUsage());
+}
+
+}  // namespace souffle::test
@@ -0,0 +1,118 @@
+/*
+ * Souffle - A Datalog Compiler
+ * Copyright (c) 2026, The Souffle Developers. All rights reserved
+ * Licensed under the Universal Permissive License v 1.0 as shown at:
+ * - https://opensource.org/licenses/UPL
+ * - <souffle root>/licenses/SOUFFLE-UPL.txt
+ */
+
+/************************************************************************
+ *
+ * @file hash_set_test.cpp
+ *
+ * Test the concurrent insert-only hash set.
+ *
+ ***********************************************************************/
+
+#include "tests/test.h"
+
+#include "souffle/RamTypes.h"
+#include "souffle/datastructure/ConcurrentInsertOnlyHashSet.h"
+#include "souffle/utility/ParallelUtil.h"
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <random>
+#include <set>
+#include <vector>
+
+namespace souffle::test {
+
+using tuple_t = Tuple<RamDomain, 2>;
+
+TEST(TupleHashSet, Basic) {
+    TupleHashSet<2> set;
+    EXPECT_TRUE(set.empty());
+    EXPECT_EQ(0, set.size());
+    EXPECT_TRUE(set.begin() == set.end());
+
+    EXPECT_TRUE(set.insert(tuple_t{{1, 2}}));
+    EXPECT_FALSE(set.insert(tuple_t{{1, 2}}));
+    EXPECT_TRUE(set.insert(tuple_t{{2, 1}}));
+    EXPECT_EQ(2, set.size());
+
+    EXPECT_TRUE(set.contains(tuple_t{{1, 2}}));
+    EXPECT_TRUE(set.contains(tuple_t{{2, 1}}));
+    EXPECT_FALSE(set.contains(tuple_t{{1, 1}}));
+
+    EXPECT_TRUE(set.find(tuple_t{{1, 1}}) == set.end());
+    EXPECT_TRUE(*set.find(tuple_t{{2, 1}}) == (tuple_t{{2, 1}}));
+
+    auto range = set.equalRange(tuple_t{{1, 2}});
+    EXPECT_EQ(1, std::distance(range.begin(), range.end()));
+    range = set.equalRange(tuple_t{{2, 2}});
+    EXPECT_TRUE(range.empty());
+
+    set.clear();
+    EXPECT_TRUE(set.empty());
+    EXPECT_FALSE(set.contains(tuple_t{{1, 2}}));
+}
+
+TEST(TupleHashSet, Grow) {
+    TupleHashSet<2> set;
+    std::set<tuple_t> expected;
+    std::mt19937 generator(3);
+    std::uniform_int_distribution<RamDomain> dist(-1000, 1000);
+    for (int i = 0; i < 100000; ++i) {
+        tuple_t t{{dist(generator), dist(generator)}};
+        EXPECT_EQ(expected.insert(t).second, set.insert(t));
+    }
+    EXPECT_EQ(expected.size(), set.size());
+
+    std::set<tuple_t> content(set.begin(), set.end());
+    EXPECT_EQ(expected, content);
+    for (RamDomain i = -1000; i < 1000; i += 7) {
+        tuple_t t{{i, -i}};
+        EXPECT_EQ(expected.count(t) > 0, set.contains(t));
+    }
+
+    // the partition covers every element exactly once
+    for (std::size_t count : {1, 7, 100, 1 << 20}) {
+        std::size_t total = 0;
+        for (const auto& part : set.partition(count)) {
+            EXPECT_FALSE(part.empty());
+            total += std::distance(part.begin(), part.end());
+        }
+        EXPECT_EQ(expected.size(), total);
+    }
+}
+
+TEST(TupleHashSet, Parallel) {
+    TupleHashSet<2> set;
+    const int N = 200000;
+    std::atomic<std::size_t> inserted{0};
+    std::atomic<std::size_t> missing{0};
+
+    // every tuple is inserted by two threads, only one of which succeeds
+    PARALLEL_START
+    pfor(int i = 0; i < 2 * N; ++i) {
+        const RamDomain x = i % N;
+        if (set.insert(tuple_t{{x, x % 13}})) {
+            ++inserted;
+        }
+        if (!set.contains(tuple_t{{x, x % 13}})) {
+            ++missing;
+        }
+    }
+    PARALLEL_END
+
+    EXPECT_EQ(0, missing.load());
+    EXPECT_EQ(static_cast<std::size_t>(N), inserted.load());
+    EXPECT_EQ(static_cast<std::size_t>(N), set.size());
+    for (RamDomain x = 0; x < N; ++x) {
+        EXPECT_TRUE(set.contains(tuple_t{{x, x % 13}}));
+        EXPECT_FALSE(set.contains(tuple_t{{x, x % 13 + 1}}));
+    }
+}
+
+}  // namespace souffle::test
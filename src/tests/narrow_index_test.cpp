@@ -0,0 +1,187 @@
+/*
+ * Souffle - A Datalog Compiler
+ * Copyright (c) 2026, The Souffle Developers. All rights reserved
+ * Licensed under the Universal Permissive License v 1.0 as shown at:
+ * - https://opensource.org/licenses/UPL
+ * - <souffle root>/licenses/SOUFFLE-UPL.txt
+ */
+
+/************************************************************************
+ *
+ * @file narrow_index_test.cpp
+ *
+ * Test the indexes storing tuples in packed 32-bit columns.
+ *
+ ***********************************************************************/
+
+#include "tests/test.h"
+
+#include "souffle/RamTypes.h"
+#include "souffle/datastructure/BTree.h"
+#include "souffle/datastructure/NarrowIndex.h"
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <limits>
+#include <random>
+#include <set>
+#include <vector>
+
+namespace souffle::test {
+
+using tuple_t = Tuple<int64_t, 3>;
+
+// the first column keeps its full width, the others are narrowed
+using codec_t = narrow_codec<tuple_t, 0b001>;
+using narrow_comparator_t = narrow_comparator<codec_t, detail::comparator<tuple_t>>;
+using narrow_set_t = narrow_index<codec_t, btree_set<codec_t::stored_type, narrow_comparator_t>>;
+
+TEST(NarrowCodec, Layout) {
+    EXPECT_EQ(4, codec_t::slots);
+    EXPECT_EQ(16, sizeof(codec_t::stored_type));
+    EXPECT_EQ(2, (narrow_codec<Tuple<int64_t, 2>>::slots));
+    EXPECT_EQ(3, (narrow_codec<Tuple<int32_t, 3>, 0b111>::slots));
+}
+
+TEST(NarrowCodec, RoundTrip) {
+    const int64_t wideMin = std::numeric_limits<int64_t>::min();
+    const int64_t wideMax = std::numeric_limits<int64_t>::max();
+    const int64_t narrowMin = std::numeric_limits<int32_t>::min();
+    const int64_t narrowMax = std::numeric_limits<int32_t>::max();
+    for (int64_t a : {wideMin, narrowMin - 1, int64_t(-1), int64_t(0), narrowMax + 1, wideMax}) {
+        for (int64_t b : {narrowMin, int64_t(-5), int64_t(0), narrowMax}) {
+            tuple_t t{{a, b, -1 - b}};
+            EXPECT_EQ(t, codec_t::widen(codec_t::narrow(t)));
+        }
+    }
+}
+
+TEST(NarrowIndex, Basic) {
+    narrow_set_t set;
+    EXPECT_TRUE(set.empty());
+    EXPECT_TRUE(set.begin() == set.end());
+
+    const int64_t big = int64_t(1) << 40;
+    EXPECT_TRUE(set.insert(tuple_t{{big, 2, 3}}));
+    EXPECT_TRUE(set.insert(tuple_t{{-big, 2, -4}}));
+    EXPECT_FALSE(set.insert(tuple_t{{big, 2, 3}}));
+    EXPECT_EQ(2, set.size());
+
+    std::vector<tuple_t> expected = {tuple_t{{-big, 2, -4}}, tuple_t{{big, 2, 3}}};
+    EXPECT_EQ(expected, std::vector<tuple_t>(set.begin(), set.end()));
+    EXPECT_TRUE(set.contains(tuple_t{{-big, 2, -4}}));
+    EXPECT_FALSE(set.contains(tuple_t{{big, 2, -4}}));
+    EXPECT_TRUE(set.find(tuple_t{{0, 0, 0}}) == set.end());
+    EXPECT_TRUE(*set.find(tuple_t{{big, 2, 3}}) == (tuple_t{{big, 2, 3}}));
+
+    set.clear();
+    EXPECT_TRUE(set.empty());
+}
+
+TEST(NarrowIndex, UnconstrainedBounds) {
+    // searches leave columns unconstrained with the limits of the wide column type
+    const int64_t lo = std::numeric_limits<int64_t>::min();
+    const int64_t hi = std::numeric_limits<int64_t>::max();
+    narrow_set_t set;
+    for (int64_t i = -10; i < 10; ++i) {
+        set.insert(tuple_t{{i % 3, i, -i}});
+    }
+    auto lower = set.lower_bound(tuple_t{{1, lo, lo}});
+    auto upper = set.upper_bound(tuple_t{{1, hi, hi}});
+    std::size_t found = 0;
+    for (auto it = lower; it != upper; ++it) {
+        EXPECT_EQ(1, (*it)[0]);
+        ++found;
+    }
+    EXPECT_EQ(3, found);
+
+    auto first = set.lower_bound(tuple_t{{lo, lo, lo}});
+    auto last = set.upper_bound(tuple_t{{hi, hi, hi}});
+    EXPECT_EQ(20, set.distance(first, last));
+}
+
+TEST(NarrowIndex, OutOfRange) {
+    const int64_t beyond = int64_t(std::numeric_limits<int32_t>::max()) + 1;
+    EXPECT_TRUE(codec_t::fits(tuple_t{{beyond, 0, 0}}));
+    EXPECT_FALSE(codec_t::fits(tuple_t{{0, beyond, 0}}));
+    EXPECT_FALSE(codec_t::fits(tuple_t{{0, 0, -beyond - 1}}));
+
+    // lookups of values beyond a narrow column are not confused with its limits
+    narrow_set_t set;
+    const int64_t narrowMax = std::numeric_limits<int32_t>::max();
+    set.insert(tuple_t{{0, narrowMax, 0}});
+    EXPECT_TRUE(set.contains(tuple_t{{0, narrowMax, 0}}));
+    EXPECT_FALSE(set.contains(tuple_t{{0, beyond, 0}}));
+    EXPECT_TRUE(set.find(tuple_t{{0, beyond, 0}}) == set.end());
+}
+
+TEST(NarrowIndex, Random) {
+    std::mt19937 gen(5);
+    std::uniform_int_distribution<int64_t> dist(-50, 50);
+    narrow_set_t set;
+    std::set<tuple_t> reference;
+    narrow_set_t::operation_hints hints;
+
+    for (int i = 0; i < 5000; ++i) {
+        tuple_t t{{dist(gen) << 36, dist(gen), dist(gen)}};
+        EXPECT_EQ(reference.insert(t).second, set.insert(t, hints));
+    }
+    EXPECT_EQ(reference.size(), set.size());
+    EXPECT_TRUE(std::equal(reference.begin(), reference.end(), set.begin(), set.end()));
+
+    for (int i = 0; i < 200; ++i) {
+        tuple_t low{{dist(gen) << 36, dist(gen), dist(gen)}};
+        tuple_t high{{low[0], dist(gen), dist(gen)}};
+        if (high < low) {
+            std::swap(low, high);
+        }
+        auto expected = std::distance(reference.lower_bound(low), reference.upper_bound(high));
+        auto lower = set.lower_bound(low, hints);
+        auto upper = set.upper_bound(high, hints);
+        EXPECT_EQ(expected, std::distance(lower, upper));
+        EXPECT_EQ(static_cast<std::size_t>(expected), set.distance(lower, upper));
+        EXPECT_EQ(reference.count(low) == 1, set.contains(low, hints));
+    }
+
+    // the chunks of a partition cover the set in order
+    std::vector<tuple_t> chunked;
+    for (const auto& chunk : set.partition(7)) {
+        chunked.insert(chunked.end(), chunk.begin(), chunk.end());
+    }
+    EXPECT_TRUE(std::equal(reference.begin(), reference.end(), chunked.begin(), chunked.end()));
+}
+
+TEST(NarrowIndex, InsertSorted) {
+    narrow_set_t set;
+    for (int64_t i = 0; i < 100; i += 2) {
+        set.insert(tuple_t{{i, i, i}});
+    }
+
+    std::vector<tuple_t> sorted;
+    for (int64_t i = 0; i < 100; ++i) {
+        sorted.push_back(tuple_t{{i, i, i}});
+    }
+    std::size_t inserted = 0;
+    set.insertSorted(sorted.begin(), sorted.end(), [&](const tuple_t&) { ++inserted; });
+    EXPECT_EQ(50, inserted);
+    EXPECT_EQ(sorted, std::vector<tuple_t>(set.begin(), set.end()));
+}
+
+TEST(NarrowIndex, MemoryUsage) {
+    using wide_t = Tuple<int64_t, 4>;
+    using narrow_t = narrow_codec<wide_t>;
+    using comparator_t = narrow_comparator<narrow_t, detail::comparator<wide_t>>;
+    narrow_index<narrow_t, btree_set<narrow_t::stored_type, comparator_t>> narrow;
+    btree_set<wide_t> plain;
+    for (int64_t i = 0; i < 100000; ++i) {
+        wide_t t{{i / 1000, -i, i % 7, i}};
+        narrow.insert(t);
+        plain.insert(t);
+    }
+    EXPECT_EQ(plain.size(), narrow.size());
+    EXPECT_TRUE(std::equal(plain.begin(), plain.end(), narrow.begin(), narrow.end()));
+    EXPECT_LT(narrow.getMemoryUsage() * 3, plain.getMemoryUsage() * 2);
+}
+
+}  // namespace souffle::test
@@ -0,0 +1,141 @@
+/*
+ * Souffle - A Datalog Compiler
+ * Copyright (c) 2026, The Souffle Developers. All rights reserved
+ * Licensed under the Universal Permissive License v 1.0 as shown at:
+ * - https://opensource.org/licenses/UPL
+ * - <souffle root>/licenses/SOUFFLE-UPL.txt
+ */
+
+/************************************************************************
+ *
+ * @file node_arena_test.cpp
+ *
+ * Test the arena allocating the nodes of b-trees.
+ *
+ ***********************************************************************/
+
+#include "tests/test.h"
+
+#include "souffle/RamTypes.h"
+#include "souffle/datastructure/BTree.h"
+#include "souffle/datastructure/NodeArena.h"
+#include "souffle/utility/ParallelUtil.h"
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <set>
+#include <vector>
+
+namespace souffle::test {
+
+using tuple_t = Tuple<RamDomain, 2>;
+using arena_set_t = btree_set<tuple_t, detail::comparator<tuple_t>, NodeArena>;
+using arena_multiset_t = btree_multiset<tuple_t, detail::comparator<tuple_t>, NodeArena>;
+
+TEST(NodeArena, Allocate) {
+    NodeArena arena;
+    EXPECT_EQ(0, arena.getMemoryUsage() - NodeArena().getMemoryUsage());
+
+    std::vector<char*> blocks;
+    for (std::size_t i = 0; i < 1000; ++i) {
+        auto* block = static_cast<char*>(arena.allocate(100 + i % 7, 16));
+        EXPECT_EQ(0, reinterpret_cast<std::uintptr_t>(block) % 16);
+        std::fill(block, block + 100, static_cast<char>(i));
+        blocks.push_back(block);
+    }
+    for (std::size_t i = 0; i < blocks.size(); ++i) {
+        const char fill = static_cast<char>(i);
+        EXPECT_TRUE(std::all_of(blocks[i], blocks[i] + 100, [&](char c) { return c == fill; }));
+    }
+    EXPECT_LT(100000, arena.getMemoryUsage());
+
+    arena.release();
+    EXPECT_EQ(0, arena.getMemoryUsage() - NodeArena().getMemoryUsage());
+}
+
+TEST(NodeArena, Scope) {
+    NodeArena outer;
+    NodeArena inner;
+    NodeArena::Scope outerScope(outer);
+    EXPECT_EQ(&outer, &NodeArena::current());
+    {
+        NodeArena::Scope innerScope(inner);
+        EXPECT_EQ(&inner, &NodeArena::current());
+    }
+    EXPECT_EQ(&outer, &NodeArena::current());
+}
+
+TEST(NodeArena, HugePages) {
+    for (bool enable : {false, true}) {
+        NodeArena::setHugePages(enable);
+        NodeArena arena;
+        // allocate past the growth of the slabs up to the size of a huge page
+        for (std::size_t i = 0; i < 3 * NodeArena::maxSlabSize / 1024; ++i) {
+            static_cast<char*>(arena.allocate(1000))[999] = 1;
+        }
+        EXPECT_LT(2 * NodeArena::maxSlabSize, arena.getMemoryUsage());
+    }
+}
+
+TEST(BTreeArena, Basic) {
+    std::mt19937 gen(7);
+    std::uniform_int_distribution<RamDomain> dist(0, 5000);
+    arena_set_t set;
+    std::set<tuple_t> reference;
+    for (int i = 0; i < 20000; ++i) {
+        tuple_t t{{dist(gen), dist(gen)}};
+        EXPECT_EQ(reference.insert(t).second, set.insert(t));
+    }
+    EXPECT_EQ(reference.size(), set.size());
+    EXPECT_TRUE(std::equal(reference.begin(), reference.end(), set.begin(), set.end()));
+    EXPECT_TRUE(set.check());
+
+    // copies and moves keep their own nodes
+    arena_set_t copy(set);
+    arena_set_t moved(std::move(copy));
+    set.clear();
+    EXPECT_TRUE(set.empty());
+    EXPECT_TRUE(std::equal(reference.begin(), reference.end(), moved.begin(), moved.end()));
+
+    // the tree is reusable after the release of its nodes
+    set.insert(tuple_t{{1, 2}});
+    EXPECT_EQ(1, set.size());
+    set.swap(moved);
+    EXPECT_EQ(1, moved.size());
+    EXPECT_EQ(reference.size(), set.size());
+}
+
+TEST(BTreeArena, InsertSorted) {
+    arena_multiset_t set;
+    for (RamDomain i = 0; i < 1000; i += 2) {
+        set.insert(tuple_t{{i, i}});
+    }
+    std::vector<tuple_t> sorted;
+    for (RamDomain i = 0; i < 1000; ++i) {
+        sorted.push_back(tuple_t{{i, i}});
+    }
+    // the merge rebuilds the tree in a new arena
+    set.insertSorted(sorted.begin(), sorted.end());
+    EXPECT_EQ(1500, set.size());
+    EXPECT_TRUE(std::is_sorted(set.begin(), set.end()));
+
+    auto loaded = arena_set_t::load(sorted.begin(), sorted.end());
+    EXPECT_EQ(sorted.size(), loaded.size());
+    EXPECT_TRUE(std::equal(sorted.begin(), sorted.end(), loaded.begin(), loaded.end()));
+}
+
+TEST(BTreeArena, Parallel) {
+    arena_set_t set;
+    const RamDomain n = 100000;
+
+#pragma omp parallel for
+    for (RamDomain i = 0; i < n; ++i) {
+        set.insert(tuple_t{{(i * 7919) % n, i % 3}});
+    }
+    EXPECT_EQ(n, set.size());
+    EXPECT_TRUE(set.check());
+    EXPECT_EQ(n, std::distance(set.begin(), set.end()));
+}
+
+}  // namespace souffle::test
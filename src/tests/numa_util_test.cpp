@@ -0,0 +1,103 @@
+/*
+ * Souffle - A Datalog Compiler
+ * Copyright (c) 2026, The Souffle Developers. All rights reserved
+ * Licensed under the Universal Permissive License v 1.0 as shown at:
+ * - https://opensource.org/licenses/UPL
+ * - <souffle root>/licenses/SOUFFLE-UPL.txt
+ */
+
+/************************************************************************
+ *
+ * @file numa_util_test.cpp
+ *
+ * Tests the NUMA topology and the placement of partitioned scans.
+ *
+ ***********************************************************************/
+
+#include "tests/test.h"
+
+#include "souffle/utility/NumaUtil.h"
+#include "souffle/utility/ParallelUtil.h"
+#include <cstddef>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+
+namespace souffle::test {
+
+TEST(NumaTopology, ParseCpuList) {
+    using cpus = std::vector<std::size_t>;
+    EXPECT_EQ(NumaTopology::parseCpuList(""), cpus());
+    EXPECT_EQ(NumaTopology::parseCpuList("3"), cpus({3}));
+    EXPECT_EQ(NumaTopology::parseCpuList("0-3"), cpus({0, 1, 2, 3}));
+    EXPECT_EQ(NumaTopology::parseCpuList("0-1,8,10-11\n"), cpus({0, 1, 8, 10, 11}));
+    EXPECT_EQ(NumaTopology::parseCpuList("x,4"), cpus({4}));
+}
+
+TEST(NumaTopology, Read) {
+    namespace fs = std::filesystem;
+    const fs::path dir = fs::temp_directory_path() / "souffle_numa_test";
+    fs::create_directories(dir / "node0");
+    fs::create_directories(dir / "node1");
+    std::ofstream(dir / "online") << "0-1\n";
+    std::ofstream(dir / "node0" / "cpulist") << "0-3\n";
+    std::ofstream(dir / "node1" / "cpulist") << "4-7\n";
+
+    const auto topology = NumaTopology::read(dir.string());
+    fs::remove_all(dir);
+
+    EXPECT_EQ(topology.getNumNodes(), 2);
+    EXPECT_EQ(topology.getCpus(0), std::vector<std::size_t>({0, 1, 2, 3}));
+    EXPECT_EQ(topology.getCpus(1), std::vector<std::size_t>({4, 5, 6, 7}));
+    EXPECT_TRUE(topology.getCpus(2).empty());
+
+    // consecutive threads share a node
+    EXPECT_EQ(topology.getNodeOfThread(0, 4), 0);
+    EXPECT_EQ(topology.getNodeOfThread(1, 4), 0);
+    EXPECT_EQ(topology.getNodeOfThread(2, 4), 1);
+    EXPECT_EQ(topology.getNodeOfThread(3, 4), 1);
+    EXPECT_EQ(topology.getNodeOfThread(0, 1), 0);
+}
+
+TEST(NumaTopology, Unknown) {
+    const auto topology = NumaTopology::read("/nonexistent/souffle/node");
+    EXPECT_EQ(topology.getNumNodes(), 1);
+    EXPECT_TRUE(topology.getCpus(0).empty());
+    EXPECT_EQ(topology.getNodeOfThread(5, 8), 0);
+}
+
+TEST(NumaPlacement, Partitions) {
+    const int count = 1000;
+    std::vector<int> owner(count, -1);
+
+    setNumaPlacement(true);
+    PARALLEL_START
+        pfor_partitions(int i = 0; i < count; i++) {
+#ifdef IS_PARALLEL
+            owner[i] = omp_get_thread_num();
+#else
+            owner[i] = 0;
+#endif
+        }
+    PARALLEL_END
+
+    // every partition is scanned, each thread scanning a contiguous block
+    for (int i = 0; i < count; i++) {
+        EXPECT_TRUE(0 <= owner[i]);
+        if (i > 0) {
+            EXPECT_TRUE(owner[i - 1] <= owner[i]);
+        }
+    }
+
+    setNumaPlacement(false);
+    std::vector<int> scanned(count, 0);
+    PARALLEL_START
+        pfor_partitions(int i = 0; i < count; i++) {
+            scanned[i]++;
+        }
+    PARALLEL_END
+    EXPECT_EQ(std::vector<int>(count, 1), scanned);
+}
+
+}  // end namespace souffle::test
@@ -209,4 +209,13 @@ INSTANTIATE_TEMPLATE_TEST(PackUnpack, Vector, 11);
 INSTANTIATE_TEMPLATE_TEST(PackUnpack, Vector, 23);
 INSTANTIATE_TEMPLATE_TEST(PackUnpack, Vector, 59);
 
+TEST(RecordTable, MemoryUsage) {
+    SpecializedRecordTable<0> recordTable;
+    const std::size_t empty = recordTable.getMemoryUsage();
+    for (RamDomain i = 0; i < 1000; ++i) {
+        recordTable.pack({i, i + 1, i + 2});
+    }
+    EXPECT_TRUE(recordTable.getMemoryUsage() >= empty + 1000 * 3 * sizeof(RamDomain));
+}
+
 }  // namespace souffle::test
@@ -0,0 +1,115 @@
+/*
+ * Souffle - A Datalog Compiler
+ * Copyright (c) 2026, The Souffle Developers. All rights reserved
+ * Licensed under the Universal Permissive License v 1.0 as shown at:
+ * - https://opensource.org/licenses/UPL
+ * - <souffle root>/licenses/SOUFFLE-UPL.txt
+ */
+
+/************************************************************************
+ *
+ * @file spill_test.cpp
+ *
+ * Tests spilling relations to disk and restoring them.
+ *
+ ***********************************************************************/
+
+#include "tests/test.h"
+
+#include "souffle/RamTypes.h"
+#include "souffle/datastructure/RecordTableImpl.h"
+#include "souffle/datastructure/SymbolTableImpl.h"
+#include "souffle/io/Spill.h"
+#include <array>
+#include <cstddef>
+#include <map>
+#include <string>
+#include <vector>
+
+namespace souffle::test {
+
+/** A minimal binary relation with the interface required by the spill manager */
+struct PairRelation {
+    std::vector<std::array<RamDomain, 2>> tuples;
+
+    std::size_t size() const {
+        return tuples.size();
+    }
+
+    void purge() {
+        tuples.clear();
+    }
+
+    void insert(const RamDomain* tuple) {
+        tuples.push_back({tuple[0], tuple[1]});
+    }
+
+    auto begin() const {
+        return tuples.begin();
+    }
+
+    auto end() const {
+        return tuples.end();
+    }
+};
+
+std::map<std::string, std::string> spillDirectives(const std::string& budget) {
+    return {{"IO", "spill"}, {"name", "pair"}, {"auxArity", "0"},
+            {"types", R"({"relation": {"arity": 2, "types": ["i:number", "s:symbol"]}})"},
+            {"memory-budget", budget}};
+}
+
+#ifdef __linux__
+TEST(Spill, RoundTrip) {
+    SymbolTableImpl symbols;
+    SpecializedRecordTable<0> records;
+    PairRelation rel;
+    for (RamDomain i = 0; i < 1000; ++i) {
+        rel.tuples.push_back({i, symbols.encode("s" + std::to_string(i))});
+    }
+    const auto expected = rel.tuples;
+
+    EXPECT_TRUE(SpillManager::residentMemory() > 0);
+    SpillManager::getInstance().spill(rel, spillDirectives("0"), symbols, records);
+    EXPECT_EQ(rel.size(), 0);
+
+    SpillManager::getInstance().restore(rel, spillDirectives("0"), symbols, records);
+    EXPECT_EQ(rel.size(), 1000);
+    EXPECT_TRUE(rel.tuples == expected);
+    EXPECT_EQ(symbols.decode(rel.tuples[42][1]), "s42");
+}
+
+TEST(Spill, AuxiliaryAttributes) {
+    SymbolTableImpl symbols;
+    SpecializedRecordTable<0> records;
+    PairRelation rel;
+    for (RamDomain i = 0; i < 100; ++i) {
+        rel.tuples.push_back({i, -i});
+    }
+    const auto expected = rel.tuples;
+
+    // the types only list the first attribute, the auxiliary one is spilled as a number
+    auto directives = spillDirectives("0");
+    directives["auxArity"] = "1";
+    directives["types"] = R"({"relation": {"arity": 1, "types": ["i:number"]}})";
+    SpillManager::getInstance().spill(rel, directives, symbols, records);
+    EXPECT_EQ(rel.size(), 0);
+    SpillManager::getInstance().restore(rel, directives, symbols, records);
+    EXPECT_TRUE(rel.tuples == expected);
+}
+#endif
+
+TEST(Spill, WithinBudget) {
+    SymbolTableImpl symbols;
+    SpecializedRecordTable<0> records;
+    PairRelation rel;
+    rel.tuples.push_back({1, symbols.encode("a")});
+
+    // the budget is not exceeded, so the relation stays in memory and restoring is a no-op
+    SpillManager::getInstance().spill(rel, spillDirectives("18446744073709551615"), symbols, records);
+    EXPECT_EQ(rel.size(), 1);
+    SpillManager::getInstance().restore(rel, spillDirectives("18446744073709551615"), symbols, records);
+    EXPECT_EQ(rel.size(), 1);
+}
+
+}  // namespace souffle::test
@@ -111,4 +111,14 @@ TEST(SymbolTable, Inserts) {
     }
 }
 
+TEST(SymbolTable, MemoryUsage) {
+    SymbolTableImpl table;
+    const std::size_t empty = table.getMemoryUsage();
+    for (int i = 0; i < RANDOM_TEST_SIZE; ++i) {
+        table.encode(random_string_with_length(64) + std::to_string(i));
+    }
+    // every symbol is stored outside of the string object
+    EXPECT_TRUE(table.getMemoryUsage() >= empty + RANDOM_TEST_SIZE * 64);
+}
+
 }  // namespace souffle::test